@@ -0,0 +1,34 @@
+'use strict';
+
+// Encodes buffers to and decodes them from base64 and hex strings of sizes
+// from 16 B to 16 MiB. Every run processes about `n` bytes of binary data.
+
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  codec: ['base64', 'hex'],
+  operation: ['encode', 'decode'],
+  len: [16, 256, 4096, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024],
+  n: [64 * 1024 * 1024]
+});
+
+function main({ codec, operation, len, n }) {
+  const iterations = Math.ceil(n / len);
+  const buf = Buffer.allocUnsafe(len);
+  for (let i = 0; i < len; i++)
+    buf[i] = (i * 7) & 0xff;
+  const str = buf.toString(codec);
+
+  if (operation === 'encode') {
+    bench.start();
+    for (let i = 0; i < iterations; i++)
+      buf.toString(codec);
+    bench.end(iterations);
+  } else {
+    const out = Buffer.allocUnsafe(len);
+    bench.start();
+    for (let i = 0; i < iterations; i++)
+      out.write(str, codec);
+    bench.end(iterations);
+  }
+}
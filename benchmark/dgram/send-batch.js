@@ -0,0 +1,60 @@
+// Test UDP send throughput of socket.send() versus socket.sendBatch()
+'use strict';
+
+const common = require('../common.js');
+const dgram = require('dgram');
+const PORT = common.PORT;
+
+// `num` is the number of datagrams to queue up each time.
+const bench = common.createBenchmark(main, {
+  len: [16, 64, 512],
+  num: [100, 1000],
+  method: ['send', 'sendBatch'],
+  dur: [5]
+});
+
+function main({ dur, len, num, method }) {
+  const chunk = Buffer.allocUnsafe(len);
+  const messages = [];
+  for (let i = 0; i < num; i++)
+    messages.push({ msg: chunk, port: PORT, address: '127.0.0.1' });
+  let sent = 0;
+  let done = false;
+  const socket = dgram.createSocket('udp4');
+
+  function onsend() {
+    if (sent++ % num === 0) {
+      // The setImmediate() is necessary to have event loop progress on OSes
+      // that only perform synchronous I/O on nonblocking UDP sockets.
+      setImmediate(() => {
+        for (let i = 0; i < num; i++) {
+          socket.send(chunk, PORT, '127.0.0.1', onsend);
+        }
+      });
+    }
+  }
+
+  function onsendbatch() {
+    if (done)
+      return;
+    sent += num;
+    setImmediate(() => socket.sendBatch(messages, onsendbatch));
+  }
+
+  socket.on('listening', () => {
+    bench.start();
+    if (method === 'send') {
+      onsend();
+    } else {
+      socket.sendBatch(messages, onsendbatch);
+    }
+
+    setTimeout(() => {
+      done = true;
+      bench.end(sent);
+      process.exit(0);
+    }, dur * 1000);
+  });
+
+  socket.bind(PORT);
+}
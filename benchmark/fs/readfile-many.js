@@ -0,0 +1,53 @@
+// Read a set of files with fs.readFile() n times, with a limited number of
+// reads in flight, and report the number of files read per second.
+// Small files are read in a single threadpool job, larger ones in chunks.
+'use strict';
+
+const path = require('path');
+const common = require('../common.js');
+const fs = require('fs');
+const assert = require('assert');
+
+const tmpdir = require('../../test/common/tmpdir');
+
+const bench = common.createBenchmark(main, {
+  n: [1e4],
+  files: [100],
+  len: [64, 4 * 1024, 64 * 1024, 1024 * 1024],
+  encoding: ['buffer', 'utf8'],
+  concurrent: [1, 10]
+});
+
+function main({ n, files, len, encoding, concurrent }) {
+  tmpdir.refresh();
+  const filenames = [];
+  const data = Buffer.alloc(len, 'x');
+  for (let i = 0; i < files; i++) {
+    const filename = path.join(tmpdir.path, `readfile-many-${i}`);
+    fs.writeFileSync(filename, data);
+    filenames.push(filename);
+  }
+  const options = encoding === 'buffer' ? undefined : { encoding };
+
+  let started = 0;
+  let finished = 0;
+
+  function read() {
+    fs.readFile(filenames[started++ % files], options, afterRead);
+  }
+
+  function afterRead(err, result) {
+    assert.ifError(err);
+    assert.strictEqual(result.length, len);
+    if (++finished === n) {
+      bench.end(n);
+      tmpdir.refresh();
+    } else if (started < n) {
+      read();
+    }
+  }
+
+  bench.start();
+  for (let i = 0; i < concurrent && i < n; i++)
+    read();
+}
@@ -0,0 +1,45 @@
+'use strict';
+
+// Requests with many headers, parsed with and without the batchHeaders server
+// option. With `read=false` neither the handler nor the server itself turns
+// the header block into `req.headers`, as none of the requests has an Expect
+// header.
+
+const common = require('../common.js');
+const http = require('http');
+
+const bench = common.createBenchmark(main, {
+  headers: [20, 60, 100],
+  batch: ['true', 'false'],
+  read: ['true', 'false'],
+  c: [50]
+});
+
+function main({ headers, batch, read, c }) {
+  const server = http.createServer({
+    batchHeaders: batch === 'true'
+  }, (req, res) => {
+    if (read === 'true' && req.headers['x-header-0'] === undefined)
+      throw new Error('missing header');
+    res.end();
+  });
+
+  server.listen(common.PORT, () => {
+    const requestHeaders = {
+      'Content-Type': 'text/plain',
+      'Accept': 'text/plain',
+      'User-Agent': 'nodejs-benchmark',
+      'Date': new Date().toString(),
+      'Cache-Control': 'no-cache'
+    };
+    for (let i = 0; i < headers; i++)
+      requestHeaders[`X-Header-${i}`] = `some header value ${i}`;
+    bench.http({
+      path: '/',
+      connections: c,
+      headers: requestHeaders
+    }, () => {
+      server.close();
+    });
+  });
+}
@@ -0,0 +1,45 @@
+'use strict';
+
+const common = require('../common.js');
+const PORT = common.PORT;
+
+// Many concurrent streams with small responses, as with an RPC gateway.
+const bench = common.createBenchmark(main, {
+  n: [1e4],
+  streams: [10, 100],
+  writeCoalesceSize: [0, 16384]
+}, { flags: ['--no-warnings'] });
+
+function main({ n, streams, writeCoalesceSize }) {
+  const http2 = require('http2');
+  const server = http2.createServer({ writeCoalesceSize });
+  server.on('stream', (stream) => {
+    stream.respond({ 'content-type': 'application/grpc' });
+    stream.end('{"status":"ok"}');
+  });
+  server.listen(PORT, () => {
+    const client = http2.connect(`http://localhost:${PORT}/`);
+    let started = 0;
+    let finished = 0;
+
+    function doRequest() {
+      started++;
+      const req = client.request({ ':method': 'POST' });
+      req.resume();
+      req.on('end', () => {
+        if (++finished === n) {
+          bench.end(n);
+          server.close();
+          client.destroy();
+        } else if (started < n) {
+          doRequest();
+        }
+      });
+      req.end('{"id":1}');
+    }
+
+    bench.start();
+    for (let i = 0; i < Math.min(streams, n); i++)
+      doRequest();
+  });
+}
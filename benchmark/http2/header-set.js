@@ -0,0 +1,64 @@
+'use strict';
+
+const common = require('../common.js');
+const PORT = common.PORT;
+
+const bench = common.createBenchmark(main, {
+  n: [1e3],
+  nheaders: [10, 100],
+  headerSet: ['true', 'false']
+}, { flags: ['--no-warnings'] });
+
+function main({ n, nheaders, headerSet }) {
+  const http2 = require('http2');
+  const server = http2.createServer();
+
+  // Headers that are the same for every response, like those a server adds
+  // for security policies and caching.
+  const staticHeaders = {
+    'cache-control': 'public, max-age=3600',
+    'content-type': 'text/plain; charset=utf-8',
+    'strict-transport-security': 'max-age=31536000; includeSubDomains',
+    'x-content-type-options': 'nosniff',
+    'x-frame-options': 'DENY'
+  };
+  for (var i = 0; i < nheaders; i++) {
+    staticHeaders[`x-static-${i}`] = `some header value ${i}`;
+  }
+
+  let respond;
+  if (headerSet === 'true') {
+    const options = { headerSet: http2.createHeaderSet(staticHeaders) };
+    respond = (stream) => stream.respond({ ':status': 200 }, options);
+  } else {
+    respond = (stream) => stream.respond({
+      ':status': 200,
+      ...staticHeaders
+    });
+  }
+
+  server.on('stream', (stream) => {
+    respond(stream);
+    stream.end('Hi!');
+  });
+  server.listen(PORT, () => {
+    const client = http2.connect(`http://localhost:${PORT}/`);
+
+    function doRequest(remaining) {
+      const req = client.request({ ':path': '/' });
+      req.resume();
+      req.on('end', () => {
+        if (remaining > 0) {
+          doRequest(remaining - 1);
+        } else {
+          bench.end(n);
+          server.close();
+          client.destroy();
+        }
+      });
+    }
+
+    bench.start();
+    doRequest(n);
+  });
+}
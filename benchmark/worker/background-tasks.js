@@ -0,0 +1,86 @@
+'use strict';
+
+// Posts many short V8 background tasks from several isolates at once by
+// compiling WebAssembly modules asynchronously in Worker threads. Every
+// compilation is split into tasks that run on the shared platform workers.
+
+const common = require('../common.js');
+const bench = common.createBenchmark(main, {
+  workers: [1, 4, 8],
+  functions: [16, 256],
+  n: [200]
+});
+
+function leb128(value) {
+  const bytes = [];
+  do {
+    let byte = value & 0x7f;
+    value >>>= 7;
+    if (value !== 0)
+      byte |= 0x80;
+    bytes.push(byte);
+  } while (value !== 0);
+  return bytes;
+}
+
+function section(id, contents) {
+  return [id, ...leb128(contents.length), ...contents];
+}
+
+// A module with `functions` functions of type () => i32.
+function makeModule(functions) {
+  const body = [0x04, 0x00, 0x41, 0x2a, 0x0b];  // i32.const 42
+  const code = [...leb128(functions)];
+  const decls = [...leb128(functions)];
+  for (let i = 0; i < functions; i++) {
+    decls.push(0x00);
+    code.push(...body);
+  }
+  return Buffer.from([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+    ...section(0x01, [0x01, 0x60, 0x00, 0x01, 0x7f]),
+    ...section(0x03, decls),
+    ...section(0x07, [0x01, 0x01, 0x66, 0x00, 0x00]),
+    ...section(0x0a, code),
+  ]);
+}
+
+const workerSource = `
+const { parentPort, workerData } = require('worker_threads');
+const { bytes, n } = workerData;
+parentPort.once('message', async () => {
+  for (let i = 0; i < n; i++)
+    await WebAssembly.compile(bytes);
+  parentPort.postMessage('done');
+});
+parentPort.postMessage('ready');
+`;
+
+function main({ workers, functions, n }) {
+  const { Worker } = require('worker_threads');
+  const bytes = makeModule(functions);
+  const threads = [];
+  let ready = 0;
+  let done = 0;
+
+  for (let i = 0; i < workers; i++) {
+    const worker = new Worker(workerSource, {
+      eval: true,
+      workerData: { bytes, n }
+    });
+    threads.push(worker);
+    worker.on('message', (msg) => {
+      if (msg === 'ready') {
+        if (++ready === workers) {
+          bench.start();
+          for (const thread of threads)
+            thread.postMessage('start');
+        }
+      } else if (++done === workers) {
+        bench.end(n * workers);
+        for (const thread of threads)
+          thread.terminate();
+      }
+    });
+  }
+}
@@ -0,0 +1,62 @@
+'use strict';
+
+const common = require('../common.js');
+const bench = common.createBenchmark(main, {
+  method: ['RingChannel', 'MessagePort'],
+  size: [16, 1024],
+  n: [1e5]
+});
+
+// The worker sends n messages of `size` bytes to the main thread, either
+// through a RingChannel or by posting Buffers to its parent port.
+const workerSource = `
+const { RingChannel, parentPort, workerData } = require('worker_threads');
+const { method, size, n, buffer } = workerData;
+const message = Buffer.alloc(size, 'x');
+if (method === 'MessagePort') {
+  for (let i = 0; i < n; i++)
+    parentPort.postMessage(message);
+} else {
+  const channel = new RingChannel(buffer);
+  let sent = 0;
+  function write() {
+    while (sent < n) {
+      if (!channel.write(message))
+        return;
+      sent++;
+    }
+    channel.close();
+  }
+  channel.on('drain', write);
+  write();
+}
+`;
+
+function main({ method, size, n }) {
+  const { RingChannel, Worker } = require('worker_threads');
+
+  let received = 0;
+  function onMessage() {
+    if (++received === n) {
+      bench.end(n);
+      if (channel !== undefined)
+        channel.close();
+    }
+  }
+
+  let channel;
+  let buffer;
+  if (method === 'RingChannel') {
+    channel = new RingChannel(1024 * 1024);
+    channel.on('message', onMessage);
+    buffer = channel.buffer;
+  }
+
+  bench.start();
+  const worker = new Worker(workerSource, {
+    eval: true,
+    workerData: { method, size, n, buffer }
+  });
+  if (method === 'MessagePort')
+    worker.on('message', onMessage);
+}
@@ -0,0 +1,39 @@
+'use strict';
+const common = require('../common.js');
+const fs = require('fs');
+const zlib = require('zlib');
+
+const bench = common.createBenchmark(main, {
+  type: ['Gzip', 'Deflate'],
+  parallel: [0, 2, 4],
+  level: [6],
+  inputLen: [64 * 1024 * 1024],
+  n: [4]
+});
+
+function main({ type, parallel, level, inputLen, n }) {
+  // Numbered copies of this file, so that the input does not compress
+  // unrealistically well.
+  const source = fs.readFileSync(__filename, 'latin1');
+  const copies = [];
+  for (let length = 0; length < inputLen; length += source.length)
+    copies.push(`${copies.length} ${source}`);
+  const input = Buffer.from(copies.join(''), 'latin1').slice(0, inputLen);
+  const chunkSize = 64 * 1024;
+  const options = { level, parallel: parallel > 0 ? parallel : false };
+
+  let i = 0;
+  bench.start();
+  (function next() {
+    if (i++ === n) {
+      // Give result in MiB/s of input.
+      return bench.end(inputLen * n / (1024 ** 2));
+    }
+    const stream = new zlib[type](options);
+    stream.resume();
+    stream.on('end', next);
+    for (let offset = 0; offset < inputLen; offset += chunkSize)
+      stream.write(input.slice(offset, offset + chunkSize));
+    stream.end();
+  })();
+}
@@ -450,6 +450,15 @@ parser.add_option('--with-ltcg',
     dest='with_ltcg',
     help='Use Link Time Code Generation. This feature is only available on Windows.')
 
+parser.add_option('--node-snapshot-main',
+    action='store',
+    dest='node_snapshot_main',
+    help='Run the specified JavaScript file in the main context before it is '
+         'snapshotted, so that the globals it defines are available at '
+         'startup without running it again. The script runs before Node.js '
+         'is bootstrapped and can only use plain JavaScript. Worker threads '
+         'do not start from the snapshot.')
+
 parser.add_option('--without-node-snapshot',
     action='store_true',
     dest='without_node_snapshot',
@@ -980,6 +989,13 @@ def configure_node(o):
   else:
     o['variables']['node_use_node_snapshot'] = 'false'
 
+  if options.node_snapshot_main is not None:
+    if o['variables']['node_use_node_snapshot'] != 'true':
+      error('--node-snapshot-main is incompatible with --without-node-snapshot '
+            'and with cross compilation')
+    o['variables']['node_snapshot_main'] = \
+        os.path.abspath(options.node_snapshot_main)
+
   if target_arch == 'arm':
     configure_arm(o)
   elif target_arch in ('mips', 'mipsel', 'mips64el'):
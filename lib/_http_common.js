@@ -30,6 +30,7 @@ const FreeList = require('internal/freelist');
 const incoming = require('_http_incoming');
 const {
   IncomingMessage,
+  headerBlockToArray,
   readStart,
   readStop
 } = incoming;
@@ -37,6 +38,7 @@ const {
 const debug = require('internal/util/debuglog').debuglog('http');
 
 const kIncomingMessage = Symbol('IncomingMessage');
+const kBatchHeaders = Symbol('kBatchHeaders');
 const kOnHeaders = HTTPParser.kOnHeaders | 0;
 const kOnHeadersComplete = HTTPParser.kOnHeadersComplete | 0;
 const kOnBody = HTTPParser.kOnBody | 0;
@@ -50,7 +52,10 @@ const MAX_HEADER_PAIRS = 2000;
 // across multiple TCP packets or too large to be
 // processed in a single run. This method is also
 // called to process trailing HTTP headers.
-function parserOnHeaders(headers, url) {
+// In batch mode, it is only called for trailers and `offsets` is set.
+function parserOnHeaders(headers, url, offsets) {
+  if (offsets !== undefined)
+    headers = headerBlockToArray(headers, offsets);
   // Once we exceeded headers limit - stop collecting them
   if (this.maxHeaderPairs <= 0 ||
       this._headers.length < this.maxHeaderPairs) {
@@ -63,9 +68,11 @@ function parserOnHeaders(headers, url) {
 // this request.
 // `url` is not set for response parsers but that's not applicable here since
 // all our parsers are request parsers.
+// In batch mode, `headers` is a Buffer with all header fields and values and
+// `headerOffsets` says where each of them starts.
 function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
                                  url, statusCode, statusMessage, upgrade,
-                                 shouldKeepAlive) {
+                                 shouldKeepAlive, headerOffsets) {
   const parser = this;
   const { socket } = parser;
 
@@ -91,13 +98,17 @@ function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
   incoming.url = url;
   incoming.upgrade = upgrade;
 
-  var n = headers.length;
+  var n = headerOffsets !== undefined ?
+    headerOffsets.length - 1 : headers.length;
 
   // If parser.maxHeaderPairs <= 0 assume that there's no limit.
   if (parser.maxHeaderPairs > 0)
     n = Math.min(n, parser.maxHeaderPairs);
 
-  incoming._addHeaderLines(headers, n);
+  if (headerOffsets !== undefined)
+    incoming._addHeaderBlock(headers, headerOffsets, n);
+  else
+    incoming._addHeaderLines(headers, n);
 
   if (typeof method === 'number') {
     // server only
@@ -244,6 +255,7 @@ module.exports = {
   freeParser,
   methods,
   parsers,
+  kBatchHeaders,
   kIncomingMessage,
   HTTPParser,
   prepareError,
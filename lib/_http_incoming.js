@@ -21,9 +21,18 @@
 
 'use strict';
 
-const { Object } = primordials;
+const { Object, SafeMap } = primordials;
 
 const Stream = require('stream');
+const { knownHeaderNames } = internalBinding('http_parser');
+
+const kHeaderBlock = Symbol('kHeaderBlock');
+
+// Maps each well-known header name to the string that the parser uses for it
+// when it passes headers one by one.
+const knownHeaderNameMap = new SafeMap();
+for (const name of knownHeaderNames)
+  knownHeaderNameMap.set(name, name);
 
 function readStart(socket) {
   if (socket && !socket._paused && socket.readable)
@@ -49,6 +58,7 @@ function IncomingMessage(socket) {
   this.complete = false;
   this.headers = {};
   this.rawHeaders = [];
+  this[kHeaderBlock] = null;
   this.trailers = {};
   this.rawTrailers = [];
 
@@ -115,6 +125,120 @@ IncomingMessage.prototype.destroy = function destroy(error) {
 };
 
 
+// Turns the header block passed by a parser in batch mode into the usual
+// alternating list of field names and values. The block is decoded into a
+// single string, of which each entry is a slice. Well-known field names are
+// replaced with the parser's strings for them.
+function headerBlockToArray(buffer, offsets) {
+  const count = offsets.length - 1;
+  const headers = new Array(count);
+  if (count > 0) {
+    const block = buffer.latin1Slice(0, buffer.length);
+    for (var i = 0; i < count; i++) {
+      const str = block.slice(offsets[i], offsets[i + 1]);
+      headers[i] = i % 2 === 0 ? knownHeaderNameMap.get(str) || str : str;
+    }
+  }
+  return headers;
+}
+
+function materializeHeaders(msg) {
+  const { buffer, offsets, n } = msg[kHeaderBlock];
+  msg[kHeaderBlock] = null;
+  const headers = headerBlockToArray(buffer, offsets);
+  const dest = {};
+  // Replace the accessors with the usual data properties.
+  Object.defineProperties(msg, {
+    headers: {
+      configurable: true,
+      enumerable: true,
+      writable: true,
+      value: dest
+    },
+    rawHeaders: {
+      configurable: true,
+      enumerable: true,
+      writable: true,
+      value: headers
+    }
+  });
+  // Not _addHeaderLines(), the message may be complete by now.
+  for (var i = 0; i < n; i += 2)
+    msg._addHeaderLine(headers[i], headers[i + 1], dest);
+}
+
+// Installed on messages that hold a header block, in place of the `headers`
+// and `rawHeaders` data properties.
+const headerBlockAccessors = {
+  headers: {
+    configurable: true,
+    enumerable: true,
+    get() {
+      materializeHeaders(this);
+      return this.headers;
+    },
+    set(val) {
+      materializeHeaders(this);
+      this.headers = val;
+    }
+  },
+  rawHeaders: {
+    configurable: true,
+    enumerable: true,
+    get() {
+      materializeHeaders(this);
+      return this.rawHeaders;
+    },
+    set(val) {
+      materializeHeaders(this);
+      this.rawHeaders = val;
+    }
+  }
+};
+
+// Like _addHeaderLines(), but takes the header block passed by a parser in
+// batch mode. Strings are only created once `headers` or `rawHeaders` is
+// accessed, which may be never.
+IncomingMessage.prototype._addHeaderBlock = _addHeaderBlock;
+function _addHeaderBlock(buffer, offsets, n) {
+  if (offsets.length <= 1)
+    return;
+  if (this.complete) {
+    this._addHeaderLines(headerBlockToArray(buffer, offsets), n);
+  } else {
+    this[kHeaderBlock] = { buffer, offsets, n };
+    Object.defineProperties(this, headerBlockAccessors);
+  }
+}
+
+// Whether a header block may contain the lowercase field `name`, by comparing
+// the raw bytes of the field names. Lowercasing with `| 0x20` can only cause
+// false positives for characters other than letters, which is harmless.
+function headerBlockHasField({ buffer, offsets, n }, name) {
+  const length = name.length;
+  for (var i = 0; i < n && i + 1 < offsets.length; i += 2) {
+    const start = offsets[i];
+    if (offsets[i + 1] - start !== length)
+      continue;
+    var j = 0;
+    while (j < length && (buffer[start + j] | 0x20) === name.charCodeAt(j))
+      j++;
+    if (j === length)
+      return true;
+  }
+  return false;
+}
+
+// Returns `msg.headers[name]` for a lowercase `name`. A pending header block
+// is only turned into `headers` if it contains the field, so that the server
+// can check for rare fields such as Expect without giving up the laziness.
+function getIncomingHeader(msg, name) {
+  const block = msg[kHeaderBlock];
+  if (block !== null && !headerBlockHasField(block, name))
+    return undefined;
+  return msg.headers[name];
+}
+
 IncomingMessage.prototype._addHeaderLines = _addHeaderLines;
 function _addHeaderLines(headers, n) {
   if (headers && headers.length) {
@@ -141,9 +265,8 @@ function _addHeaderLines(headers, n) {
 // 'no duplicates' field, a `0` byte is prepended as a flag. The one exception
 // to this is the Set-Cookie header which is indicated by a `1` byte flag, since
 // it is an 'array' field and thus is treated differently in _addHeaderLines().
-// TODO: perhaps http_parser could be returning both raw and lowercased versions
-// of known header names to avoid us having to call toLowerCase() for those
-// headers.
+// The parser passes common field names spelled either way as internalized
+// strings (see src/node_http_parser.cc), which makes these comparisons cheap.
 function matchKnownFields(field, lowercased) {
   switch (field.length) {
     case 3:
@@ -290,6 +413,8 @@ IncomingMessage.prototype._dump = function _dump() {
 
 module.exports = {
   IncomingMessage,
+  getIncomingHeader,
+  headerBlockToArray,
   readStart,
   readStop
 };
@@ -32,6 +32,7 @@ const {
   CRLF,
   continueExpression,
   chunkExpression,
+  kBatchHeaders,
   kIncomingMessage,
   HTTPParser,
   _checkInvalidHeaderChar: checkInvalidHeaderChar,
@@ -48,7 +49,10 @@ const {
   defaultTriggerAsyncIdScope,
   getOrSetAsyncId
 } = require('internal/async_hooks');
-const { IncomingMessage } = require('_http_incoming');
+const {
+  IncomingMessage,
+  getIncomingHeader
+} = require('_http_incoming');
 const {
   ERR_HTTP_HEADERS_SENT,
   ERR_HTTP_INVALID_STATUS_CODE,
@@ -151,7 +155,8 @@ function ServerResponse(req) {
   this._expect_continue = false;
 
   if (req.httpVersionMajor < 1 || req.httpVersionMinor < 1) {
-    this.useChunkedEncodingByDefault = chunkExpression.test(req.headers.te);
+    this.useChunkedEncodingByDefault =
+      chunkExpression.test(getIncomingHeader(req, 'te'));
     this.shouldKeepAlive = false;
   }
 
@@ -318,6 +323,7 @@ function Server(options, requestListener) {
 
   this[kIncomingMessage] = options.IncomingMessage || IncomingMessage;
   this[kServerResponse] = options.ServerResponse || ServerResponse;
+  this[kBatchHeaders] = validateBatchHeaders(options.batchHeaders);
 
   net.Server.call(this, { allowHalfOpen: true });
 
@@ -349,6 +355,15 @@ Server.prototype.setTimeout = function setTimeout(msecs, callback) {
 };
 
 
+function validateBatchHeaders(batchHeaders) {
+  if (batchHeaders !== undefined && typeof batchHeaders !== 'boolean') {
+    throw new ERR_INVALID_ARG_TYPE(
+      'options.batchHeaders', 'boolean', batchHeaders);
+  }
+  return batchHeaders === true;
+}
+
+
 function connectionListener(socket) {
   defaultTriggerAsyncIdScope(
     getOrSetAsyncId(socket), connectionListenerInternal, this, socket
@@ -377,7 +392,8 @@ function connectionListenerInternal(server, socket) {
   // https://github.com/nodejs/node/pull/21313
   parser.initialize(
     HTTPParser.REQUEST,
-    new HTTPServerAsyncResource('HTTPINCOMINGMESSAGE', socket)
+    new HTTPServerAsyncResource('HTTPINCOMINGMESSAGE', socket),
+    server[kBatchHeaders]
   );
   parser.socket = socket;
 
@@ -721,9 +737,10 @@ function parserOnIncoming(server, socket, state, req, keepAlive) {
   res.on('finish',
          resOnFinish.bind(undefined, req, res, socket, state, server));
 
-  if (req.headers.expect !== undefined &&
+  const expect = getIncomingHeader(req, 'expect');
+  if (expect !== undefined &&
       (req.httpVersionMajor === 1 && req.httpVersionMinor === 1)) {
-    if (continueExpression.test(req.headers.expect)) {
+    if (continueExpression.test(expect)) {
       res._expect_continue = true;
 
       if (server.listenerCount('checkContinue') > 0) {
@@ -820,5 +837,6 @@ module.exports = {
   Server,
   ServerResponse,
   _connectionListener: connectionListener,
-  kServerResponse
+  kServerResponse,
+  validateBatchHeaders
 };
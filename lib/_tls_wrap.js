@@ -67,6 +67,7 @@ const kHandshakeTimeout = Symbol('handshake-timeout');
 const kRes = Symbol('res');
 const kSNICallback = Symbol('snicallback');
 const kEnableTrace = Symbol('enableTrace');
+const kKernelTLS = Symbol('kernelTLS');
 
 const noop = () => {};
 
@@ -374,6 +375,11 @@ function TLSSocket(socket, opts) {
       'options.enableTrace', 'boolean', enableTrace);
   }
 
+  const kernelTLS = tlsOptions.kernelTLS;
+  if (kernelTLS != null && typeof kernelTLS !== 'boolean') {
+    throw new ERR_INVALID_ARG_TYPE('options.kernelTLS', 'boolean', kernelTLS);
+  }
+
   if (tlsOptions.ALPNProtocols)
     tls.convertALPNProtocols(tlsOptions.ALPNProtocols, tlsOptions);
 
@@ -432,6 +438,9 @@ function TLSSocket(socket, opts) {
   if (enableTrace && this._handle)
     this._handle.enableTrace();
 
+  if (kernelTLS && this._handle)
+    this._handle.enableKernelTLS();
+
   // Read on next tick so the caller has a chance to setup listeners
   process.nextTick(initRead, this, socket);
 }
@@ -868,6 +877,8 @@ function makeSocketMethodProxy(name) {
   'getProtocol',
   'getSession',
   'getTLSTicket',
+  'getWriteStatistics',
+  'getKernelTLSStatus',
   'isSessionReused',
   'enableTrace',
 ].forEach((method) => {
@@ -929,6 +940,7 @@ function tlsConnectionListener(rawSocket) {
     ALPNProtocols: this.ALPNProtocols,
     SNICallback: this[kSNICallback] || SNICallback,
     enableTrace: this[kEnableTrace],
+    kernelTLS: this[kKernelTLS],
     pauseOnConnect: this.pauseOnConnect,
   });
 
@@ -1053,6 +1065,7 @@ function Server(options, listener) {
   }
 
   this[kEnableTrace] = options.enableTrace;
+  this[kKernelTLS] = options.kernelTLS;
 }
 
 Object.setPrototypeOf(Server.prototype, net.Server.prototype);
@@ -1416,7 +1429,8 @@ exports.connect = function connect(...args) {
     session: options.session,
     ALPNProtocols: options.ALPNProtocols,
     requestOCSP: options.requestOCSP,
-    enableTrace: options.enableTrace
+    enableTrace: options.enableTrace,
+    kernelTLS: options.kernelTLS
   });
 
   tlssock[kConnectOptions] = options;
@@ -35,6 +35,7 @@ const {
 } = require('internal/net');
 const {
   ERR_INVALID_ARG_TYPE,
+  ERR_INVALID_CALLBACK,
   ERR_MISSING_ARGS,
   ERR_SOCKET_ALREADY_BOUND,
   ERR_SOCKET_BAD_BUFFER_SIZE,
@@ -48,10 +49,12 @@ const {
 } = errors.codes;
 const {
   isInt32,
+  validateInteger,
   validateString,
   validateNumber
 } = require('internal/validators');
 const { Buffer } = require('buffer');
+const { FastBuffer } = require('internal/buffer');
 const { deprecate } = require('internal/util');
 const { isUint8Array } = require('internal/util/types');
 const EventEmitter = require('events');
@@ -90,6 +93,7 @@ function Socket(type, listener) {
   let lookup;
   let recvBufferSize;
   let sendBufferSize;
+  let recvBatchSize;
 
   let options;
   if (type !== null && typeof type === 'object') {
@@ -98,6 +102,9 @@ function Socket(type, listener) {
     lookup = options.lookup;
     recvBufferSize = options.recvBufferSize;
     sendBufferSize = options.sendBufferSize;
+    recvBatchSize = options.recvBatchSize;
+    if (recvBatchSize !== undefined)
+      validateInteger(recvBatchSize, 'options.recvBatchSize', 1, 4096);
   }
 
   const handle = newHandle(type, lookup);
@@ -118,7 +125,8 @@ function Socket(type, listener) {
     reuseAddr: options && options.reuseAddr, // Use UV_UDP_REUSEADDR if true.
     ipv6Only: options && options.ipv6Only,
     recvBufferSize,
-    sendBufferSize
+    sendBufferSize,
+    recvBatchSize
   };
 }
 Object.setPrototypeOf(Socket.prototype, EventEmitter.prototype);
@@ -134,6 +142,10 @@ function startListening(socket) {
   const state = socket[kStateSymbol];
 
   state.handle.onmessage = onMessage;
+  if (state.recvBatchSize) {
+    state.handle.onmessages = onMessages;
+    state.handle.setRecvBatchSize(state.recvBatchSize);
+  }
   // Todo: handle errors
   state.handle.recvStart();
   state.receiving = true;
@@ -156,6 +168,7 @@ function replaceHandle(self, newHandle) {
   newHandle.lookup = oldHandle.lookup;
   newHandle.bind = oldHandle.bind;
   newHandle.send = oldHandle.send;
+  newHandle.sendBatch = oldHandle.sendBatch;
   newHandle[owner_symbol] = self;
 
   // Replace the existing handle by the handle we got from master.
@@ -681,6 +694,148 @@ function doSend(ex, self, ip, list, address, port, callback) {
   }
 }
 
+// sendBatch(messages[, callback])
+// Each message is an object { msg, port, address } for connectionless
+// sockets, or { msg } for connected sockets. All datagrams are handed to the
+// kernel with as few system calls as possible and share one completion.
+Socket.prototype.sendBatch = function(messages, callback) {
+  if (!Array.isArray(messages))
+    throw new ERR_INVALID_ARG_TYPE('messages', 'Array', messages);
+  if (callback !== undefined && typeof callback !== 'function')
+    throw new ERR_INVALID_CALLBACK(callback);
+
+  const state = this[kStateSymbol];
+  const connected = state.connectState === CONNECT_STATE_CONNECTED;
+  const count = messages.length;
+  const list = new Array(count);
+  const ports = connected ? undefined : new Array(count);
+  const addresses = connected ? undefined : new Array(count);
+
+  for (let i = 0; i < count; i++) {
+    const message = messages[i];
+    if (message === null || typeof message !== 'object')
+      throw new ERR_INVALID_ARG_TYPE(`messages[${i}]`, 'Object', message);
+
+    const { msg, port, address } = message;
+    if (typeof msg === 'string') {
+      list[i] = Buffer.from(msg);
+    } else if (isUint8Array(msg)) {
+      list[i] = msg;
+    } else {
+      throw new ERR_INVALID_ARG_TYPE(`messages[${i}].msg`,
+                                     ['Buffer', 'Uint8Array', 'string'],
+                                     msg);
+    }
+
+    if (connected) {
+      if (port || address)
+        throw new ERR_SOCKET_DGRAM_IS_CONNECTED();
+    } else {
+      ports[i] = validatePort(port);
+      if (address && typeof address !== 'string') {
+        throw new ERR_INVALID_ARG_TYPE(`messages[${i}].address`,
+                                       ['string', 'falsy'], address);
+      }
+      addresses[i] = address || undefined;
+    }
+  }
+
+  healthCheck(this);
+
+  if (state.bindState === BIND_STATE_UNBOUND)
+    this.bind({ port: 0, exclusive: true }, null);
+
+  if (count === 0) {
+    if (callback)
+      process.nextTick(callback, null, 0);
+    return;
+  }
+
+  // If the socket hasn't been bound yet, push the outbound packets onto the
+  // send queue and send after binding is complete.
+  if (state.bindState !== BIND_STATE_BOUND) {
+    enqueue(this, this.sendBatch.bind(this, messages, callback));
+    return;
+  }
+
+  const afterDns = (ex, ips) => {
+    defaultTriggerAsyncIdScope(
+      this[async_id_symbol],
+      doSendBatch,
+      ex, this, list, ports, ips, callback
+    );
+  };
+
+  if (connected)
+    return afterDns(null, undefined);
+
+  // Resolve each distinct destination once.
+  const resolved = new Map();
+  for (let i = 0; i < count; i++)
+    resolved.set(addresses[i], undefined);
+  let pending = resolved.size;
+  let failed = false;
+  for (const address of resolved.keys()) {
+    state.handle.lookup(address, (ex, ip) => {
+      if (failed)
+        return;
+      if (ex) {
+        failed = true;
+        return afterDns(ex);
+      }
+      resolved.set(address, ip);
+      if (--pending === 0) {
+        const ips = new Array(count);
+        for (let i = 0; i < count; i++)
+          ips[i] = resolved.get(addresses[i]);
+        afterDns(null, ips);
+      }
+    });
+  }
+};
+
+function doSendBatch(ex, self, list, ports, ips, callback) {
+  const state = self[kStateSymbol];
+
+  if (ex) {
+    if (typeof callback === 'function') {
+      process.nextTick(callback, ex);
+      return;
+    }
+
+    process.nextTick(() => self.emit('error', ex));
+    return;
+  } else if (!state.handle) {
+    return;
+  }
+
+  const req = new SendWrap();
+  req.list = list;  // Keep reference alive.
+  if (callback) {
+    req.callback = callback;
+    req.oncomplete = afterSendBatch;
+  }
+
+  const err = state.handle.sendBatch(req, list, ports, ips, !!callback);
+
+  if (err >= 1) {
+    // Synchronous finish. The return code is msg_length + 1 so that we can
+    // distinguish between synchronous success and asynchronous success.
+    if (callback)
+      process.nextTick(callback, null, err - 1);
+    return;
+  }
+
+  if (err && callback) {
+    const ex = errnoException(err, 'send');
+    process.nextTick(callback, ex);
+  }
+}
+
+function afterSendBatch(err, sent) {
+  this.callback(err ? errnoException(err, 'send') : null, sent);
+}
+
 function afterSend(err, sent) {
   if (err) {
     err = exceptionWithHostPort(err, 'send', this.address, this.port);
@@ -911,6 +1066,12 @@ function onMessage(nread, handle, buf, rinfo) {
 }
 
 
+function onMessages(count, handle, arrayBuffer, offsets, rinfos) {
+  const self = handle[owner_symbol];
+  self.emit('messages', new FastBuffer(arrayBuffer), offsets, rinfos);
+}
+
+
 Socket.prototype.ref = function() {
   const handle = this[kStateSymbol].handle;
 
@@ -64,11 +64,13 @@ const {
   getDirents,
   getOptions,
   getValidatedPath,
+  getValidatedPaths,
   handleErrorFromBinding,
   nullCheck,
   preprocessSymlinkDestination,
   Stats,
   getStatsFromBinding,
+  getStatsManyFromBinding,
   realpathCacheKey,
   stringToFlags,
   stringToSymlinkType,
@@ -105,6 +107,7 @@ let fs;
 let promises = null;
 let watchers;
 let ReadFileContext;
+let kReadFileBufferLength;
 let ReadStream;
 let WriteStream;
 let rimraf;
@@ -254,10 +257,14 @@ function readFileAfterStat(err, stats) {
   if (err)
     return context.close(err);
 
-  const size = context.size = isFileType(stats, S_IFREG) ? stats[8] : 0;
+  readFileWithSize(context, isFileType(stats, S_IFREG) ? stats[8] : 0);
+}
+
+function readFileWithSize(context, size) {
+  context.size = size;
 
   if (size > kMaxLength) {
-    err = new ERR_FS_FILE_TOO_LARGE(size);
+    const err = new ERR_FS_FILE_TOO_LARGE(size);
     return context.close(err);
   }
 
@@ -273,30 +280,52 @@ function readFileAfterStat(err, stats) {
   context.read();
 }
 
+function readFileAfterReadAll(err, result) {
+  const context = this.context;
+
+  if (err)
+    return context.callback(err);
+
+  if (!Array.isArray(result))
+    return context.callback(null, result);
+
+  // The file is too large to be read in one go, or it is not a regular file.
+  // It has been opened, read it in chunks.
+  context.fd = result[0];
+  readFileWithSize(context, result[1]);
+}
+
 function readFile(path, options, callback) {
   callback = maybeCallback(callback || options);
   options = getOptions(options, { flag: 'r' });
-  if (!ReadFileContext)
-    ReadFileContext = require('internal/fs/read_file_context');
+  if (!ReadFileContext) {
+    ({
+      ReadFileContext,
+      kReadFileBufferLength
+    } = require('internal/fs/read_file_context'));
+  }
   const context = new ReadFileContext(callback, options.encoding);
   context.isUserFd = isFd(path); // File descriptor ownership
 
   const req = new FSReqCallback();
   req.context = context;
-  req.oncomplete = readFileAfterOpen;
 
   if (context.isUserFd) {
+    req.oncomplete = readFileAfterOpen;
     process.nextTick(function tick() {
       req.oncomplete(null, path);
     });
     return;
   }
 
+  // Open, stat, read and close small files in a single threadpool job.
   path = getValidatedPath(path);
-  binding.open(pathModule.toNamespacedPath(path),
-               stringToFlags(options.flag || 'r'),
-               0o666,
-               req);
+  req.oncomplete = readFileAfterReadAll;
+  binding.readFileAll(pathModule.toNamespacedPath(path),
+                      stringToFlags(options.flag || 'r'),
+                      kReadFileBufferLength,
+                      options.encoding,
+                      req);
 }
 
 function tryStatSync(fd, isUserFd) {
@@ -932,6 +961,29 @@ function statSync(path, options = {}) {
   return getStatsFromBinding(stats);
 }
 
+function statMany(paths, options = { bigint: false }, callback) {
+  if (typeof options === 'function') {
+    callback = options;
+    options = {};
+  }
+  callback = makeCallback(callback);
+  paths = getValidatedPaths(paths);
+  const req = new FSReqCallback(options.bigint);
+  req.oncomplete = (err, result) => {
+    if (err) return callback(err);
+    callback(null, getStatsManyFromBinding(result, paths));
+  };
+  binding.statMany(paths.map(pathModule.toNamespacedPath),
+                   options.bigint, req);
+}
+
+function statManySync(paths, options = {}) {
+  paths = getValidatedPaths(paths);
+  const result = binding.statMany(paths.map(pathModule.toNamespacedPath),
+                                  options.bigint);
+  return getStatsManyFromBinding(result, paths);
+}
+
 function readlink(path, options, callback) {
   callback = makeCallback(typeof options === 'function' ? options : callback);
   options = getOptions(options, {});
@@ -1885,6 +1937,8 @@ module.exports = fs = {
   rmdir,
   rmdirSync,
   stat,
+  statMany,
+  statManySync,
   statSync,
   symlink,
   symlinkSync,
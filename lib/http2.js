@@ -3,6 +3,7 @@
 const {
   connect,
   constants,
+  createHeaderSet,
   createServer,
   createSecureServer,
   getDefaultSettings,
@@ -15,6 +16,7 @@ const {
 module.exports = {
   connect,
   constants,
+  createHeaderSet,
   createServer,
   createSecureServer,
   getDefaultSettings,
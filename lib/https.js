@@ -31,13 +31,14 @@ const { Agent: HttpAgent } = require('_http_agent');
 const {
   Server: HttpServer,
   _connectionListener,
-  kServerResponse
+  kServerResponse,
+  validateBatchHeaders
 } = require('_http_server');
 const { ClientRequest } = require('_http_client');
 const debug = require('internal/util/debuglog').debuglog('https');
 const { URL, urlToOptions, searchParamsSymbol } = require('internal/url');
 const { IncomingMessage, ServerResponse } = require('http');
-const { kIncomingMessage } = require('_http_common');
+const { kBatchHeaders, kIncomingMessage } = require('_http_common');
 
 function Server(opts, requestListener) {
   if (!(this instanceof Server)) return new Server(opts, requestListener);
@@ -57,6 +58,7 @@ function Server(opts, requestListener) {
 
   this[kIncomingMessage] = opts.IncomingMessage || IncomingMessage;
   this[kServerResponse] = opts.ServerResponse || ServerResponse;
+  this[kBatchHeaders] = validateBatchHeaders(opts.batchHeaders);
 
   tls.Server.call(this, opts, _connectionListener);
 
@@ -103,6 +103,9 @@ if (isMainThread) {
   process.reallyExit = rawMethods.reallyExit;
   process._kill = rawMethods._kill;
 
+  rawMethods.setExitHooksFunction(
+    require('internal/process/exit_hooks').runExitHooks);
+
   const wrapped = perThreadSetup.wrapProcessMethods(rawMethods);
   process._rawDebug = wrapped._rawDebug;
   process.hrtime = wrapped.hrtime;
@@ -43,6 +43,7 @@ function newHandle(type, lookup) {
     handle.bind = handle.bind6;
     handle.connect = handle.connect6;
     handle.send = handle.send6;
+    handle.sendBatch = handle.sendBatch6;
     return handle;
   }
 
@@ -414,6 +414,9 @@ function makeTextDecoderICU() {
       if (typeof ret === 'number') {
         throw new ERR_ENCODING_INVALID_ENCODED_DATA(this.encoding, ret);
       }
+      // Valid UTF-8 is decoded to a string directly.
+      if (typeof ret === 'string')
+        return ret;
       return ret.toString('ucs2');
     }
   }
@@ -1230,6 +1230,11 @@ E('ERR_WORKER_PATH',
   'The worker script filename must be an absolute path or a relative ' +
   'path starting with \'./\' or \'../\'. Received "%s"',
   TypeError);
+E('ERR_WORKER_RING_CHANNEL_CORRUPTED',
+  'The RingChannel buffer was modified by something other than a RingChannel',
+  Error);
+E('ERR_WORKER_RING_CHANNEL_RECEIVING',
+  'Another RingChannel is already receiving messages from this buffer', Error);
 E('ERR_WORKER_UNSERIALIZABLE_ERROR',
   'Serializing an uncaught exception failed', Error);
 E('ERR_WORKER_UNSUPPORTED_EXTENSION',
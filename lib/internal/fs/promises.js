@@ -24,7 +24,9 @@ const {
   getDirents,
   getOptions,
   getStatsFromBinding,
+  getStatsManyFromBinding,
   getValidatedPath,
+  getValidatedPaths,
   nullCheck,
   preprocessSymlinkDestination,
   stringToFlags,
@@ -390,6 +392,13 @@ async function stat(path, options = { bigint: false }) {
   return getStatsFromBinding(result);
 }
 
+async function statMany(paths, options = { bigint: false }) {
+  paths = getValidatedPaths(paths);
+  const result = await binding.statMany(
+    paths.map(pathModule.toNamespacedPath), options.bigint, kUsePromises);
+  return getStatsManyFromBinding(result, paths);
+}
+
 async function link(existingPath, newPath) {
   existingPath = getValidatedPath(existingPath, 'existingPath');
   newPath = getValidatedPath(newPath, 'newPath');
@@ -521,6 +530,7 @@ module.exports = {
     symlink,
     lstat,
     stat,
+    statMany,
     link,
     unlink,
     chmod,
@@ -114,4 +114,7 @@ class ReadFileContext {
   }
 }
 
-module.exports = ReadFileContext;
+module.exports = {
+  ReadFileContext,
+  kReadFileBufferLength
+};
@@ -28,6 +28,7 @@ const {
   validateUint32
 } = require('internal/validators');
 const pathModule = require('path');
+const { kFsStatsFieldsNumber } = internalBinding('fs');
 const kType = Symbol('type');
 const kStats = Symbol('stats');
 
@@ -419,6 +420,25 @@ function getStatsFromBinding(stats, offset = 0) {
   );
 }
 
+// Turns the [errors, stats] result of binding.statMany() into an array with
+// an fs.Stats object or an error for each path.
+function getStatsManyFromBinding(result, paths) {
+  const { 0: errors, 1: stats } = result;
+  const results = new Array(paths.length);
+  for (let i = 0; i < paths.length; i++) {
+    if (errors[i] === 0) {
+      results[i] = getStatsFromBinding(stats, i * kFsStatsFieldsNumber);
+    } else {
+      results[i] = uvException({
+        errno: errors[i],
+        syscall: 'stat',
+        path: paths[i]
+      });
+    }
+  }
+  return results;
+}
+
 function stringToFlags(flags) {
   if (typeof flags === 'number') {
     return flags;
@@ -537,6 +557,16 @@ const getValidatedPath = hideStackFrames((fileURLOrPath, propName = 'path') => {
   return path;
 });
 
+const getValidatedPaths = hideStackFrames((paths, propName = 'paths') => {
+  if (!Array.isArray(paths))
+    throw new ERR_INVALID_ARG_TYPE(propName, 'Array', paths);
+
+  const validated = new Array(paths.length);
+  for (let i = 0; i < paths.length; i++)
+    validated[i] = getValidatedPath(paths[i], `${propName}[${i}]`);
+  return validated;
+});
+
 const validateBufferArray = hideStackFrames((buffers, propName = 'buffers') => {
   if (!Array.isArray(buffers))
     throw new ERR_INVALID_ARG_TYPE(propName, 'ArrayBufferView[]', buffers);
@@ -594,11 +624,13 @@ module.exports = {
   getDirents,
   getOptions,
   getValidatedPath,
+  getValidatedPaths,
   handleErrorFromBinding,
   nullCheck,
   preprocessSymlinkDestination,
   realpathCacheKey: Symbol('realpathCacheKey'),
   getStatsFromBinding,
+  getStatsManyFromBinding,
   stringToFlags,
   stringToSymlinkType,
   Stats,
@@ -81,7 +81,11 @@ const {
   },
   hideStackFrames
 } = require('internal/errors');
-const { validateNumber, validateString } = require('internal/validators');
+const {
+  validateNumber,
+  validateString,
+  validateUint32
+} = require('internal/validators');
 const fsPromisesInternal = require('internal/fs/promises');
 const { utcDate } = require('internal/http');
 const { onServerStream,
@@ -98,7 +102,9 @@ const {
   getSessionState,
   getSettings,
   getStreamState,
+  Http2HeaderSet,
   isPayloadMeaningless,
+  kHeaderSetHandle,
   kSocket,
   kRequest,
   kProxySocket,
@@ -189,6 +195,7 @@ const kProtocol = Symbol('protocol');
 const kRemoteSettings = Symbol('remote-settings');
 const kSelectPadding = Symbol('select-padding');
 const kSentHeaders = Symbol('sent-headers');
+const kSentHeaderSet = Symbol('sent-header-set');
 const kSentTrailers = Symbol('sent-trailers');
 const kServer = Symbol('server');
 const kState = Symbol('state');
@@ -650,11 +657,15 @@ function requestOnConnect(headers, options) {
 
   // `ret` will be either the reserved stream ID (if positive)
   // or an error code (if negative)
+  const headerSet = options.headerSet;
   const ret = session[kHandle].request(headers,
                                        streamOptions,
                                        options.parent | 0,
                                        options.weight | 0,
-                                       !!options.exclusive);
+                                       !!options.exclusive,
+                                       headerSet !== undefined ?
+                                         headerSet[kHeaderSetHandle] :
+                                         undefined);
 
   // In an error condition, one of three possible response codes will be
   // possible:
@@ -1580,10 +1591,13 @@ class ClientHttp2Session extends Http2Session {
       throw new ERR_INVALID_OPT_VALUE('endStream', options.endStream);
     }
 
-    const headersList = mapToHeaders(headers);
+    const headerSet = validateHeaderSet(options);
+    const headersList = mapToHeaders(headers, undefined,
+                                     headerSet && headerSet.headers);
 
     const stream = new ClientHttp2Stream(this, undefined, undefined, {});
     stream[kSentHeaders] = headers;
+    stream[kSentHeaderSet] = headerSet;
     stream[kOrigin] = `${headers[HTTP2_HEADER_SCHEME]}://` +
                       `${headers[HTTP2_HEADER_AUTHORITY]}`;
 
@@ -1612,6 +1626,13 @@ class ClientHttp2Session extends Http2Session {
   }
 }
 
+function validateHeaderSet(options) {
+  const headerSet = options.headerSet;
+  if (headerSet !== undefined && !(headerSet instanceof Http2HeaderSet))
+    throw new ERR_INVALID_OPT_VALUE('headerSet', headerSet);
+  return headerSet;
+}
+
 function trackWriteState(stream, bytes) {
   const session = stream[kSession];
   stream[kState].writeQueueSize += bytes;
@@ -1798,6 +1819,12 @@ class Http2Stream extends Duplex {
   }
 
   get sentHeaders() {
+    // The headers of an Http2HeaderSet are only copied when asked for.
+    const headerSet = this[kSentHeaderSet];
+    if (headerSet !== undefined) {
+      this[kSentHeaderSet] = undefined;
+      Object.assign(this[kSentHeaders], headerSet.headers);
+    }
     return this[kSentHeaders];
   }
 
@@ -2170,8 +2197,10 @@ function onPipedFileHandleRead() {
   }
 }
 
+// If `exact` is true, `length` is known to be available in the file, and the
+// stream is reset if the file turns out to be shorter than that.
 function processRespondWithFD(self, fd, headers, offset = 0, length = -1,
-                              streamOptions = 0) {
+                              streamOptions = 0, exact = false) {
   const state = self[kState];
   state.flags |= STREAM_FLAGS_HEADERS_SENT;
 
@@ -2197,11 +2226,11 @@ function processRespondWithFD(self, fd, headers, offset = 0, length = -1,
   }
 
   defaultTriggerAsyncIdScope(self[async_id_symbol], startFilePipe,
-                             self, fd, offset, length);
+                             self, fd, offset, length, exact);
 }
 
-function startFilePipe(self, fd, offset, length) {
-  const handle = new FileHandle(fd, offset, length);
+function startFilePipe(self, fd, offset, length, exact) {
+  const handle = new FileHandle(fd, offset, length, exact);
   handle.onread = onPipedFileHandleRead;
   handle.stream = self;
 
@@ -2246,10 +2275,20 @@ function doSendFD(session, options, fd, headers, streamOptions, err, stat) {
     return;
   }
 
+  // Ranges that go past the end of a regular file are cut short, so that the
+  // rest of the range can be expected to be read.
+  const exact = stat.isFile() && statOptions.length >= 0;
+  if (exact) {
+    statOptions.length =
+      Math.max(0, Math.min(stat.size - (+statOptions.offset),
+                           statOptions.length));
+  }
+
   processRespondWithFD(this, fd, headers,
                        statOptions.offset | 0,
                        statOptions.length | 0,
-                       streamOptions);
+                       streamOptions,
+                       exact);
 }
 
 function doSendFileFD(session, options, fd, headers, streamOptions, err, stat) {
@@ -2318,7 +2357,8 @@ function doSendFileFD(session, options, fd, headers, streamOptions, err, stat) {
   processRespondWithFD(this, fd, headers,
                        options.offset | 0,
                        statOptions.length | 0,
-                       streamOptions);
+                       streamOptions,
+                       stat.isFile());
 }
 
 function afterOpen(session, options, headers, streamOptions, err, fd) {
@@ -2464,9 +2504,12 @@ class ServerHttp2Stream extends Http2Stream {
       state.flags |= STREAM_FLAGS_HAS_TRAILERS;
     }
 
+    const headerSet = validateHeaderSet(options);
     headers = processHeaders(headers);
-    const headersList = mapToHeaders(headers, assertValidPseudoHeaderResponse);
+    const headersList = mapToHeaders(headers, assertValidPseudoHeaderResponse,
+                                     headerSet && headerSet.headers);
     this[kSentHeaders] = headers;
+    this[kSentHeaderSet] = headerSet;
 
     state.flags |= STREAM_FLAGS_HEADERS_SENT;
 
@@ -2482,7 +2525,10 @@ class ServerHttp2Stream extends Http2Stream {
       this.end();
     }
 
-    const ret = this[kHandle].respond(headersList, streamOptions);
+    const ret = this[kHandle].respond(
+      headersList,
+      streamOptions,
+      headerSet !== undefined ? headerSet[kHeaderSetHandle] : undefined);
     if (ret < 0)
       this.destroy(new NghttpError(ret));
   }
@@ -2762,9 +2808,19 @@ function connectionListener(socket) {
   this.emit('session', session);
 }
 
+// The options buffer holds these as uint32 values, which larger or negative
+// numbers would silently wrap around in.
+function validateWriteCoalesceOptions(options) {
+  if (options.writeCoalesceSize !== undefined)
+    validateUint32(options.writeCoalesceSize, 'options.writeCoalesceSize');
+  if (options.writeCoalesceDelay !== undefined)
+    validateUint32(options.writeCoalesceDelay, 'options.writeCoalesceDelay');
+}
+
 function initializeOptions(options) {
   assertIsObject(options, 'options');
   options = { ...options };
+  validateWriteCoalesceOptions(options);
   assertIsObject(options.settings, 'options.settings');
   options.settings = { ...options.settings };
 
@@ -2865,6 +2921,10 @@ function socketOnClose() {
   }
 }
 
+function createHeaderSet(headers) {
+  return new Http2HeaderSet(headers);
+}
+
 function connect(authority, options, listener) {
   if (typeof options === 'function') {
     listener = options;
@@ -2873,6 +2933,7 @@ function connect(authority, options, listener) {
 
   assertIsObject(options, 'options');
   options = { ...options };
+  validateWriteCoalesceOptions(options);
 
   if (typeof authority === 'string')
     authority = new URL(authority);
@@ -3015,6 +3076,7 @@ binding.setCallbackFunctions(
 module.exports = {
   connect,
   constants,
+  createHeaderSet,
   createServer,
   createSecureServer,
   getDefaultSettings,
@@ -18,6 +18,8 @@ const {
 const kSocket = Symbol('socket');
 const kProxySocket = Symbol('proxySocket');
 const kRequest = Symbol('request');
+const kHeaderSetHandle = Symbol('headerSetHandle');
+const kHeaderSetHeaders = Symbol('headerSetHeaders');
 
 const {
   NGHTTP2_SESSION_CLIENT,
@@ -194,7 +196,9 @@ const IDX_OPTIONS_MAX_HEADER_LIST_PAIRS = 5;
 const IDX_OPTIONS_MAX_OUTSTANDING_PINGS = 6;
 const IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS = 7;
 const IDX_OPTIONS_MAX_SESSION_MEMORY = 8;
-const IDX_OPTIONS_FLAGS = 9;
+const IDX_OPTIONS_WRITE_COALESCE_SIZE = 9;
+const IDX_OPTIONS_WRITE_COALESCE_DELAY = 10;
+const IDX_OPTIONS_FLAGS = 11;
 
 function updateOptionsBuffer(options) {
   var flags = 0;
@@ -243,6 +247,16 @@ function updateOptionsBuffer(options) {
     optionsBuffer[IDX_OPTIONS_MAX_SESSION_MEMORY] =
       Math.max(1, options.maxSessionMemory);
   }
+  if (typeof options.writeCoalesceSize === 'number') {
+    flags |= (1 << IDX_OPTIONS_WRITE_COALESCE_SIZE);
+    optionsBuffer[IDX_OPTIONS_WRITE_COALESCE_SIZE] =
+      options.writeCoalesceSize;
+  }
+  if (typeof options.writeCoalesceDelay === 'number') {
+    flags |= (1 << IDX_OPTIONS_WRITE_COALESCE_DELAY);
+    optionsBuffer[IDX_OPTIONS_WRITE_COALESCE_DELAY] =
+      options.writeCoalesceDelay;
+  }
   optionsBuffer[IDX_OPTIONS_FLAGS] = flags;
 }
 
@@ -426,8 +440,11 @@ const assertValidPseudoHeaderTrailer = hideStackFrames((key) => {
   throw new ERR_HTTP2_INVALID_PSEUDOHEADER(key);
 });
 
+// If given, extraHeaders are the headers of an Http2HeaderSet that is sent
+// along with map. Single value headers may not appear in both.
 function mapToHeaders(map,
-                      assertValuePseudoHeader = assertValidPseudoHeader) {
+                      assertValuePseudoHeader = assertValidPseudoHeader,
+                      extraHeaders) {
   let ret = '';
   let count = 0;
   const keys = Object.keys(map);
@@ -462,7 +479,8 @@ function mapToHeaders(map,
       value = String(value);
     }
     if (isSingleValueHeader) {
-      if (singles.has(key))
+      if (singles.has(key) ||
+          (extraHeaders !== undefined && extraHeaders[key] !== undefined))
         throw new ERR_HTTP2_HEADER_SINGLE_VALUE(key);
       singles.add(key);
     }
@@ -492,6 +510,39 @@ function mapToHeaders(map,
   return [ret, count];
 }
 
+// A set of regular headers that is validated and converted for the native
+// layer once, and can then be sent along with any number of requests and
+// responses. Returned by http2.createHeaderSet().
+class Http2HeaderSet {
+  constructor(headers) {
+    assertIsObject(headers, 'headers');
+    const copy = Object.create(null);
+    const keys = Object.keys(headers);
+    for (let i = 0; i < keys.length; i++) {
+      const key = keys[i];
+      const value = headers[key];
+      if (value === undefined || key === '')
+        continue;
+      if (Array.isArray(value)) {
+        if (value.length > 0)
+          copy[key.toLowerCase()] = Object.freeze(value.map(String));
+      } else {
+        copy[key.toLowerCase()] = String(value);
+      }
+    }
+    // Pseudo-headers have to precede all other headers, so the set cannot
+    // contain any.
+    const headersList = mapToHeaders(copy, assertValidPseudoHeaderTrailer);
+    this[kHeaderSetHandle] = new binding.Http2HeaderSet(headersList);
+    this[kHeaderSetHeaders] = Object.freeze(copy);
+    Object.freeze(this);
+  }
+
+  get headers() {
+    return this[kHeaderSetHeaders];
+  }
+}
+
 class NghttpError extends Error {
   constructor(ret) {
     super(binding.nghttp2ErrorString(ret));
@@ -592,7 +643,9 @@ module.exports = {
   getSessionState,
   getSettings,
   getStreamState,
+  Http2HeaderSet,
   isPayloadMeaningless,
+  kHeaderSetHandle,
   kSocket,
   kProxySocket,
   kRequest,
@@ -44,6 +44,7 @@ const internalFS = require('internal/fs/utils');
 const path = require('path');
 const {
   internalModuleReadJSON,
+  internalModuleReadPackageJSON,
   internalModuleStat
 } = internalBinding('fs');
 const { safeGetenv } = internalBinding('credentials');
@@ -53,6 +54,9 @@ const {
   stripBOM,
   loadNativeModule
 } = require('internal/modules/cjs/helpers');
+const {
+  getResolutionCache
+} = require('internal/modules/resolution_cache');
 const { getOptionValue } = require('internal/options');
 const enableSourceMaps = getOptionValue('--enable-source-maps');
 const preserveSymlinks = getOptionValue('--preserve-symlinks');
@@ -117,6 +121,8 @@ function enrichCJSError(err) {
 }
 
 function stat(filename) {
+  if (moduleStatCache !== null)
+    return moduleStatCache.stat(filename);
   filename = path.toNamespacedPath(filename);
   if (statCache !== null) {
     const result = statCache.get(filename);
@@ -228,7 +234,11 @@ function readPackage(requestPath) {
   const existing = packageJsonCache.get(jsonPath);
   if (existing !== undefined) return existing;
 
-  const json = internalModuleReadJSON(path.toNamespacedPath(jsonPath));
+  // Policy integrity checks need the contents of the file. Otherwise the
+  // fields are read by a per-process cache that is shared with Workers.
+  const json = manifest ?
+    internalModuleReadJSON(path.toNamespacedPath(jsonPath)) :
+    internalModuleReadPackageJSON(path.toNamespacedPath(jsonPath));
   if (json === undefined) {
     packageJsonCache.set(jsonPath, false);
     return false;
@@ -240,13 +250,25 @@ function readPackage(requestPath) {
   }
 
   try {
-    const parsed = JSON.parse(json);
-    const filtered = {
-      name: parsed.name,
-      main: parsed.main,
-      exports: parsed.exports,
-      type: parsed.type
-    };
+    let filtered;
+    if (typeof json === 'string') {
+      const parsed = JSON.parse(json);
+      filtered = {
+        name: parsed.name,
+        main: parsed.main,
+        exports: parsed.exports,
+        imports: parsed.imports,
+        type: parsed.type
+      };
+    } else {
+      filtered = {
+        name: parsePackageField(json[0]),
+        main: parsePackageField(json[1]),
+        exports: parsePackageField(json[2]),
+        imports: parsePackageField(json[3]),
+        type: parsePackageField(json[4])
+      };
+    }
     packageJsonCache.set(jsonPath, filtered);
     return filtered;
   } catch (e) {
@@ -256,6 +278,16 @@ function readPackage(requestPath) {
   }
 }
 
+// Turns the JSON source text of a field from internalModuleReadPackageJSON()
+// into its value. Most fields are strings without escape sequences.
+function parsePackageField(json) {
+  if (json === undefined)
+    return undefined;
+  if (json[0] === '"' && !StringPrototype.includes(json, '\\'))
+    return StringPrototype.slice(json, 1, -1);
+  return JSON.parse(json);
+}
+
 function readPackageScope(checkPath) {
   const rootSeparatorIndex = checkPath.indexOf(path.sep);
   let separatorIndex;
@@ -326,6 +358,13 @@ function tryPackage(requestPath, exts, isMain, originalPath) {
 // Set to an empty Map to reset.
 const realpathCache = new Map();
 
+// With --experimental-module-stat-cache, the results of stat() and
+// toRealPath() are kept for the lifetime of the process.
+const moduleStatCache = getOptionValue('--experimental-module-stat-cache') ?
+  new (require('internal/modules/cjs/stat_cache').ModuleStatCache)(
+    realpathCache) :
+  null;
+
 // Check if the file exists and is not a directory
 // if using --preserve-symlinks and isMain is false,
 // keep symlinks intact, otherwise resolve to the
@@ -339,13 +378,18 @@ function tryFile(requestPath, isMain) {
 }
 
 function toRealPath(requestPath) {
-  return fs.realpathSync(requestPath, {
+  const realPath = fs.realpathSync(requestPath, {
     [internalFS.realpathCacheKey]: realpathCache
   });
+  if (moduleStatCache !== null)
+    moduleStatCache.addRealPath(requestPath, realPath);
+  return realPath;
 }
 
 // Given a path, check if the file exists with any of the set extensions
 function tryExtensions(p, exts, isMain) {
+  if (moduleStatCache !== null)
+    moduleStatCache.prefetch(exts.map((ext) => p + ext));
   for (var i = 0; i < exts.length; i++) {
     const filename = tryFile(p + exts[i], isMain);
 
@@ -562,6 +606,20 @@ Module._findPath = function(request, paths, isMain) {
   if (entry)
     return entry;
 
+  // With --experimental-resolution-cache, results from earlier runs are used
+  // for as long as the directories that were searched do not change.
+  const resolutionCache = getResolutionCache();
+  let resolutionKey;
+  if (resolutionCache !== null) {
+    resolutionKey = `cjs\x00${isMain ? 1 : 0}\x00` +
+      Object.keys(Module._extensions).join() + '\x00' + cacheKey;
+    const filename = resolutionCache.get(resolutionKey);
+    if (typeof filename === 'string') {
+      Module._pathCache[cacheKey] = filename;
+      return filename;
+    }
+  }
+
   var exts;
   var trailingSlash = request.length > 0 &&
     request.charCodeAt(request.length - 1) === CHAR_FORWARD_SLASH;
@@ -569,6 +627,11 @@ Module._findPath = function(request, paths, isMain) {
     trailingSlash = /(?:^|\/)\.?\.$/.test(request);
   }
 
+  // Look up all of the node_modules directories at once. Most of them do not
+  // exist, and the results are reused by later lookups from the same place.
+  if (moduleStatCache !== null && !absoluteRequest)
+    moduleStatCache.prefetch(paths);
+
   // For each path
   for (var i = 0; i < paths.length; i++) {
     // Don't search further if path doesn't exist
@@ -618,6 +681,17 @@ Module._findPath = function(request, paths, isMain) {
 
     if (filename) {
       Module._pathCache[cacheKey] = filename;
+      if (resolutionCache !== null) {
+        // The result depends on the directories that the request could have
+        // been found in, up to this one, and on the contents of a package
+        // directory.
+        const dirs = [];
+        for (let j = 0; j <= i; j++)
+          dirs.push(path.dirname(path.resolve(paths[j], request)));
+        if (rc === 1)
+          dirs.push(basePath);
+        resolutionCache.set(resolutionKey, filename, dirs, [filename]);
+      }
       return filename;
     }
   }
@@ -625,6 +699,8 @@ Module._findPath = function(request, paths, isMain) {
   const selfFilename = trySelf(paths, exts, isMain, trailingSlash, request);
   if (selfFilename) {
     Module._pathCache[cacheKey] = selfFilename;
+    if (resolutionCache !== null)
+      resolutionCache.set(resolutionKey, selfFilename, paths, [selfFilename]);
     return selfFilename;
   }
 
@@ -995,7 +1071,8 @@ function wrapSafe(filename, content, cjsModuleInstance) {
         'module',
         '__filename',
         '__dirname',
-      ]
+      ],
+      true  // Use the compile cache, if enabled.
     );
   } catch (err) {
     if (experimentalModules && process.mainModule === cjsModuleInstance)
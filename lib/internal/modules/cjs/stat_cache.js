@@ -0,0 +1,217 @@
+'use strict';
+
+const {
+  SafeMap,
+  StringPrototype,
+} = primordials;
+
+const fs = require('fs');
+const path = require('path');
+const {
+  internalModuleStat,
+  internalModuleStatMany
+} = internalBinding('fs');
+
+// The state of a directory that cached paths depend on, for directories that
+// are not being watched.
+const kMissing = 0;  // Did not exist. Creating it changes its parent.
+const kUnwatchable = 1;  // fs.watch() failed, e.g. because of ENOSPC.
+
+function isInside(filename, dir) {
+  return filename === dir ||
+    (StringPrototype.startsWith(filename, dir) &&
+     (filename[dir.length] === path.sep ||
+      dir[dir.length - 1] === path.sep));
+}
+
+// Keeps the internalModuleStat() results and real paths that the CommonJS
+// loader looks up for the lifetime of the process, instead of only for the
+// duration of a top-level require() call. Used with
+// --experimental-module-stat-cache.
+//
+// Each directory that a cached path goes through is watched with fs.watch(),
+// and cached entries below a directory entry are dropped when that entry is
+// renamed, or when a watched directory itself changes. Watchers do not keep
+// the event loop alive. Results for paths below a directory that cannot be
+// watched are not cached.
+class ModuleStatCache {
+  constructor(realpathCache) {
+    // Absolute path => 0 for a file, 1 for a directory, or a negative errno.
+    this.stats = new SafeMap();
+    // The cache passed to fs.realpathSync() by the loader. Its keys are
+    // absolute paths and its values are real paths.
+    this.realpathCache = realpathCache;
+    // Directory => FSWatcher, kMissing or kUnwatchable.
+    this.dirs = new SafeMap();
+  }
+
+  stat(filename) {
+    const cached = this.stats.get(filename);
+    if (cached !== undefined)
+      return cached;
+    // The watchers have to be in place before the lookup, otherwise a change
+    // right after it would not be reported.
+    const watched = this.watchParents(filename);
+    const result = internalModuleStat(path.toNamespacedPath(filename));
+    if (watched)
+      this.stats.set(filename, result);
+    return result;
+  }
+
+  // Looks up the paths that are not cached yet with a single call into the
+  // binding, so that the following stat() calls for them are cache hits.
+  prefetch(filenames) {
+    const missing = [];
+    for (let i = 0; i < filenames.length; i++) {
+      if (!this.stats.has(filenames[i]))
+        missing.push(filenames[i]);
+    }
+    if (missing.length < 2)
+      return;
+
+    const watched = [];
+    const namespaced = [];
+    for (let i = 0; i < missing.length; i++) {
+      if (this.watchParents(missing[i])) {
+        watched.push(missing[i]);
+        namespaced.push(path.toNamespacedPath(missing[i]));
+      }
+    }
+    if (watched.length === 0)
+      return;
+
+    const results = internalModuleStatMany(namespaced);
+    for (let i = 0; i < watched.length; i++)
+      this.stats.set(watched[i], results[i]);
+  }
+
+  // Called after fs.realpathSync() has added `realPath` to realpathCache.
+  // The directories on the way to `requestPath` are already watched, since it
+  // has been passed to stat(). Those on the real path are only known now. If
+  // some of them were not watched during the lookup, a change to them could
+  // have been missed, so the result is only kept from the next lookup on.
+  addRealPath(requestPath, realPath) {
+    const wasWatched = this.isWatched(realPath);
+    if (this.watchParents(requestPath) && this.watchParents(realPath) &&
+        wasWatched) {
+      return;
+    }
+    // fs.realpathSync() also caches the paths on the way to `requestPath`.
+    for (const filename of this.realpathCache.keys()) {
+      if (isInside(requestPath, filename))
+        this.realpathCache.delete(filename);
+    }
+  }
+
+  // Whether changes to the directory entries on the way to `filename` are
+  // already being reported. watchParents() adds the directories from the
+  // root down, so only the parent directory has to be looked at.
+  isWatched(filename) {
+    const state = this.dirs.get(path.dirname(filename));
+    return state !== undefined && state !== kUnwatchable;
+  }
+
+  // Makes sure that a change to any directory entry on the way to `filename`
+  // is noticed. Returns false if that is not possible.
+  watchParents(filename) {
+    if (!path.isAbsolute(filename))
+      return false;
+    const added = [];
+    let dir = path.dirname(filename);
+    let state;
+    for (;;) {
+      state = this.dirs.get(dir);
+      if (state !== undefined)
+        break;
+      added.push(dir);
+      const parent = path.dirname(dir);
+      if (parent === dir)
+        break;
+      dir = parent;
+    }
+
+    // Watch from the root down. Once a directory is missing, so are the
+    // directories below it.
+    for (let i = added.length - 1; i >= 0; i--) {
+      if (state === kMissing || state === kUnwatchable) {
+        this.dirs.set(added[i], state);
+        continue;
+      }
+      state = this.watch(added[i]);
+      this.dirs.set(added[i], state);
+    }
+    return state !== kUnwatchable;
+  }
+
+  watch(dir) {
+    let watcher;
+    try {
+      watcher = fs.watch(dir, { persistent: false }, (eventType, filename) => {
+        const changed = filename ? path.join(dir, filename) : dir;
+        // Writing to a file changes neither whether nor where it exists, and
+        // happens far more often than anything else, so 'change' events are
+        // only looked at for the directories that cached paths go through.
+        if (eventType === 'change' && changed !== dir &&
+            !this.dirs.has(changed)) {
+          return;
+        }
+        this.invalidate(changed, eventType === 'rename');
+      });
+    } catch (err) {
+      if (err.code === 'ENOENT' || err.code === 'ENOTDIR')
+        return kMissing;
+      return kUnwatchable;
+    }
+    watcher.on('error', () => this.invalidate(dir, true));
+    return watcher;
+  }
+
+  // Drops everything that was looked up below `changed`, including paths
+  // that reach it through a symbolic link.
+  invalidate(changed, renamed) {
+    const prefixes = [changed];
+    for (const { 0: link, 1: target } of this.realpathCache) {
+      if (link === target)
+        continue;
+      if (isInside(target, changed)) {
+        prefixes.push(link);
+      } else if (isInside(changed, target)) {
+        prefixes.push(link + StringPrototype.slice(changed, target.length));
+      }
+    }
+
+    const isAffected = (filename) => {
+      for (let i = 0; i < prefixes.length; i++) {
+        if (isInside(filename, prefixes[i]))
+          return true;
+      }
+      return false;
+    };
+
+    for (const filename of this.stats.keys()) {
+      if (isAffected(filename))
+        this.stats.delete(filename);
+    }
+    for (const { 0: filename, 1: realPath } of this.realpathCache) {
+      if (isAffected(filename) || isInside(realPath, changed))
+        this.realpathCache.delete(filename);
+    }
+    // A watcher keeps watching a directory that has been moved away, so it
+    // is only kept if the change was not a rename. Directories that were
+    // missing or could not be watched are looked at again next time.
+    for (const { 0: dir, 1: state } of this.dirs) {
+      if (!isAffected(dir))
+        continue;
+      if (state !== kMissing && state !== kUnwatchable) {
+        if (!renamed)
+          continue;
+        state.close();
+      }
+      this.dirs.delete(dir);
+    }
+  }
+}
+
+module.exports = {
+  ModuleStatCache
+};
@@ -2,9 +2,18 @@
 
 const internalFS = require('internal/fs/utils');
 const { NativeModule } = require('internal/bootstrap/loaders');
-const { extname } = require('path');
+const {
+  basename,
+  dirname,
+  extname,
+  join,
+  resolve: resolvePath
+} = require('path');
 const { realpathSync } = require('fs');
 const { getOptionValue } = require('internal/options');
+const {
+  getResolutionCache
+} = require('internal/modules/resolution_cache');
 
 const preserveSymlinks = getOptionValue('--preserve-symlinks');
 const preserveSymlinksMain = getOptionValue('--preserve-symlinks-main');
@@ -81,7 +90,19 @@ function resolve(specifier, parentURL) {
   if (isMain)
     parentURL = pathToFileURL(`${process.cwd()}/`).href;
 
+  // With --experimental-resolution-cache, results from earlier runs are used
+  // for as long as the directories involved do not change.
+  const resolutionCache = isMain && typeFlag ? null : getResolutionCache();
+  let resolutionKey;
+  if (resolutionCache !== null && parentURL.startsWith('file:')) {
+    resolutionKey = `esm\x00${isMain ? 1 : 0}\x00${specifier}\x00${parentURL}`;
+    const cached = resolutionCache.get(resolutionKey);
+    if (Array.isArray(cached))
+      return { url: cached[0], format: cached[1] };
+  }
+
   let url = moduleWrapResolve(specifier, parentURL);
+  const requestURL = url;
 
   if (isMain ? !preserveSymlinksMain : !preserveSymlinks) {
     const real = realpathSync(fileURLToPath(url), {
@@ -117,6 +138,27 @@ function resolve(specifier, parentURL) {
     else
       throw new ERR_UNKNOWN_FILE_EXTENSION(fileURLToPath(url));
   }
+
+  if (resolutionKey !== undefined) {
+    // The result depends on the directory that the specifier points into,
+    // which changes when a symbolic link in it is replaced. Packages are also
+    // looked up in the node_modules directories above the parent.
+    const requestPath = fileURLToPath(requestURL);
+    const dirs = [dirname(requestPath)];
+    if (specifier[0] !== '.' && specifier[0] !== '/') {
+      let dir = resolvePath(fileURLToPath(new URL('./', parentURL)));
+      for (;;) {
+        if (basename(dir) !== 'node_modules')
+          dirs.push(join(dir, 'node_modules'));
+        const parent = dirname(dir);
+        if (parent === dir)
+          break;
+        dir = parent;
+      }
+    }
+    resolutionCache.set(resolutionKey, [`${url}`, format], dirs,
+                        [requestPath, fileURLToPath(url)]);
+  }
   return { url: `${url}`, format };
 }
 
@@ -81,7 +81,10 @@ translators.set('module', async function moduleStrategy(url) {
   const source = `${await getSource(url)}`;
   maybeCacheSourceMap(url, source);
   debug(`Translating StandardModule ${url}`);
-  const module = new ModuleWrap(url, undefined, source, 0, 0);
+  // Only modules loaded from files are worth caching across runs.
+  const useCompileCache = StringPrototype.startsWith(url, 'file:');
+  const module = new ModuleWrap(url, undefined, source, 0, 0,
+                                useCompileCache);
   moduleWrap.callbackMap.set(module, {
     initializeImportMeta,
     importModuleDynamically,
@@ -0,0 +1,325 @@
+'use strict';
+
+const {
+  Date,
+  JSON,
+  Object,
+  SafeMap,
+  SafeSet,
+} = primordials;
+
+const fs = require('fs');
+const path = require('path');
+const { getOptionValue } = require('internal/options');
+const { addExitHook } = require('internal/process/exit_hooks');
+const { isMainThread } = internalBinding('worker');
+const {
+  kFsStatsFieldsNumber,
+  statMany
+} = internalBinding('fs');
+
+// Bump this when the format of the file or of the keys changes.
+const kVersion = 1;
+
+// Offsets of the modification time in the stats returned by statMany().
+const kMTimeSec = 12;
+const kMTimeNsec = 13;
+
+// The modification time recorded for paths that do not exist.
+const kMissing = -1;
+// Recorded instead of the modification time for files that only have to
+// exist, so that editing them does not invalidate anything.
+const kExists = true;
+// Written instead of the listing of the directory of the cache file, which is
+// stored once for the whole file.
+const kListed = false;
+
+// Modification times that are this close to the time they were looked at may
+// not change when the path is modified again right away, as file systems only
+// keep them with a limited precision. Entries that depend on such paths are
+// not written to the file, like racily clean entries in the index of git.
+const kRacyInterval = 2000;
+
+// Options that change the result of resolving the same specifier from the
+// same place. A cache file written with different ones is ignored.
+function getInputs() {
+  return JSON.stringify([
+    process.version,
+    getOptionValue('--preserve-symlinks'),
+    getOptionValue('--preserve-symlinks-main'),
+    getOptionValue('--experimental-modules'),
+    getOptionValue('--experimental-resolve-self'),
+    getOptionValue('--experimental-json-modules'),
+    getOptionValue('--experimental-wasm-modules'),
+    getOptionValue('--es-module-specifier-resolution'),
+  ]);
+}
+
+// Keeps the results of module resolution in a file across runs, for
+// --experimental-resolution-cache.
+//
+// Each entry maps the inputs of a lookup to its result, together with the
+// modification times of the directories that were searched and of the
+// package.json files above the result. An entry is only used if none of them
+// have changed since it was written, and if the files it resolved to still
+// exist. Adding, removing or renaming a file changes the modification time of
+// its directory, so this covers files that would take precedence over the
+// cached result as well.
+//
+// Writing the cache file modifies the directory that contains it. If lookups
+// search that directory, the names of its other entries are recorded instead
+// of its modification time, so that the file does not invalidate itself.
+class ResolutionCache {
+  constructor(filename) {
+    this.filename = filename;
+    this.dir = path.dirname(filename);
+    this.basename = path.basename(filename);
+    // The listing of this.dir that the entries in the file were written with.
+    this.listing = undefined;
+    this.inputs = getInputs();
+    // Key => [value, path, mtime, path, mtime, ...].
+    this.entries = new SafeMap();
+    // Path => its current modification time, or kMissing. Every path is only
+    // looked at once per process.
+    this.mtimes = new SafeMap();
+    // Paths whose modification time is too recent to be relied on.
+    this.racy = new SafeSet();
+    this.changed = false;
+    this.hits = 0;
+    this.misses = 0;
+    this.stale = 0;
+    this.load();
+  }
+
+  load() {
+    let data;
+    try {
+      data = JSON.parse(fs.readFileSync(this.filename, 'utf8'));
+    } catch {
+      // A missing or corrupt file is the same as an empty one.
+      return;
+    }
+    if (data === null || typeof data !== 'object' ||
+        data.version !== kVersion || data.inputs !== this.inputs ||
+        !Array.isArray(data.paths) || data.entries === null ||
+        typeof data.entries !== 'object') {
+      this.changed = true;
+      return;
+    }
+
+    const { paths, entries, listing } = data;
+    if (typeof listing === 'string')
+      this.listing = listing;
+    const keys = Object.keys(entries);
+    for (let i = 0; i < keys.length; i++) {
+      const packed = entries[keys[i]];
+      if (!Array.isArray(packed) || packed.length % 2 !== 1)
+        continue;
+      const entry = [packed[0]];
+      for (let j = 1; j < packed.length; j += 2) {
+        const value = packed[j + 1];
+        entry.push(paths[packed[j]], value === kListed ? this.listing : value);
+      }
+      this.entries.set(keys[i], entry);
+    }
+  }
+
+  // Returns the names in the directory of the cache file other than the
+  // cache file itself and its temporary files, or kMissing.
+  readListing() {
+    let names;
+    try {
+      names = fs.readdirSync(this.dir);
+    } catch {
+      return kMissing;
+    }
+    const prefix = `${this.basename}.`;
+    return names.filter((name) => name !== this.basename &&
+                                  !(name.startsWith(prefix) &&
+                                    name.endsWith('.tmp')))
+                .sort().join('/');
+  }
+
+  // Looks up the modification times of the given paths that have not been
+  // looked at yet, with a single call into the binding.
+  statPaths(paths) {
+    const missing = [];
+    for (let i = 0; i < paths.length; i++) {
+      if (typeof paths[i] === 'string' && !this.mtimes.has(paths[i]))
+        missing.push(paths[i]);
+    }
+    if (missing.length === 0)
+      return;
+
+    const now = Date.now();
+    const { 0: errors, 1: stats } =
+      statMany(missing.map(path.toNamespacedPath), false);
+    for (let i = 0; i < missing.length; i++) {
+      let mtime = kMissing;
+      if (errors[i] === 0) {
+        const offset = i * kFsStatsFieldsNumber;
+        mtime = stats[offset + kMTimeSec] * 1e3 +
+                stats[offset + kMTimeNsec] / 1e6;
+        if (missing[i] === this.dir)
+          mtime = this.readListing();
+        else if (mtime > now - kRacyInterval)
+          this.racy.add(missing[i]);
+      }
+      this.mtimes.set(missing[i], mtime);
+    }
+  }
+
+  // Returns the cached result for `key`, or undefined if there is none or if
+  // it is out of date.
+  get(key) {
+    const entry = this.entries.get(key);
+    if (entry === undefined) {
+      this.misses++;
+      return undefined;
+    }
+
+    const paths = [];
+    for (let i = 1; i < entry.length; i += 2)
+      paths.push(entry[i]);
+    this.statPaths(paths);
+    for (let i = 1; i < entry.length; i += 2) {
+      const mtime = this.mtimes.get(entry[i]);
+      if (entry[i + 1] === kExists ? mtime === kMissing :
+        mtime !== entry[i + 1]) {
+        this.entries.delete(key);
+        this.changed = true;
+        this.stale++;
+        return undefined;
+      }
+    }
+    this.hits++;
+    return entry[0];
+  }
+
+  // Records `value` as the result for `key`. `dirs` are the directories whose
+  // contents the result depends on, and `files` the files that it found.
+  set(key, value, dirs, files) {
+    const deps = new SafeMap();
+    for (let i = 0; i < files.length; i++) {
+      deps.set(files[i], kExists);
+      let dir = path.dirname(files[i]);
+      for (;;) {
+        deps.set(path.join(dir, 'package.json'), undefined);
+        const parent = path.dirname(dir);
+        if (parent === dir)
+          break;
+        dir = parent;
+      }
+    }
+    for (let i = 0; i < dirs.length; i++) {
+      if (dirs[i])
+        deps.set(dirs[i], undefined);
+    }
+    const paths = [...deps.keys()];
+    this.statPaths(paths);
+
+    const entry = [value];
+    for (let i = 0; i < paths.length; i++) {
+      const mtime = this.mtimes.get(paths[i]);
+      if (deps.get(paths[i]) === kExists && mtime !== kMissing)
+        entry.push(paths[i], kExists);
+      else
+        entry.push(paths[i], mtime);
+    }
+    this.entries.set(key, entry);
+    this.changed = true;
+  }
+
+  save() {
+    if (!this.changed)
+      return;
+
+    // Entries that were loaded from the file and not looked up since still
+    // refer to the listing the file was written with.
+    const listing = this.mtimes.has(this.dir) ?
+      this.mtimes.get(this.dir) : this.listing;
+
+    // Paths are shared by many entries, so they are stored once.
+    const paths = [];
+    const indices = new SafeMap();
+    const entries = {};
+    for (const { 0: key, 1: entry } of this.entries) {
+      const packed = [entry[0]];
+      for (let i = 1; i < entry.length; i += 2) {
+        let value = entry[i + 1];
+        if ((typeof value === 'number' && this.racy.has(entry[i])) ||
+            (typeof value === 'string' && value !== listing)) {
+          packed.length = 0;
+          break;
+        }
+        if (typeof value === 'string')
+          value = kListed;
+        let index = indices.get(entry[i]);
+        if (index === undefined) {
+          index = paths.length;
+          paths.push(entry[i]);
+          indices.set(entry[i], index);
+        }
+        packed.push(index, value);
+      }
+      if (packed.length > 0)
+        entries[key] = packed;
+    }
+
+    const data = JSON.stringify({
+      version: kVersion,
+      inputs: this.inputs,
+      listing: typeof listing === 'string' ? listing : undefined,
+      paths,
+      entries
+    });
+    // Write to a temporary file first, so that processes that run at the
+    // same time never see a partially written cache.
+    const tmp = `${this.filename}.${process.pid}.tmp`;
+    try {
+      fs.writeFileSync(tmp, data);
+      fs.renameSync(tmp, this.filename);
+    } catch {
+      try {
+        fs.unlinkSync(tmp);
+      } catch {}
+    }
+  }
+
+  report() {
+    const lookups = this.hits + this.misses + this.stale;
+    const rate = lookups === 0 ? 0 : (this.hits / lookups * 100).toFixed(1);
+    try {
+      fs.writeSync(2, `Resolution cache ${this.filename}: ${this.hits} ` +
+                      `hits, ${this.misses} misses, ${this.stale} stale ` +
+                      `(${rate}% hit rate)\n`);
+    } catch {}
+  }
+}
+
+let cache;
+
+// Returns the cache of the process, or null if it is disabled. Worker
+// threads do not use it, so that only one thread writes the file.
+function getResolutionCache() {
+  if (cache !== undefined)
+    return cache;
+  const filename = getOptionValue('--experimental-resolution-cache');
+  if (!filename || !isMainThread) {
+    cache = null;
+    return cache;
+  }
+
+  cache = new ResolutionCache(path.resolve(filename));
+  const trace = getOptionValue('--trace-resolution-cache');
+  addExitHook(() => {
+    cache.save();
+    if (trace)
+      cache.report();
+  });
+  return cache;
+}
+
+module.exports = {
+  getResolutionCache
+};
@@ -3,6 +3,7 @@
 const { JSON } = primordials;
 
 const path = require('path');
+const { runExitHooks } = require('internal/process/exit_hooks');
 
 const {
   codes: {
@@ -159,6 +160,7 @@ function createOnGlobalUncaughtException() {
       } catch {
         // Nothing to be done about it at this point.
       }
+      runExitHooks();
       return false;
     }
 
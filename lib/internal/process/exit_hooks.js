@@ -0,0 +1,24 @@
+'use strict';
+
+// Internal callbacks that run once when the thread exits, after the 'exit'
+// event has been emitted. Unlike 'exit' listeners, user code cannot remove
+// them. They must not throw.
+const hooks = [];
+let ran = false;
+
+function addExitHook(fn) {
+  hooks.push(fn);
+}
+
+function runExitHooks() {
+  if (ran)
+    return;
+  ran = true;
+  for (let i = 0; i < hooks.length; i++)
+    hooks[i]();
+}
+
+module.exports = {
+  addExitHook,
+  runExitHooks
+};
@@ -23,6 +23,7 @@ const {
   }
 } = require('internal/errors');
 const format = require('internal/util/inspect').format;
+const { runExitHooks } = require('internal/process/exit_hooks');
 const constants = internalBinding('constants').os.signals;
 
 function assert(x, msg) {
@@ -156,6 +157,7 @@ function wrapProcessMethods(binding) {
     if (!process._exiting) {
       process._exiting = true;
       process.emit('exit', process.exitCode || 0);
+      runExitHooks();
     }
     // FIXME(joyeecheung): This is an undocumented API that gets monkey-patched
     // in the user land. Either document it, or deprecate it in favor of a
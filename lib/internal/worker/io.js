@@ -1,5 +1,7 @@
 'use strict';
 
+/* global SharedArrayBuffer */
+
 const { Object } = primordials;
 
 const {
@@ -10,7 +12,9 @@ const {
 const {
   MessagePort,
   MessageChannel,
+  RingChannel: RingChannelHandle,
   drainMessagePort,
+  kRingChannelHeaderSize,
   moveMessagePortToContext,
   receiveMessageOnPort: receiveMessageOnPort_,
   stopMessagePort
@@ -24,6 +28,22 @@ const { Readable, Writable } = require('stream');
 const EventEmitter = require('events');
 const { inspect } = require('internal/util/inspect');
 const debug = require('internal/util/debuglog').debuglog('worker');
+const { setImmediate } = require('timers');
+const { owner_symbol } = require('internal/async_hooks').symbols;
+const {
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+    ERR_INVALID_ARG_VALUE,
+    ERR_OUT_OF_RANGE,
+    ERR_WORKER_RING_CHANNEL_CORRUPTED,
+    ERR_WORKER_RING_CHANNEL_RECEIVING
+  }
+} = require('internal/errors');
+const { validateInteger } = require('internal/validators');
+const {
+  isArrayBufferView,
+  isSharedArrayBuffer
+} = require('internal/util/types');
 
 const kIncrementsPortRef = Symbol('kIncrementsPortRef');
 const kName = Symbol('kName');
@@ -33,6 +53,14 @@ const kWaitingStreams = Symbol('kWaitingStreams');
 const kWritableCallbacks = Symbol('kWritableCallbacks');
 const kStartedReading = Symbol('kStartedReading');
 const kStdioWantsMoreDataCallback = Symbol('kStdioWantsMoreDataCallback');
+const kHandle = Symbol('kHandle');
+const kReceiving = Symbol('kReceiving');
+const kRefed = Symbol('kRefed');
+const kWaitingForDrain = Symbol('kWaitingForDrain');
+
+// The number of messages that a RingChannel emits before it lets the event
+// loop run other callbacks.
+const kRingChannelMessagesPerTick = 1000;
 
 const messageTypes = {
   UP_AND_RUNNING: 'upAndRunning',
@@ -239,6 +267,169 @@ function createWorkerStdio() {
   };
 }
 
+// A channel for binary messages that are copied through a ring buffer in a
+// SharedArrayBuffer instead of being serialized. Each thread creates its own
+// RingChannel for the same buffer.
+class RingChannel extends EventEmitter {
+  constructor(sizeOrBuffer) {
+    super();
+    let buffer;
+    if (typeof sizeOrBuffer === 'number') {
+      validateInteger(sizeOrBuffer, 'size', 64, 2 ** 31);
+      if ((sizeOrBuffer & (sizeOrBuffer - 1)) !== 0) {
+        throw new ERR_INVALID_ARG_VALUE('size', sizeOrBuffer,
+                                        'must be a power of two');
+      }
+      buffer = new SharedArrayBuffer(kRingChannelHeaderSize + sizeOrBuffer);
+    } else if (isSharedArrayBuffer(sizeOrBuffer)) {
+      buffer = sizeOrBuffer;
+      const size = buffer.byteLength - kRingChannelHeaderSize;
+      if (size < 64 || size > 2 ** 31 || (size & (size - 1)) !== 0) {
+        throw new ERR_INVALID_ARG_VALUE('buffer', buffer,
+                                        'was not created by a RingChannel');
+      }
+    } else {
+      throw new ERR_INVALID_ARG_TYPE('size',
+                                     ['number', 'SharedArrayBuffer'],
+                                     sizeOrBuffer);
+    }
+
+    const handle = new RingChannelHandle(buffer);
+    handle[owner_symbol] = this;
+    handle.onmessage = onRingChannelMessage;
+    handle.ondrain = onRingChannelDrain;
+    this[kHandle] = handle;
+    this[kReceiving] = false;
+    this[kRefed] = true;
+    this[kWaitingForDrain] = false;
+    this.buffer = buffer;
+    this.maxMessageSize = (buffer.byteLength - kRingChannelHeaderSize) / 2 - 4;
+
+    this.on('newListener', (name) => {
+      if (name === 'message' && this.listenerCount('message') === 0 &&
+          this[kHandle] !== null) {
+        claimRingChannelReceiver(this);
+        this[kReceiving] = true;
+        updateRingChannelRef(this);
+      }
+    });
+    this.on('removeListener', (name) => {
+      if (name === 'message' && this.listenerCount('message') === 0) {
+        this[kReceiving] = false;
+        updateRingChannelRef(this);
+      }
+    });
+  }
+
+  write(data) {
+    if (!isArrayBufferView(data)) {
+      throw new ERR_INVALID_ARG_TYPE('data',
+                                     ['Buffer', 'TypedArray', 'DataView'],
+                                     data);
+    }
+    if (data.byteLength > this.maxMessageSize) {
+      throw new ERR_OUT_OF_RANGE('data.byteLength',
+                                 `<= ${this.maxMessageSize}`,
+                                 data.byteLength);
+    }
+    const handle = this[kHandle];
+    if (handle === null)
+      return false;
+    const ret = handle.write(data);
+    if (ret === null)
+      throw new ERR_WORKER_RING_CHANNEL_CORRUPTED();
+    if (!ret && !this[kWaitingForDrain]) {
+      this[kWaitingForDrain] = true;
+      updateRingChannelRef(this);
+      handle.waitForDrain(data.byteLength);
+    }
+    return ret;
+  }
+
+  read() {
+    if (this[kHandle] === null)
+      return undefined;
+    claimRingChannelReceiver(this);
+    return readRingChannel(this);
+  }
+
+  close() {
+    const handle = this[kHandle];
+    if (handle === null)
+      return;
+    this[kHandle] = null;
+    this[kReceiving] = false;
+    handle[owner_symbol] = undefined;
+    handle.close();
+  }
+
+  ref() {
+    this[kRefed] = true;
+    updateRingChannelRef(this);
+    return this;
+  }
+
+  unref() {
+    this[kRefed] = false;
+    updateRingChannelRef(this);
+    return this;
+  }
+}
+
+function claimRingChannelReceiver(channel) {
+  if (!channel[kHandle].start())
+    throw new ERR_WORKER_RING_CHANNEL_RECEIVING();
+}
+
+function readRingChannel(channel) {
+  const message = channel[kHandle].read();
+  if (message === null)
+    throw new ERR_WORKER_RING_CHANNEL_CORRUPTED();
+  return message;
+}
+
+// Only keep the event loop alive while messages or space are expected.
+function updateRingChannelRef(channel) {
+  const handle = channel[kHandle];
+  if (handle === null)
+    return;
+  if (channel[kRefed] && (channel[kReceiving] || channel[kWaitingForDrain]))
+    handle.ref();
+  else
+    handle.unref();
+}
+
+// Called by the handle when messages have been written after the last call.
+function onRingChannelMessage() {
+  const channel = this[owner_symbol];
+  if (channel === undefined)
+    return;
+  emitRingChannelMessages(channel);
+}
+
+function emitRingChannelMessages(channel) {
+  for (let i = 0; i < kRingChannelMessagesPerTick; i++) {
+    if (!channel[kReceiving])
+      return;
+    const message = readRingChannel(channel);
+    if (message === undefined)
+      return;
+    channel.emit('message', message);
+  }
+  // There may be more messages, which the producers will not notify about.
+  setImmediate(emitRingChannelMessages, channel);
+}
+
+// Called by the handle when there is space again after a failed write.
+function onRingChannelDrain() {
+  const channel = this[owner_symbol];
+  if (channel === undefined)
+    return;
+  channel[kWaitingForDrain] = false;
+  updateRingChannelRef(channel);
+  channel.emit('drain');
+}
+
 function receiveMessageOnPort(port) {
   const message = receiveMessageOnPort_(port);
   if (message === noMessageSymbol) return undefined;
@@ -256,6 +447,7 @@ module.exports = {
   MessagePort,
   MessageChannel,
   receiveMessageOnPort,
+  RingChannel,
   setupPortReferencing,
   ReadableWorkerStdio,
   WritableWorkerStdio,
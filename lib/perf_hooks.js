@@ -92,6 +92,8 @@ const IDX_SESSION_STATS_STREAMAVERAGEDURATION = 5;
 const IDX_SESSION_STATS_DATA_SENT = 6;
 const IDX_SESSION_STATS_DATA_RECEIVED = 7;
 const IDX_SESSION_STATS_MAX_CONCURRENT_STREAMS = 8;
+const IDX_SESSION_STATS_DATA_QUEUED = 9;
+const IDX_SESSION_STATS_WRITES = 10;
 
 let http2;
 let sessionStats;
@@ -137,6 +139,10 @@ function collectHttp2Stats(entry) {
         sessionStats[IDX_SESSION_STATS_DATA_RECEIVED];
       entry.maxConcurrentStreams =
         sessionStats[IDX_SESSION_STATS_MAX_CONCURRENT_STREAMS];
+      entry.bytesQueued =
+        sessionStats[IDX_SESSION_STATS_DATA_QUEUED];
+      entry.framesPerWrite = sessionStats[IDX_SESSION_STATS_WRITES] > 0 ?
+        entry.framesSent / sessionStats[IDX_SESSION_STATS_WRITES] : 0;
       break;
   }
 }
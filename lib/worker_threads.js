@@ -11,7 +11,8 @@ const {
   MessagePort,
   MessageChannel,
   moveMessagePortToContext,
-  receiveMessageOnPort
+  receiveMessageOnPort,
+  RingChannel
 } = require('internal/worker/io');
 
 module.exports = {
@@ -20,6 +21,7 @@ module.exports = {
   MessageChannel,
   moveMessagePortToContext,
   receiveMessageOnPort,
+  RingChannel,
   threadId,
   SHARE_ENV,
   Worker,
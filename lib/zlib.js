@@ -583,11 +583,41 @@ function _close(engine, callback) {
   engine._handle = null;
 }
 
+// Defaults and limits for parallel compression. 4 is the default size of the
+// libuv threadpool; 128 KiB blocks compress almost as well as a single stream.
+const kDefaultParallelism = 4;
+const kMaxParallelism = 1024;
+const kDefaultParallelBlockSize = 128 * 1024;
+const kMinParallelBlockSize = 32 * 1024;
+const kMaxParallelBlockSize = 2 ** 30;
+
 const zlibDefaultOpts = {
   flush: Z_NO_FLUSH,
   finishFlush: Z_FINISH,
   fullFlush: Z_FULL_FLUSH
 };
+// A preset dictionary that can be used by any number of zlib streams, in this
+// thread and in Workers, without being copied for each one. The data is
+// copied into native memory once and never changes afterwards.
+const { Dictionary } = binding;
+
+function createDictionary(data) {
+  return new Dictionary(data);
+}
+
+// The pool is per thread, and only some of its numbers are memory, so these
+// are not part of process.memoryUsage().
+function getContextPoolStatistics() {
+  return binding.getContextPoolStatistics() || {
+    hits: 0,
+    misses: 0,
+    released: 0,
+    evicted: 0,
+    idle: 0,
+    idleBytes: 0
+  };
+}
+
 // Base class for all streams actually backed by zlib and using zlib-specific
 // parameters.
 function Zlib(opts, mode) {
@@ -596,6 +626,8 @@ function Zlib(opts, mode) {
   var memLevel = Z_DEFAULT_MEMLEVEL;
   var strategy = Z_DEFAULT_STRATEGY;
   var dictionary;
+  var parallelism = 0;
+  var blockSize = kDefaultParallelBlockSize;
 
   if (opts) {
     // windowBits is special. On the compression side, 0 is an invalid value.
@@ -625,31 +657,72 @@ function Zlib(opts, mode) {
       Z_DEFAULT_STRATEGY, Z_FIXED, Z_DEFAULT_STRATEGY);
 
     dictionary = opts.dictionary;
-    if (dictionary !== undefined && !isArrayBufferView(dictionary)) {
+    // The binding shares the data of a zlib.Dictionary rather than copying it.
+    if (dictionary !== undefined &&
+        !(dictionary instanceof Dictionary) &&
+        !isArrayBufferView(dictionary)) {
       if (isAnyArrayBuffer(dictionary)) {
         dictionary = Buffer.from(dictionary);
       } else {
         throw new ERR_INVALID_ARG_TYPE(
           'options.dictionary',
-          ['Buffer', 'TypedArray', 'DataView', 'ArrayBuffer'],
+          ['Buffer', 'TypedArray', 'DataView', 'ArrayBuffer',
+           'zlib.Dictionary'],
           dictionary
         );
       }
     }
+
+    const { parallel } = opts;
+    if (parallel !== undefined && parallel !== false) {
+      if (parallel === true) {
+        parallelism = kDefaultParallelism;
+      } else if (typeof parallel === 'number') {
+        parallelism = checkRangesOrGetDefault(
+          parallel, 'options.parallel', 1, kMaxParallelism, 0);
+      } else {
+        throw new ERR_INVALID_ARG_TYPE(
+          'options.parallel', ['boolean', 'number'], parallel);
+      }
+      blockSize = checkRangesOrGetDefault(
+        opts.blockSize, 'options.blockSize',
+        kMinParallelBlockSize, kMaxParallelBlockSize,
+        kDefaultParallelBlockSize);
+    }
   }
 
-  const handle = new binding.Zlib(mode);
+  // Only compression can be split up into blocks.
+  if (mode !== DEFLATE && mode !== GZIP && mode !== DEFLATERAW)
+    parallelism = 0;
+
   // Ideally, we could let ZlibBase() set up _writeState. I haven't been able
   // to come up with a good solution that doesn't break our internal API,
   // and with it all supported npm versions at the time of writing.
   this._writeState = new Uint32Array(2);
-  if (!handle.init(windowBits,
-                   level,
-                   memLevel,
-                   strategy,
-                   this._writeState,
-                   processCallback,
-                   dictionary)) {
+  let handle;
+  let initialized;
+  if (parallelism > 0) {
+    handle = new binding.ParallelDeflate(mode);
+    initialized = handle.init(windowBits,
+                              level,
+                              memLevel,
+                              strategy,
+                              this._writeState,
+                              processCallback,
+                              dictionary,
+                              blockSize,
+                              parallelism);
+  } else {
+    handle = new binding.Zlib(mode);
+    initialized = handle.init(windowBits,
+                              level,
+                              memLevel,
+                              strategy,
+                              this._writeState,
+                              processCallback,
+                              dictionary);
+  }
+  if (!initialized) {
     // TODO(addaleax): Sometimes we generate better error codes in C++ land,
     // e.g. ERR_BROTLI_PARAM_SET_FAILED -- it's hard to access them with
     // the current bindings setup, though.
@@ -856,6 +929,9 @@ module.exports = {
   Unzip,
   BrotliCompress,
   BrotliDecompress,
+  Dictionary,
+  createDictionary,
+  getContextPoolStatistics,
 
   // Convenience methods.
   // compress/decompress a string or buffer in one step.
@@ -7,6 +7,7 @@
     'node_use_etw%': 'false',
     'node_no_browser_globals%': 'false',
     'node_use_node_snapshot%': 'false',
+    'node_snapshot_main%': '',
     'node_use_v8_platform%': 'true',
     'node_use_bundled_v8%': 'true',
     'node_shared%': 'false',
@@ -147,12 +148,14 @@
       'lib/internal/main/worker_thread.js',
       'lib/internal/modules/cjs/helpers.js',
       'lib/internal/modules/cjs/loader.js',
+      'lib/internal/modules/cjs/stat_cache.js',
       'lib/internal/modules/esm/loader.js',
       'lib/internal/modules/esm/create_dynamic_module.js',
       'lib/internal/modules/esm/default_resolve.js',
       'lib/internal/modules/esm/module_job.js',
       'lib/internal/modules/esm/module_map.js',
       'lib/internal/modules/esm/translators.js',
+      'lib/internal/modules/resolution_cache.js',
       'lib/internal/net.js',
       'lib/internal/options.js',
       'lib/internal/policy/manifest.js',
@@ -160,6 +163,7 @@
       'lib/internal/priority_queue.js',
       'lib/internal/process/esm_loader.js',
       'lib/internal/process/execution.js',
+      'lib/internal/process/exit_hooks.js',
       'lib/internal/process/main_thread_only.js',
       'lib/internal/process/per_thread.js',
       'lib/internal/process/policy.js',
@@ -459,21 +463,45 @@
           'dependencies': [
             'node_mksnapshot',
           ],
-          'actions': [
-            {
-              'action_name': 'node_mksnapshot',
-              'process_outputs_as_sources': 1,
-              'inputs': [
-                '<(node_mksnapshot_exec)',
-              ],
-              'outputs': [
-                '<(SHARED_INTERMEDIATE_DIR)/node_snapshot.cc',
+          'conditions': [
+            ['node_snapshot_main!=""', {
+              'actions': [
+                {
+                  'action_name': 'node_mksnapshot',
+                  'process_outputs_as_sources': 1,
+                  'inputs': [
+                    '<(node_mksnapshot_exec)',
+                    '<(node_snapshot_main)',
+                  ],
+                  'outputs': [
+                    '<(SHARED_INTERMEDIATE_DIR)/node_snapshot.cc',
+                  ],
+                  'action': [
+                    '<(node_mksnapshot_exec)',
+                    '--main',
+                    '<(node_snapshot_main)',
+                    '<@(_outputs)',
+                  ],
+                },
               ],
-              'action': [
-                '<@(_inputs)',
-                '<@(_outputs)',
+            }, {
+              'actions': [
+                {
+                  'action_name': 'node_mksnapshot',
+                  'process_outputs_as_sources': 1,
+                  'inputs': [
+                    '<(node_mksnapshot_exec)',
+                  ],
+                  'outputs': [
+                    '<(SHARED_INTERMEDIATE_DIR)/node_snapshot.cc',
+                  ],
+                  'action': [
+                    '<@(_inputs)',
+                    '<@(_outputs)',
+                  ],
+                },
               ],
-            },
+            }],
           ],
         }, {
           'sources': [
@@ -524,6 +552,7 @@
         'src/node_api.cc',
         'src/node_binding.cc',
         'src/node_buffer.cc',
+        'src/node_compile_cache.cc',
         'src/node_config.cc',
         'src/node_constants.cc',
         'src/node_contextify.cc',
@@ -536,6 +565,7 @@
         'src/node_http_parser.cc',
         'src/node_http2.cc',
         'src/node_i18n.cc',
+        'src/node_io_uring.cc',
         'src/node_main_instance.cc',
         'src/node_messaging.cc',
         'src/node_metadata.cc',
@@ -543,12 +573,14 @@
         'src/node_native_module_env.cc',
         'src/node_options.cc',
         'src/node_os.cc',
+        'src/node_package_json.cc',
         'src/node_perf.cc',
         'src/node_platform.cc',
         'src/node_postmortem_metadata.cc',
         'src/node_process_events.cc',
         'src/node_process_methods.cc',
         'src/node_process_object.cc',
+        'src/node_ring_channel.cc',
         'src/node_serdes.cc',
         'src/node_stat_watcher.cc',
         'src/node_symbols.cc',
@@ -571,6 +603,7 @@
         'src/stream_wrap.cc',
         'src/string_bytes.cc',
         'src/string_decoder.cc',
+        'src/string_simd.cc',
         'src/tcp_wrap.cc',
         'src/timers.cc',
         'src/tracing/agent.cc',
@@ -606,6 +639,7 @@
         'src/node_api_types.h',
         'src/node_binding.h',
         'src/node_buffer.h',
+        'src/node_compile_cache.h',
         'src/node_constants.h',
         'src/node_context_data.h',
         'src/node_contextify.h',
@@ -615,6 +649,7 @@
         'src/node_http2.h',
         'src/node_http2_state.h',
         'src/node_i18n.h',
+        'src/node_io_uring.h',
         'src/node_internals.h',
         'src/node_main_instance.h',
         'src/node_messaging.h',
@@ -625,11 +660,13 @@
         'src/node_object_wrap.h',
         'src/node_options.h',
         'src/node_options-inl.h',
+        'src/node_package_json.h',
         'src/node_perf.h',
         'src/node_perf_common.h',
         'src/node_platform.h',
         'src/node_process.h',
         'src/node_revert.h',
+        'src/node_ring_channel.h',
         'src/node_root_certs.h',
         'src/node_stat_watcher.h',
         'src/node_union_bytes.h',
@@ -638,6 +675,8 @@
         'src/node_v8_platform-inl.h',
         'src/node_watchdog.h',
         'src/node_worker.h',
+        'src/node_zlib_dictionary.h',
+        'src/node_zlib_pool.h',
         'src/pipe_wrap.h',
         'src/req_wrap.h',
         'src/req_wrap-inl.h',
@@ -651,6 +690,7 @@
         'src/string_decoder.h',
         'src/string_decoder-inl.h',
         'src/string_search.h',
+        'src/string_simd.h',
         'src/tcp_wrap.h',
         'src/tracing/agent.h',
         'src/tracing/node_trace_buffer.h',
@@ -1105,6 +1145,8 @@
         'test/cctest/test_linked_binding.cc',
         'test/cctest/test_per_process.cc',
         'test/cctest/test_platform.cc',
+        'test/cctest/test_package_json.cc',
+        'test/cctest/test_string_simd.cc',
         'test/cctest/test_traced_value.cc',
         'test/cctest/test_util.cc',
         'test/cctest/test_url.cc',
@@ -1,4 +1,5 @@
 #include "env-inl.h"
+#include "node_compile_cache.h"
 #include "node_internals.h"
 #include "node_process.h"
 #include "async_wrap.h"
@@ -6,6 +7,7 @@
 namespace node {
 
 using v8::Context;
+using v8::Function;
 using v8::HandleScope;
 using v8::Integer;
 using v8::Isolate;
@@ -58,6 +60,17 @@ int EmitExit(Environment* env) {
                  .ToChecked();
   ProcessEmit(env, "exit", Integer::New(env->isolate(), code));
 
+  // Internal hooks run after the 'exit' listeners, and cannot be removed
+  // from JS land.
+  Local<Function> exit_hooks = env->exit_hooks_function();
+  if (!exit_hooks.IsEmpty()) {
+    USE(MakeCallback(env->isolate(), process_object, exit_hooks, 0, nullptr,
+                     {0, 0}));
+  }
+
+  if (CompileCacheHandler* handler = env->compile_cache_handler())
+    handler->Persist();
+
   // Reload exit code, it may be changed by `emit('exit')`
   return process_object->Get(env->context(), exit_code)
       .ToLocalChecked()
@@ -3,6 +3,7 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include "string_simd.h"
 #include "util.h"
 
 #include <cstddef>
@@ -85,6 +86,21 @@ bool base64_decode_group_slow(char* const dst, const size_t dstlen,
 }
 
 
+// Decodes a prefix of |src| with vector instructions, which are only used for
+// one-byte input. Returns the number of characters that were consumed.
+template <typename TypeName>
+size_t base64_decode_simd(char* const dst, const size_t dstlen,
+                          const TypeName* const src, const size_t srclen) {
+  return 0;
+}
+
+
+inline size_t base64_decode_simd(char* const dst, const size_t dstlen,
+                                 const char* const src, const size_t srclen) {
+  return simd::Base64Decode(src, srclen, dst, dstlen);
+}
+
+
 template <typename TypeName>
 size_t base64_decode_fast(char* const dst, const size_t dstlen,
                           const TypeName* const src, const size_t srclen,
@@ -92,8 +108,8 @@ size_t base64_decode_fast(char* const dst, const size_t dstlen,
   const size_t available = dstlen < decoded_size ? dstlen : decoded_size;
   const size_t max_k = available / 3 * 3;
   size_t max_i = srclen / 4 * 4;
-  size_t i = 0;
-  size_t k = 0;
+  size_t i = base64_decode_simd(dst, max_k, src, max_i);
+  size_t k = i / 4 * 3;
   while (i < max_i && k < max_k) {
     const uint32_t v =
         unbase64(src[i + 0]) << 24 |
@@ -127,10 +143,10 @@ size_t base64_decode(char* const dst, const size_t dstlen,
   return base64_decode_fast(dst, dstlen, src, srclen, decoded_size);
 }
 
-static size_t base64_encode(const char* src,
-                            size_t slen,
-                            char* dst,
-                            size_t dlen) {
+static inline size_t base64_encode(const char* src,
+                                   size_t slen,
+                                   char* dst,
+                                   size_t dlen) {
   // We know how much we'll write, just make sure that there's space.
   CHECK(dlen >= base64_encoded_size(slen) &&
         "not enough space provided for base64 encode");
@@ -148,9 +164,9 @@ static size_t base64_encode(const char* src,
                               "abcdefghijklmnopqrstuvwxyz"
                               "0123456789+/";
 
-  i = 0;
-  k = 0;
   n = slen / 3 * 3;
+  i = simd::Base64Encode(src, n, dst);
+  k = i / 3 * 4;
 
   while (i < n) {
     a = src[i + 0] & 0xff;
@@ -3,15 +3,19 @@
 #include "async_wrap.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
+#include "node_compile_cache.h"
 #include "node_context_data.h"
 #include "node_errors.h"
 #include "node_file.h"
 #include "node_internals.h"
+#include "node_io_uring.h"
 #include "node_native_module.h"
 #include "node_options-inl.h"
 #include "node_process.h"
 #include "node_v8_platform-inl.h"
 #include "node_worker.h"
+#include "node_zlib_pool.h"
+#include "stream_base.h"
 #include "tracing/agent.h"
 #include "tracing/traced_value.h"
 #include "util-inl.h"
@@ -412,6 +416,11 @@ Environment::~Environment() {
     tracing_controller->RemoveTraceStateObserver(trace_state_observer_.get());
   }
 
+  stream_read_pool_.reset();
+  zlib_context_pool_.reset();
+  fs_io_uring_.reset();
+  compile_cache_handler_.reset();
+
   delete[] heap_statistics_buffer_;
   delete[] heap_space_statistics_buffer_;
   delete[] http_parser_buffer_;
@@ -524,6 +533,44 @@ void Environment::RegisterHandleCleanups() {
       nullptr);
 }
 
+StreamReadPool* Environment::stream_read_pool() {
+  if (!stream_read_pool_ && options_->stream_read_pool_size > 0) {
+    stream_read_pool_ = std::make_unique<StreamReadPool>(
+        this, options_->stream_read_pool_size);
+  }
+  return stream_read_pool_.get();
+}
+
+ZlibContextPool* Environment::zlib_context_pool() {
+  if (!zlib_context_pool_ && options_->zlib_context_pool_size > 0) {
+    zlib_context_pool_ = std::make_unique<ZlibContextPool>(
+        this, options_->zlib_context_pool_size);
+  }
+  return zlib_context_pool_.get();
+}
+
+fs::IoUring* Environment::fs_io_uring() {
+  if (!fs_io_uring_initialized_) {
+    fs_io_uring_initialized_ = true;
+    if (options_->experimental_fs_io_uring)
+      fs_io_uring_ = fs::IoUring::Create(this);
+  }
+  return fs_io_uring_.get();
+}
+
+CompileCacheHandler* Environment::compile_cache_handler() {
+  if (!compile_cache_initialized_) {
+    compile_cache_initialized_ = true;
+    const std::string& dir = options_->compile_cache_dir;
+    if (!dir.empty()) {
+      auto handler = std::make_unique<CompileCacheHandler>(this);
+      if (handler->InitializeDirectory(dir))
+        compile_cache_handler_ = std::move(handler);
+    }
+  }
+  return compile_cache_handler_.get();
+}
+
 void Environment::CleanupHandles() {
   for (ReqWrapBase* request : req_wrap_queue_)
     request->Cancel();
@@ -917,6 +964,8 @@ void AsyncHooks::grow_async_ids_stack() {
 uv_key_t Environment::thread_local_env = {};
 
 void Environment::Exit(int exit_code) {
+  if (compile_cache_handler_)
+    compile_cache_handler_->Persist();
   if (is_main_thread()) {
     stop_sub_worker_contexts();
     DisposePlatform();
@@ -993,6 +1042,9 @@ void Environment::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackField("should_abort_on_uncaught_toggle",
                       should_abort_on_uncaught_toggle_);
   tracker->TrackField("stream_base_state", stream_base_state_);
+  tracker->TrackField("stream_read_pool", stream_read_pool_);
+  tracker->TrackField("zlib_context_pool", zlib_context_pool_);
+  tracker->TrackField("fs_io_uring", fs_io_uring_);
   tracker->TrackField("fs_stats_field_array", fs_stats_field_array_);
   tracker->TrackField("fs_stats_field_bigint_array",
                       fs_stats_field_bigint_array_);
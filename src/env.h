@@ -53,6 +53,10 @@ struct nghttp2_rcbuf;
 
 namespace node {
 
+class CompileCacheHandler;
+class StreamReadPool;
+class ZlibContextPool;
+
 namespace contextify {
 class ContextifyScript;
 class CompiledFnEntry;
@@ -60,6 +64,7 @@ class CompiledFnEntry;
 
 namespace fs {
 class FileHandleReadWrap;
+class IoUring;
 }
 
 namespace performance {
@@ -286,12 +291,14 @@ constexpr size_t kFsStatsBufferLength =
   V(oncomplete_string, "oncomplete")                                           \
   V(onconnection_string, "onconnection")                                       \
   V(ondone_string, "ondone")                                                   \
+  V(ondrain_string, "ondrain")                                                 \
   V(onerror_string, "onerror")                                                 \
   V(onexit_string, "onexit")                                                   \
   V(onhandshakedone_string, "onhandshakedone")                                 \
   V(onhandshakestart_string, "onhandshakestart")                               \
   V(onkeylog_string, "onkeylog")                                               \
   V(onmessage_string, "onmessage")                                             \
+  V(onmessages_string, "onmessages")                                           \
   V(onnewsession_string, "onnewsession")                                       \
   V(onocspresponse_string, "onocspresponse")                                   \
   V(onreadstart_string, "onreadstart")                                         \
@@ -406,7 +413,8 @@ constexpr size_t kFsStatsBufferLength =
   V(streambaseoutputstream_constructor_template, v8::ObjectTemplate)           \
   V(tcp_constructor_template, v8::FunctionTemplate)                            \
   V(tty_constructor_template, v8::FunctionTemplate)                            \
-  V(write_wrap_template, v8::ObjectTemplate)
+  V(write_wrap_template, v8::ObjectTemplate)                                   \
+  V(zlib_dictionary_constructor_template, v8::FunctionTemplate)
 
 #define ENVIRONMENT_STRONG_PERSISTENT_VALUES(V)                                \
   V(as_callback_data, v8::Object)                                              \
@@ -422,6 +430,7 @@ constexpr size_t kFsStatsBufferLength =
   V(domexception_function, v8::Function)                                       \
   V(enhance_fatal_stack_after_inspector, v8::Function)                         \
   V(enhance_fatal_stack_before_inspector, v8::Function)                        \
+  V(exit_hooks_function, v8::Function)                                         \
   V(fs_use_promises_symbol, v8::Symbol)                                        \
   V(host_import_module_dynamically_callback, v8::Function)                     \
   V(host_initialize_import_meta_object_callback, v8::Function)                 \
@@ -493,6 +502,8 @@ class IsolateData : public MemoryRetainer {
 #undef VP
 
   std::unordered_map<nghttp2_rcbuf*, v8::Eternal<v8::String>> http2_static_strs;
+  // Well-known HTTP/1 header names, see src/node_http_parser.cc.
+  std::vector<v8::Eternal<v8::String>> http_known_header_names;
   inline v8::Isolate* isolate() const;
   IsolateData(const IsolateData&) = delete;
   IsolateData& operator=(const IsolateData&) = delete;
@@ -537,7 +548,8 @@ struct ContextInfo {
 #define DEBUG_CATEGORY_NAMES(V)                                                \
   NODE_ASYNC_PROVIDER_TYPES(V)                                                 \
   V(INSPECTOR_SERVER)                                                          \
-  V(INSPECTOR_PROFILER)
+  V(INSPECTOR_PROFILER)                                                        \
+  V(COMPILE_CACHE)
 
 enum class DebugCategory {
 #define V(name) name,
@@ -999,6 +1011,15 @@ class Environment : public MemoryRetainer {
   inline AliasedUint32Array& should_abort_on_uncaught_toggle();
 
   inline AliasedInt32Array& stream_base_state();
+  // Returns nullptr unless --stream-read-pool-size is set.
+  StreamReadPool* stream_read_pool();
+  // Returns nullptr unless --zlib-context-pool-size is set.
+  ZlibContextPool* zlib_context_pool();
+  // Returns nullptr unless --experimental-fs-io-uring is set and io_uring is
+  // supported.
+  fs::IoUring* fs_io_uring();
+  // Returns nullptr unless a compile cache directory is configured.
+  CompileCacheHandler* compile_cache_handler();
 
   // The necessary API for async_hooks.
   inline double new_async_id();
@@ -1329,6 +1350,12 @@ class Environment : public MemoryRetainer {
   std::unique_ptr<TrackingTraceStateObserver> trace_state_observer_;
 
   AliasedInt32Array stream_base_state_;
+  std::unique_ptr<StreamReadPool> stream_read_pool_;
+  std::unique_ptr<ZlibContextPool> zlib_context_pool_;
+  std::unique_ptr<fs::IoUring> fs_io_uring_;
+  bool fs_io_uring_initialized_ = false;
+  std::unique_ptr<CompileCacheHandler> compile_cache_handler_;
+  bool compile_cache_initialized_ = false;
 
   std::unique_ptr<performance::performance_state> performance_state_;
   std::unordered_map<std::string, uint64_t> performance_marks_;
@@ -2,7 +2,9 @@
 
 #include "env.h"
 #include "memory_tracker-inl.h"
+#include "node_compile_cache.h"
 #include "node_errors.h"
+#include "node_package_json.h"
 #include "node_url.h"
 #include "util-inl.h"
 #include "node_contextify.h"
@@ -97,7 +99,8 @@ ModuleWrap* ModuleWrap::GetFromID(Environment* env, uint32_t id) {
   return module_wrap_it->second;
 }
 
-// new ModuleWrap(url, context, source, lineOffset, columnOffset)
+// new ModuleWrap(url, context, source, lineOffset, columnOffset,
+//                useCompileCache)
 // new ModuleWrap(url, context, exportNames, syntheticExecutionFunction)
 void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
   CHECK(args.IsConstructCall());
@@ -131,7 +134,8 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
     // new ModuleWrap(url, context, exportNames, syntheticExecutionFunction)
     CHECK(args[3]->IsFunction());
   } else {
-    // new ModuleWrap(url, context, source, lineOffset, columOffset)
+    // new ModuleWrap(url, context, source, lineOffset, columOffset,
+    //                useCompileCache)
     CHECK(args[2]->IsString());
     CHECK(args[3]->IsNumber());
     line_offset = args[3].As<Integer>();
@@ -178,8 +182,23 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
                           False(isolate),                   // is WASM
                           True(isolate),                    // is ES Module
                           host_defined_options);
-      ScriptCompiler::Source source(source_text, origin);
-      if (!ScriptCompiler::CompileModule(isolate, &source).ToLocal(&module)) {
+      CompileCacheHandler* cache_handler = nullptr;
+      CompileCacheEntry* cache_entry = nullptr;
+      ScriptCompiler::CachedData* cached_data = nullptr;
+      if (args[5]->IsTrue()) {
+        cache_handler = env->compile_cache_handler();
+        if (cache_handler != nullptr) {
+          cache_entry = cache_handler->GetOrInsert(
+              source_text, url, CachedCodeType::kESM);
+          cached_data = cache_entry->CopyCache();
+        }
+      }
+      ScriptCompiler::Source source(source_text, origin, cached_data);
+      ScriptCompiler::CompileOptions options = cached_data == nullptr ?
+          ScriptCompiler::kNoCompileOptions :
+          ScriptCompiler::kConsumeCodeCache;
+      if (!ScriptCompiler::CompileModule(isolate, &source, options)
+               .ToLocal(&module)) {
         if (try_catch.HasCaught() && !try_catch.HasTerminated()) {
           CHECK(!try_catch.Message().IsEmpty());
           CHECK(!try_catch.Exception().IsEmpty());
@@ -189,6 +208,10 @@ void ModuleWrap::New(const FunctionCallbackInfo<Value>& args) {
         }
         return;
       }
+      if (cache_entry != nullptr) {
+        bool rejected = cached_data != nullptr && cached_data->rejected;
+        cache_handler->MaybeSave(cache_entry, module, rejected);
+      }
     }
   }
 
@@ -480,29 +503,6 @@ inline bool ShouldBeTreatedAsRelativeOrAbsolutePath(
   return false;
 }
 
-std::string ReadFile(uv_file file) {
-  std::string contents;
-  uv_fs_t req;
-  char buffer_memory[4096];
-  uv_buf_t buf = uv_buf_init(buffer_memory, sizeof(buffer_memory));
-
-  do {
-    const int r = uv_fs_read(nullptr,
-                             &req,
-                             file,
-                             &buf,
-                             1,
-                             contents.length(),  // offset
-                             nullptr);
-    uv_fs_req_cleanup(&req);
-
-    if (r <= 0)
-      break;
-    contents.append(buf.base, r);
-  } while (true);
-  return contents;
-}
-
 enum DescriptorType {
   FILE,
   DIRECTORY,
@@ -553,49 +553,18 @@ DescriptorType CheckDescriptorAtPath(const std::string& path) {
   return type;
 }
 
-Maybe<std::string> ReadIfFile(const std::string& path) {
-  Maybe<uv_file> fd = OpenDescriptor(path);
-  if (fd.IsNothing()) return Nothing<std::string>();
-  DescriptorType type = CheckDescriptorAtFile(fd.FromJust());
-  if (type != FILE) return Nothing<std::string>();
-  std::string source = ReadFile(fd.FromJust());
-  CloseDescriptor(fd.FromJust());
-  return Just(source);
-}
-
 using Exists = PackageConfig::Exists;
 using IsValid = PackageConfig::IsValid;
 using HasMain = PackageConfig::HasMain;
 using HasName = PackageConfig::HasName;
 using PackageType = PackageConfig::PackageType;
 
-Maybe<const PackageConfig*> GetPackageConfig(Environment* env,
-                                             const std::string& path,
-                                             const URL& base) {
-  auto existing = env->package_json_cache.find(path);
-  if (existing != env->package_json_cache.end()) {
-    const PackageConfig* pcfg = &existing->second;
-    if (pcfg->is_valid == IsValid::No) {
-      std::string msg = "Invalid JSON in " + path +
-        " imported from " + base.ToFilePath();
-      node::THROW_ERR_INVALID_PACKAGE_CONFIG(env, msg.c_str());
-      return Nothing<const PackageConfig*>();
-    }
-    return Just(pcfg);
-  }
-
-  Maybe<std::string> source = ReadIfFile(path);
-
-  if (source.IsNothing()) {
-    auto entry = env->package_json_cache.emplace(path,
-        PackageConfig { Exists::No, IsValid::Yes, HasMain::No, "",
-                        HasName::No, "",
-                        PackageType::None, Global<Value>() });
-    return Just(&entry.first->second);
-  }
-
-  std::string pkg_src = source.FromJust();
-
+// Parses a package.json that the native parser in node_package_json.cc did
+// not handle, to report invalid JSON in the same way as before.
+Maybe<const PackageConfig*> ParsePackageConfig(Environment* env,
+                                               const std::string& path,
+                                               const std::string& pkg_src,
+                                               const URL& base) {
   Isolate* isolate = env->isolate();
   v8::HandleScope handle_scope(isolate);
 
@@ -674,6 +643,75 @@ Maybe<const PackageConfig*> GetPackageConfig(Environment* env,
   return Just(&entry.first->second);
 }
 
+Maybe<const PackageConfig*> GetPackageConfig(Environment* env,
+                                             const std::string& path,
+                                             const URL& base) {
+  auto existing = env->package_json_cache.find(path);
+  if (existing != env->package_json_cache.end()) {
+    const PackageConfig* pcfg = &existing->second;
+    if (pcfg->is_valid == IsValid::No) {
+      std::string msg = "Invalid JSON in " + path +
+        " imported from " + base.ToFilePath();
+      node::THROW_ERR_INVALID_PACKAGE_CONFIG(env, msg.c_str());
+      return Nothing<const PackageConfig*>();
+    }
+    return Just(pcfg);
+  }
+
+  std::shared_ptr<const PackageJson> package_json = GetPackageJson(path);
+
+  if (!package_json) {
+    auto entry = env->package_json_cache.emplace(path,
+        PackageConfig { Exists::No, IsValid::Yes, HasMain::No, "",
+                        HasName::No, "",
+                        PackageType::None, Global<Value>() });
+    return Just(&entry.first->second);
+  }
+
+  if (package_json->needs_js_parse)
+    return ParsePackageConfig(env, path, package_json->source, base);
+
+  Isolate* isolate = env->isolate();
+  v8::HandleScope handle_scope(isolate);
+
+  const PackageJson::FieldValue& main = (*package_json)[PackageJson::kMain];
+  const PackageJson::FieldValue& name = (*package_json)[PackageJson::kName];
+  const PackageJson::FieldValue& type = (*package_json)[PackageJson::kType];
+  const PackageJson::FieldValue& exports_json =
+      (*package_json)[PackageJson::kExports];
+
+  PackageType pkg_type = PackageType::None;
+  if (type.is_string) {
+    if (type.value == "module") {
+      pkg_type = PackageType::Module;
+    } else if (type.value == "commonjs") {
+      pkg_type = PackageType::CommonJS;
+    }
+    // ignore unknown types for forwards compatibility
+  }
+
+  Global<Value> exports;
+  if (exports_json.present && exports_json.json != "null") {
+    Local<Value> src;
+    Local<Value> exports_v;
+    if (!ToV8Value(env->context(), exports_json.json).ToLocal(&src) ||
+        !v8::JSON::Parse(env->context(), src.As<String>())
+            .ToLocal(&exports_v)) {
+      return Nothing<const PackageConfig*>();
+    }
+    exports.Reset(isolate, exports_v);
+  }
+
+  auto entry = env->package_json_cache.emplace(path,
+      PackageConfig { Exists::Yes, IsValid::Yes,
+                      main.is_string ? HasMain::Yes : HasMain::No,
+                      main.is_string ? main.value : "",
+                      name.is_string ? HasName::Yes : HasName::No,
+                      name.is_string ? name.value : "",
+                      pkg_type, std::move(exports) });
+  return Just(&entry.first->second);
+}
+
 Maybe<const PackageConfig*> GetPackageScopeConfig(Environment* env,
                                                   const URL& resolved,
                                                   const URL& base) {
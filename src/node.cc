@@ -830,6 +830,11 @@ int InitializeNodeWithArgs(std::vector<std::string>* argv,
         text[0] == '1';
   }
 
+  if (default_env_options->compile_cache_dir.empty()) {
+    credentials::SafeGetenv("NODE_COMPILE_CACHE",
+                            &default_env_options->compile_cache_dir);
+  }
+
   if (default_env_options->redirect_warnings.empty()) {
     credentials::SafeGetenv("NODE_REDIRECT_WARNINGS",
                             &default_env_options->redirect_warnings);
@@ -27,6 +27,7 @@
 #include "env-inl.h"
 #include "string_bytes.h"
 #include "string_search.h"
+#include "string_simd.h"
 #include "util-inl.h"
 #include "v8-profiler.h"
 #include "v8.h"
@@ -658,8 +659,21 @@ void ByteLengthUtf8(const FunctionCallbackInfo<Value> &args) {
   Environment* env = Environment::GetCurrent(args);
   CHECK(args[0]->IsString());
 
+  Local<String> str = args[0].As<String>();
+  // External one-byte strings, such as large ones that Buffer#toString()
+  // returns for ASCII or Latin-1 text, can be measured in place: every
+  // character beyond U+007F takes two bytes in UTF-8.
+  if (str->IsExternalOneByte()) {
+    const String::ExternalOneByteStringResource* ext =
+        str->GetExternalOneByteStringResource();
+    const size_t length =
+        ext->length() + simd::CountNonAscii(ext->data(), ext->length());
+    args.GetReturnValue().Set(static_cast<double>(length));
+    return;
+  }
+
   // Fast case: avoid StringBytes on UTF8 string. Jump to v8.
-  args.GetReturnValue().Set(args[0].As<String>()->Utf8Length(env->isolate()));
+  args.GetReturnValue().Set(str->Utf8Length(env->isolate()));
 }
 
 // Normalize val to be an integer in the range of [1, -1] since
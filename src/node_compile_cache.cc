@@ -0,0 +1,319 @@
+#include "node_compile_cache.h"
+
+#include "debug_utils.h"
+#include "env-inl.h"
+#include "node_file.h"
+#include "node_internals.h"
+#include "util-inl.h"
+#include "zlib.h"
+
+#include <cstring>
+
+namespace node {
+
+using v8::Function;
+using v8::Isolate;
+using v8::Local;
+using v8::Module;
+using v8::ScriptCompiler;
+using v8::String;
+
+namespace {
+
+constexpr uint32_t kCacheMagicNumber = 0x4e434331;  // "NCC1"
+
+struct CacheHeader {
+  uint32_t magic_number;
+  uint32_t type;
+  uint32_t code_size;
+  uint32_t code_hash;
+  uint32_t filename_size;
+  uint32_t cache_size;
+  uint32_t cache_hash;
+};
+
+inline uint32_t GetHash(const char* data, size_t size) {
+  uLong crc = crc32(0L, Z_NULL, 0);
+  return static_cast<uint32_t>(
+      crc32(crc, reinterpret_cast<const Bytef*>(data), size));
+}
+
+uint32_t GetCodeHash(Isolate* isolate, Local<String> code) {
+  if (code->IsOneByte()) {
+    MaybeStackBuffer<uint8_t> buf(code->Length());
+    code->WriteOneByte(isolate, *buf, 0, code->Length(),
+                       String::NO_NULL_TERMINATION);
+    return GetHash(reinterpret_cast<const char*>(*buf), code->Length());
+  }
+  TwoByteValue value(isolate, code);
+  return GetHash(reinterpret_cast<const char*>(*value),
+                 value.length() * sizeof(**value));
+}
+
+std::string GetCacheVersionTag() {
+  // The cache is only usable by the same V8 build with the same flags, which
+  // CachedDataVersionTag() accounts for. The V8 version keeps the directory
+  // names readable.
+  char tag[64];
+  snprintf(tag, sizeof(tag), "%s-%08x",
+           v8::V8::GetVersion(), ScriptCompiler::CachedDataVersionTag());
+  return tag;
+}
+
+int ReadFully(uv_file fd, char* data, size_t size, int64_t offset) {
+  while (size > 0) {
+    uv_fs_t req;
+    uv_buf_t buf = uv_buf_init(data, size);
+    int ret = uv_fs_read(nullptr, &req, fd, &buf, 1, offset, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (ret <= 0)
+      return ret == 0 ? UV_EOF : ret;
+    data += ret;
+    size -= ret;
+    offset += ret;
+  }
+  return 0;
+}
+
+}  // anonymous namespace
+
+ScriptCompiler::CachedData* CompileCacheEntry::CopyCache() const {
+  if (cache.empty())
+    return nullptr;
+  return new ScriptCompiler::CachedData(cache.data(), cache.size());
+}
+
+CompileCacheHandler::CompileCacheHandler(Environment* env) : env_(env) {}
+
+bool CompileCacheHandler::InitializeDirectory(const std::string& dir) {
+  std::string cache_dir = dir + kPathSeparator + GetCacheVersionTag();
+  uv_fs_t req;
+  int ret = fs::MKDirpSync(nullptr, &req, cache_dir, 0777, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (ret < 0 && ret != UV_EEXIST) {
+    Debug(env_, DebugCategory::COMPILE_CACHE,
+          "[compile cache] cannot create %s: %s\n",
+          cache_dir.c_str(), uv_strerror(ret));
+    return false;
+  }
+  Debug(env_, DebugCategory::COMPILE_CACHE,
+        "[compile cache] using directory %s\n", cache_dir.c_str());
+  cache_dir_ = std::move(cache_dir);
+  return true;
+}
+
+CompileCacheEntry* CompileCacheHandler::GetOrInsert(Local<String> code,
+                                                    Local<String> filename,
+                                                    CachedCodeType type) {
+  Isolate* isolate = env_->isolate();
+  Utf8Value filename_utf8(isolate, filename);
+  std::string source_filename(*filename_utf8, filename_utf8.length());
+  source_filename += static_cast<char>(type);
+  uint32_t key = GetHash(source_filename.data(), source_filename.size());
+  source_filename.pop_back();
+
+  uint32_t code_hash = GetCodeHash(isolate, code);
+  uint32_t code_size = static_cast<uint32_t>(code->Length());
+
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    CompileCacheEntry* entry = it->second.get();
+    if (entry->source_filename == source_filename &&
+        entry->code_hash == code_hash &&
+        entry->code_size == code_size) {
+      return entry;
+    }
+    // The file changed or another file hashed to the same key. Start over;
+    // the on-disk cache is overwritten at exit.
+    entries_.erase(it);
+  }
+
+  auto entry = std::make_unique<CompileCacheEntry>();
+  char name[16];
+  snprintf(name, sizeof(name), "%08x", key);
+  entry->cache_filename = cache_dir_ + kPathSeparator + name;
+  entry->source_filename = std::move(source_filename);
+  entry->type = type;
+  entry->code_hash = code_hash;
+  entry->code_size = code_size;
+  ReadCacheFile(entry.get());
+
+  CompileCacheEntry* result = entry.get();
+  entries_.emplace(key, std::move(entry));
+  return result;
+}
+
+void CompileCacheHandler::ReadCacheFile(CompileCacheEntry* entry) {
+  const char* path = entry->cache_filename.c_str();
+  uv_fs_t req;
+  uv_file fd = uv_fs_open(nullptr, &req, path, O_RDONLY, 0, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (fd < 0) {
+    Debug(env_, DebugCategory::COMPILE_CACHE,
+          "[compile cache] no cache for %s\n", entry->source_filename.c_str());
+    return;
+  }
+
+  OnScopeLeave cleanup([&]() {
+    uv_fs_t close_req;
+    CHECK_EQ(0, uv_fs_close(nullptr, &close_req, fd, nullptr));
+    uv_fs_req_cleanup(&close_req);
+  });
+
+  CacheHeader header;
+  if (ReadFully(fd, reinterpret_cast<char*>(&header), sizeof(header), 0) < 0)
+    return;
+
+  const char* mismatch = nullptr;
+  if (header.magic_number != kCacheMagicNumber)
+    mismatch = "magic number";
+  else if (header.type != static_cast<uint32_t>(entry->type))
+    mismatch = "module type";
+  else if (header.code_size != entry->code_size ||
+           header.code_hash != entry->code_hash)
+    mismatch = "source hash";
+  else if (header.filename_size != entry->source_filename.size())
+    mismatch = "file name";
+  if (mismatch != nullptr) {
+    Debug(env_, DebugCategory::COMPILE_CACHE,
+          "[compile cache] %s mismatch for %s\n",
+          mismatch, entry->source_filename.c_str());
+    entry->refresh = true;
+    return;
+  }
+
+  std::string stored_filename(header.filename_size, '\0');
+  std::vector<uint8_t> cache(header.cache_size);
+  int64_t offset = sizeof(header);
+  if (ReadFully(fd, &stored_filename[0], stored_filename.size(), offset) < 0 ||
+      ReadFully(fd, reinterpret_cast<char*>(cache.data()), cache.size(),
+                offset + stored_filename.size()) < 0 ||
+      stored_filename != entry->source_filename ||
+      GetHash(reinterpret_cast<const char*>(cache.data()), cache.size()) !=
+          header.cache_hash) {
+    Debug(env_, DebugCategory::COMPILE_CACHE,
+          "[compile cache] corrupted cache for %s\n",
+          entry->source_filename.c_str());
+    entry->refresh = true;
+    return;
+  }
+
+  Debug(env_, DebugCategory::COMPILE_CACHE,
+        "[compile cache] read %zu bytes for %s\n",
+        cache.size(), entry->source_filename.c_str());
+  entry->cache = std::move(cache);
+}
+
+void CompileCacheHandler::RecordResult(CompileCacheEntry* entry,
+                                       bool rejected) {
+  if (entry->cache.empty()) {
+    stats_[kMisses]++;
+    entry->refresh = true;
+  } else if (rejected) {
+    Debug(env_, DebugCategory::COMPILE_CACHE,
+          "[compile cache] cache for %s was rejected\n",
+          entry->source_filename.c_str());
+    stats_[kRejected]++;
+    entry->refresh = true;
+  } else {
+    stats_[kHits]++;
+  }
+}
+
+void CompileCacheHandler::MaybeSave(CompileCacheEntry* entry,
+                                    Local<Function> fn,
+                                    bool rejected) {
+  RecordResult(entry, rejected);
+  if (entry->refresh)
+    entry->function.Reset(env_->isolate(), fn);
+}
+
+void CompileCacheHandler::MaybeSave(CompileCacheEntry* entry,
+                                    Local<Module> module,
+                                    bool rejected) {
+  RecordResult(entry, rejected);
+  if (!entry->refresh)
+    return;
+  std::unique_ptr<ScriptCompiler::CachedData> data(
+      ScriptCompiler::CreateCodeCache(module->GetUnboundModuleScript()));
+  if (!data) {
+    entry->refresh = false;
+    return;
+  }
+  entry->cache.assign(data->data, data->data + data->length);
+}
+
+bool CompileCacheHandler::WriteCacheFile(
+    const CompileCacheEntry* entry,
+    const ScriptCompiler::CachedData* data) {
+  CacheHeader header;
+  header.magic_number = kCacheMagicNumber;
+  header.type = static_cast<uint32_t>(entry->type);
+  header.code_size = entry->code_size;
+  header.code_hash = entry->code_hash;
+  header.filename_size = static_cast<uint32_t>(entry->source_filename.size());
+  header.cache_size = static_cast<uint32_t>(data->length);
+  header.cache_hash =
+      GetHash(reinterpret_cast<const char*>(data->data), data->length);
+
+  std::string contents(reinterpret_cast<const char*>(&header), sizeof(header));
+  contents += entry->source_filename;
+  contents.append(reinterpret_cast<const char*>(data->data), data->length);
+
+  // Write to a temporary file first so that concurrent processes never
+  // observe a partially written cache.
+  std::string tmp = entry->cache_filename + "." +
+                    std::to_string(uv_os_getpid()) + "." +
+                    std::to_string(env_->thread_id()) + ".tmp";
+  uv_buf_t buf = uv_buf_init(&contents[0], contents.size());
+  int err = WriteFileSync(tmp.c_str(), buf);
+  if (err == 0) {
+    uv_fs_t req;
+    err = uv_fs_rename(nullptr, &req, tmp.c_str(),
+                       entry->cache_filename.c_str(), nullptr);
+    uv_fs_req_cleanup(&req);
+  }
+  if (err < 0) {
+    uv_fs_t req;
+    uv_fs_unlink(nullptr, &req, tmp.c_str(), nullptr);
+    uv_fs_req_cleanup(&req);
+    Debug(env_, DebugCategory::COMPILE_CACHE,
+          "[compile cache] failed to write %s: %s\n",
+          entry->cache_filename.c_str(), uv_strerror(err));
+    return false;
+  }
+  Debug(env_, DebugCategory::COMPILE_CACHE,
+        "[compile cache] wrote %zu bytes for %s\n",
+        data->length, entry->source_filename.c_str());
+  return true;
+}
+
+void CompileCacheHandler::Persist() {
+  Isolate* isolate = env_->isolate();
+  v8::HandleScope handle_scope(isolate);
+  for (auto& it : entries_) {
+    CompileCacheEntry* entry = it.second.get();
+    if (!entry->refresh)
+      continue;
+    entry->refresh = false;
+
+    std::unique_ptr<ScriptCompiler::CachedData> data;
+    if (entry->type == CachedCodeType::kCommonJS) {
+      if (entry->function.IsEmpty())
+        continue;
+      data.reset(ScriptCompiler::CreateCodeCacheForFunction(
+          entry->function.Get(isolate)));
+      entry->function.Reset();
+    } else {
+      if (entry->cache.empty())
+        continue;
+      data = std::make_unique<ScriptCompiler::CachedData>(
+          entry->cache.data(), entry->cache.size());
+    }
+
+    if (data && WriteCacheFile(entry, data.get()))
+      stats_[kWritten]++;
+  }
+}
+
+}  // namespace node
@@ -0,0 +1,103 @@
+#ifndef SRC_NODE_COMPILE_CACHE_H_
+#define SRC_NODE_COMPILE_CACHE_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "v8.h"
+
+namespace node {
+// Forward declaration to break recursive dependency chain with src/env.h.
+class Environment;
+
+enum class CachedCodeType : uint8_t {
+  kCommonJS = 0,
+  kESM = 1,
+};
+
+struct CompileCacheEntry {
+  // Returns a non-owning view of the cached data read from disk, or nullptr.
+  // The caller passes it to ScriptCompiler::Source, which takes ownership of
+  // the view but not of the underlying buffer.
+  v8::ScriptCompiler::CachedData* CopyCache() const;
+
+  std::string cache_filename;
+  std::string source_filename;
+  CachedCodeType type;
+  uint32_t code_hash;
+  uint32_t code_size;
+  // The cache read from disk, if any.
+  std::vector<uint8_t> cache;
+  // Set when the entry needs to be written back to disk.
+  bool refresh = false;
+  // For CommonJS the compiled function is kept around so that the code cache
+  // can be produced at exit and include lazily compiled inner functions.
+  // ES modules have to be serialized before they are evaluated, so their
+  // cache is produced right after compilation and stored in |cache|.
+  v8::Global<v8::Function> function;
+};
+
+// Persists V8 code caches of user-land modules in a directory on disk so that
+// later runs can skip parsing and compiling them. Caches are keyed by the
+// file name, the source hash and the V8 version/flags; stale or rejected
+// caches are refreshed when the process exits.
+class CompileCacheHandler {
+ public:
+  enum StatsFields {
+    kHits,
+    kMisses,
+    kRejected,
+    kWritten,
+    kStatsFieldCount
+  };
+
+  explicit CompileCacheHandler(Environment* env);
+  CompileCacheHandler(const CompileCacheHandler&) = delete;
+  CompileCacheHandler& operator=(const CompileCacheHandler&) = delete;
+
+  // Creates the versioned cache directory below |dir|. Returns false if the
+  // directory cannot be used, in which case the cache stays disabled.
+  bool InitializeDirectory(const std::string& dir);
+
+  // Looks up the entry for |filename|, reading the on-disk cache if this is
+  // the first time the file is compiled in this process.
+  CompileCacheEntry* GetOrInsert(v8::Local<v8::String> code,
+                                 v8::Local<v8::String> filename,
+                                 CachedCodeType type);
+
+  // Called after compilation. |rejected| is whether V8 refused the cached
+  // data that was passed in.
+  void MaybeSave(CompileCacheEntry* entry,
+                 v8::Local<v8::Function> fn,
+                 bool rejected);
+  void MaybeSave(CompileCacheEntry* entry,
+                 v8::Local<v8::Module> module,
+                 bool rejected);
+
+  // Writes all new or refreshed entries to disk.
+  void Persist();
+
+  const std::string& cache_dir() const { return cache_dir_; }
+  const uint64_t* stats() const { return stats_; }
+
+ private:
+  void ReadCacheFile(CompileCacheEntry* entry);
+  bool WriteCacheFile(const CompileCacheEntry* entry,
+                      const v8::ScriptCompiler::CachedData* data);
+  void RecordResult(CompileCacheEntry* entry, bool rejected);
+
+  Environment* env_;
+  std::string cache_dir_;
+  std::unordered_map<uint32_t, std::unique_ptr<CompileCacheEntry>> entries_;
+  uint64_t stats_[kStatsFieldCount] = {};
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_COMPILE_CACHE_H_
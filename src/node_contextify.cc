@@ -25,6 +25,7 @@
 #include "node_internals.h"
 #include "node_watchdog.h"
 #include "base_object-inl.h"
+#include "node_compile_cache.h"
 #include "node_context_data.h"
 #include "node_errors.h"
 #include "module_wrap.h"
@@ -1041,6 +1042,17 @@ void ContextifyContext::CompileFunction(
     params_buf = args[8].As<Array>();
   }
 
+  // Argument 10: use the on-disk compile cache (optional)
+  CompileCacheEntry* cache_entry = nullptr;
+  CompileCacheHandler* cache_handler = nullptr;
+  if (args[9]->IsTrue() && cached_data_buf.IsEmpty()) {
+    cache_handler = env->compile_cache_handler();
+    if (cache_handler != nullptr) {
+      cache_entry = cache_handler->GetOrInsert(
+          code, filename, CachedCodeType::kCommonJS);
+    }
+  }
+
   // Read cache from cached data buffer
   ScriptCompiler::CachedData* cached_data = nullptr;
   if (!cached_data_buf.IsEmpty()) {
@@ -1048,6 +1060,8 @@ void ContextifyContext::CompileFunction(
     uint8_t* data = static_cast<uint8_t*>(contents.Data());
     cached_data = new ScriptCompiler::CachedData(
       data + cached_data_buf->ByteOffset(), cached_data_buf->ByteLength());
+  } else if (cache_entry != nullptr) {
+    cached_data = cache_entry->CopyCache();
   }
 
   // Get the function id
@@ -1122,6 +1136,12 @@ void ContextifyContext::CompileFunction(
   }
   Local<Function> fn = maybe_fn.ToLocalChecked();
 
+  if (cache_entry != nullptr) {
+    bool rejected = source.GetCachedData() != nullptr &&
+                    source.GetCachedData()->rejected;
+    cache_handler->MaybeSave(cache_entry, fn, rejected);
+  }
+
   Local<Object> cache_key;
   if (!env->compiled_fn_entry_template()->NewInstance(
            context).ToLocal(&cache_key)) {
@@ -1200,6 +1220,41 @@ static void WatchdogHasPendingSigint(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(ret);
 }
 
+static void GetCompileCacheStatistics(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CompileCacheHandler* handler = env->compile_cache_handler();
+  if (handler == nullptr)
+    return;
+
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  const uint64_t* stats = handler->stats();
+  Local<Object> obj = Object::New(isolate);
+#define V(name, index)                                                        \
+  obj->Set(context,                                                           \
+           FIXED_ONE_BYTE_STRING(isolate, name),                              \
+           Number::New(isolate,                                               \
+                       static_cast<double>(                                   \
+                           stats[CompileCacheHandler::index]))).Check();
+  V("hits", kHits)
+  V("misses", kMisses)
+  V("rejected", kRejected)
+  V("written", kWritten)
+#undef V
+  obj->Set(context,
+           FIXED_ONE_BYTE_STRING(isolate, "directory"),
+           ToV8Value(context, handler->cache_dir()).ToLocalChecked()).Check();
+  args.GetReturnValue().Set(obj);
+}
+
+static void FlushCompileCache(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CompileCacheHandler* handler = env->compile_cache_handler();
+  if (handler != nullptr)
+    handler->Persist();
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -1213,6 +1268,9 @@ void Initialize(Local<Object> target,
   // Used in tests.
   env->SetMethodNoSideEffect(
       target, "watchdogHasPendingSigint", WatchdogHasPendingSigint);
+  env->SetMethod(target, "getCompileCacheStatistics",
+                 GetCompileCacheStatistics);
+  env->SetMethod(target, "flushCompileCache", FlushCompileCache);
 
   {
     Local<FunctionTemplate> tpl = FunctionTemplate::New(env->isolate());
@@ -23,6 +23,7 @@
 #include "aliased_buffer.h"
 #include "memory_tracker-inl.h"
 #include "node_buffer.h"
+#include "node_package_json.h"
 #include "node_process.h"
 #include "node_stat_watcher.h"
 #include "util-inl.h"
@@ -33,6 +34,7 @@
 #include "stream_base-inl.h"
 #include "string_bytes.h"
 #include "string_search.h"
+#include "threadpoolwork-inl.h"
 
 #include <fcntl.h>
 #include <sys/types.h>
@@ -46,6 +48,8 @@
 #endif
 
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace node {
 
@@ -80,6 +84,10 @@ using v8::Value;
 # define S_ISDIR(mode)  (((mode) & S_IFMT) == S_IFDIR)
 #endif
 
+#ifndef S_ISREG
+# define S_ISREG(mode)  (((mode) & S_IFMT) == S_IFREG)
+#endif
+
 #ifdef __POSIX__
 constexpr char kPathSeparator = '/';
 #else
@@ -149,6 +157,7 @@ void FileHandle::New(const FunctionCallbackInfo<Value>& args) {
     handle->read_offset_ = args[1]->IntegerValue(env->context()).FromJust();
   if (args[2]->IsNumber())
     handle->read_length_ = args[2]->IntegerValue(env->context()).FromJust();
+  handle->read_exact_ = args[3]->IsTrue();
 }
 
 FileHandle::~FileHandle() {
@@ -404,9 +413,12 @@ int FileHandle::ReadStart() {
     }
 
     // Reading 0 bytes from a file always means EOF, or that we reached
-    // the end of the requested range.
-    if (result == 0)
-      result = UV_EOF;
+    // the end of the requested range. If the whole range was expected to be
+    // there, the file has become shorter in the meantime.
+    if (result == 0) {
+      result = handle->read_exact_ && handle->read_length_ > 0 ?
+          UV_EIO : UV_EOF;
+    }
 
     handle->EmitRead(result, buffer);
 
@@ -715,8 +727,8 @@ void Close(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(env, args[1]);
   if (req_wrap_async != nullptr) {  // close(fd, req)
-    AsyncCall(env, req_wrap_async, args, "close", UTF8, AfterNoArgs,
-              uv_fs_close, fd);
+    AsyncUringCall(env, req_wrap_async, args, "close", UTF8, AfterNoArgs,
+                   &IoUring::Close, uv_fs_close, fd);
   } else {  // close(fd, undefined, ctx)
     CHECK_EQ(argc, 3);
     FSReqWrapSync req_wrap_sync;
@@ -798,6 +810,48 @@ static void InternalModuleReadJSON(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Like InternalModuleReadJSON(), but parses the file natively, once per
+// process. Returns undefined if the file cannot be read or does not mention
+// "main", "exports" or "type". Returns the contents of the file if they have
+// to be parsed with JSON.parse(), e.g. because they are not valid JSON, so
+// that errors are reported as before. Otherwise returns an array with the
+// JSON source text of the name, main, exports, imports and type fields, with
+// undefined for fields that are not present.
+static void InternalModuleReadPackageJSON(
+    const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CHECK(args[0]->IsString());
+  node::Utf8Value path(isolate, args[0]);
+
+  if (strlen(*path) != path.length())
+    return;  // Contains a nul byte.
+
+  std::shared_ptr<const loader::PackageJson> pkg =
+      loader::GetPackageJson(std::string(*path, path.length()));
+  if (!pkg || !pkg->mentions_fields)
+    return;
+
+  if (pkg->needs_js_parse) {
+    Local<Value> source;
+    if (ToV8Value(env->context(), pkg->source).ToLocal(&source))
+      args.GetReturnValue().Set(source);
+    return;
+  }
+
+  Local<Value> fields[loader::PackageJson::kFieldCount];
+  for (size_t i = 0; i < arraysize(fields); i++) {
+    const loader::PackageJson::FieldValue& field = pkg->fields[i];
+    if (!field.present) {
+      fields[i] = Undefined(isolate);
+    } else if (!ToV8Value(env->context(), field.json).ToLocal(&fields[i])) {
+      return;
+    }
+  }
+  args.GetReturnValue().Set(Array::New(isolate, fields, arraysize(fields)));
+}
+
 // Used to speed up module loading.  Returns 0 if the path refers to
 // a file, 1 when it's a directory or < 0 on error (usually -ENOENT.)
 // The speedup comes from not creating thousands of Stat and Error objects.
@@ -830,8 +884,8 @@ static void Stat(const FunctionCallbackInfo<Value>& args) {
   bool use_bigint = args[1]->IsTrue();
   FSReqBase* req_wrap_async = GetReqWrap(env, args[2], use_bigint);
   if (req_wrap_async != nullptr) {  // stat(path, use_bigint, req)
-    AsyncCall(env, req_wrap_async, args, "stat", UTF8, AfterStat,
-              uv_fs_stat, *path);
+    AsyncUringCall(env, req_wrap_async, args, "stat", UTF8, AfterStat,
+                   &IoUring::Stat, uv_fs_stat, *path);
   } else {  // stat(path, use_bigint, undefined, ctx)
     CHECK_EQ(argc, 4);
     FSReqWrapSync req_wrap_sync;
@@ -860,8 +914,8 @@ static void LStat(const FunctionCallbackInfo<Value>& args) {
   bool use_bigint = args[1]->IsTrue();
   FSReqBase* req_wrap_async = GetReqWrap(env, args[2], use_bigint);
   if (req_wrap_async != nullptr) {  // lstat(path, use_bigint, req)
-    AsyncCall(env, req_wrap_async, args, "lstat", UTF8, AfterStat,
-              uv_fs_lstat, *path);
+    AsyncUringCall(env, req_wrap_async, args, "lstat", UTF8, AfterStat,
+                   &IoUring::LStat, uv_fs_lstat, *path);
   } else {  // lstat(path, use_bigint, undefined, ctx)
     CHECK_EQ(argc, 4);
     FSReqWrapSync req_wrap_sync;
@@ -891,8 +945,8 @@ static void FStat(const FunctionCallbackInfo<Value>& args) {
   bool use_bigint = args[1]->IsTrue();
   FSReqBase* req_wrap_async = GetReqWrap(env, args[2], use_bigint);
   if (req_wrap_async != nullptr) {  // fstat(fd, use_bigint, req)
-    AsyncCall(env, req_wrap_async, args, "fstat", UTF8, AfterStat,
-              uv_fs_fstat, fd);
+    AsyncUringCall(env, req_wrap_async, args, "fstat", UTF8, AfterStat,
+                   &IoUring::FStat, uv_fs_fstat, fd);
   } else {  // fstat(fd, use_bigint, undefined, ctx)
     CHECK_EQ(argc, 4);
     FSReqWrapSync req_wrap_sync;
@@ -909,6 +963,163 @@ static void FStat(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+// Stats a batch of paths, either on the calling thread or in a single
+// threadpool job. Errors are recorded per path rather than failing the batch.
+class StatManyWork : public ThreadPoolWork {
+ public:
+  StatManyWork(Environment* env,
+               FSReqBase* req_wrap,
+               std::vector<std::string>&& paths,
+               bool use_bigint)
+      : ThreadPoolWork(env),
+        req_wrap_(req_wrap),
+        paths_(std::move(paths)),
+        use_bigint_(use_bigint) {}
+
+  void DoThreadPoolWork() override { StatAll(); }
+  void AfterThreadPoolWork(int status) override;
+
+  void StatAll();
+  // Returns [errors, stats], where errors is an Int32Array with 0 or a
+  // negative errno for each path, and stats holds kFsStatsFieldsNumber
+  // fields for each path in the format of the single stat functions.
+  Local<Value> ToArray(Isolate* isolate) const;
+
+ private:
+  template <typename AliasedBufferT>
+  Local<Value> StatsArray(Isolate* isolate) const;
+
+  FSReqBase* const req_wrap_;
+  const std::vector<std::string> paths_;
+  const bool use_bigint_;
+  std::vector<int> errors_;
+  std::vector<uv_stat_t> stats_;
+};
+
+void StatManyWork::StatAll() {
+  errors_.resize(paths_.size());
+  stats_.resize(paths_.size());
+  for (size_t i = 0; i < paths_.size(); i++) {
+    uv_fs_t req;
+    errors_[i] = uv_fs_stat(nullptr, &req, paths_[i].c_str(), nullptr);
+    if (errors_[i] == 0)
+      stats_[i] = req.statbuf;
+    uv_fs_req_cleanup(&req);
+  }
+}
+
+template <typename AliasedBufferT>
+Local<Value> StatManyWork::StatsArray(Isolate* isolate) const {
+  constexpr size_t kFields =
+      static_cast<size_t>(FsStatsOffset::kFsStatsFieldsNumber);
+  // AliasedBufferBase does not support empty arrays.
+  AliasedBufferT stats(isolate, std::max<size_t>(paths_.size(), 1) * kFields);
+  for (size_t i = 0; i < paths_.size(); i++) {
+    if (errors_[i] == 0)
+      FillStatsArray(&stats, &stats_[i], i * kFields);
+  }
+  return stats.GetJSArray();
+}
+
+Local<Value> StatManyWork::ToArray(Isolate* isolate) const {
+  AliasedInt32Array errors(isolate, std::max<size_t>(paths_.size(), 1));
+  for (size_t i = 0; i < paths_.size(); i++)
+    errors.SetValue(i, errors_[i]);
+
+  Local<Value> values[] = {
+    errors.GetJSArray(),
+    use_bigint_ ? StatsArray<AliasedBigUint64Array>(isolate) :
+                  StatsArray<AliasedFloat64Array>(isolate)
+  };
+  return Array::New(isolate, values, arraysize(values));
+}
+
+void StatManyWork::AfterThreadPoolWork(int status) {
+  std::unique_ptr<StatManyWork> self(this);
+  std::unique_ptr<FSReqBase> req_wrap(req_wrap_);
+  Environment* env = req_wrap->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  CHECK_EQ(status, 0);  // The job is never cancelled.
+  req_wrap->Resolve(ToArray(env->isolate()));
+}
+
+/*
+ * Wrapper for fs.statMany(). Returns [errors, stats], see
+ * StatManyWork::ToArray().
+ *
+ * 0 paths      array of strings or buffers
+ * 1 useBigint
+ * 2 req        undefined to stat the paths synchronously
+ */
+static void StatMany(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 2);
+
+  CHECK(args[0]->IsArray());
+  Local<Array> array = args[0].As<Array>();
+  std::vector<std::string> paths(array->Length());
+  for (uint32_t i = 0; i < paths.size(); i++) {
+    Local<Value> value;
+    if (!array->Get(env->context(), i).ToLocal(&value))
+      return;
+    BufferValue path(isolate, value);
+    CHECK_NOT_NULL(*path);
+    paths[i].assign(*path, path.length());
+  }
+
+  bool use_bigint = args[1]->IsTrue();
+  FSReqBase* req_wrap_async = GetReqWrap(env, args[2], use_bigint);
+  if (req_wrap_async != nullptr) {  // statMany(paths, use_bigint, req)
+    req_wrap_async->Init("stat", nullptr, 0, UTF8);
+    StatManyWork* work =
+        new StatManyWork(env, req_wrap_async, std::move(paths), use_bigint);
+    work->ScheduleWork();
+    req_wrap_async->SetReturnValue(args);
+  } else {  // statMany(paths, use_bigint)
+    StatManyWork work(env, nullptr, std::move(paths), use_bigint);
+    FS_SYNC_TRACE_BEGIN(statMany);
+    work.StatAll();
+    FS_SYNC_TRACE_END(statMany);
+    args.GetReturnValue().Set(work.ToArray(isolate));
+  }
+}
+
+// Like InternalModuleStat(), for a list of paths. Returns an Int32Array
+// with one result for each path.
+static void InternalModuleStatMany(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+
+  CHECK(args[0]->IsArray());
+  Local<Array> paths = args[0].As<Array>();
+  const uint32_t count = paths->Length();
+
+  AliasedInt32Array results(isolate, std::max<uint32_t>(count, 1));
+  for (uint32_t i = 0; i < count; i++) {
+    Local<Value> value;
+    if (!paths->Get(env->context(), i).ToLocal(&value))
+      return;
+    CHECK(value->IsString());
+    node::Utf8Value path(isolate, value);
+
+    uv_fs_t req;
+    int rc = uv_fs_stat(env->event_loop(), &req, *path, nullptr);
+    if (rc == 0) {
+      const uv_stat_t* const s = static_cast<const uv_stat_t*>(req.ptr);
+      rc = !!(s->st_mode & S_IFDIR);
+    }
+    uv_fs_req_cleanup(&req);
+    results.SetValue(i, rc);
+  }
+
+  args.GetReturnValue().Set(results.GetJSArray());
+}
+
 static void Symlink(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
@@ -1072,8 +1283,8 @@ static void Fdatasync(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(env, args[1]);
   if (req_wrap_async != nullptr) {
-    AsyncCall(env, req_wrap_async, args, "fdatasync", UTF8, AfterNoArgs,
-              uv_fs_fdatasync, fd);
+    AsyncUringCall(env, req_wrap_async, args, "fdatasync", UTF8,
+                   AfterNoArgs, &IoUring::Fdatasync, uv_fs_fdatasync, fd);
   } else {
     CHECK_EQ(argc, 3);
     FSReqWrapSync req_wrap_sync;
@@ -1094,8 +1305,8 @@ static void Fsync(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(env, args[1]);
   if (req_wrap_async != nullptr) {
-    AsyncCall(env, req_wrap_async, args, "fsync", UTF8, AfterNoArgs,
-              uv_fs_fsync, fd);
+    AsyncUringCall(env, req_wrap_async, args, "fsync", UTF8, AfterNoArgs,
+                   &IoUring::Fsync, uv_fs_fsync, fd);
   } else {
     CHECK_EQ(argc, 3);
     FSReqWrapSync req_wrap_sync;
@@ -1479,8 +1690,8 @@ static void Open(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(env, args[3]);
   if (req_wrap_async != nullptr) {  // open(path, flags, mode, req)
-    AsyncCall(env, req_wrap_async, args, "open", UTF8, AfterInteger,
-              uv_fs_open, *path, flags, mode);
+    AsyncUringCall(env, req_wrap_async, args, "open", UTF8, AfterInteger,
+                   &IoUring::Open, uv_fs_open, *path, flags, mode);
   } else {  // open(path, flags, mode, undefined, ctx)
     CHECK_EQ(argc, 5);
     FSReqWrapSync req_wrap_sync;
@@ -1510,8 +1721,9 @@ static void OpenFileHandle(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(env, args[3]);
   if (req_wrap_async != nullptr) {  // openFileHandle(path, flags, mode, req)
-    AsyncCall(env, req_wrap_async, args, "open", UTF8, AfterOpenFileHandle,
-              uv_fs_open, *path, flags, mode);
+    AsyncUringCall(env, req_wrap_async, args, "open", UTF8,
+                   AfterOpenFileHandle, &IoUring::Open, uv_fs_open,
+                   *path, flags, mode);
   } else {  // openFileHandle(path, flags, mode, undefined, ctx)
     CHECK_EQ(argc, 5);
     FSReqWrapSync req_wrap_sync;
@@ -1602,8 +1814,8 @@ static void WriteBuffer(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(env, args[5]);
   if (req_wrap_async != nullptr) {  // write(fd, buffer, off, len, pos, req)
-    AsyncCall(env, req_wrap_async, args, "write", UTF8, AfterInteger,
-              uv_fs_write, fd, &uvbuf, 1, pos);
+    AsyncUringCall(env, req_wrap_async, args, "write", UTF8, AfterInteger,
+                   &IoUring::Write, uv_fs_write, fd, &uvbuf, 1, pos);
   } else {  // write(fd, buffer, off, len, pos, undefined, ctx)
     CHECK_EQ(argc, 7);
     FSReqWrapSync req_wrap_sync;
@@ -1647,8 +1859,9 @@ static void WriteBuffers(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(env, args[3]);
   if (req_wrap_async != nullptr) {  // writeBuffers(fd, chunks, pos, req)
-    AsyncCall(env, req_wrap_async, args, "write", UTF8, AfterInteger,
-              uv_fs_write, fd, *iovs, iovs.length(), pos);
+    AsyncUringCall(env, req_wrap_async, args, "write", UTF8, AfterInteger,
+                   &IoUring::Write, uv_fs_write,
+                   fd, *iovs, iovs.length(), pos);
   } else {  // writeBuffers(fd, chunks, pos, undefined, ctx)
     CHECK_EQ(argc, 5);
     FSReqWrapSync req_wrap_sync;
@@ -1803,8 +2016,8 @@ static void Read(const FunctionCallbackInfo<Value>& args) {
 
   FSReqBase* req_wrap_async = GetReqWrap(env, args[5]);
   if (req_wrap_async != nullptr) {  // read(fd, buffer, offset, len, pos, req)
-    AsyncCall(env, req_wrap_async, args, "read", UTF8, AfterInteger,
-              uv_fs_read, fd, &uvbuf, 1, pos);
+    AsyncUringCall(env, req_wrap_async, args, "read", UTF8, AfterInteger,
+                   &IoUring::Read, uv_fs_read, fd, &uvbuf, 1, pos);
   } else {  // read(fd, buffer, offset, len, pos, undefined, ctx)
     CHECK_EQ(argc, 7);
     FSReqWrapSync req_wrap_sync;
@@ -1817,6 +2030,244 @@ static void Read(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Reads a whole file for fs.readFile() in a single threadpool job, instead of
+// one job each for open, fstat, every read and close. Regular files of up to
+// max_size bytes are read into a buffer of their exact size. Everything else,
+// i.e. larger files and files that are not regular files, is handed back to
+// JS after the fstat, together with the open file descriptor, so that reading
+// it is still split into multiple jobs and does not block a threadpool thread
+// for too long.
+class ReadFileWork : public ThreadPoolWork {
+ public:
+  ReadFileWork(Environment* env,
+               FSReqBase* req_wrap,
+               const char* path,
+               int flags,
+               uint64_t max_size,
+               enum encoding encoding)
+      : ThreadPoolWork(env),
+        req_wrap_(req_wrap),
+        path_(path),
+        flags_(flags),
+        max_size_(max_size),
+        encoding_(encoding) {}
+
+  ~ReadFileWork() override {
+    free(data_);
+  }
+
+  void DoThreadPoolWork() override;
+  void AfterThreadPoolWork(int status) override;
+
+ private:
+  void Close(uv_file fd);
+  // Reads until EOF or until size_ bytes have been read. If size_ is 0,
+  // the size of the file is unknown and the buffer grows as needed.
+  void ReadAll(uv_file fd);
+
+  FSReqBase* const req_wrap_;
+  const std::string path_;
+  const int flags_;
+  const uint64_t max_size_;
+  const enum encoding encoding_;
+
+  int err_ = 0;
+  const char* syscall_ = "open";
+  // Set if the file is handed back to JS.
+  uv_file fd_ = -1;
+  uint64_t size_ = 0;
+  char* data_ = nullptr;
+  size_t length_ = 0;
+};
+
+void ReadFileWork::Close(uv_file fd) {
+  uv_fs_t req;
+  int err = uv_fs_close(nullptr, &req, fd, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (err < 0 && err_ == 0) {
+    err_ = err;
+    syscall_ = "close";
+  }
+}
+
+void ReadFileWork::ReadAll(uv_file fd) {
+  // Use 64kb when the size of the file is not known, like
+  // kReadFileUnknownBufferLength in lib/internal/fs/read_file_context.js.
+  constexpr size_t kUnknownSizeChunk = 64 * 1024;
+  size_t capacity = size_ > 0 ? static_cast<size_t>(size_) : kUnknownSizeChunk;
+
+  syscall_ = "read";
+  data_ = UncheckedMalloc(capacity);
+  if (data_ == nullptr) {
+    err_ = UV_ENOMEM;
+    return;
+  }
+
+  for (;;) {
+    if (length_ == capacity) {
+      // The size of a regular file is only known if fstat() said so.
+      if (size_ > 0)
+        break;
+      if (capacity >= Buffer::kMaxLength) {
+        err_ = UV_EFBIG;
+        return;
+      }
+      size_t new_capacity = std::min<size_t>(capacity * 2, Buffer::kMaxLength);
+      char* new_data = UncheckedRealloc(data_, new_capacity);
+      if (new_data == nullptr) {
+        err_ = UV_ENOMEM;
+        return;
+      }
+      data_ = new_data;
+      capacity = new_capacity;
+    }
+
+    uv_buf_t buf = uv_buf_init(data_ + length_,
+                               static_cast<unsigned int>(capacity - length_));
+    uv_fs_t req;
+    int bytes_read = uv_fs_read(nullptr, &req, fd, &buf, 1, -1, nullptr);
+    uv_fs_req_cleanup(&req);
+    if (bytes_read < 0) {
+      err_ = bytes_read;
+      return;
+    }
+    if (bytes_read == 0)
+      break;
+    length_ += bytes_read;
+  }
+
+  // The file may have been truncated since the fstat(), and files of unknown
+  // size rarely fill the last chunk.
+  if (length_ < capacity) {
+    if (length_ == 0) {
+      free(data_);
+      data_ = nullptr;
+    } else if (char* new_data = UncheckedRealloc(data_, length_)) {
+      data_ = new_data;
+    }
+  }
+}
+
+void ReadFileWork::DoThreadPoolWork() {
+  uv_fs_t req;
+  uv_file fd = uv_fs_open(nullptr, &req, path_.c_str(), flags_, 0666, nullptr);
+  uv_fs_req_cleanup(&req);
+  if (fd < 0) {
+    err_ = fd;
+    return;
+  }
+
+  syscall_ = "fstat";
+  err_ = uv_fs_fstat(nullptr, &req, fd, nullptr);
+  const uint64_t mode = req.statbuf.st_mode;
+  const uint64_t size = req.statbuf.st_size;
+  uv_fs_req_cleanup(&req);
+  if (err_ < 0)
+    return Close(fd);
+
+  if (!S_ISREG(mode) || size > max_size_) {
+    fd_ = fd;
+    size_ = S_ISREG(mode) ? size : 0;
+    return;
+  }
+
+  size_ = size;
+  ReadAll(fd);
+  Close(fd);
+}
+
+void ReadFileWork::AfterThreadPoolWork(int status) {
+  std::unique_ptr<ReadFileWork> self(this);
+  std::unique_ptr<FSReqBase> req_wrap(req_wrap_);
+  Environment* env = req_wrap->env();
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env->context());
+
+  CHECK_EQ(status, 0);  // The job is never cancelled.
+
+  if (err_ < 0) {
+    req_wrap->Reject(UVException(isolate,
+                                 err_,
+                                 syscall_,
+                                 nullptr,
+                                 path_.c_str(),
+                                 nullptr));
+    return;
+  }
+
+  if (fd_ >= 0) {
+    Local<Value> values[] = {
+      Integer::New(isolate, fd_),
+      Number::New(isolate, static_cast<double>(size_))
+    };
+    req_wrap->Resolve(Array::New(isolate, values, arraysize(values)));
+    return;
+  }
+
+  Local<Value> result;
+  if (encoding_ == BUFFER) {
+    Local<Object> buffer;
+    char* data = data_;
+    data_ = nullptr;
+    if (!Buffer::New(env, data, length_, true).ToLocal(&buffer))
+      return;
+    result = buffer;
+  } else {
+    Local<Value> error;
+    if (!StringBytes::Encode(isolate, data_, length_, encoding_, &error)
+            .ToLocal(&result)) {
+      CHECK(!error.IsEmpty());
+      req_wrap->Reject(error);
+      return;
+    }
+  }
+  req_wrap->Resolve(result);
+}
+
+/*
+ * Wrapper for fs.readFile(). Returns the contents of the file as a Buffer or
+ * a string, or [fd, size] if the rest of the file has to be read from JS.
+ *
+ * 0 path
+ * 1 flags
+ * 2 maxSize    number. the largest file that is read in one go
+ * 3 encoding   the encoding of the result, or undefined for a Buffer
+ * 4 req
+ */
+static void ReadFileAll(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  const int argc = args.Length();
+  CHECK_GE(argc, 5);
+
+  BufferValue path(env->isolate(), args[0]);
+  CHECK_NOT_NULL(*path);
+
+  CHECK(args[1]->IsInt32());
+  const int flags = args[1].As<Int32>()->Value();
+
+  CHECK(IsSafeJsInt(args[2]));
+  const int64_t max_size = args[2].As<Integer>()->Value();
+  CHECK_GE(max_size, 0);
+
+  const enum encoding encoding = ParseEncoding(env->isolate(), args[3], BUFFER);
+
+  FSReqBase* req_wrap = GetReqWrap(env, args[4]);
+  CHECK_NOT_NULL(req_wrap);
+  req_wrap->Init("open", *path, path.length(), UTF8);
+
+  ReadFileWork* work = new ReadFileWork(env,
+                                        req_wrap,
+                                        *path,
+                                        flags,
+                                        static_cast<uint64_t>(max_size),
+                                        encoding);
+  work->ScheduleWork();
+  req_wrap->SetReturnValue(args);
+}
+
+
 /* fs.chmod(path, mode);
  * Wrapper for chmod(1) / EIO_CHMOD
  */
@@ -2068,6 +2519,30 @@ static void Mkdtemp(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+static void GetIoUringStatistics(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  IoUring* ring = env->fs_io_uring();
+  if (ring == nullptr)
+    return;
+
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  const uint64_t* stats = ring->stats();
+  Local<Object> obj = Object::New(isolate);
+#define V(name, value)                                                        \
+  obj->Set(context,                                                           \
+           FIXED_ONE_BYTE_STRING(isolate, name),                              \
+           Number::New(isolate, static_cast<double>(value))).Check();
+  V("submitCalls", stats[IoUring::kSubmitCalls])
+  V("submitted", stats[IoUring::kSubmitted])
+  V("completed", stats[IoUring::kCompleted])
+  V("fallbacks", stats[IoUring::kFallbacks])
+  V("inFlight", ring->in_flight())
+  V("maxInFlight", stats[IoUring::kMaxInFlight])
+#undef V
+  args.GetReturnValue().Set(obj);
+}
+
 void Initialize(Local<Object> target,
                 Local<Value> unused,
                 Local<Context> context,
@@ -2080,6 +2555,8 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "open", Open);
   env->SetMethod(target, "openFileHandle", OpenFileHandle);
   env->SetMethod(target, "read", Read);
+  env->SetMethod(target, "readFileAll", ReadFileAll);
+  env->SetMethod(target, "getIoUringStatistics", GetIoUringStatistics);
   env->SetMethod(target, "fdatasync", Fdatasync);
   env->SetMethod(target, "fsync", Fsync);
   env->SetMethod(target, "rename", Rename);
@@ -2088,10 +2565,15 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "mkdir", MKDir);
   env->SetMethod(target, "readdir", ReadDir);
   env->SetMethod(target, "internalModuleReadJSON", InternalModuleReadJSON);
+  env->SetMethod(target,
+                 "internalModuleReadPackageJSON",
+                 InternalModuleReadPackageJSON);
   env->SetMethod(target, "internalModuleStat", InternalModuleStat);
+  env->SetMethod(target, "internalModuleStatMany", InternalModuleStatMany);
   env->SetMethod(target, "stat", Stat);
   env->SetMethod(target, "lstat", LStat);
   env->SetMethod(target, "fstat", FStat);
+  env->SetMethod(target, "statMany", StatMany);
   env->SetMethod(target, "link", Link);
   env->SetMethod(target, "symlink", Symlink);
   env->SetMethod(target, "readlink", ReadLink);
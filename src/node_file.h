@@ -7,6 +7,7 @@
 #include "aliased_buffer.h"
 #include "stream_base.h"
 #include "memory_tracker-inl.h"
+#include "node_io_uring.h"
 #include "req_wrap-inl.h"
 #include <iostream>
 
@@ -442,6 +443,9 @@ class FileHandle : public AsyncWrap, public StreamBase {
   bool closed_ = false;
   int64_t read_offset_ = -1;
   int64_t read_length_ = -1;
+  // Whether reaching the end of the file before read_length_ bytes have been
+  // read is an error rather than the end of the data.
+  bool read_exact_ = false;
 
   bool reading_ = false;
   std::unique_ptr<FileHandleReadWrap> current_read_ = nullptr;
@@ -515,6 +519,28 @@ inline FSReqBase* AsyncCall(Environment* env,
                        after, fn, fn_args...);
 }
 
+// Like AsyncCall(), but runs the request through the io_uring of the
+// Environment if --experimental-fs-io-uring is set. |submit| is the IoUring
+// counterpart of |fn| and takes the same arguments. Falls back to the
+// threadpool if io_uring is not available or the ring is full.
+template <typename Submit, typename Func, typename... Args>
+inline FSReqBase* AsyncUringCall(Environment* env,
+                                 FSReqBase* req_wrap,
+                                 const v8::FunctionCallbackInfo<Value>& args,
+                                 const char* syscall, enum encoding enc,
+                                 uv_fs_cb after, Submit submit,
+                                 Func fn, Args... fn_args) {
+  IoUring* ring = env->fs_io_uring();
+  if (ring != nullptr) {
+    req_wrap->Init(syscall, nullptr, 0, enc);
+    if ((ring->*submit)(req_wrap, after, fn_args...)) {
+      req_wrap->SetReturnValue(args);
+      return req_wrap;
+    }
+  }
+  return AsyncCall(env, req_wrap, args, syscall, enc, after, fn, fn_args...);
+}
+
 // Template counterpart of SYNC_CALL, except that it only puts
 // the error number and the syscall in the context instead of
 // creating an error in the C++ land.
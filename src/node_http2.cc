@@ -199,6 +199,18 @@ Http2Options::Http2Options(Environment* env, nghttp2_session_type type) {
   if (flags & (1 << IDX_OPTIONS_MAX_SESSION_MEMORY)) {
     SetMaxSessionMemory(buffer[IDX_OPTIONS_MAX_SESSION_MEMORY] * 1e6);
   }
+
+  // Many small frames, e.g. from lots of concurrent short streams, can be
+  // collected into fewer and larger writes to the socket. Writes are held
+  // back until the given number of bytes is pending, the given number of
+  // microseconds has passed or the current event loop iteration ends,
+  // whichever comes first.
+  if (flags & (1 << IDX_OPTIONS_WRITE_COALESCE_SIZE)) {
+    uint64_t delay = UINT64_MAX;
+    if (flags & (1 << IDX_OPTIONS_WRITE_COALESCE_DELAY))
+      delay = buffer[IDX_OPTIONS_WRITE_COALESCE_DELAY] * 1000ull;
+    SetWriteCoalescing(buffer[IDX_OPTIONS_WRITE_COALESCE_SIZE], delay);
+  }
 }
 
 void Http2Session::Http2Settings::Init() {
@@ -356,27 +368,31 @@ const char* Http2Session::TypeName() const {
 // containing the header name value pairs.
 Headers::Headers(Isolate* isolate,
                  Local<Context> context,
-                 Local<Array> headers) {
+                 Local<Array> headers,
+                 const Headers* extra) {
   Local<Value> header_string = headers->Get(context, 0).ToLocalChecked();
   Local<Value> header_count = headers->Get(context, 1).ToLocalChecked();
   count_ = header_count.As<Uint32>()->Value();
   int header_string_len = header_string.As<String>()->Length();
+  size_t extra_count = extra != nullptr ? extra->length() : 0;
 
   if (count_ == 0) {
     CHECK_EQ(header_string_len, 0);
-    return;
+    if (extra_count == 0)
+      return;
   }
 
-  // Allocate a single buffer with count_ nghttp2_nv structs, followed
-  // by the raw header data as passed from JS. This looks like:
+  // Allocate a single buffer with count_ + extra_count nghttp2_nv structs,
+  // followed by the raw header data as passed from JS. This looks like:
   // | possible padding | nghttp2_nv | nghttp2_nv | ... | header contents |
   buf_.AllocateSufficientStorage((alignof(nghttp2_nv) - 1) +
-                                 count_ * sizeof(nghttp2_nv) +
+                                 (count_ + extra_count) * sizeof(nghttp2_nv) +
                                  header_string_len);
   // Make sure the start address is aligned appropriately for an nghttp2_nv*.
   char* start = reinterpret_cast<char*>(
       RoundUp(reinterpret_cast<uintptr_t>(*buf_), alignof(nghttp2_nv)));
-  char* header_contents = start + (count_ * sizeof(nghttp2_nv));
+  char* header_contents =
+      start + ((count_ + extra_count) * sizeof(nghttp2_nv));
   nghttp2_nv* const nva = reinterpret_cast<nghttp2_nv*>(start);
 
   CHECK_LE(header_contents + header_string_len, *buf_ + buf_.length());
@@ -410,6 +426,35 @@ Headers::Headers(Isolate* isolate,
     nva[n].valuelen = strlen(p);
     p += nva[n].valuelen + 1;
   }
+
+  // The pseudo-headers from JS have to come first, so add the others after.
+  if (extra_count > 0) {
+    memcpy(nva + count_, **extra, extra_count * sizeof(nghttp2_nv));
+    count_ += extra_count;
+  }
+}
+
+Http2HeaderSet::Http2HeaderSet(Environment* env,
+                               Local<Object> obj,
+                               Local<Array> headers)
+    : BaseObject(env, obj),
+      headers_(env->isolate(), env->context(), headers) {
+  MakeWeak();
+}
+
+const Headers* Http2HeaderSet::HeadersFrom(Local<Value> value) {
+  if (!value->IsObject())
+    return nullptr;
+  Http2HeaderSet* header_set = Unwrap<Http2HeaderSet>(value.As<Object>());
+  CHECK_NOT_NULL(header_set);
+  return &header_set->headers_;
+}
+
+void Http2HeaderSet::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsArray());
+  new Http2HeaderSet(env, args.This(), args[0].As<Array>());
 }
 
 Origins::Origins(Isolate* isolate,
@@ -623,6 +668,9 @@ Http2Session::Http2Session(Environment* env,
 
   padding_strategy_ = opts.GetPaddingStrategy();
 
+  write_coalesce_size_ = opts.GetWriteCoalesceSize();
+  write_coalesce_delay_ = opts.GetWriteCoalesceDelay();
+
   bool hasGetPaddingCallback =
       padding_strategy_ != PADDING_STRATEGY_NONE;
 
@@ -731,6 +779,8 @@ void Http2Session::EmitStatistics() {
     buffer[IDX_SESSION_STATS_DATA_RECEIVED] = entry->data_received();
     buffer[IDX_SESSION_STATS_MAX_CONCURRENT_STREAMS] =
         entry->max_concurrent_streams();
+    buffer[IDX_SESSION_STATS_DATA_QUEUED] = entry->data_queued();
+    buffer[IDX_SESSION_STATS_WRITES] = entry->write_count();
     Local<Object> obj;
     if (entry->ToObject().ToLocal(&obj)) entry->Notify(obj);
   });
@@ -764,6 +814,16 @@ void Http2Session::Close(uint32_t code, bool socket_closed) {
 
   flags_ |= SESSION_STATE_CLOSED;
 
+  // Writes that were held back for coalescing cannot be sent anymore. They
+  // fail on the next iteration of the event loop, so that no write callbacks
+  // are called from within Close(). Until then, they keep their streams
+  // alive through HasWritesOnSocketForStream().
+  if (flags_ & SESSION_STATE_WRITE_DEFERRED) {
+    env()->SetImmediate([this](Environment* env) {
+      CancelDeferredWrites();
+    }, object());
+  }
+
   // If there are outstanding pings, those will need to be canceled, do
   // so on the next iteration of the event loop to avoid calling out into
   // javascript since this may be called during garbage collection.
@@ -848,48 +908,62 @@ ssize_t Http2Session::OnMaxFrameSizePadding(size_t frameLen,
 // out to JavaScript so this particular function is rather hot and can be
 // quite expensive. This is a potential performance optimization target later.
 ssize_t Http2Session::ConsumeHTTP2Data() {
-  CHECK_NOT_NULL(stream_buf_.base);
-  CHECK_LT(stream_buf_offset_, stream_buf_.len);
-  size_t read_len = stream_buf_.len - stream_buf_offset_;
-
-  // multiple side effects.
-  Debug(this, "receiving %d bytes [wants data? %d]",
-        read_len,
-        nghttp2_session_want_read(session_));
-  flags_ &= ~SESSION_STATE_NGHTTP2_RECV_PAUSED;
-  ssize_t ret =
-    nghttp2_session_mem_recv(session_,
-                             reinterpret_cast<uint8_t*>(stream_buf_.base) +
-                                 stream_buf_offset_,
-                             read_len);
-  CHECK_NE(ret, NGHTTP2_ERR_NOMEM);
-
-  if (flags_ & SESSION_STATE_NGHTTP2_RECV_PAUSED) {
-    CHECK_NE(flags_ & SESSION_STATE_READING_STOPPED, 0);
-
-    CHECK_GT(ret, 0);
-    CHECK_LE(static_cast<size_t>(ret), read_len);
+  ssize_t ret;
+  do {
+    if (stream_buf_.base == nullptr) {
+      // Go on with input that was queued while nghttp2 was paused.
+      CHECK(!pending_recv_bufs_.empty());
+      AllocatedBuffer buf = std::move(pending_recv_bufs_.front());
+      pending_recv_bufs_.pop();
+      pending_recv_size_ -= buf.size();
+      stream_buf_ = uv_buf_init(buf.data(), buf.size());
+      stream_buf_allocation_ = std::move(buf);
+    }
 
-    if (static_cast<size_t>(ret) < read_len) {
-      // Mark the remainder of the data as available for later consumption.
-      stream_buf_offset_ += ret;
-      return ret;
+    CHECK_LT(stream_buf_offset_, stream_buf_.len);
+    size_t read_len = stream_buf_.len - stream_buf_offset_;
+
+    // multiple side effects.
+    Debug(this, "receiving %d bytes [wants data? %d]",
+          read_len,
+          nghttp2_session_want_read(session_));
+    flags_ &= ~SESSION_STATE_NGHTTP2_RECV_PAUSED;
+    ret =
+      nghttp2_session_mem_recv(session_,
+                               reinterpret_cast<uint8_t*>(stream_buf_.base) +
+                                   stream_buf_offset_,
+                               read_len);
+    CHECK_NE(ret, NGHTTP2_ERR_NOMEM);
+
+    if (flags_ & SESSION_STATE_NGHTTP2_RECV_PAUSED) {
+      CHECK_NE(flags_ & SESSION_STATE_READING_STOPPED, 0);
+
+      CHECK_GT(ret, 0);
+      CHECK_LE(static_cast<size_t>(ret), read_len);
+
+      if (static_cast<size_t>(ret) < read_len) {
+        // Mark the remainder of the data as available for later consumption.
+        stream_buf_offset_ += ret;
+        return ret;
+      }
     }
-  }
 
-  // We are done processing the current input chunk.
-  DecrementCurrentSessionMemory(stream_buf_.len);
-  stream_buf_offset_ = 0;
-  stream_buf_ab_.Reset();
-  stream_buf_allocation_.clear();
-  stream_buf_ = uv_buf_init(nullptr, 0);
+    // We are done processing the current input chunk.
+    DecrementCurrentSessionMemory(stream_buf_.len);
+    stream_buf_offset_ = 0;
+    stream_buf_ab_.Reset();
+    stream_buf_allocation_.clear();
+    stream_buf_ = uv_buf_init(nullptr, 0);
 
-  if (ret < 0)
-    return ret;
+    if (ret < 0)
+      return ret;
+  } while (!pending_recv_bufs_.empty() &&
+           !(flags_ & SESSION_STATE_NGHTTP2_RECV_PAUSED) &&
+           !IsDestroyed());
 
   // Send any data that was queued up while processing the received data.
   if (!IsDestroyed()) {
-    SendPendingData();
+    SendPendingData(true);
   }
   return ret;
 }
@@ -1193,7 +1267,7 @@ int Http2Session::OnDataChunkReceived(nghttp2_session* handle,
     // If we have a gathered a lot of data for output, try sending it now.
     if (session->outgoing_length_ > 4096 ||
         stream->available_outbound_length_ > 4096) {
-      session->SendPendingData();
+      session->SendPendingData(true);
     }
   } while (len != 0);
 
@@ -1562,7 +1636,7 @@ void Http2Session::OnStreamAfterWrite(WriteWrap* w, int status) {
   }
 
   // If there is more incoming data queued up, consume it.
-  if (stream_buf_offset_ > 0) {
+  if (stream_buf_offset_ > 0 || !pending_recv_bufs_.empty()) {
     ConsumeHTTP2Data();
   }
 
@@ -1573,15 +1647,17 @@ void Http2Session::OnStreamAfterWrite(WriteWrap* w, int status) {
 }
 
 // If the underlying nghttp2_session struct has data pending in its outbound
-// queue, MaybeScheduleWrite will schedule a SendPendingData() call to occur
-// on the next iteration of the Node.js event loop (using the SetImmediate
-// queue), but only if a write has not already been scheduled.
+// queue, or data has been held back for coalescing, MaybeScheduleWrite will
+// schedule a SendPendingData() call to occur on the next iteration of the
+// Node.js event loop (using the SetImmediate queue), but only if a write has
+// not already been scheduled.
 void Http2Session::MaybeScheduleWrite() {
   CHECK_EQ(flags_ & SESSION_STATE_WRITE_SCHEDULED, 0);
   if (UNLIKELY(session_ == nullptr))
     return;
 
-  if (nghttp2_session_want_write(session_)) {
+  if (nghttp2_session_want_write(session_) ||
+      (flags_ & SESSION_STATE_WRITE_DEFERRED)) {
     HandleScope handle_scope(env()->isolate());
     Debug(this, "scheduling write");
     flags_ |= SESSION_STATE_WRITE_SCHEDULED;
@@ -1617,7 +1693,8 @@ void Http2Session::MaybeStopReading() {
 void Http2Session::ClearOutgoing(int status) {
   CHECK_NE(flags_ & SESSION_STATE_SENDING, 0);
 
-  flags_ &= ~SESSION_STATE_SENDING;
+  flags_ &= ~(SESSION_STATE_SENDING | SESSION_STATE_WRITE_DEFERRED);
+  write_deferred_since_ = 0;
 
   if (outgoing_buffers_.size() > 0) {
     outgoing_storage_.clear();
@@ -1652,6 +1729,22 @@ void Http2Session::ClearOutgoing(int status) {
   }
 }
 
+// Fails the writes that were held back for coalescing when the session was
+// closed.
+void Http2Session::CancelDeferredWrites() {
+  flags_ &= ~SESSION_STATE_WRITE_DEFERRED;
+  write_deferred_since_ = 0;
+  outgoing_storage_.clear();
+  outgoing_length_ = 0;
+
+  std::vector<nghttp2_stream_write> current_outgoing_buffers_;
+  current_outgoing_buffers_.swap(outgoing_buffers_);
+  for (const nghttp2_stream_write& wr : current_outgoing_buffers_) {
+    if (wr.req_wrap != nullptr)
+      wr.req_wrap->Done(UV_ECANCELED);
+  }
+}
+
 void Http2Session::PushOutgoingBuffer(nghttp2_stream_write&& write) {
   outgoing_length_ += write.buf.len;
   outgoing_buffers_.emplace_back(std::move(write));
@@ -1659,8 +1752,11 @@ void Http2Session::PushOutgoingBuffer(nghttp2_stream_write&& write) {
 
 // Queue a given block of data for sending. This always creates a copy,
 // so it is used for the cases in which nghttp2 requests sending of a
-// small chunk of data.
-void Http2Session::CopyDataIntoOutgoing(const uint8_t* src, size_t src_length) {
+// small chunk of data. |req_wrap| is completed once the data has been
+// written.
+void Http2Session::CopyDataIntoOutgoing(const uint8_t* src,
+                                        size_t src_length,
+                                        WriteWrap* req_wrap) {
   size_t offset = outgoing_storage_.size();
   outgoing_storage_.resize(offset + src_length);
   memcpy(&outgoing_storage_[offset], src, src_length);
@@ -1670,6 +1766,7 @@ void Http2Session::CopyDataIntoOutgoing(const uint8_t* src, size_t src_length) {
   // The correct base pointers will be set later, before writing to the
   // underlying socket.
   PushOutgoingBuffer(nghttp2_stream_write {
+    req_wrap,
     uv_buf_init(nullptr, src_length)
   });
 }
@@ -1679,13 +1776,14 @@ void Http2Session::CopyDataIntoOutgoing(const uint8_t* src, size_t src_length) {
 // that will generally be called at least twice be event loop iteration.
 // This is a potential performance optimization target later.
 // Returns non-zero value if a write is already in progress.
-uint8_t Http2Session::SendPendingData() {
+uint8_t Http2Session::SendPendingData(bool coalesce) {
   Debug(this, "sending pending data");
   // Do not attempt to send data on the socket if the destroying flag has
   // been set. That means everything is shutting down and the socket
   // will not be usable.
   if (IsDestroyed())
     return 0;
+  const bool write_scheduled = flags_ & SESSION_STATE_WRITE_SCHEDULED;
   flags_ &= ~SESSION_STATE_WRITE_SCHEDULED;
 
   // SendPendingData should not be called recursively.
@@ -1697,8 +1795,11 @@ uint8_t Http2Session::SendPendingData() {
   ssize_t src_length;
   const uint8_t* src;
 
-  CHECK_EQ(outgoing_buffers_.size(), 0);
-  CHECK_EQ(outgoing_storage_.size(), 0);
+  // Data that was held back for coalescing is still in here.
+  if (!(flags_ & SESSION_STATE_WRITE_DEFERRED)) {
+    CHECK_EQ(outgoing_buffers_.size(), 0);
+    CHECK_EQ(outgoing_storage_.size(), 0);
+  }
 
   // Part One: Gather data from nghttp2
 
@@ -1724,27 +1825,54 @@ uint8_t Http2Session::SendPendingData() {
     ClearOutgoing(0);
     return 0;
   }
+
+  if (coalesce && outgoing_length_ < write_coalesce_size_) {
+    uint64_t now = uv_hrtime();
+    if (write_deferred_since_ == 0)
+      write_deferred_since_ = now;
+    if (now - write_deferred_since_ < write_coalesce_delay_) {
+      Debug(this, "holding back %d bytes", outgoing_length_);
+      flags_ &= ~SESSION_STATE_SENDING;
+      flags_ |= SESSION_STATE_WRITE_DEFERRED;
+      if (write_scheduled)
+        flags_ |= SESSION_STATE_WRITE_SCHEDULED;
+      else
+        MaybeScheduleWrite();
+      return 0;
+    }
+  }
+
   MaybeStackBuffer<uv_buf_t, 32> bufs;
   bufs.AllocateSufficientStorage(count);
 
   // Set the buffer base pointers for copied data that ended up in the
   // sessions's own storage since it might have shifted around during gathering.
-  // (Those are marked by having .base == nullptr.)
+  // (Those are marked by having .base == nullptr.) Consecutive pieces of the
+  // storage are passed on as a single buffer.
   size_t offset = 0;
   size_t i = 0;
+  bool previous_in_storage = false;
   for (const nghttp2_stream_write& write : outgoing_buffers_) {
     statistics_.data_sent += write.buf.len;
     if (write.buf.base == nullptr) {
-      bufs[i++] = uv_buf_init(
-          reinterpret_cast<char*>(outgoing_storage_.data() + offset),
-          write.buf.len);
+      if (previous_in_storage) {
+        bufs[i - 1].len += write.buf.len;
+      } else {
+        bufs[i++] = uv_buf_init(
+            reinterpret_cast<char*>(outgoing_storage_.data() + offset),
+            write.buf.len);
+      }
       offset += write.buf.len;
+      previous_in_storage = true;
     } else {
       bufs[i++] = write.buf;
+      previous_in_storage = false;
     }
   }
+  count = i;
 
   chunks_sent_since_last_write_++;
+  statistics_.write_count++;
 
   CHECK_EQ(flags_ & SESSION_STATE_WRITE_IN_PROGRESS, 0);
   flags_ |= SESSION_STATE_WRITE_IN_PROGRESS;
@@ -1792,15 +1920,29 @@ int Http2Session::OnSendData(
     if (write.buf.len <= length) {
       // This write does not suffice by itself, so we can consume it completely.
       length -= write.buf.len;
-      session->PushOutgoingBuffer(std::move(write));
+      if (session->write_coalesce_size_ > 0 &&
+          write.buf.len <= MAX_COALESCED_DATA_LENGTH) {
+        session->CopyDataIntoOutgoing(
+            reinterpret_cast<const uint8_t*>(write.buf.base),
+            write.buf.len,
+            write.req_wrap);
+      } else {
+        session->PushOutgoingBuffer(std::move(write));
+      }
       stream->queue_.pop();
       continue;
     }
 
     // Slice off `length` bytes of the first write in the queue.
-    session->PushOutgoingBuffer(nghttp2_stream_write {
-      uv_buf_init(write.buf.base, length)
-    });
+    if (session->write_coalesce_size_ > 0 &&
+        length <= MAX_COALESCED_DATA_LENGTH) {
+      session->CopyDataIntoOutgoing(
+          reinterpret_cast<const uint8_t*>(write.buf.base), length);
+    } else {
+      session->PushOutgoingBuffer(nghttp2_stream_write {
+        uv_buf_init(write.buf.base, length)
+      });
+    }
     write.buf.base += length;
     write.buf.len -= length;
     break;
@@ -1857,41 +1999,31 @@ void Http2Session::OnStreamRead(ssize_t nread, const uv_buf_t& buf_) {
 
   statistics_.data_received += nread;
 
-  if (UNLIKELY(stream_buf_offset_ > 0)) {
-    // This is a very unlikely case, and should only happen if the ReadStart()
-    // call in OnStreamAfterWrite() immediately provides data. If that does
-    // happen, we concatenate the data we received with the already-stored
-    // pending input data, slicing off the already processed part.
-    AllocatedBuffer new_buf = env()->AllocateManaged(
-        stream_buf_.len - stream_buf_offset_ + nread);
-    memcpy(new_buf.data(),
-           stream_buf_.base + stream_buf_offset_,
-           stream_buf_.len - stream_buf_offset_);
-    memcpy(new_buf.data() + stream_buf_.len - stream_buf_offset_,
-           buf.data(),
-           nread);
-    buf = std::move(new_buf);
-    nread = buf.size();
-    stream_buf_offset_ = 0;
-    stream_buf_ab_.Reset();
-    DecrementCurrentSessionMemory(stream_buf_offset_);
-  }
-
   // Shrink to the actual amount of used data.
   buf.Resize(nread);
   IncrementCurrentSessionMemory(nread);
 
-  // Remember the current buffer, so that OnDataChunkReceived knows the
-  // offset of a DATA frame's data into the socket read buffer.
-  stream_buf_ = uv_buf_init(buf.data(), nread);
+  if (UNLIKELY(stream_buf_offset_ > 0 || !pending_recv_bufs_.empty())) {
+    // nghttp2 has not consumed all of the previous input yet, e.g. because
+    // the ReadStart() call in OnStreamAfterWrite() immediately provided data.
+    // Queue the data behind the pending input rather than copying both into
+    // a new buffer.
+    statistics_.data_queued += nread;
+    pending_recv_size_ += nread;
+    pending_recv_bufs_.emplace(std::move(buf));
+  } else {
+    // Remember the current buffer, so that OnDataChunkReceived knows the
+    // offset of a DATA frame's data into the socket read buffer.
+    stream_buf_ = uv_buf_init(buf.data(), nread);
+
+    // Store this so we can create an ArrayBuffer for read data from it.
+    // DATA frames will be emitted as slices of that ArrayBuffer to avoid
+    // having to copy memory.
+    stream_buf_allocation_ = std::move(buf);
+  }
 
   Isolate* isolate = env()->isolate();
 
-  // Store this so we can create an ArrayBuffer for read data from it.
-  // DATA frames will be emitted as slices of that ArrayBuffer to avoid having
-  // to copy memory.
-  stream_buf_allocation_ = std::move(buf);
-
   ssize_t ret = ConsumeHTTP2Data();
 
   if (UNLIKELY(ret < 0)) {
@@ -2358,12 +2490,17 @@ ssize_t Http2Stream::Provider::Stream::OnRead(nghttp2_session* handle,
       *flags |= NGHTTP2_DATA_FLAG_NO_COPY;
       stream->DecrementAvailableOutboundLength(amount);
     }
+    // Ask a piped source for more data before the queue runs empty.
+    if (stream->IsWritable() &&
+        stream->available_outbound_length_ < STREAM_READ_AHEAD_LENGTH) {
+      stream->EmitWantsWrite(STREAM_READ_AHEAD_LENGTH);
+    }
   }
 
   if (amount == 0 && stream->IsWritable()) {
     CHECK(stream->queue_.empty());
     Debug(session, "deferring stream %d", id);
-    stream->EmitWantsWrite(length);
+    stream->EmitWantsWrite(std::max<size_t>(length, STREAM_READ_AHEAD_LENGTH));
     if (stream->available_outbound_length_ > 0 || !stream->IsWritable()) {
       // EmitWantsWrite() did something interesting synchronously, restart:
       return OnRead(handle, id, buf, length, flags, source, user_data);
@@ -2541,7 +2678,8 @@ void Http2Session::Request(const FunctionCallbackInfo<Value>& args) {
   int options = args[1]->IntegerValue(context).ToChecked();
   Http2Priority priority(env, args[2], args[3], args[4]);
 
-  Headers list(isolate, context, headers);
+  Headers list(isolate, context, headers,
+               Http2HeaderSet::HeadersFrom(args[5]));
 
   Debug(session, "request submitted");
 
@@ -2641,7 +2779,8 @@ void Http2Stream::Respond(const FunctionCallbackInfo<Value>& args) {
   Local<Array> headers = args[0].As<Array>();
   int options = args[1]->IntegerValue(context).ToChecked();
 
-  Headers list(isolate, context, headers);
+  Headers list(isolate, context, headers,
+               Http2HeaderSet::HeadersFrom(args[2]));
 
   args.GetReturnValue().Set(
       stream->SubmitResponse(*list, list.length(), options));
@@ -3080,6 +3219,16 @@ void Initialize(Local<Object> target,
   settingt->SetInternalFieldCount(1);
   env->set_http2settings_constructor_template(settingt);
 
+  Local<String> header_set_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "Http2HeaderSet");
+  Local<FunctionTemplate> header_set =
+      env->NewFunctionTemplate(Http2HeaderSet::New);
+  header_set->SetClassName(header_set_string);
+  header_set->InstanceTemplate()->SetInternalFieldCount(1);
+  target->Set(context,
+              header_set_string,
+              header_set->GetFunction(env->context()).ToLocalChecked()).Check();
+
   Local<FunctionTemplate> stream = FunctionTemplate::New(env->isolate());
   stream->SetClassName(FIXED_ONE_BYTE_STRING(env->isolate(), "Http2Stream"));
   env->SetProtoMethod(stream, "id", Http2Stream::GetID);
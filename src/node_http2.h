@@ -37,6 +37,20 @@ using performance::PerformanceEntry;
 // Default maximum total memory cap for Http2Session.
 #define DEFAULT_MAX_SESSION_MEMORY 1e7
 
+// When write coalescing is enabled, DATA frame payloads of up to this many
+// bytes are copied next to the frame headers instead of being written from
+// the stream's own buffers, so that they take up no extra uv_buf_t.
+#define MAX_COALESCED_DATA_LENGTH 1024
+
+// When a Http2Stream is piped from another StreamBase, such as a FileHandle,
+// it asks for more data once less than this many bytes are queued, so that
+// reading the next chunk overlaps with sending the current one.
+// File data is still copied into userspace on its way to the socket. Sending
+// it with sendfile() would need the threadpool to write to the socket after
+// pending StreamBase writes are flushed, and to account for those bytes in
+// bytesWritten and flow control, which is not implemented.
+#define STREAM_READ_AHEAD_LENGTH 65536
+
 // These are the standard HTTP/2 defaults as specified by the RFC
 #define DEFAULT_SETTINGS_HEADER_TABLE_SIZE 4096
 #define DEFAULT_SETTINGS_ENABLE_PUSH 1
@@ -336,7 +350,8 @@ enum session_state_flags {
   SESSION_STATE_SENDING = 0x10,
   SESSION_STATE_WRITE_IN_PROGRESS = 0x20,
   SESSION_STATE_READING_STOPPED = 0x40,
-  SESSION_STATE_NGHTTP2_RECV_PAUSED = 0x80
+  SESSION_STATE_NGHTTP2_RECV_PAUSED = 0x80,
+  SESSION_STATE_WRITE_DEFERRED = 0x100
 };
 
 typedef uint32_t(*get_setting)(nghttp2_session* session,
@@ -415,6 +430,19 @@ class Http2Options {
     return max_session_memory_;
   }
 
+  void SetWriteCoalescing(size_t size, uint64_t delay) {
+    write_coalesce_size_ = size;
+    write_coalesce_delay_ = delay;
+  }
+
+  size_t GetWriteCoalesceSize() const {
+    return write_coalesce_size_;
+  }
+
+  uint64_t GetWriteCoalesceDelay() const {
+    return write_coalesce_delay_;
+  }
+
  private:
   nghttp2_option* options_;
   uint64_t max_session_memory_ = DEFAULT_MAX_SESSION_MEMORY;
@@ -422,6 +450,8 @@ class Http2Options {
   padding_strategy_type padding_strategy_ = PADDING_STRATEGY_NONE;
   size_t max_outstanding_pings_ = DEFAULT_MAX_PINGS;
   size_t max_outstanding_settings_ = DEFAULT_MAX_SETTINGS;
+  size_t write_coalesce_size_ = 0;
+  uint64_t write_coalesce_delay_ = UINT64_MAX;
 };
 
 class Http2Priority {
@@ -720,7 +750,10 @@ class Http2Session : public AsyncWrap, public StreamListener {
               size_t value_len);
   void Origin(nghttp2_origin_entry* ov, size_t count);
 
-  uint8_t SendPendingData();
+  // If |coalesce| is true and less than write_coalesce_size_ bytes are
+  // pending, the data is only gathered and the write is left to a later
+  // call, at the latest the one scheduled for this event loop iteration.
+  uint8_t SendPendingData(bool coalesce = false);
 
   // Submits a new request. If the request is a success, assigned
   // will be a pointer to the Http2Stream instance assigned.
@@ -766,7 +799,8 @@ class Http2Session : public AsyncWrap, public StreamListener {
   // Indicates whether there currently exist outgoing buffers for this stream.
   bool HasWritesOnSocketForStream(Http2Stream* stream);
 
-  // Write data from stream_buf_ to the session
+  // Write data from stream_buf_, and then from pending_recv_bufs_, to the
+  // session
   ssize_t ConsumeHTTP2Data();
 
   void MemoryInfo(MemoryTracker* tracker) const override {
@@ -775,6 +809,7 @@ class Http2Session : public AsyncWrap, public StreamListener {
     tracker->TrackField("outstanding_settings", outstanding_settings_);
     tracker->TrackField("outgoing_buffers", outgoing_buffers_);
     tracker->TrackFieldWithSize("stream_buf", stream_buf_.len);
+    tracker->TrackFieldWithSize("pending_recv_bufs", pending_recv_size_);
     tracker->TrackFieldWithSize("outgoing_storage", outgoing_storage_.size());
     tracker->TrackFieldWithSize("pending_rst_streams",
                                 pending_rst_streams_.size() * sizeof(int32_t));
@@ -861,8 +896,10 @@ class Http2Session : public AsyncWrap, public StreamListener {
     uint64_t ping_rtt;
     uint64_t data_sent;
     uint64_t data_received;
+    uint64_t data_queued;
     uint32_t frame_count;
     uint32_t frame_sent;
+    uint32_t write_count;
     int32_t stream_count;
     size_t max_concurrent_streams;
     double stream_average_duration;
@@ -999,6 +1036,11 @@ class Http2Session : public AsyncWrap, public StreamListener {
   v8::Global<v8::ArrayBuffer> stream_buf_ab_;
   AllocatedBuffer stream_buf_allocation_;
   size_t stream_buf_offset_ = 0;
+  // Input that was read while nghttp2 had not consumed all of stream_buf_.
+  // nghttp2 can continue parsing at any byte, so these become stream_buf_ in
+  // turn rather than being joined with it.
+  std::queue<AllocatedBuffer> pending_recv_bufs_;
+  size_t pending_recv_size_ = 0;
 
   size_t max_outstanding_pings_ = DEFAULT_MAX_PINGS;
   std::queue<std::unique_ptr<Http2Ping>> outstanding_pings_;
@@ -1009,6 +1051,11 @@ class Http2Session : public AsyncWrap, public StreamListener {
   std::vector<nghttp2_stream_write> outgoing_buffers_;
   std::vector<uint8_t> outgoing_storage_;
   size_t outgoing_length_ = 0;
+  // Write coalescing policy, see SendPendingData(). The delay is in
+  // nanoseconds and counts from the first write that was held back.
+  size_t write_coalesce_size_ = 0;
+  uint64_t write_coalesce_delay_ = UINT64_MAX;
+  uint64_t write_deferred_since_ = 0;
   std::vector<int32_t> pending_rst_streams_;
   // Count streams that have been rejected while being opened. Exceeding a fixed
   // limit will result in the session being destroyed, as an indication of a
@@ -1019,8 +1066,11 @@ class Http2Session : public AsyncWrap, public StreamListener {
   int32_t invalid_frame_count_ = 0;
 
   void PushOutgoingBuffer(nghttp2_stream_write&& write);
-  void CopyDataIntoOutgoing(const uint8_t* src, size_t src_length);
+  void CopyDataIntoOutgoing(const uint8_t* src,
+                            size_t src_length,
+                            WriteWrap* req_wrap = nullptr);
   void ClearOutgoing(int status);
+  void CancelDeferredWrites();
 
   friend class Http2Scope;
   friend class Http2StreamListener;
@@ -1038,8 +1088,10 @@ class Http2SessionPerformanceEntry : public PerformanceEntry {
           ping_rtt_(stats.ping_rtt),
           data_sent_(stats.data_sent),
           data_received_(stats.data_received),
+          data_queued_(stats.data_queued),
           frame_count_(stats.frame_count),
           frame_sent_(stats.frame_sent),
+          write_count_(stats.write_count),
           stream_count_(stats.stream_count),
           max_concurrent_streams_(stats.max_concurrent_streams),
           stream_average_duration_(stats.stream_average_duration),
@@ -1048,8 +1100,10 @@ class Http2SessionPerformanceEntry : public PerformanceEntry {
   uint64_t ping_rtt() const { return ping_rtt_; }
   uint64_t data_sent() const { return data_sent_; }
   uint64_t data_received() const { return data_received_; }
+  uint64_t data_queued() const { return data_queued_; }
   uint32_t frame_count() const { return frame_count_; }
   uint32_t frame_sent() const { return frame_sent_; }
+  uint32_t write_count() const { return write_count_; }
   int32_t stream_count() const { return stream_count_; }
   size_t max_concurrent_streams() const { return max_concurrent_streams_; }
   double stream_average_duration() const { return stream_average_duration_; }
@@ -1063,8 +1117,10 @@ class Http2SessionPerformanceEntry : public PerformanceEntry {
   uint64_t ping_rtt_;
   uint64_t data_sent_;
   uint64_t data_received_;
+  uint64_t data_queued_;
   uint32_t frame_count_;
   uint32_t frame_sent_;
+  uint32_t write_count_;
   int32_t stream_count_;
   size_t max_concurrent_streams_;
   double stream_average_duration_;
@@ -1240,13 +1296,23 @@ class ExternalHeader :
 
 class Headers {
  public:
-  Headers(Isolate* isolate, Local<Context> context, Local<Array> headers);
+  // The headers from |extra|, if any, are appended to the ones from
+  // |headers|. Only the nghttp2_nv structs are copied, so |extra| has to
+  // outlive this object.
+  Headers(Isolate* isolate,
+          Local<Context> context,
+          Local<Array> headers,
+          const Headers* extra = nullptr);
   ~Headers() = default;
 
   nghttp2_nv* operator*() {
     return reinterpret_cast<nghttp2_nv*>(*buf_);
   }
 
+  const nghttp2_nv* operator*() const {
+    return reinterpret_cast<const nghttp2_nv*>(*buf_);
+  }
+
   size_t length() const {
     return count_;
   }
@@ -1256,6 +1322,28 @@ class Headers {
   MaybeStackBuffer<char, 3000> buf_;
 };
 
+// A list of headers that is converted from JS once and can then be sent with
+// any number of requests and responses, see http2.createHeaderSet().
+class Http2HeaderSet : public BaseObject {
+ public:
+  Http2HeaderSet(Environment* env,
+                 Local<Object> obj,
+                 Local<Array> headers);
+
+  // Returns the headers of the Http2HeaderSet |value|, or nullptr if |value|
+  // is not an object, e.g. undefined.
+  static const Headers* HeadersFrom(Local<Value> value);
+
+  static void New(const FunctionCallbackInfo<Value>& args);
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(Http2HeaderSet)
+  SET_SELF_SIZE(Http2HeaderSet)
+
+ private:
+  Headers headers_;
+};
+
 class Origins {
  public:
   Origins(Isolate* isolate,
@@ -52,6 +52,8 @@ namespace http2 {
     IDX_OPTIONS_MAX_OUTSTANDING_PINGS,
     IDX_OPTIONS_MAX_OUTSTANDING_SETTINGS,
     IDX_OPTIONS_MAX_SESSION_MEMORY,
+    IDX_OPTIONS_WRITE_COALESCE_SIZE,
+    IDX_OPTIONS_WRITE_COALESCE_DELAY,
     IDX_OPTIONS_FLAGS
   };
 
@@ -75,6 +77,8 @@ namespace http2 {
     IDX_SESSION_STATS_DATA_SENT,
     IDX_SESSION_STATS_DATA_RECEIVED,
     IDX_SESSION_STATS_MAX_CONCURRENT_STREAMS,
+    IDX_SESSION_STATS_DATA_QUEUED,
+    IDX_SESSION_STATS_WRITES,
     IDX_SESSION_STATS_COUNT
   };
 
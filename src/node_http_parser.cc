@@ -32,6 +32,8 @@
 
 #include <cstdlib>  // free()
 #include <cstring>  // strdup(), strchr()
+#include <string>
+#include <vector>
 
 
 // This is a binding to llhttp (https://github.com/nodejs/llhttp)
@@ -50,6 +52,7 @@ namespace node {
 namespace {  // NOLINT(build/namespaces)
 
 using v8::Array;
+using v8::ArrayBuffer;
 using v8::Boolean;
 using v8::Context;
 using v8::EscapableHandleScope;
@@ -60,11 +63,13 @@ using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Int32;
 using v8::Integer;
+using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
 using v8::Object;
 using v8::String;
 using v8::Uint32;
+using v8::Uint32Array;
 using v8::Undefined;
 using v8::Value;
 
@@ -76,6 +81,153 @@ const uint32_t kOnExecute = 4;
 // Any more fields than this will be flushed into JS
 const size_t kMaxHeaderFieldsCount = 32;
 
+// Header names that are common enough to be kept as internalized strings, in
+// their usual and in their lowercase spelling. Header fields spelled either
+// way do not allocate a new string for every message, and comparing them to
+// the string constants in lib/_http_incoming.js is a pointer comparison.
+#define HTTP_KNOWN_HEADER_NAMES(V)                                            \
+  V("Accept", "accept")                                                       \
+  V("Accept-Charset", "accept-charset")                                       \
+  V("Accept-Encoding", "accept-encoding")                                     \
+  V("Accept-Language", "accept-language")                                     \
+  V("Accept-Ranges", "accept-ranges")                                         \
+  V("Access-Control-Request-Headers", "access-control-request-headers")       \
+  V("Access-Control-Request-Method", "access-control-request-method")         \
+  V("Age", "age")                                                             \
+  V("Authorization", "authorization")                                         \
+  V("Cache-Control", "cache-control")                                         \
+  V("Connection", "connection")                                               \
+  V("Content-Disposition", "content-disposition")                             \
+  V("Content-Encoding", "content-encoding")                                   \
+  V("Content-Language", "content-language")                                   \
+  V("Content-Length", "content-length")                                       \
+  V("Content-Location", "content-location")                                   \
+  V("Content-Range", "content-range")                                         \
+  V("Content-Type", "content-type")                                           \
+  V("Cookie", "cookie")                                                       \
+  V("Date", "date")                                                           \
+  V("DNT", "dnt")                                                             \
+  V("ETag", "etag")                                                           \
+  V("Expect", "expect")                                                       \
+  V("Expires", "expires")                                                     \
+  V("Forwarded", "forwarded")                                                 \
+  V("From", "from")                                                           \
+  V("Host", "host")                                                           \
+  V("If-Match", "if-match")                                                   \
+  V("If-Modified-Since", "if-modified-since")                                 \
+  V("If-None-Match", "if-none-match")                                         \
+  V("If-Range", "if-range")                                                   \
+  V("If-Unmodified-Since", "if-unmodified-since")                             \
+  V("Keep-Alive", "keep-alive")                                               \
+  V("Last-Modified", "last-modified")                                         \
+  V("Location", "location")                                                   \
+  V("Max-Forwards", "max-forwards")                                           \
+  V("Origin", "origin")                                                       \
+  V("Pragma", "pragma")                                                       \
+  V("Proxy-Authorization", "proxy-authorization")                             \
+  V("Range", "range")                                                         \
+  V("Referer", "referer")                                                     \
+  V("Retry-After", "retry-after")                                             \
+  V("Sec-Fetch-Dest", "sec-fetch-dest")                                       \
+  V("Sec-Fetch-Mode", "sec-fetch-mode")                                       \
+  V("Sec-Fetch-Site", "sec-fetch-site")                                       \
+  V("Sec-Fetch-User", "sec-fetch-user")                                       \
+  V("Server", "server")                                                       \
+  V("Set-Cookie", "set-cookie")                                               \
+  V("TE", "te")                                                               \
+  V("Transfer-Encoding", "transfer-encoding")                                 \
+  V("Upgrade", "upgrade")                                                     \
+  V("Upgrade-Insecure-Requests", "upgrade-insecure-requests")                 \
+  V("User-Agent", "user-agent")                                               \
+  V("Vary", "vary")                                                           \
+  V("Via", "via")                                                             \
+  V("Warning", "warning")                                                     \
+  V("WWW-Authenticate", "www-authenticate")                                   \
+  V("X-Forwarded-For", "x-forwarded-for")                                     \
+  V("X-Forwarded-Host", "x-forwarded-host")                                   \
+  V("X-Forwarded-Proto", "x-forwarded-proto")                                 \
+  V("X-Real-IP", "x-real-ip")                                                 \
+  V("X-Request-ID", "x-request-id")                                           \
+  V("X-Requested-With", "x-requested-with")
+
+struct KnownHeaderName {
+  const char* name;
+  const char* lowercase;
+  size_t length;
+};
+
+const KnownHeaderName kKnownHeaderNames[] = {
+#define V(name, lowercase) { name, lowercase, sizeof(name) - 1 },
+  HTTP_KNOWN_HEADER_NAMES(V)
+#undef V
+};
+
+constexpr size_t kKnownHeaderNameCount = arraysize(kKnownHeaderNames);
+constexpr size_t kMaxKnownHeaderNameLength = 32;
+
+// Indices into kKnownHeaderNames, grouped by name length.
+class KnownHeaderNameIndex {
+ public:
+  KnownHeaderNameIndex() {
+    for (size_t i = 0; i < kKnownHeaderNameCount; i++)
+      CHECK_LE(kKnownHeaderNames[i].length, kMaxKnownHeaderNameLength);
+    size_t next = 0;
+    for (size_t length = 0; length <= kMaxKnownHeaderNameLength; length++) {
+      first_[length] = next;
+      for (size_t i = 0; i < kKnownHeaderNameCount; i++) {
+        if (kKnownHeaderNames[i].length == length)
+          entries_[next++] = i;
+      }
+    }
+    first_[kMaxKnownHeaderNameLength + 1] = next;
+  }
+
+  // Returns the index of the string for |str| in the list of known names,
+  // which has the usual spelling of name i at 2 * i and its lowercase
+  // spelling at 2 * i + 1, or -1 if |str| is spelled differently.
+  int Find(const char* str, size_t length) const {
+    if (length > kMaxKnownHeaderNameLength)
+      return -1;
+    for (size_t j = first_[length]; j < first_[length + 1]; j++) {
+      const KnownHeaderName& known = kKnownHeaderNames[entries_[j]];
+      if (memcmp(str, known.name, length) == 0)
+        return 2 * entries_[j];
+      if (memcmp(str, known.lowercase, length) == 0)
+        return 2 * entries_[j] + 1;
+    }
+    return -1;
+  }
+
+ private:
+  size_t first_[kMaxKnownHeaderNameLength + 2];
+  size_t entries_[kKnownHeaderNameCount];
+};
+
+int FindKnownHeaderName(const char* str, size_t length) {
+  static const KnownHeaderNameIndex index;
+  return index.Find(str, length);
+}
+
+Local<String> GetKnownHeaderName(Environment* env, int index) {
+  std::vector<v8::Eternal<String>>& strings =
+      env->isolate_data()->http_known_header_names;
+  if (strings.empty())
+    strings.resize(2 * kKnownHeaderNameCount);
+  v8::Eternal<String>& eternal = strings[index];
+  if (eternal.IsEmpty()) {
+    const KnownHeaderName& known = kKnownHeaderNames[index / 2];
+    const char* name = index % 2 == 0 ? known.name : known.lowercase;
+    Local<String> str =
+        String::NewFromOneByte(env->isolate(),
+                               reinterpret_cast<const uint8_t*>(name),
+                               v8::NewStringType::kInternalized,
+                               known.length).ToLocalChecked();
+    eternal.Set(env->isolate(), str);
+    return str;
+  }
+  return eternal.Get(env->isolate());
+}
+
 // helper class for the Parser
 struct StringPtr {
   StringPtr() {
@@ -141,6 +293,14 @@ struct StringPtr {
       return String::Empty(env->isolate());
   }
 
+  // Like ToString(), but returns a shared string for well-known header names.
+  Local<String> ToHeaderName(Environment* env) const {
+    int index = FindKnownHeaderName(str_, size_);
+    if (index >= 0)
+      return GetKnownHeaderName(env, index);
+    return ToString(env);
+  }
+
 
   const char* str_;
   bool on_heap_;
@@ -165,6 +325,8 @@ class Parser : public AsyncWrap, public StreamListener {
 
   int on_message_begin() {
     num_fields_ = num_values_ = 0;
+    header_block_.clear();
+    header_offsets_.clear();
     url_.Reset();
     status_message_.Reset();
     return 0;
@@ -199,6 +361,15 @@ class Parser : public AsyncWrap, public StreamListener {
       return rv;
     }
 
+    if (batch_headers_) {
+      if (num_fields_ == num_values_) {
+        num_fields_++;
+        header_offsets_.push_back(header_block_.size());
+      }
+      header_block_.append(at, length);
+      return 0;
+    }
+
     if (num_fields_ == num_values_) {
       // start of new field name
       num_fields_++;
@@ -226,6 +397,15 @@ class Parser : public AsyncWrap, public StreamListener {
       return rv;
     }
 
+    if (batch_headers_) {
+      if (num_values_ != num_fields_) {
+        num_values_++;
+        header_offsets_.push_back(header_block_.size());
+      }
+      header_block_.append(at, length);
+      return 0;
+    }
+
     if (num_values_ != num_fields_) {
       // start of new header value
       num_values_++;
@@ -257,6 +437,7 @@ class Parser : public AsyncWrap, public StreamListener {
       A_STATUS_MESSAGE,
       A_UPGRADE,
       A_SHOULD_KEEP_ALIVE,
+      A_HEADER_OFFSETS,
       A_MAX
     };
 
@@ -272,7 +453,12 @@ class Parser : public AsyncWrap, public StreamListener {
     for (size_t i = 0; i < arraysize(argv); i++)
       argv[i] = undefined;
 
-    if (have_flushed_) {
+    if (batch_headers_) {
+      // All headers are passed at once, no matter how many there are.
+      argv[A_HEADERS] = CreateHeaderBlock(&argv[A_HEADER_OFFSETS]);
+      if (parser_.type == HTTP_REQUEST)
+        argv[A_URL] = url_.ToString(env());
+    } else if (have_flushed_) {
       // Slow case, flush remaining headers.
       Flush();
     } else {
@@ -284,6 +470,8 @@ class Parser : public AsyncWrap, public StreamListener {
 
     num_fields_ = 0;
     num_values_ = 0;
+    header_block_.clear();
+    header_offsets_.clear();
 
     // METHOD
     if (parser_.type == HTTP_REQUEST) {
@@ -477,11 +665,13 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+  // parser.initialize(type, resource[, batchHeaders])
   static void Initialize(const FunctionCallbackInfo<Value>& args) {
     Environment* env = Environment::GetCurrent(args);
 
     CHECK(args[0]->IsInt32());
     CHECK(args[1]->IsObject());
+    bool batch_headers = args[2]->IsTrue();
 
     llhttp_type_t type =
         static_cast<llhttp_type_t>(args[0].As<Int32>()->Value());
@@ -499,7 +689,7 @@ class Parser : public AsyncWrap, public StreamListener {
 
     parser->set_provider_type(provider);
     parser->AsyncReset(args[1].As<Object>());
-    parser->Init(type);
+    parser->Init(type, batch_headers);
   }
 
   template <bool should_pause>
@@ -711,7 +901,7 @@ class Parser : public AsyncWrap, public StreamListener {
     Local<Value> headers_v[kMaxHeaderFieldsCount * 2];
 
     for (size_t i = 0; i < num_values_; ++i) {
-      headers_v[i * 2] = fields_[i].ToString(env());
+      headers_v[i * 2] = fields_[i].ToHeaderName(env());
       headers_v[i * 2 + 1] = values_[i].ToString(env());
     }
 
@@ -719,6 +909,32 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+  // Returns a Buffer with all header fields and values back to back. String
+  // i of the alternating field/value list is in the range
+  // [offsets[i], offsets[i + 1]); the offsets are stored in |*offsets|.
+  Local<Value> CreateHeaderBlock(Local<Value>* offsets) {
+    Isolate* isolate = env()->isolate();
+    size_t count = num_values_ * 2;
+    // Leave out a field without a value, which can be left over if the
+    // message ended early.
+    uint32_t end = header_offsets_.size() > count ? header_offsets_[count] :
+                                                    header_block_.size();
+    header_offsets_.resize(count);
+    header_offsets_.push_back(end);
+
+    Local<ArrayBuffer> ab =
+        ArrayBuffer::New(isolate, header_offsets_.size() * sizeof(uint32_t));
+    memcpy(ab->GetContents().Data(),
+           header_offsets_.data(),
+           header_offsets_.size() * sizeof(uint32_t));
+    *offsets = Uint32Array::New(ab, 0, header_offsets_.size());
+
+    return Buffer::Copy(env(),
+                        header_block_.data(),
+                        header_offsets_.back()).ToLocalChecked();
+  }
+
+
   // spill headers and request path to JS land
   void Flush() {
     HandleScope scope(env()->isolate());
@@ -729,10 +945,16 @@ class Parser : public AsyncWrap, public StreamListener {
     if (!cb->IsFunction())
       return;
 
-    Local<Value> argv[2] = {
-      CreateHeaders(),
-      url_.ToString(env())
-    };
+    Local<Value> argv[3];
+    if (batch_headers_) {
+      argv[0] = CreateHeaderBlock(&argv[2]);
+      header_block_.clear();
+      header_offsets_.clear();
+    } else {
+      argv[0] = CreateHeaders();
+      argv[2] = Undefined(env()->isolate());
+    }
+    argv[1] = url_.ToString(env());
 
     MaybeLocal<Value> r = MakeCallback(cb.As<Function>(),
                                        arraysize(argv),
@@ -746,8 +968,11 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
-  void Init(llhttp_type_t type) {
+  void Init(llhttp_type_t type, bool batch_headers) {
     llhttp_init(&parser_, type, &settings);
+    batch_headers_ = batch_headers;
+    header_block_.clear();
+    header_offsets_.clear();
     header_nread_ = 0;
     url_.Reset();
     status_message_.Reset();
@@ -787,6 +1012,11 @@ class Parser : public AsyncWrap, public StreamListener {
   StringPtr status_message_;
   size_t num_fields_;
   size_t num_values_;
+  // In batch mode, header fields and values are collected in |header_block_|
+  // instead of |fields_| and |values_|, and passed to JS in one go.
+  bool batch_headers_ = false;
+  std::string header_block_;
+  std::vector<uint32_t> header_offsets_;
   bool have_flushed_;
   bool got_exception_;
   Local<Object> current_buffer_;
@@ -865,6 +1095,18 @@ void InitializeHttpParser(Local<Object> target,
               FIXED_ONE_BYTE_STRING(env->isolate(), "methods"),
               methods).Check();
 
+  // The strings that the parser uses for well-known header names, so that
+  // header blocks passed in batch mode can be turned into the same strings.
+  Local<Array> known_header_names = Array::New(env->isolate());
+  for (size_t i = 0; i < 2 * kKnownHeaderNameCount; i++) {
+    known_header_names->Set(env->context(),
+                            i,
+                            GetKnownHeaderName(env, i)).Check();
+  }
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(env->isolate(), "knownHeaderNames"),
+              known_header_names).Check();
+
   t->Inherit(AsyncWrap::GetConstructorTemplate(env));
   env->SetProtoMethod(t, "close", Parser::Close);
   env->SetProtoMethod(t, "free", Parser::Free);
@@ -49,6 +49,8 @@
 #include "node_buffer.h"
 #include "node_errors.h"
 #include "node_internals.h"
+#include "string_bytes.h"
+#include "string_simd.h"
 #include "util-inl.h"
 #include "v8.h"
 
@@ -209,11 +211,7 @@ class ConverterObject : public BaseObject, Converter {
     int flags = args[2]->Uint32Value(env->context()).ToChecked();
 
     UErrorCode status = U_ZERO_ERROR;
-    MaybeStackBuffer<UChar> result;
     MaybeLocal<Object> ret;
-    size_t limit = ucnv_getMinCharSize(converter->conv) * input.length();
-    if (limit > 0)
-      result.AllocateSufficientStorage(limit);
 
     UBool flush = (flags & CONVERTER_FLAGS_FLUSH) == CONVERTER_FLAGS_FLUSH;
     OnScopeLeave cleanup([&]() {
@@ -235,6 +233,28 @@ class ConverterObject : public BaseObject, Converter {
       converter->bomSeen_ = true;
     }
 
+    // Complete, valid UTF-8 does not need ICU, unless the converter still
+    // holds the start of a character from a previous call.
+    UErrorCode pending_status = U_ZERO_ERROR;
+    if (converter->utf8_ && U_SUCCESS(status) &&
+        ucnv_toUCountPending(converter->conv, &pending_status) == 0 &&
+        simd::ValidateUtf8(source, source_length)) {
+      Local<Value> error;
+      Local<Value> str;
+      if (!StringBytes::Encode(env->isolate(), source, source_length, UTF8,
+                               &error).ToLocal(&str)) {
+        env->isolate()->ThrowException(error);
+        return;
+      }
+      args.GetReturnValue().Set(str);
+      return;
+    }
+
+    MaybeStackBuffer<UChar> result;
+    size_t limit = ucnv_getMinCharSize(converter->conv) * input.length();
+    if (limit > 0)
+      result.AllocateSufficientStorage(limit);
+
     UChar* target = *result;
     ucnv_toUnicode(converter->conv,
                    &target, target + (limit * sizeof(UChar)),
@@ -269,6 +289,9 @@ class ConverterObject : public BaseObject, Converter {
 
     switch (ucnv_getType(converter)) {
       case UCNV_UTF8:
+        utf8_ = true;
+        unicode_ = true;
+        break;
       case UCNV_UTF16_BigEndian:
       case UCNV_UTF16_LittleEndian:
         unicode_ = true;
@@ -280,6 +303,7 @@ class ConverterObject : public BaseObject, Converter {
 
  private:
   bool unicode_ = false;     // True if this is a Unicode converter
+  bool utf8_ = false;        // True if this is the UTF-8 converter
   bool ignoreBOM_ = false;   // True if the BOM should be ignored on Unicode
   bool bomSeen_ = false;     // True if the BOM has been seen
 };
@@ -0,0 +1,624 @@
+#include "node_io_uring.h"
+#include "env-inl.h"
+#include "memory_tracker-inl.h"
+#include "node_file.h"
+#include "util-inl.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <string>
+#include <vector>
+
+namespace node {
+namespace fs {
+
+#ifdef __linux__
+
+namespace {
+
+// The parts of the io_uring kernel ABI that are used here, as defined in
+// <linux/io_uring.h>. They are spelled out so that building does not depend
+// on the version of the installed kernel headers. The system call numbers
+// are the same on all architectures.
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+
+constexpr uint8_t kOpReadv = 1;
+constexpr uint8_t kOpWritev = 2;
+constexpr uint8_t kOpFsync = 3;
+constexpr uint8_t kOpOpenat = 18;
+constexpr uint8_t kOpClose = 19;
+constexpr uint8_t kOpStatx = 21;
+
+constexpr uint32_t kFsyncDatasync = 1;
+constexpr uint64_t kOffSqRing = 0;
+constexpr uint64_t kOffSqes = 0x10000000;
+constexpr uint32_t kRegisterProbe = 8;
+constexpr uint16_t kOpSupported = 1;
+
+constexpr uint32_t kFeatSingleMmap = 1 << 0;
+constexpr uint32_t kFeatNoDrop = 1 << 1;
+constexpr uint32_t kFeatRwCurPos = 1 << 3;
+
+// The same as libuv uses for uv_fs_stat() with statx().
+constexpr uint32_t kStatxMask = 0xfff;  // STATX_BASIC_STATS | STATX_BTIME
+constexpr int kAtEmptyPath = 0x1000;
+
+// The completion queue is twice as large, which limits the number of
+// requests in flight to 512.
+constexpr unsigned int kEntries = 256;
+
+struct SqringOffsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t flags;
+  uint32_t dropped;
+  uint32_t array;
+  uint32_t reserved0;
+  uint64_t reserved1;
+};
+
+struct CqringOffsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t overflow;
+  uint32_t cqes;
+  uint32_t flags;
+  uint32_t reserved0;
+  uint64_t reserved1;
+};
+
+struct Params {
+  uint32_t sq_entries;
+  uint32_t cq_entries;
+  uint32_t flags;
+  uint32_t sq_thread_cpu;
+  uint32_t sq_thread_idle;
+  uint32_t features;
+  uint32_t wq_fd;
+  uint32_t reserved[3];
+  SqringOffsets sq_off;
+  CqringOffsets cq_off;
+};
+
+struct Sqe {
+  uint8_t opcode;
+  uint8_t flags;
+  uint16_t ioprio;
+  int32_t fd;
+  uint64_t off;  // Also the statx buffer.
+  uint64_t addr;
+  uint32_t len;
+  uint32_t op_flags;  // rw_flags, fsync_flags, open_flags or statx_flags.
+  uint64_t user_data;
+  uint64_t pad[3];
+};
+
+struct Cqe {
+  uint64_t user_data;
+  int32_t res;
+  uint32_t flags;
+};
+
+struct ProbeOp {
+  uint8_t op;
+  uint8_t reserved0;
+  uint16_t flags;
+  uint32_t reserved1;
+};
+
+struct Probe {
+  uint8_t last_op;
+  uint8_t ops_len;
+  uint16_t reserved0;
+  uint32_t reserved1[3];
+  ProbeOp ops[256];
+};
+
+struct StatxTimestamp {
+  int64_t tv_sec;
+  uint32_t tv_nsec;
+  int32_t reserved;
+};
+
+struct Statx {
+  uint32_t stx_mask;
+  uint32_t stx_blksize;
+  uint64_t stx_attributes;
+  uint32_t stx_nlink;
+  uint32_t stx_uid;
+  uint32_t stx_gid;
+  uint16_t stx_mode;
+  uint16_t reserved0;
+  uint64_t stx_ino;
+  uint64_t stx_size;
+  uint64_t stx_blocks;
+  uint64_t stx_attributes_mask;
+  StatxTimestamp stx_atime;
+  StatxTimestamp stx_btime;
+  StatxTimestamp stx_ctime;
+  StatxTimestamp stx_mtime;
+  uint32_t stx_rdev_major;
+  uint32_t stx_rdev_minor;
+  uint32_t stx_dev_major;
+  uint32_t stx_dev_minor;
+  uint64_t reserved1[14];
+};
+
+static_assert(sizeof(Params) == 120, "io_uring_params has 120 bytes");
+static_assert(sizeof(Sqe) == 64, "io_uring_sqe has 64 bytes");
+static_assert(sizeof(Cqe) == 16, "io_uring_cqe has 16 bytes");
+static_assert(sizeof(Statx) == 256, "statx has 256 bytes");
+static_assert(sizeof(uv_buf_t) == sizeof(struct iovec),
+              "uv_buf_t is compatible with struct iovec");
+
+// Fills in |buf| in the same way as libuv does it for statx().
+void StatxToUvStat(const Statx& statx, uv_stat_t* buf) {
+  buf->st_dev = 256 * statx.stx_dev_major + statx.stx_dev_minor;
+  buf->st_mode = statx.stx_mode;
+  buf->st_nlink = statx.stx_nlink;
+  buf->st_uid = statx.stx_uid;
+  buf->st_gid = statx.stx_gid;
+  buf->st_rdev = statx.stx_rdev_major;
+  buf->st_ino = statx.stx_ino;
+  buf->st_size = statx.stx_size;
+  buf->st_blksize = statx.stx_blksize;
+  buf->st_blocks = statx.stx_blocks;
+  buf->st_atim.tv_sec = statx.stx_atime.tv_sec;
+  buf->st_atim.tv_nsec = statx.stx_atime.tv_nsec;
+  buf->st_mtim.tv_sec = statx.stx_mtime.tv_sec;
+  buf->st_mtim.tv_nsec = statx.stx_mtime.tv_nsec;
+  buf->st_ctim.tv_sec = statx.stx_ctime.tv_sec;
+  buf->st_ctim.tv_nsec = statx.stx_ctime.tv_nsec;
+  buf->st_birthtim.tv_sec = statx.stx_btime.tv_sec;
+  buf->st_birthtim.tv_nsec = statx.stx_btime.tv_nsec;
+  buf->st_flags = 0;
+  buf->st_gen = 0;
+}
+
+template <typename T>
+inline T LoadAcquire(T* ptr) {
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+template <typename T>
+inline void StoreRelease(T* ptr, T value) {
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+}  // anonymous namespace
+
+struct IoUring::Request {
+  Request(FSReqBase* req_wrap, uv_fs_cb after, uv_fs_type fs_type)
+      : req_wrap(req_wrap), after(after), fs_type(fs_type) {}
+
+  FSReqBase* const req_wrap;
+  const uv_fs_cb after;
+  const uv_fs_type fs_type;
+  Sqe sqe {};
+  // Data that the kernel reads or writes while the request is in flight.
+  std::string path;
+  std::vector<uv_buf_t> bufs;
+  Statx statx {};
+};
+
+IoUring::IoUring(Environment* env) : env_(env) {}
+
+IoUring::~IoUring() {
+  CHECK_EQ(in_flight_, 0);
+  if (sqes_ != nullptr)
+    munmap(sqes_, sqes_size_);
+  if (rings_ != nullptr)
+    munmap(rings_, rings_size_);
+  if (ring_fd_ != -1)
+    close(ring_fd_);
+}
+
+std::unique_ptr<IoUring> IoUring::Create(Environment* env) {
+  std::unique_ptr<IoUring> ring(new IoUring(env));
+  if (!ring->Init())
+    return nullptr;
+  return ring;
+}
+
+bool IoUring::Init() {
+  Params params {};
+  ring_fd_ = syscall(__NR_io_uring_setup, kEntries, &params);
+  if (ring_fd_ == -1)
+    return false;
+
+  // These features and IORING_REGISTER_PROBE are all available since
+  // Linux 5.6, which is also the first version to support all operations.
+  const uint32_t features = kFeatSingleMmap | kFeatNoDrop | kFeatRwCurPos;
+  if ((params.features & features) != features)
+    return false;
+
+  Probe probe {};
+  if (syscall(__NR_io_uring_register,
+              ring_fd_,
+              kRegisterProbe,
+              &probe,
+              arraysize(probe.ops)) == -1) {
+    return false;
+  }
+  for (uint8_t op : { kOpReadv, kOpWritev, kOpFsync,
+                      kOpOpenat, kOpClose, kOpStatx }) {
+    if (op > probe.last_op || (probe.ops[op].flags & kOpSupported) == 0)
+      return false;
+  }
+
+  rings_size_ =
+      std::max<size_t>(params.sq_off.array + params.sq_entries * 4,
+                       params.cq_off.cqes + params.cq_entries * sizeof(Cqe));
+  void* rings = mmap(nullptr,
+                     rings_size_,
+                     PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE,
+                     ring_fd_,
+                     kOffSqRing);
+  if (rings == MAP_FAILED)
+    return false;
+  rings_ = rings;
+
+  sqes_size_ = params.sq_entries * sizeof(Sqe);
+  void* sqes = mmap(nullptr,
+                    sqes_size_,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE,
+                    ring_fd_,
+                    kOffSqes);
+  if (sqes == MAP_FAILED)
+    return false;
+  sqes_ = sqes;
+
+  char* base = static_cast<char*>(rings_);
+  sq_head_ = reinterpret_cast<uint32_t*>(base + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<uint32_t*>(base + params.sq_off.tail);
+  sq_mask_ = *reinterpret_cast<uint32_t*>(base + params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  sq_array_ = reinterpret_cast<uint32_t*>(base + params.sq_off.array);
+  cq_head_ = reinterpret_cast<uint32_t*>(base + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<uint32_t*>(base + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<uint32_t*>(base + params.cq_off.ring_mask);
+  cq_entries_ = params.cq_entries;
+  cqes_ = base + params.cq_off.cqes;
+
+  CHECK_EQ(uv_poll_init(env_->event_loop(), &poll_, ring_fd_), 0);
+  poll_.data = this;
+  CHECK_EQ(uv_poll_start(&poll_, UV_READABLE, [](uv_poll_t* handle,
+                                                 int status,
+                                                 int events) {
+    static_cast<IoUring*>(handle->data)->ReapCompletions();
+  }), 0);
+  uv_unref(reinterpret_cast<uv_handle_t*>(&poll_));
+
+  CHECK_EQ(uv_prepare_init(env_->event_loop(), &prepare_), 0);
+  prepare_.data = this;
+  uv_unref(reinterpret_cast<uv_handle_t*>(&prepare_));
+
+  env_->AddCleanupHook(CleanupHook, this);
+  return true;
+}
+
+bool IoUring::Queue(std::unique_ptr<Request> request) {
+  if (closing_ || in_flight_ >= cq_entries_) {
+    stats_[kFallbacks]++;
+    return false;
+  }
+  if (queued_ == sq_entries_) {
+    Submit();
+    if (queued_ == sq_entries_) {
+      stats_[kFallbacks]++;
+      return false;
+    }
+  }
+
+  // Only this thread writes to the tail of the submission queue.
+  const uint32_t tail = *sq_tail_;
+  const uint32_t index = tail & sq_mask_;
+  Sqe* sqe = static_cast<Sqe*>(sqes_) + index;
+  *sqe = request->sqe;
+  sqe->user_data = reinterpret_cast<uint64_t>(request.release());
+  sq_array_[index] = index;
+  StoreRelease(sq_tail_, tail + 1);
+
+  if (queued_++ == 0) {
+    uv_prepare_start(&prepare_, [](uv_prepare_t* handle) {
+      static_cast<IoUring*>(handle->data)->Submit();
+    });
+  }
+  in_flight_++;
+  if (in_flight_ > stats_[kMaxInFlight])
+    stats_[kMaxInFlight] = in_flight_;
+  env_->IncreaseWaitingRequestCounter();
+  UpdateRef();
+  return true;
+}
+
+void IoUring::Submit() {
+  while (queued_ > 0) {
+    int ret = syscall(__NR_io_uring_enter, ring_fd_, queued_, 0, 0,
+                      nullptr, 0);
+    if (ret == -1 && errno == EINTR)
+      continue;
+    int err = ret == -1 ? -errno : UV_EAGAIN;
+    if (ret > 0) {
+      stats_[kSubmitCalls]++;
+      stats_[kSubmitted] += ret;
+      queued_ -= ret;
+      continue;
+    }
+
+    // The kernel did not take any more requests. Try again on the next
+    // iteration of the event loop if there are requests in flight whose
+    // completion wakes it up, otherwise take the queued requests out of the
+    // submission queue again and fail them. Queue() calls this from inside
+    // fs.open() and friends, so the callbacks are deferred like those of
+    // requests that complete normally.
+    if (in_flight_ > queued_)
+      return;
+    const uint32_t head = LoadAcquire(sq_head_);
+    std::vector<Request*> failed;
+    for (uint32_t i = head; i != *sq_tail_; i++) {
+      const Sqe* sqe = static_cast<Sqe*>(sqes_) + sq_array_[i & sq_mask_];
+      failed.push_back(reinterpret_cast<Request*>(sqe->user_data));
+    }
+    StoreRelease(sq_tail_, head);
+    queued_ = 0;
+    uv_prepare_stop(&prepare_);
+    env_->SetImmediate([this, failed = std::move(failed), err](Environment*) {
+      for (Request* request : failed)
+        Complete(request, err);
+    });
+    return;
+  }
+  uv_prepare_stop(&prepare_);
+}
+
+void IoUring::ReapCompletions() {
+  // Only this thread writes to the head of the completion queue.
+  uint32_t head = *cq_head_;
+  for (;;) {
+    if (head == LoadAcquire(cq_tail_))
+      break;
+    const Cqe* cqe = static_cast<Cqe*>(cqes_) + (head & cq_mask_);
+    Request* request = reinterpret_cast<Request*>(cqe->user_data);
+    const int result = cqe->res;
+    StoreRelease(cq_head_, ++head);
+    Complete(request, result);
+  }
+}
+
+void IoUring::Complete(Request* request, int result) {
+  std::unique_ptr<Request> req(request);
+  CHECK_GT(in_flight_, 0);
+  in_flight_--;
+  stats_[kCompleted]++;
+  env_->DecreaseWaitingRequestCounter();
+  UpdateRef();
+
+  // Fill in the fields that the uv_fs_cb functions in node_file.cc use, and
+  // leave nothing for uv_fs_req_cleanup() to free.
+  uv_fs_t* uv_req = req->req_wrap->req();
+  uv_req->fs_type = req->fs_type;
+  uv_req->result = result;
+  uv_req->path = req->path.empty() ? nullptr : req->path.c_str();
+  uv_req->new_path = nullptr;
+  uv_req->cb = nullptr;
+  uv_req->bufs = nullptr;
+  uv_req->ptr = nullptr;
+  if (req->fs_type == UV_FS_STAT ||
+      req->fs_type == UV_FS_LSTAT ||
+      req->fs_type == UV_FS_FSTAT) {
+    if (result == 0)
+      StatxToUvStat(req->statx, &uv_req->statbuf);
+    uv_req->ptr = &uv_req->statbuf;
+  }
+  req->after(uv_req);
+
+  MaybeCloseHandles();
+}
+
+void IoUring::UpdateRef() {
+  // Keep the event loop alive while requests are in flight, like the
+  // threadpool does.
+  if (in_flight_ > 0)
+    uv_ref(reinterpret_cast<uv_handle_t*>(&poll_));
+  else
+    uv_unref(reinterpret_cast<uv_handle_t*>(&poll_));
+}
+
+void IoUring::MaybeCloseHandles() {
+  if (!closing_ || handles_closed_ || in_flight_ > 0)
+    return;
+  handles_closed_ = true;
+  env_->CloseHandle(&poll_, [](uv_poll_t* handle) {});
+  env_->CloseHandle(&prepare_, [](uv_prepare_t* handle) {});
+}
+
+void IoUring::CleanupHook(void* data) {
+  IoUring* ring = static_cast<IoUring*>(data);
+  // New requests go to the threadpool from now on. Requests that are still
+  // in flight keep the handles open until they complete.
+  ring->closing_ = true;
+  ring->MaybeCloseHandles();
+}
+
+bool IoUring::Open(FSReqBase* req_wrap, uv_fs_cb after,
+                   const char* path, int flags, int mode) {
+  auto request = std::make_unique<Request>(req_wrap, after, UV_FS_OPEN);
+  request->path = path;
+  request->sqe.opcode = kOpOpenat;
+  request->sqe.fd = AT_FDCWD;
+  request->sqe.addr = reinterpret_cast<uint64_t>(request->path.c_str());
+  request->sqe.len = mode;
+  request->sqe.op_flags = flags | O_CLOEXEC;
+  return Queue(std::move(request));
+}
+
+bool IoUring::Close(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd) {
+  auto request = std::make_unique<Request>(req_wrap, after, UV_FS_CLOSE);
+  request->sqe.opcode = kOpClose;
+  request->sqe.fd = fd;
+  return Queue(std::move(request));
+}
+
+bool IoUring::Read(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd,
+                   const uv_buf_t* bufs, unsigned int nbufs, int64_t pos) {
+  if (nbufs > IOV_MAX)
+    return false;
+  auto request = std::make_unique<Request>(req_wrap, after, UV_FS_READ);
+  request->bufs.assign(bufs, bufs + nbufs);
+  request->sqe.opcode = kOpReadv;
+  request->sqe.fd = fd;
+  request->sqe.addr = reinterpret_cast<uint64_t>(request->bufs.data());
+  request->sqe.len = nbufs;
+  // A negative offset reads from the current file position.
+  request->sqe.off = pos < 0 ? static_cast<uint64_t>(-1) : pos;
+  return Queue(std::move(request));
+}
+
+bool IoUring::Write(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd,
+                    const uv_buf_t* bufs, unsigned int nbufs, int64_t pos) {
+  if (nbufs > IOV_MAX)
+    return false;
+  auto request = std::make_unique<Request>(req_wrap, after, UV_FS_WRITE);
+  request->bufs.assign(bufs, bufs + nbufs);
+  request->sqe.opcode = kOpWritev;
+  request->sqe.fd = fd;
+  request->sqe.addr = reinterpret_cast<uint64_t>(request->bufs.data());
+  request->sqe.len = nbufs;
+  request->sqe.off = pos < 0 ? static_cast<uint64_t>(-1) : pos;
+  return Queue(std::move(request));
+}
+
+bool IoUring::Stat(FSReqBase* req_wrap, uv_fs_cb after, const char* path) {
+  auto request = std::make_unique<Request>(req_wrap, after, UV_FS_STAT);
+  request->path = path;
+  request->sqe.opcode = kOpStatx;
+  request->sqe.fd = AT_FDCWD;
+  request->sqe.addr = reinterpret_cast<uint64_t>(request->path.c_str());
+  request->sqe.len = kStatxMask;
+  request->sqe.off = reinterpret_cast<uint64_t>(&request->statx);
+  return Queue(std::move(request));
+}
+
+bool IoUring::LStat(FSReqBase* req_wrap, uv_fs_cb after, const char* path) {
+  auto request = std::make_unique<Request>(req_wrap, after, UV_FS_LSTAT);
+  request->path = path;
+  request->sqe.opcode = kOpStatx;
+  request->sqe.fd = AT_FDCWD;
+  request->sqe.addr = reinterpret_cast<uint64_t>(request->path.c_str());
+  request->sqe.len = kStatxMask;
+  request->sqe.off = reinterpret_cast<uint64_t>(&request->statx);
+  request->sqe.op_flags = AT_SYMLINK_NOFOLLOW;
+  return Queue(std::move(request));
+}
+
+bool IoUring::FStat(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd) {
+  auto request = std::make_unique<Request>(req_wrap, after, UV_FS_FSTAT);
+  request->sqe.opcode = kOpStatx;
+  request->sqe.fd = fd;
+  request->sqe.addr = reinterpret_cast<uint64_t>("");
+  request->sqe.len = kStatxMask;
+  request->sqe.off = reinterpret_cast<uint64_t>(&request->statx);
+  request->sqe.op_flags = kAtEmptyPath;
+  return Queue(std::move(request));
+}
+
+bool IoUring::Fsync(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd) {
+  auto request = std::make_unique<Request>(req_wrap, after, UV_FS_FSYNC);
+  request->sqe.opcode = kOpFsync;
+  request->sqe.fd = fd;
+  return Queue(std::move(request));
+}
+
+bool IoUring::Fdatasync(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd) {
+  auto request = std::make_unique<Request>(req_wrap, after, UV_FS_FDATASYNC);
+  request->sqe.opcode = kOpFsync;
+  request->sqe.fd = fd;
+  request->sqe.op_flags = kFsyncDatasync;
+  return Queue(std::move(request));
+}
+
+void IoUring::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("rings", rings_size_ + sqes_size_);
+}
+
+#else  // !__linux__
+
+// io_uring only exists on Linux. Create() always fails elsewhere, so none of
+// the other functions are ever called.
+
+IoUring::IoUring(Environment* env) : env_(env) {}
+IoUring::~IoUring() {}
+
+std::unique_ptr<IoUring> IoUring::Create(Environment* env) {
+  return nullptr;
+}
+
+bool IoUring::Open(FSReqBase* req_wrap, uv_fs_cb after,
+                   const char* path, int flags, int mode) {
+  return false;
+}
+
+bool IoUring::Close(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd) {
+  return false;
+}
+
+bool IoUring::Read(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd,
+                   const uv_buf_t* bufs, unsigned int nbufs, int64_t pos) {
+  return false;
+}
+
+bool IoUring::Write(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd,
+                    const uv_buf_t* bufs, unsigned int nbufs, int64_t pos) {
+  return false;
+}
+
+bool IoUring::Stat(FSReqBase* req_wrap, uv_fs_cb after, const char* path) {
+  return false;
+}
+
+bool IoUring::LStat(FSReqBase* req_wrap, uv_fs_cb after, const char* path) {
+  return false;
+}
+
+bool IoUring::FStat(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd) {
+  return false;
+}
+
+bool IoUring::Fsync(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd) {
+  return false;
+}
+
+bool IoUring::Fdatasync(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd) {
+  return false;
+}
+
+void IoUring::MemoryInfo(MemoryTracker* tracker) const {}
+
+#endif  // __linux__
+
+}  // namespace fs
+}  // namespace node
@@ -0,0 +1,124 @@
+#ifndef SRC_NODE_IO_URING_H_
+#define SRC_NODE_IO_URING_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "memory_tracker.h"
+#include "uv.h"
+
+#include <memory>
+
+namespace node {
+
+class Environment;
+
+namespace fs {
+
+class FSReqBase;
+
+// Runs fs requests through an io_uring instead of the libuv threadpool, when
+// `--experimental-fs-io-uring` is set and the kernel supports all operations
+// used here (Linux 5.6 or later). Completions are picked up by a uv_poll_t on
+// the ring's file descriptor, so the `after` callbacks of the requests are
+// called on the event loop in the same way as for threadpool requests.
+//
+// Requests are queued and submitted with a single io_uring_enter() call per
+// event loop iteration, from a uv_prepare_t. The functions that start
+// requests return false if a request cannot be queued because the ring is
+// full, in which case the caller has to dispatch it to the threadpool.
+class IoUring : public MemoryRetainer {
+ public:
+  enum StatsFields {
+    kSubmitCalls,  // io_uring_enter() calls that submitted requests.
+    kSubmitted,    // Requests that were submitted to the kernel.
+    kCompleted,    // Requests that have completed.
+    kFallbacks,    // Requests that went to the threadpool because of a full
+                   // ring.
+    kMaxInFlight,  // The largest number of requests in flight at once.
+    kStatsFieldCount
+  };
+
+  // Returns nullptr if io_uring is not supported on this system.
+  static std::unique_ptr<IoUring> Create(Environment* env);
+  ~IoUring() override;
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  // These mirror the corresponding uv_fs_*() functions. |req_wrap| has to be
+  // initialized with FSReqBase::Init() already. |after| is called with
+  // req_wrap->req(), filled in like libuv does.
+  bool Open(FSReqBase* req_wrap, uv_fs_cb after,
+            const char* path, int flags, int mode);
+  bool Close(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd);
+  bool Read(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd,
+            const uv_buf_t* bufs, unsigned int nbufs, int64_t pos);
+  bool Write(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd,
+             const uv_buf_t* bufs, unsigned int nbufs, int64_t pos);
+  bool Stat(FSReqBase* req_wrap, uv_fs_cb after, const char* path);
+  bool LStat(FSReqBase* req_wrap, uv_fs_cb after, const char* path);
+  bool FStat(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd);
+  bool Fsync(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd);
+  bool Fdatasync(FSReqBase* req_wrap, uv_fs_cb after, uv_file fd);
+
+  inline size_t in_flight() const { return in_flight_; }
+  inline const uint64_t* stats() const { return stats_; }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(IoUring)
+  SET_SELF_SIZE(IoUring)
+
+ private:
+  struct Request;
+
+  explicit IoUring(Environment* env);
+  bool Init();
+  bool Queue(std::unique_ptr<Request> request);
+  // Submits the queued requests. Requests that the kernel did not accept stay
+  // queued if other requests are in flight, and fail otherwise. The callbacks
+  // of failed requests are called from a SetImmediate() callback.
+  void Submit();
+  void ReapCompletions();
+  void Complete(Request* request, int result);
+  void UpdateRef();
+  // Closes the uv handles once no requests are in flight any more.
+  void MaybeCloseHandles();
+  static void CleanupHook(void* data);
+
+  Environment* const env_;
+  int ring_fd_ = -1;
+  // The mmap()ed submission and completion queues, which share a mapping,
+  // and the array of submission queue entries.
+  void* rings_ = nullptr;
+  size_t rings_size_ = 0;
+  void* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t* sq_array_ = nullptr;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  uint32_t cq_entries_ = 0;
+  void* cqes_ = nullptr;
+
+  // Requests that are queued or submitted and have not completed yet.
+  size_t in_flight_ = 0;
+  // Requests that are queued but not yet submitted.
+  uint32_t queued_ = 0;
+  bool closing_ = false;
+  bool handles_closed_ = false;
+  uv_poll_t poll_;
+  uv_prepare_t prepare_;
+  uint64_t stats_[kStatsFieldCount] = {};
+};
+
+}  // namespace fs
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_IO_URING_H_
@@ -7,6 +7,7 @@
 #include "node_buffer.h"
 #include "node_errors.h"
 #include "node_process.h"
+#include "node_ring_channel.h"
 #include "util-inl.h"
 
 using node::contextify::ContextifyContext;
@@ -49,6 +50,12 @@ bool Message::IsCloseMessage() const {
 
 namespace {
 
+// The kinds of host objects that can be part of a message.
+enum class HostObjectKind : uint32_t {
+  kMessagePort,
+  kZlibDictionary
+};
+
 // This is used to tell V8 how to read transferred host objects, like other
 // `MessagePort`s and `SharedArrayBuffer`s, and make new JS objects out of them.
 class DeserializerDelegate : public ValueDeserializer::Delegate {
@@ -58,19 +65,30 @@ class DeserializerDelegate : public ValueDeserializer::Delegate {
       Environment* env,
       const std::vector<MessagePort*>& message_ports,
       const std::vector<Local<SharedArrayBuffer>>& shared_array_buffers,
-      const std::vector<WasmModuleObject::TransferrableModule>& wasm_modules)
-      : message_ports_(message_ports),
+      const std::vector<WasmModuleObject::TransferrableModule>& wasm_modules,
+      const std::vector<zlib::DictionaryData>& zlib_dictionaries)
+      : env_(env),
+        message_ports_(message_ports),
         shared_array_buffers_(shared_array_buffers),
-        wasm_modules_(wasm_modules) {}
+        wasm_modules_(wasm_modules),
+        zlib_dictionaries_(zlib_dictionaries) {}
 
   MaybeLocal<Object> ReadHostObject(Isolate* isolate) override {
-    // Currently, only MessagePort hosts objects are supported, so identifying
-    // by the index in the message's MessagePort array is sufficient.
+    // Host objects are identified by their kind and their index in the
+    // message's array for that kind.
+    uint32_t kind;
     uint32_t id;
-    if (!deserializer->ReadUint32(&id))
+    if (!deserializer->ReadUint32(&kind) || !deserializer->ReadUint32(&id))
       return MaybeLocal<Object>();
-    CHECK_LE(id, message_ports_.size());
-    return message_ports_[id]->object(isolate);
+    switch (static_cast<HostObjectKind>(kind)) {
+      case HostObjectKind::kMessagePort:
+        CHECK_LT(id, message_ports_.size());
+        return message_ports_[id]->object(isolate);
+      case HostObjectKind::kZlibDictionary:
+        CHECK_LT(id, zlib_dictionaries_.size());
+        return zlib::DictionaryObject::Create(env_, zlib_dictionaries_[id]);
+    }
+    UNREACHABLE();
   }
 
   MaybeLocal<SharedArrayBuffer> GetSharedArrayBufferFromId(
@@ -89,9 +107,11 @@ class DeserializerDelegate : public ValueDeserializer::Delegate {
   ValueDeserializer* deserializer = nullptr;
 
  private:
+  Environment* env_;
   const std::vector<MessagePort*>& message_ports_;
   const std::vector<Local<SharedArrayBuffer>>& shared_array_buffers_;
   const std::vector<WasmModuleObject::TransferrableModule>& wasm_modules_;
+  const std::vector<zlib::DictionaryData>& zlib_dictionaries_;
 };
 
 }  // anonymous namespace
@@ -132,7 +152,8 @@ MaybeLocal<Value> Message::Deserialize(Environment* env,
   shared_array_buffers_.clear();
 
   DeserializerDelegate delegate(
-      this, env, ports, shared_array_buffers, wasm_modules_);
+      this, env, ports, shared_array_buffers, wasm_modules_,
+      zlib_dictionaries_);
   ValueDeserializer deserializer(
       env->isolate(),
       reinterpret_cast<const uint8_t*>(main_message_buf_.data),
@@ -186,6 +207,11 @@ uint32_t Message::AddWASMModule(WasmModuleObject::TransferrableModule&& mod) {
   return wasm_modules_.size() - 1;
 }
 
+uint32_t Message::AddZlibDictionary(const zlib::DictionaryData& data) {
+  zlib_dictionaries_.push_back(data);
+  return zlib_dictionaries_.size() - 1;
+}
+
 namespace {
 
 MaybeLocal<Function> GetDOMException(Local<Context> context) {
@@ -233,6 +259,9 @@ class SerializerDelegate : public ValueSerializer::Delegate {
     if (env_->message_port_constructor_template()->HasInstance(object)) {
       return WriteMessagePort(Unwrap<MessagePort>(object));
     }
+    if (zlib::DictionaryObject::HasInstance(env_, object)) {
+      return WriteZlibDictionary(Unwrap<zlib::DictionaryObject>(object));
+    }
 
     ThrowDataCloneError(env_->clone_unsupported_type_str());
     return Nothing<bool>();
@@ -282,6 +311,8 @@ class SerializerDelegate : public ValueSerializer::Delegate {
   Maybe<bool> WriteMessagePort(MessagePort* port) {
     for (uint32_t i = 0; i < ports_.size(); i++) {
       if (ports_[i] == port) {
+        serializer->WriteUint32(
+            static_cast<uint32_t>(HostObjectKind::kMessagePort));
         serializer->WriteUint32(i);
         return Just(true);
       }
@@ -291,6 +322,13 @@ class SerializerDelegate : public ValueSerializer::Delegate {
     return Nothing<bool>();
   }
 
+  Maybe<bool> WriteZlibDictionary(zlib::DictionaryObject* dictionary) {
+    serializer->WriteUint32(
+        static_cast<uint32_t>(HostObjectKind::kZlibDictionary));
+    serializer->WriteUint32(msg_->AddZlibDictionary(dictionary->data()));
+    return Just(true);
+  }
+
   Environment* env_;
   Local<Context> context_;
   Message* msg_;
@@ -415,6 +453,8 @@ void Message::MemoryInfo(MemoryTracker* tracker) const {
   tracker->TrackFieldWithSize("shared_array_buffers",
       shared_array_buffers_.size() * sizeof(shared_array_buffers_[0]));
   tracker->TrackField("message_ports", message_ports_);
+  tracker->TrackFieldWithSize("zlib_dictionaries",
+      zlib_dictionaries_.size() * sizeof(zlib_dictionaries_[0]));
 }
 
 MessagePortData::MessagePortData(MessagePort* owner) : owner_(owner) { }
@@ -999,6 +1039,8 @@ static void InitMessaging(Local<Object> target,
   env->SetMethod(target, "moveMessagePortToContext",
                  MessagePort::MoveToContext);
 
+  RingChannel::Initialize(env, target, context);
+
   {
     Local<Function> domexception = GetDOMException(context).ToLocalChecked();
     target
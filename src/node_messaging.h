@@ -5,6 +5,7 @@
 
 #include "env.h"
 #include "node_mutex.h"
+#include "node_zlib_dictionary.h"
 #include "sharedarraybuffer_metadata.h"
 #include <list>
 
@@ -59,6 +60,10 @@ class Message : public MemoryRetainer {
   // Internal method of Message that is called when a new WebAssembly.Module
   // object is encountered in the incoming value's structure.
   uint32_t AddWASMModule(v8::WasmModuleObject::TransferrableModule&& mod);
+  // Internal method of Message that is called when a zlib.Dictionary is
+  // encountered in the incoming value's structure. Its data is shared, not
+  // copied.
+  uint32_t AddZlibDictionary(const zlib::DictionaryData& data);
 
   // The MessagePorts that will be transferred, as recorded by Serialize().
   // Used for warning user about posting the target MessagePort to itself,
@@ -78,6 +83,7 @@ class Message : public MemoryRetainer {
   std::vector<SharedArrayBufferMetadataReference> shared_array_buffers_;
   std::vector<std::unique_ptr<MessagePortData>> message_ports_;
   std::vector<v8::WasmModuleObject::TransferrableModule> wasm_modules_;
+  std::vector<zlib::DictionaryData> zlib_dictionaries_;
 
   friend class MessagePort;
 };
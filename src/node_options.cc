@@ -172,6 +172,13 @@ void EnvironmentOptions::CheckOptions(std::vector<std::string>* errors) {
                       "used, not both");
   }
 
+  if (stream_read_pool_size != 0 &&
+      (stream_read_pool_size < kMinStreamReadPoolSize ||
+       stream_read_pool_size > kMaxStreamReadPoolSize)) {
+    errors->push_back("--stream-read-pool-size must be 0 or between 4096 "
+                      "and 67108864");
+  }
+
 #if HAVE_INSPECTOR
   if (!cpu_prof) {
     if (!cpu_prof_name.empty()) {
@@ -317,6 +324,16 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "experimental Source Map V3 support",
             &EnvironmentOptions::enable_source_maps,
             kAllowedInEnvironment);
+  AddOption("--experimental-compile-cache",
+            "persist the V8 code cache of user modules in the specified "
+            "directory",
+            &EnvironmentOptions::compile_cache_dir,
+            kAllowedInEnvironment);
+  AddOption("--experimental-fs-io-uring",
+            "run fs requests through io_uring instead of the threadpool "
+            "where supported (Linux 5.6 or later)",
+            &EnvironmentOptions::experimental_fs_io_uring,
+            kAllowedInEnvironment);
   AddOption("--experimental-json-modules",
             "experimental JSON interop support for the ES Module loader",
             &EnvironmentOptions::experimental_json_modules,
@@ -331,6 +348,16 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "experimental ES Module support and caching modules",
             &EnvironmentOptions::experimental_modules,
             kAllowedInEnvironment);
+  AddOption("--experimental-module-stat-cache",
+            "keep the file system lookups of the CommonJS loader for the "
+            "lifetime of the process, invalidated through fs.watch()",
+            &EnvironmentOptions::experimental_module_stat_cache,
+            kAllowedInEnvironment);
+  AddOption("--experimental-resolution-cache",
+            "keep the results of module resolution in the specified file "
+            "across runs",
+            &EnvironmentOptions::resolution_cache_file,
+            kAllowedInEnvironment);
   AddOption("--experimental-resolve-self",
             "experimental support for require/import of the current package",
             &EnvironmentOptions::experimental_resolve_self,
@@ -461,6 +488,11 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "write warnings to file instead of stderr",
             &EnvironmentOptions::redirect_warnings,
             kAllowedInEnvironment);
+  AddOption("--stream-read-pool-size",
+            "serve stream reads from shared slabs of this many bytes "
+            "(default: 0, disabled)",
+            &EnvironmentOptions::stream_read_pool_size,
+            kAllowedInEnvironment);
   AddOption("--test-udp-no-try-send", "",  // For testing only.
             &EnvironmentOptions::test_udp_no_try_send);
   AddOption("--throw-deprecation",
@@ -471,6 +503,11 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "show stack traces on deprecations",
             &EnvironmentOptions::trace_deprecation,
             kAllowedInEnvironment);
+  AddOption("--trace-resolution-cache",
+            "print the hit rate of --experimental-resolution-cache to stderr "
+            "at exit",
+            &EnvironmentOptions::trace_resolution_cache,
+            kAllowedInEnvironment);
   AddOption("--trace-sync-io",
             "show stack trace when use of sync IO is detected after the "
             "first tick",
@@ -493,6 +530,11 @@ EnvironmentOptionsParser::EnvironmentOptionsParser() {
             "an error), 'warn' (enforce warnings) or 'none' (silence warnings)",
             &EnvironmentOptions::unhandled_rejections,
             kAllowedInEnvironment);
+  AddOption("--zlib-context-pool-size",
+            "keep up to this many bytes of closed deflate streams for reuse "
+            "(default: 0, disabled)",
+            &EnvironmentOptions::zlib_context_pool_size,
+            kAllowedInEnvironment);
 
   AddOption("--check",
             "syntax check script without executing",
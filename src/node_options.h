@@ -101,8 +101,12 @@ class EnvironmentOptions : public Options {
  public:
   bool abort_on_uncaught_exception = false;
   bool enable_source_maps = false;
+  std::string compile_cache_dir;
+  bool experimental_fs_io_uring = false;
   bool experimental_json_modules = false;
   bool experimental_modules = false;
+  bool experimental_module_stat_cache = false;
+  std::string resolution_cache_file;
   bool experimental_resolve_self = false;
   std::string es_module_specifier_resolution;
   bool experimental_wasm_modules = false;
@@ -136,15 +140,20 @@ class EnvironmentOptions : public Options {
   bool heap_prof = false;
 #endif  // HAVE_INSPECTOR
   std::string redirect_warnings;
+  static const uint64_t kMinStreamReadPoolSize = 4 * 1024;
+  static const uint64_t kMaxStreamReadPoolSize = 64 * 1024 * 1024;
+  uint64_t stream_read_pool_size = 0;
   bool test_udp_no_try_send = false;
   bool throw_deprecation = false;
   bool trace_deprecation = false;
+  bool trace_resolution_cache = false;
   bool trace_sync_io = false;
   bool trace_tls = false;
   bool trace_uncaught = false;
   bool trace_warnings = false;
   std::string unhandled_rejections;
   std::string userland_loader;
+  uint64_t zlib_context_pool_size = 0;
 
   bool syntax_check_only = false;
   bool has_eval_string = false;
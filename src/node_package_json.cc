@@ -0,0 +1,415 @@
+#include "node_package_json.h"
+#include "node_mutex.h"
+#include "string_search.h"
+#include "util.h"
+#include "uv.h"
+
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+namespace node {
+namespace loader {
+
+namespace {
+
+// A JSON parser that checks the syntax of a whole document but only keeps the
+// values that its caller asks for. It gives up on rare inputs that would need
+// more work to handle exactly like JSON.parse(), such as very deep nesting or
+// unpaired surrogates, since the caller falls back to JSON.parse() then.
+class JsonScanner {
+ public:
+  JsonScanner(const char* data, size_t size)
+      : pos_(data), end_(data + size) {}
+
+  void SkipWhitespace() {
+    while (pos_ < end_ &&
+           (*pos_ == ' ' || *pos_ == '\t' || *pos_ == '\n' || *pos_ == '\r')) {
+      pos_++;
+    }
+  }
+
+  // Skips whitespace, then consumes |c| if it is the next character.
+  bool Consume(char c) {
+    SkipWhitespace();
+    if (pos_ == end_ || *pos_ != c)
+      return false;
+    pos_++;
+    return true;
+  }
+
+  bool AtEnd() const { return pos_ == end_; }
+  const char* position() const { return pos_; }
+
+  // Parses a string at the current position, and stores its decoded value
+  // in |out| unless it is nullptr.
+  bool ParseString(std::string* out);
+  // Skips over the value at the current position.
+  bool SkipValue(int depth);
+
+ private:
+  static constexpr int kMaxDepth = 64;
+
+  bool SkipLiteral(const char* literal);
+  bool SkipNumber();
+  bool SkipDigits();
+  bool ParseHex4(uint32_t* code_unit);
+  static void AppendUtf8(uint32_t code_point, std::string* out);
+
+  const char* pos_;
+  const char* const end_;
+};
+
+bool JsonScanner::ParseString(std::string* out) {
+  if (pos_ == end_ || *pos_ != '"')
+    return false;
+  pos_++;
+
+  while (pos_ < end_) {
+    const char c = *pos_++;
+    if (c == '"')
+      return true;
+    if (static_cast<unsigned char>(c) < 0x20)
+      return false;
+    if (c != '\\') {
+      if (out != nullptr)
+        out->push_back(c);
+      continue;
+    }
+
+    if (pos_ == end_)
+      return false;
+    char unescaped;
+    switch (*pos_++) {
+      case '"': unescaped = '"'; break;
+      case '\\': unescaped = '\\'; break;
+      case '/': unescaped = '/'; break;
+      case 'b': unescaped = '\b'; break;
+      case 'f': unescaped = '\f'; break;
+      case 'n': unescaped = '\n'; break;
+      case 'r': unescaped = '\r'; break;
+      case 't': unescaped = '\t'; break;
+      case 'u': {
+        uint32_t code_point;
+        if (!ParseHex4(&code_point))
+          return false;
+        if (code_point >= 0xDC00 && code_point <= 0xDFFF)
+          return false;
+        if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+          uint32_t low;
+          if (end_ - pos_ < 2 || pos_[0] != '\\' || pos_[1] != 'u')
+            return false;
+          pos_ += 2;
+          if (!ParseHex4(&low) || low < 0xDC00 || low > 0xDFFF)
+            return false;
+          code_point = 0x10000 + ((code_point - 0xD800) << 10) +
+                       (low - 0xDC00);
+        }
+        if (out != nullptr)
+          AppendUtf8(code_point, out);
+        continue;
+      }
+      default:
+        return false;
+    }
+    if (out != nullptr)
+      out->push_back(unescaped);
+  }
+  return false;
+}
+
+bool JsonScanner::ParseHex4(uint32_t* code_unit) {
+  if (end_ - pos_ < 4)
+    return false;
+  uint32_t value = 0;
+  for (int i = 0; i < 4; i++) {
+    const char c = *pos_++;
+    value <<= 4;
+    if (c >= '0' && c <= '9') {
+      value |= c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      value |= c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      value |= c - 'A' + 10;
+    } else {
+      return false;
+    }
+  }
+  *code_unit = value;
+  return true;
+}
+
+void JsonScanner::AppendUtf8(uint32_t code_point, std::string* out) {
+  if (code_point < 0x80) {
+    out->push_back(static_cast<char>(code_point));
+  } else if (code_point < 0x800) {
+    out->push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  } else if (code_point < 0x10000) {
+    out->push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  } else {
+    out->push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+    out->push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+  }
+}
+
+bool JsonScanner::SkipLiteral(const char* literal) {
+  const size_t length = strlen(literal);
+  if (static_cast<size_t>(end_ - pos_) < length ||
+      memcmp(pos_, literal, length) != 0) {
+    return false;
+  }
+  pos_ += length;
+  return true;
+}
+
+bool JsonScanner::SkipDigits() {
+  const char* start = pos_;
+  while (pos_ < end_ && *pos_ >= '0' && *pos_ <= '9')
+    pos_++;
+  return pos_ != start;
+}
+
+bool JsonScanner::SkipNumber() {
+  if (pos_ < end_ && *pos_ == '-')
+    pos_++;
+  if (pos_ < end_ && *pos_ == '0') {
+    pos_++;
+  } else if (!SkipDigits()) {
+    return false;
+  }
+  if (pos_ < end_ && *pos_ == '.') {
+    pos_++;
+    if (!SkipDigits())
+      return false;
+  }
+  if (pos_ < end_ && (*pos_ == 'e' || *pos_ == 'E')) {
+    pos_++;
+    if (pos_ < end_ && (*pos_ == '+' || *pos_ == '-'))
+      pos_++;
+    if (!SkipDigits())
+      return false;
+  }
+  return true;
+}
+
+bool JsonScanner::SkipValue(int depth) {
+  if (depth > kMaxDepth)
+    return false;
+  SkipWhitespace();
+  if (pos_ == end_)
+    return false;
+
+  switch (*pos_) {
+    case '{':
+      pos_++;
+      if (Consume('}'))
+        return true;
+      do {
+        SkipWhitespace();
+        if (!ParseString(nullptr) || !Consume(':') || !SkipValue(depth + 1))
+          return false;
+      } while (Consume(','));
+      return Consume('}');
+    case '[':
+      pos_++;
+      if (Consume(']'))
+        return true;
+      do {
+        if (!SkipValue(depth + 1))
+          return false;
+      } while (Consume(','));
+      return Consume(']');
+    case '"':
+      return ParseString(nullptr);
+    case 't':
+      return SkipLiteral("true");
+    case 'f':
+      return SkipLiteral("false");
+    case 'n':
+      return SkipLiteral("null");
+    default:
+      return SkipNumber();
+  }
+}
+
+template <size_t N>
+bool Mentions(const std::string& source, const char (&needle)[N]) {
+  return SearchString(source.data(), source.size(), needle) != source.size();
+}
+
+PackageJson::Field FieldForKey(const std::string& key) {
+  if (key == "name") return PackageJson::kName;
+  if (key == "main") return PackageJson::kMain;
+  if (key == "exports") return PackageJson::kExports;
+  if (key == "imports") return PackageJson::kImports;
+  if (key == "type") return PackageJson::kType;
+  return PackageJson::kFieldCount;
+}
+
+// Fills in pkg->fields from a package.json whose top-level value is an object.
+// Duplicate keys are handled like JSON.parse() does, the last one wins.
+bool ParseFields(const std::string& source, PackageJson* pkg) {
+  JsonScanner scanner(source.data(), source.size());
+  if (!scanner.Consume('{'))
+    return false;
+
+  if (!scanner.Consume('}')) {
+    do {
+      std::string key;
+      scanner.SkipWhitespace();
+      if (!scanner.ParseString(&key) || !scanner.Consume(':'))
+        return false;
+
+      const PackageJson::Field field = FieldForKey(key);
+      if (field == PackageJson::kFieldCount) {
+        if (!scanner.SkipValue(1))
+          return false;
+        continue;
+      }
+
+      PackageJson::FieldValue value;
+      scanner.SkipWhitespace();
+      const char* start = scanner.position();
+      if (!scanner.AtEnd() && *start == '"') {
+        value.is_string = true;
+        if (!scanner.ParseString(&value.value))
+          return false;
+      } else if (!scanner.SkipValue(1)) {
+        return false;
+      }
+      value.present = true;
+      value.json.assign(start, scanner.position() - start);
+      pkg->fields[field] = std::move(value);
+    } while (scanner.Consume(','));
+
+    if (!scanner.Consume('}'))
+      return false;
+  }
+
+  scanner.SkipWhitespace();
+  return scanner.AtEnd();
+}
+
+bool ReadRegularFile(const std::string& path,
+                     uv_stat_t* stat,
+                     std::string* contents) {
+  uv_fs_t req;
+  const uv_file fd = uv_fs_open(nullptr, &req, path.c_str(), O_RDONLY, 0,
+                                nullptr);
+  uv_fs_req_cleanup(&req);
+  if (fd < 0)
+    return false;
+
+  OnScopeLeave close_fd([fd]() {
+    uv_fs_t close_req;
+    CHECK_EQ(0, uv_fs_close(nullptr, &close_req, fd, nullptr));
+    uv_fs_req_cleanup(&close_req);
+  });
+
+  const int err = uv_fs_fstat(nullptr, &req, fd, nullptr);
+  *stat = req.statbuf;
+  uv_fs_req_cleanup(&req);
+  if (err < 0 || (stat->st_mode & S_IFMT) != S_IFREG)
+    return false;
+
+  // The size is only a hint, the file may change while it is being read. One
+  // byte more than that is requested, so that the end of an unchanged file is
+  // found with a single read: a read of a regular file only comes back short
+  // at the end of the file.
+  contents->resize(stat->st_size > 0 ? stat->st_size + 1 : 4096);
+  size_t length = 0;
+  for (;;) {
+    const size_t requested = contents->size() - length;
+    uv_buf_t buf = uv_buf_init(&(*contents)[length], requested);
+    const int bytes_read = uv_fs_read(nullptr, &req, fd, &buf, 1, length,
+                                      nullptr);
+    uv_fs_req_cleanup(&req);
+    if (bytes_read < 0)
+      return false;
+    length += bytes_read;
+    if (static_cast<size_t>(bytes_read) < requested)
+      break;
+    contents->resize(contents->size() * 2);
+  }
+  contents->resize(length);
+  return true;
+}
+
+bool IsSameFile(const uv_stat_t& a, const uv_stat_t& b) {
+  return a.st_dev == b.st_dev &&
+         a.st_ino == b.st_ino &&
+         a.st_size == b.st_size &&
+         a.st_mtim.tv_sec == b.st_mtim.tv_sec &&
+         a.st_mtim.tv_nsec == b.st_mtim.tv_nsec &&
+         a.st_ctim.tv_sec == b.st_ctim.tv_sec &&
+         a.st_ctim.tv_nsec == b.st_ctim.tv_nsec;
+}
+
+struct CacheEntry {
+  uv_stat_t stat;
+  std::shared_ptr<const PackageJson> package_json;
+};
+
+Mutex package_json_cache_mutex;
+std::unordered_map<std::string, CacheEntry> package_json_cache;
+
+}  // anonymous namespace
+
+std::shared_ptr<const PackageJson> ParsePackageJson(std::string&& source) {
+  auto pkg = std::make_shared<PackageJson>();
+
+  if (source.size() >= 3 && memcmp(source.data(), "\xEF\xBB\xBF", 3) == 0)
+    source.erase(0, 3);  // Skip UTF-8 BOM.
+
+  pkg->mentions_fields = Mentions(source, "\"main\"") ||
+                         Mentions(source, "\"exports\"") ||
+                         Mentions(source, "\"type\"");
+
+  if (!ParseFields(source, pkg.get())) {
+    pkg->needs_js_parse = true;
+    for (PackageJson::FieldValue& field : pkg->fields)
+      field = PackageJson::FieldValue();
+    pkg->source = std::move(source);
+  }
+  return pkg;
+}
+
+std::shared_ptr<const PackageJson> GetPackageJson(const std::string& path) {
+  uv_fs_t req;
+  const int err = uv_fs_stat(nullptr, &req, path.c_str(), nullptr);
+  const uv_stat_t stat = req.statbuf;
+  uv_fs_req_cleanup(&req);
+  if (err < 0 || (stat.st_mode & S_IFMT) != S_IFREG)
+    return nullptr;
+
+  {
+    Mutex::ScopedLock lock(package_json_cache_mutex);
+    auto it = package_json_cache.find(path);
+    if (it != package_json_cache.end() && IsSameFile(it->second.stat, stat))
+      return it->second.package_json;
+  }
+
+  // Read and parse the file without holding the lock. If another thread does
+  // the same at the same time, the last one to finish replaces the entry.
+  CacheEntry entry;
+  std::string source;
+  if (!ReadRegularFile(path, &entry.stat, &source))
+    return nullptr;
+  entry.package_json = ParsePackageJson(std::move(source));
+
+  std::shared_ptr<const PackageJson> result = entry.package_json;
+  Mutex::ScopedLock lock(package_json_cache_mutex);
+  package_json_cache[path] = std::move(entry);
+  return result;
+}
+
+}  // namespace loader
+}  // namespace node
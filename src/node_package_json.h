@@ -0,0 +1,66 @@
+#ifndef SRC_NODE_PACKAGE_JSON_H_
+#define SRC_NODE_PACKAGE_JSON_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <memory>
+#include <string>
+
+namespace node {
+namespace loader {
+
+// The fields of a package.json file that module resolution looks at. This
+// does not hold any V8 values, so that one instance can be shared by all
+// threads of the process.
+struct PackageJson {
+  enum Field {
+    kName,
+    kMain,
+    kExports,
+    kImports,
+    kType,
+    kFieldCount
+  };
+
+  // Set if the file could not be handled natively, for example because it is
+  // not valid JSON or because its top-level value is not an object. |source|
+  // then holds the contents of the file, and callers have to parse them like
+  // they did before, so that they report errors in the same way.
+  bool needs_js_parse = false;
+  std::string source;
+
+  // Whether "main", "exports" or "type" appear anywhere in the file. The
+  // CommonJS loader has always ignored package.json files without them.
+  bool mentions_fields = false;
+
+  // For each field that is present, the JSON source text of its value. For
+  // string values, |value| holds the decoded UTF-8 string.
+  struct FieldValue {
+    bool present = false;
+    bool is_string = false;
+    std::string json;
+    std::string value;
+  };
+  FieldValue fields[kFieldCount];
+
+  inline const FieldValue& operator[](Field field) const {
+    return fields[field];
+  }
+};
+
+// Parses the contents of a package.json file. Exposed for testing.
+std::shared_ptr<const PackageJson> ParsePackageJson(std::string&& source);
+
+// Reads and parses package.json files once per process. Entries are shared
+// between the main thread and Worker threads, and are re-read when the size,
+// inode or modification times of the file change.
+//
+// Returns nullptr if |path| is not a readable regular file.
+std::shared_ptr<const PackageJson> GetPackageJson(const std::string& path);
+
+}  // namespace loader
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_PACKAGE_JSON_H_
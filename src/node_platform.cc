@@ -19,7 +19,7 @@ using node::tracing::TracingController;
 namespace {
 
 struct PlatformWorkerData {
-  TaskQueue<Task>* task_queue;
+  WorkStealingTaskQueue* task_queue;
   Mutex* platform_workers_mutex;
   ConditionVariable* platform_workers_ready;
   int* pending_platform_workers;
@@ -30,7 +30,8 @@ static void PlatformWorkerThread(void* data) {
   std::unique_ptr<PlatformWorkerData>
       worker_data(static_cast<PlatformWorkerData*>(data));
 
-  TaskQueue<Task>* pending_worker_tasks = worker_data->task_queue;
+  WorkStealingTaskQueue* pending_worker_tasks = worker_data->task_queue;
+  const int id = worker_data->id;
   TRACE_EVENT_METADATA1("__metadata", "thread_name", "name",
                         "PlatformWorkerThread");
 
@@ -41,17 +42,126 @@ static void PlatformWorkerThread(void* data) {
     worker_data->platform_workers_ready->Signal(lock);
   }
 
-  while (std::unique_ptr<Task> task = pending_worker_tasks->BlockingPop()) {
+  while (std::unique_ptr<Task> task = pending_worker_tasks->BlockingPop(id)) {
     task->Run();
     pending_worker_tasks->NotifyOfCompletion();
   }
 }
 
+// The queue and index of the worker running on the current thread, if any.
+struct CurrentWorker {
+  const WorkStealingTaskQueue* queue;
+  int index;
+};
+thread_local CurrentWorker current_worker = { nullptr, -1 };
+
 }  // namespace
 
+WorkStealingTaskQueue::WorkerDeque::WorkerDeque() {
+  for (int i = 0; i < kPriorityCount; i++)
+    size[i] = 0;
+}
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(int worker_count) {
+  // Keep at least one deque so that tasks can be queued even if no worker
+  // threads could be started.
+  for (int i = 0; i < std::max(worker_count, 1); i++)
+    deques_.emplace_back(new WorkerDeque());
+}
+
+void WorkStealingTaskQueue::Push(std::unique_ptr<Task> task,
+                                 WorkerTaskPriority priority) {
+  size_t index;
+  if (current_worker.queue == this) {
+    index = current_worker.index;
+  } else {
+    index = next_deque_.fetch_add(1, std::memory_order_relaxed) %
+            deques_.size();
+  }
+  const int p = static_cast<int>(priority);
+
+  outstanding_tasks_++;
+  {
+    WorkerDeque* deque = deques_[index].get();
+    Mutex::ScopedLock scoped_lock(deque->mutex);
+    deque->tasks[p].push_back(std::move(task));
+    deque->size[p]++;
+    pending_tasks_++;
+  }
+
+  // Idle workers announce themselves before re-checking |pending_tasks_|, so
+  // either they see the new task or we see them and wake one up.
+  if (idle_workers_ > 0) {
+    Mutex::ScopedLock scoped_lock(idle_lock_);
+    tasks_available_.Signal(scoped_lock);
+  }
+}
+
+std::unique_ptr<Task> WorkStealingTaskQueue::TryPopFrom(WorkerDeque* deque,
+                                                        int priority) {
+  if (deque->size[priority].load(std::memory_order_relaxed) == 0)
+    return nullptr;
+  Mutex::ScopedLock scoped_lock(deque->mutex);
+  std::deque<std::unique_ptr<Task>>& tasks = deque->tasks[priority];
+  if (tasks.empty())
+    return nullptr;
+  std::unique_ptr<Task> result = std::move(tasks.front());
+  tasks.pop_front();
+  deque->size[priority]--;
+  pending_tasks_--;
+  return result;
+}
+
+std::unique_ptr<Task> WorkStealingTaskQueue::TryPop(int worker_index) {
+  const size_t count = deques_.size();
+  for (int p = 0; p < kPriorityCount; p++) {
+    for (size_t i = 0; i < count; i++) {
+      WorkerDeque* deque = deques_[(worker_index + i) % count].get();
+      if (std::unique_ptr<Task> task = TryPopFrom(deque, p))
+        return task;
+    }
+  }
+  return nullptr;
+}
+
+std::unique_ptr<Task> WorkStealingTaskQueue::BlockingPop(int worker_index) {
+  current_worker = { this, worker_index };
+  for (;;) {
+    if (stopped_)
+      return nullptr;
+    if (std::unique_ptr<Task> task = TryPop(worker_index))
+      return task;
+
+    Mutex::ScopedLock scoped_lock(idle_lock_);
+    idle_workers_++;
+    while (pending_tasks_ == 0 && !stopped_)
+      tasks_available_.Wait(scoped_lock);
+    idle_workers_--;
+  }
+}
+
+void WorkStealingTaskQueue::NotifyOfCompletion() {
+  if (--outstanding_tasks_ == 0) {
+    Mutex::ScopedLock scoped_lock(drain_lock_);
+    tasks_drained_.Broadcast(scoped_lock);
+  }
+}
+
+void WorkStealingTaskQueue::BlockingDrain() {
+  Mutex::ScopedLock scoped_lock(drain_lock_);
+  while (outstanding_tasks_ > 0)
+    tasks_drained_.Wait(scoped_lock);
+}
+
+void WorkStealingTaskQueue::Stop() {
+  stopped_ = true;
+  Mutex::ScopedLock scoped_lock(idle_lock_);
+  tasks_available_.Broadcast(scoped_lock);
+}
+
 class WorkerThreadsTaskRunner::DelayedTaskScheduler {
  public:
-  explicit DelayedTaskScheduler(TaskQueue<Task>* tasks)
+  explicit DelayedTaskScheduler(WorkStealingTaskQueue* tasks)
     : pending_worker_tasks_(tasks) {}
 
   std::unique_ptr<uv_thread_t> Start() {
@@ -143,7 +253,8 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
   static void RunTask(uv_timer_t* timer) {
     DelayedTaskScheduler* scheduler =
         ContainerOf(&DelayedTaskScheduler::loop_, timer->loop);
-    scheduler->pending_worker_tasks_->Push(scheduler->TakeTimerTask(timer));
+    scheduler->pending_worker_tasks_->Push(scheduler->TakeTimerTask(timer),
+                                           WorkerTaskPriority::kUserVisible);
   }
 
   std::unique_ptr<Task> TakeTimerTask(uv_timer_t* timer) {
@@ -157,7 +268,7 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
   }
 
   uv_sem_t ready_;
-  TaskQueue<Task>* pending_worker_tasks_;
+  WorkStealingTaskQueue* pending_worker_tasks_;
 
   TaskQueue<Task> tasks_;
   uv_loop_t loop_;
@@ -165,7 +276,8 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
   std::unordered_set<uv_timer_t*> timers_;
 };
 
-WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size) {
+WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size)
+    : pending_worker_tasks_(thread_pool_size) {
   Mutex platform_workers_mutex;
   ConditionVariable platform_workers_ready;
 
@@ -196,8 +308,9 @@ WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size) {
   }
 }
 
-void WorkerThreadsTaskRunner::PostTask(std::unique_ptr<Task> task) {
-  pending_worker_tasks_.Push(std::move(task));
+void WorkerThreadsTaskRunner::PostTask(std::unique_ptr<Task> task,
+                                       WorkerTaskPriority priority) {
+  pending_worker_tasks_.Push(std::move(task), priority);
 }
 
 void WorkerThreadsTaskRunner::PostDelayedTask(std::unique_ptr<Task> task,
@@ -445,6 +558,18 @@ void NodePlatform::CallOnWorkerThread(std::unique_ptr<Task> task) {
   worker_thread_task_runner_->PostTask(std::move(task));
 }
 
+void NodePlatform::CallBlockingTaskOnWorkerThread(
+    std::unique_ptr<Task> task) {
+  worker_thread_task_runner_->PostTask(std::move(task),
+                                       WorkerTaskPriority::kUserBlocking);
+}
+
+void NodePlatform::CallLowPriorityTaskOnWorkerThread(
+    std::unique_ptr<Task> task) {
+  worker_thread_task_runner_->PostTask(std::move(task),
+                                       WorkerTaskPriority::kBestEffort);
+}
+
 void NodePlatform::CallDelayedOnWorkerThread(std::unique_ptr<Task> task,
                                              double delay_in_seconds) {
   worker_thread_task_runner_->PostDelayedTask(std::move(task),
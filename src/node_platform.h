@@ -3,6 +3,8 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <atomic>
+#include <deque>
 #include <queue>
 #include <unordered_map>
 #include <vector>
@@ -110,12 +112,72 @@ class PerIsolatePlatformData :
   std::vector<DelayedTaskPointer> scheduled_delayed_tasks_;
 };
 
+// Priorities of tasks posted to the platform worker threads, matching the
+// v8::Platform entry points they are posted through.
+enum class WorkerTaskPriority {
+  kUserBlocking,  // CallBlockingTaskOnWorkerThread()
+  kUserVisible,   // CallOnWorkerThread()
+  kBestEffort,    // CallLowPriorityTaskOnWorkerThread()
+  kCount
+};
+
+// The queue backing the platform worker threads. Every worker owns one FIFO
+// deque per priority. Tasks posted from a worker thread go to that worker's
+// deques and all other tasks are spread across the workers round-robin, so
+// producers only ever contend on a single worker's lock. Workers that run out
+// of work steal from the others, always preferring higher priority tasks.
+class WorkStealingTaskQueue {
+ public:
+  explicit WorkStealingTaskQueue(int worker_count);
+  ~WorkStealingTaskQueue() = default;
+
+  void Push(std::unique_ptr<v8::Task> task, WorkerTaskPriority priority);
+  // Called by the worker thread with the given index. Returns nullptr once
+  // the queue has been stopped.
+  std::unique_ptr<v8::Task> BlockingPop(int worker_index);
+  void NotifyOfCompletion();
+  void BlockingDrain();
+  void Stop();
+
+ private:
+  static constexpr int kPriorityCount =
+      static_cast<int>(WorkerTaskPriority::kCount);
+
+  struct WorkerDeque {
+    WorkerDeque();
+
+    Mutex mutex;
+    std::deque<std::unique_ptr<v8::Task>> tasks[kPriorityCount];
+    // Mirrors tasks[i].size() so that thieves can skip empty deques without
+    // taking the lock.
+    std::atomic<size_t> size[kPriorityCount];
+  };
+
+  std::unique_ptr<v8::Task> TryPop(int worker_index);
+  std::unique_ptr<v8::Task> TryPopFrom(WorkerDeque* deque, int priority);
+
+  std::vector<std::unique_ptr<WorkerDeque>> deques_;
+  std::atomic<size_t> next_deque_ {0};
+  // Number of tasks sitting in the deques.
+  std::atomic<int> pending_tasks_ {0};
+  // Number of tasks that have been pushed but have not completed yet.
+  std::atomic<int> outstanding_tasks_ {0};
+  std::atomic<int> idle_workers_ {0};
+  std::atomic<bool> stopped_ {false};
+
+  Mutex idle_lock_;
+  ConditionVariable tasks_available_;
+  Mutex drain_lock_;
+  ConditionVariable tasks_drained_;
+};
+
 // This acts as the single worker thread task runner for all Isolates.
 class WorkerThreadsTaskRunner {
  public:
   explicit WorkerThreadsTaskRunner(int thread_pool_size);
 
-  void PostTask(std::unique_ptr<v8::Task> task);
+  void PostTask(std::unique_ptr<v8::Task> task,
+                WorkerTaskPriority priority = WorkerTaskPriority::kUserVisible);
   void PostDelayedTask(std::unique_ptr<v8::Task> task,
                        double delay_in_seconds);
 
@@ -125,7 +187,7 @@ class WorkerThreadsTaskRunner {
   int NumberOfWorkerThreads() const;
 
  private:
-  TaskQueue<v8::Task> pending_worker_tasks_;
+  WorkStealingTaskQueue pending_worker_tasks_;
 
   class DelayedTaskScheduler;
   std::unique_ptr<DelayedTaskScheduler> delayed_task_scheduler_;
@@ -145,6 +207,9 @@ class NodePlatform : public MultiIsolatePlatform {
   // v8::Platform implementation.
   int NumberOfWorkerThreads() override;
   void CallOnWorkerThread(std::unique_ptr<v8::Task> task) override;
+  void CallBlockingTaskOnWorkerThread(std::unique_ptr<v8::Task> task) override;
+  void CallLowPriorityTaskOnWorkerThread(
+      std::unique_ptr<v8::Task> task) override;
   void CallDelayedOnWorkerThread(std::unique_ptr<v8::Task> task,
                                  double delay_in_seconds) override;
   void CallOnForegroundThread(v8::Isolate* isolate, v8::Task* task) override {
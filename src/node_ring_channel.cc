@@ -0,0 +1,452 @@
+#include "node_ring_channel.h"
+
+#include "async_wrap-inl.h"
+#include "env-inl.h"
+#include "node_internals.h"
+#include "util-inl.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::HandleScope;
+using v8::Integer;
+using v8::Local;
+using v8::Object;
+using v8::SharedArrayBuffer;
+using v8::String;
+using v8::Uint32;
+using v8::Value;
+
+namespace node {
+namespace worker {
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2,
+              "RingChannel needs lock-free 32-bit atomics");
+
+namespace {
+
+inline void YieldThread() {
+#ifdef _WIN32
+  SwitchToThread();
+#else
+  sched_yield();
+#endif
+}
+
+// All RingChannelData instances, by the address of their memory, so that
+// handles for the same SharedArrayBuffer on different threads share one.
+Mutex ring_channels_mutex;
+std::unordered_map<const void*, std::weak_ptr<RingChannelData>> ring_channels;
+
+inline uint32_t RecordSize(size_t length) {
+  return RoundUp(sizeof(uint32_t) + length, RingChannelData::kRecordAlignment);
+}
+
+}  // anonymous namespace
+
+RingChannelData::RingChannelData(uint8_t* memory,
+                                 size_t capacity,
+                                 SharedArrayBufferMetadataReference sab)
+    : memory_(memory),
+      data_(memory + kHeaderSize),
+      capacity_(capacity),
+      sab_(std::move(sab)) {}
+
+RingChannelData::~RingChannelData() {
+  Mutex::ScopedLock lock(ring_channels_mutex);
+  auto it = ring_channels.find(memory_);
+  // Another thread may already have replaced the expired entry.
+  if (it != ring_channels.end() && it->second.expired())
+    ring_channels.erase(it);
+}
+
+std::shared_ptr<RingChannelData> RingChannelData::ForSharedArrayBuffer(
+    Environment* env,
+    Local<Context> context,
+    Local<SharedArrayBuffer> sab) {
+  SharedArrayBufferMetadataReference reference =
+      SharedArrayBufferMetadata::ForSharedArrayBuffer(env, context, sab);
+  if (!reference)
+    return nullptr;
+
+  // The JS side checks the size, so that the data area is a power of two
+  // that is large enough for the padding rules in Write().
+  SharedArrayBuffer::Contents contents = sab->GetContents();
+  CHECK_GT(contents.ByteLength(), kHeaderSize);
+  size_t capacity = contents.ByteLength() - kHeaderSize;
+  CHECK_GE(capacity, 64u);
+  CHECK_EQ(capacity & (capacity - 1), 0u);
+  CHECK_LE(capacity, 1u << 31);
+  uint8_t* memory = static_cast<uint8_t*>(contents.Data());
+  CHECK_EQ(reinterpret_cast<uintptr_t>(memory) % alignof(std::atomic<uint32_t>),
+           0u);
+
+  Mutex::ScopedLock lock(ring_channels_mutex);
+  std::weak_ptr<RingChannelData>& entry = ring_channels[memory];
+  std::shared_ptr<RingChannelData> data = entry.lock();
+  if (!data) {
+    data.reset(new RingChannelData(memory, capacity, std::move(reference)));
+    entry = data;
+  }
+  return data;
+}
+
+std::atomic<uint32_t>* RingChannelData::index(size_t offset) const {
+  return reinterpret_cast<std::atomic<uint32_t>*>(memory_ + offset);
+}
+
+size_t RingChannelData::FreeSpace() const {
+  uint32_t used = index(kReserveIndexOffset)->load() -
+                  index(kReadIndexOffset)->load();
+  return used <= capacity_ ? capacity_ - used : 0;
+}
+
+RingChannelData::WriteResult RingChannelData::Write(const char* data,
+                                                    size_t length) {
+  CHECK_LE(length, max_message_size());
+  const uint32_t record_size = RecordSize(length);
+  std::atomic<uint32_t>* reserve = index(kReserveIndexOffset);
+  std::atomic<uint32_t>* commit = index(kCommitIndexOffset);
+
+  // Reserve space for the record, and for padding at the end of the data
+  // area if the record does not fit there.
+  uint32_t start = reserve->load(std::memory_order_relaxed);
+  uint32_t position;
+  uint32_t padding;
+  for (;;) {
+    if (start % kRecordAlignment != 0)
+      return kCorrupted;
+    position = start & (capacity_ - 1);
+    padding = capacity_ - position < record_size ? capacity_ - position : 0;
+    // Loading the read index makes sure that the receiver is done with the
+    // memory before it is overwritten.
+    uint32_t used = start - index(kReadIndexOffset)->load();
+    if (used > capacity_) {
+      // Either |start| is outdated, or the indices are broken.
+      uint32_t current = reserve->load(std::memory_order_relaxed);
+      if (current == start)
+        return kCorrupted;
+      start = current;
+      continue;
+    }
+    if (used + padding + record_size > capacity_)
+      return kFull;
+    if (reserve->compare_exchange_weak(start,
+                                       start + padding + record_size,
+                                       std::memory_order_relaxed)) {
+      break;
+    }
+  }
+
+  if (padding > 0) {
+    uint32_t marker = kPaddingRecord;
+    memcpy(data_ + position, &marker, sizeof(marker));
+    position = 0;
+  }
+  uint32_t length32 = static_cast<uint32_t>(length);
+  memcpy(data_ + position, &length32, sizeof(length32));
+  memcpy(data_ + position + sizeof(length32), data, length);
+
+  // Records become visible to the receiver in the order in which they were
+  // reserved, so wait for producers that reserved space before this one.
+  // That only ends if |start| lies between the commit and reserve indices,
+  // which can stop being the case if something else writes to the memory.
+  uint64_t deadline = 0;
+  for (size_t spins = 1;; spins++) {
+    const uint32_t committed = commit->load(std::memory_order_acquire);
+    if (committed == start)
+      break;
+    const uint32_t pending = reserve->load(std::memory_order_relaxed) -
+                             committed;
+    if (committed % kRecordAlignment != 0 ||
+        pending > capacity_ ||
+        start - committed >= pending) {
+      return kCorrupted;
+    }
+    if (spins % 64 == 0) {
+      const uint64_t now = uv_hrtime();
+      if (deadline == 0)
+        deadline = now + kCommitTimeoutNs;
+      else if (now > deadline)
+        return kCorrupted;
+      YieldThread();
+    }
+  }
+  commit->store(start + padding + record_size);
+
+  NotifyReceiver();
+  return kWritten;
+}
+
+bool RingChannelData::Peek(const char** data,
+                           uint32_t* length,
+                           uint32_t* record_size,
+                           bool* corrupted) {
+  *corrupted = false;
+  std::atomic<uint32_t>* read = index(kReadIndexOffset);
+  uint32_t start = read->load(std::memory_order_relaxed);
+  for (;;) {
+    uint32_t available = index(kCommitIndexOffset)->load() - start;
+    if (available == 0)
+      return false;
+    if (available > capacity_ || start % kRecordAlignment != 0) {
+      *corrupted = true;
+      return false;
+    }
+
+    uint32_t position = start & (capacity_ - 1);
+    uint32_t value;
+    memcpy(&value, data_ + position, sizeof(value));
+    if (value == kPaddingRecord) {
+      uint32_t padding = capacity_ - position;
+      if (padding > available) {
+        *corrupted = true;
+        return false;
+      }
+      start += padding;
+      read->store(start);
+      continue;
+    }
+
+    if (value > max_message_size() ||
+        RecordSize(value) > std::min<uint32_t>(available,
+                                               capacity_ - position)) {
+      *corrupted = true;
+      return false;
+    }
+    *data = reinterpret_cast<const char*>(data_ + position + sizeof(value));
+    *length = value;
+    *record_size = RecordSize(value);
+    return true;
+  }
+}
+
+void RingChannelData::Pop(uint32_t record_size) {
+  std::atomic<uint32_t>* read = index(kReadIndexOffset);
+  read->store(read->load(std::memory_order_relaxed) + record_size);
+  NotifyDrainWaiters();
+}
+
+void RingChannelData::NotifyReceiver() {
+  // The receiver resets the flag before it looks for new messages.
+  if (receiver_notified_.exchange(true))
+    return;
+  Mutex::ScopedLock lock(mutex_);
+  if (receiver_ != nullptr)
+    receiver_->Wakeup(RingChannel::kWakeupMessage);
+}
+
+void RingChannelData::NotifyDrainWaiters() {
+  uint32_t threshold = drain_threshold_.load();
+  if (threshold == 0 || FreeSpace() < threshold)
+    return;
+
+  Mutex::ScopedLock lock(mutex_);
+  size_t free_space = FreeSpace();
+  uint32_t new_threshold = 0;
+  auto it = drain_waiters_.begin();
+  while (it != drain_waiters_.end()) {
+    if (it->second <= free_space) {
+      it->first->Wakeup(RingChannel::kWakeupDrain);
+      it = drain_waiters_.erase(it);
+    } else {
+      if (new_threshold == 0 || it->second < new_threshold)
+        new_threshold = it->second;
+      ++it;
+    }
+  }
+  drain_threshold_.store(new_threshold);
+}
+
+RingChannel::RingChannel(Environment* env,
+                         Local<Object> wrap,
+                         std::shared_ptr<RingChannelData> data)
+    : HandleWrap(env,
+                 wrap,
+                 reinterpret_cast<uv_handle_t*>(&async_),
+                 AsyncWrap::PROVIDER_RINGCHANNEL),
+      data_(std::move(data)) {
+  auto onwakeup = [](uv_async_t* handle) {
+    RingChannel* channel = ContainerOf(&RingChannel::async_, handle);
+    channel->OnWakeup();
+  };
+  CHECK_EQ(uv_async_init(env->event_loop(), &async_, onwakeup), 0);
+  // The JS side refs the handle while it is receiving or waiting for space.
+  uv_unref(reinterpret_cast<uv_handle_t*>(&async_));
+}
+
+void RingChannel::Close(Local<Value> close_callback) {
+  {
+    // Once this handle is unregistered, no other thread can trigger it.
+    Mutex::ScopedLock lock(data_->mutex_);
+    if (data_->receiver_ == this)
+      data_->receiver_ = nullptr;
+    std::vector<std::pair<RingChannel*, uint32_t>>& waiters =
+        data_->drain_waiters_;
+    waiters.erase(std::remove_if(waiters.begin(), waiters.end(),
+                                 [this](const std::pair<RingChannel*,
+                                                        uint32_t>& waiter) {
+                                   return waiter.first == this;
+                                 }),
+                  waiters.end());
+  }
+  HandleWrap::Close(close_callback);
+}
+
+bool RingChannel::ClaimReceiver() {
+  if (is_receiver_)
+    return true;
+  Mutex::ScopedLock lock(data_->mutex_);
+  if (data_->receiver_ != nullptr)
+    return false;
+  data_->receiver_ = this;
+  is_receiver_ = true;
+  // Messages may have been written while there was no receiver.
+  data_->receiver_notified_.store(true);
+  Wakeup(kWakeupMessage);
+  return true;
+}
+
+void RingChannel::Wakeup(int flags) {
+  pending_wakeups_ |= flags;
+  CHECK_EQ(uv_async_send(&async_), 0);
+}
+
+void RingChannel::OnWakeup() {
+  int flags;
+  {
+    Mutex::ScopedLock lock(data_->mutex_);
+    flags = pending_wakeups_;
+    pending_wakeups_ = 0;
+  }
+  // Producers notify the receiver again for anything that they write after
+  // this point.
+  if (flags & kWakeupMessage)
+    data_->receiver_notified_.store(false);
+
+  HandleScope handle_scope(env()->isolate());
+  Context::Scope context_scope(env()->context());
+  if (flags & kWakeupDrain)
+    MakeCallback(env()->ondrain_string(), 0, nullptr);
+  if ((flags & kWakeupMessage) && !IsHandleClosing())
+    MakeCallback(env()->onmessage_string(), 0, nullptr);
+}
+
+void RingChannel::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsSharedArrayBuffer());
+  std::shared_ptr<RingChannelData> data =
+      RingChannelData::ForSharedArrayBuffer(
+          env, env->context(), args[0].As<SharedArrayBuffer>());
+  if (!data)
+    return;
+  new RingChannel(env, args.This(), std::move(data));
+}
+
+// Returns true if the message was written, false if there was not enough
+// space, or null if the ring is corrupted.
+void RingChannel::Write(const FunctionCallbackInfo<Value>& args) {
+  RingChannel* channel;
+  ASSIGN_OR_RETURN_UNWRAP(&channel, args.Holder());
+  CHECK(args[0]->IsArrayBufferView());
+  ArrayBufferViewContents<char> message(args[0]);
+  switch (channel->data_->Write(message.data(), message.length())) {
+    case RingChannelData::kWritten:
+      args.GetReturnValue().Set(true);
+      break;
+    case RingChannelData::kFull:
+      args.GetReturnValue().Set(false);
+      break;
+    case RingChannelData::kCorrupted:
+      args.GetReturnValue().SetNull();
+      break;
+  }
+}
+
+// Returns the oldest message as a Buffer, undefined if there is none, or null
+// if the ring is corrupted.
+void RingChannel::Read(const FunctionCallbackInfo<Value>& args) {
+  RingChannel* channel;
+  ASSIGN_OR_RETURN_UNWRAP(&channel, args.Holder());
+  CHECK(channel->is_receiver_);
+  const char* data;
+  uint32_t length;
+  uint32_t record_size;
+  bool corrupted;
+  if (!channel->data_->Peek(&data, &length, &record_size, &corrupted)) {
+    if (corrupted)
+      args.GetReturnValue().SetNull();
+    return;
+  }
+  Local<Object> buffer;
+  if (!Buffer::Copy(channel->env(), data, length).ToLocal(&buffer))
+    return;
+  channel->data_->Pop(record_size);
+  args.GetReturnValue().Set(buffer);
+}
+
+void RingChannel::Start(const FunctionCallbackInfo<Value>& args) {
+  RingChannel* channel;
+  ASSIGN_OR_RETURN_UNWRAP(&channel, args.Holder());
+  args.GetReturnValue().Set(channel->ClaimReceiver());
+}
+
+// Triggers the ondrain callback once there is enough space for a message of
+// args[0] bytes, wherever it ends up in the data area.
+void RingChannel::WaitForDrain(const FunctionCallbackInfo<Value>& args) {
+  RingChannel* channel;
+  ASSIGN_OR_RETURN_UNWRAP(&channel, args.Holder());
+  CHECK(args[0]->IsUint32());
+  RingChannelData* data = channel->data_.get();
+  uint32_t required = static_cast<uint32_t>(std::min<size_t>(
+      2 * RecordSize(args[0].As<Uint32>()->Value()), data->capacity()));
+
+  Mutex::ScopedLock lock(data->mutex_);
+  // Publish the threshold before checking the free space, so that either
+  // this check or the receiver's check in NotifyDrainWaiters() sees it.
+  uint32_t threshold = data->drain_threshold_.load();
+  if (threshold == 0 || required < threshold)
+    data->drain_threshold_.store(required);
+  if (data->FreeSpace() >= required) {
+    channel->Wakeup(kWakeupDrain);
+    data->drain_threshold_.store(threshold);
+    return;
+  }
+  data->drain_waiters_.emplace_back(channel, required);
+}
+
+void RingChannel::Initialize(Environment* env,
+                             Local<Object> target,
+                             Local<Context> context) {
+  Local<String> ring_channel_string =
+      FIXED_ONE_BYTE_STRING(env->isolate(), "RingChannel");
+  Local<FunctionTemplate> t = env->NewFunctionTemplate(New);
+  t->SetClassName(ring_channel_string);
+  t->InstanceTemplate()->SetInternalFieldCount(1);
+  t->Inherit(HandleWrap::GetConstructorTemplate(env));
+  env->SetProtoMethod(t, "write", Write);
+  env->SetProtoMethod(t, "read", Read);
+  env->SetProtoMethod(t, "start", Start);
+  env->SetProtoMethod(t, "waitForDrain", WaitForDrain);
+  target->Set(context,
+              ring_channel_string,
+              t->GetFunction(context).ToLocalChecked()).Check();
+
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(env->isolate(), "kRingChannelHeaderSize"),
+              Integer::NewFromUnsigned(env->isolate(),
+                                       RingChannelData::kHeaderSize)).Check();
+}
+
+}  // namespace worker
+}  // namespace node
@@ -0,0 +1,160 @@
+#ifndef SRC_NODE_RING_CHANNEL_H_
+#define SRC_NODE_RING_CHANNEL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "handle_wrap.h"
+#include "node_mutex.h"
+#include "sharedarraybuffer_metadata.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace node {
+namespace worker {
+
+class RingChannel;
+
+// The state of a ring buffer that is shared between all RingChannel handles
+// for the same SharedArrayBuffer, on any thread. The ring itself lives in the
+// SharedArrayBuffer; this object only tracks which handles have to be woken
+// up when messages arrive or space becomes available.
+class RingChannelData {
+ public:
+  // Returns the existing RingChannelData for the memory of |sab|, or creates
+  // one. Returns nullptr if an exception is pending.
+  static std::shared_ptr<RingChannelData> ForSharedArrayBuffer(
+      Environment* env,
+      v8::Local<v8::Context> context,
+      v8::Local<v8::SharedArrayBuffer> sab);
+  ~RingChannelData();
+
+  RingChannelData(const RingChannelData&) = delete;
+  RingChannelData& operator=(const RingChannelData&) = delete;
+
+  // Ring buffer layout: three indices, each on its own cache line, followed
+  // by the data area. The indices count bytes and wrap around at 2^32.
+  // Records are a 32-bit length followed by the payload, padded to
+  // kRecordAlignment. A length of kPaddingRecord marks the unused space at the
+  // end of the data area when a record did not fit there.
+  static constexpr size_t kReserveIndexOffset = 0;
+  static constexpr size_t kCommitIndexOffset = 64;
+  static constexpr size_t kReadIndexOffset = 128;
+  static constexpr size_t kHeaderSize = 192;
+  static constexpr size_t kRecordAlignment = 4;
+  static constexpr uint32_t kPaddingRecord = 0xffffffff;
+  // How long a producer waits for the producers that reserved space before it
+  // to commit their records. They only have to copy a message, so if that
+  // takes longer, the channel is treated as corrupted.
+  static constexpr uint64_t kCommitTimeoutNs = 1000 * 1000 * 1000;
+
+  enum WriteResult {
+    kWritten,
+    kFull,
+    kCorrupted
+  };
+
+  // Called by any number of producers at the same time. |length| must not
+  // exceed max_message_size().
+  WriteResult Write(const char* data, size_t length);
+  // Only called by the receiving handle. Returns the oldest message without
+  // removing it, or false if there is none. Sets |*corrupted| if the indices
+  // or lengths in the buffer are inconsistent, which can only happen if the
+  // memory has been modified by something other than RingChannel.
+  bool Peek(const char** data,
+            uint32_t* length,
+            uint32_t* record_size,
+            bool* corrupted);
+  // Removes the message returned by Peek().
+  void Pop(uint32_t record_size);
+
+  inline size_t capacity() const { return capacity_; }
+  inline size_t max_message_size() const { return capacity_ / 2 - 4; }
+
+ private:
+  RingChannelData(uint8_t* memory,
+                  size_t capacity,
+                  worker::SharedArrayBufferMetadataReference sab);
+
+  std::atomic<uint32_t>* index(size_t offset) const;
+  size_t FreeSpace() const;
+  void NotifyReceiver();
+  void NotifyDrainWaiters();
+
+  uint8_t* const memory_;
+  uint8_t* const data_;
+  const size_t capacity_;
+  // Keeps the memory alive while any thread uses it.
+  const worker::SharedArrayBufferMetadataReference sab_;
+
+  // Set once the receiver has been woken up, until it starts reading, so
+  // that producers only call uv_async_send() once per batch of messages.
+  std::atomic<bool> receiver_notified_ { false };
+  // The smallest amount of free space that a blocked producer waits for, or
+  // 0 if none is waiting.
+  std::atomic<uint32_t> drain_threshold_ { 0 };
+
+  Mutex mutex_;
+  // The handles that have to be woken up. Access is protected by mutex_.
+  RingChannel* receiver_ = nullptr;
+  std::vector<std::pair<RingChannel*, uint32_t>> drain_waiters_;
+
+  friend class RingChannel;
+};
+
+// A handle to a ring buffer in a SharedArrayBuffer. Any number of handles
+// can write messages, one handle at a time can receive them. The uv_async_t
+// of a handle is triggered when it receives messages, or when space becomes
+// available after a write has failed.
+class RingChannel : public HandleWrap {
+ public:
+  RingChannel(Environment* env,
+              v8::Local<v8::Object> wrap,
+              std::shared_ptr<RingChannelData> data);
+
+  static void Initialize(Environment* env,
+                         v8::Local<v8::Object> target,
+                         v8::Local<v8::Context> context);
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Write(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Read(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void WaitForDrain(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  void Close(
+      v8::Local<v8::Value> close_callback = v8::Local<v8::Value>()) override;
+
+  SET_NO_MEMORY_INFO()
+  SET_MEMORY_INFO_NAME(RingChannel)
+  SET_SELF_SIZE(RingChannel)
+
+ private:
+  enum WakeupFlags {
+    kWakeupMessage = 1,
+    kWakeupDrain = 2
+  };
+
+  // Claims the receiving end of the ring. Returns false if another handle
+  // has claimed it.
+  bool ClaimReceiver();
+  // Called with data_->mutex_ held.
+  void Wakeup(int flags);
+  void OnWakeup();
+
+  std::shared_ptr<RingChannelData> data_;
+  bool is_receiver_ = false;
+  // Flags for the next OnWakeup() call. Protected by data_->mutex_.
+  int pending_wakeups_ = 0;
+  uv_async_t async_;
+
+  friend class RingChannelData;
+};
+
+}  // namespace worker
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_RING_CHANNEL_H_
@@ -22,6 +22,9 @@
 #include "memory_tracker-inl.h"
 #include "node.h"
 #include "node_buffer.h"
+#include "node_errors.h"
+#include "node_zlib_dictionary.h"
+#include "node_zlib_pool.h"
 
 #include "async_wrap-inl.h"
 #include "env-inl.h"
@@ -39,13 +42,19 @@
 #include <cerrno>
 #include <cstdlib>
 #include <cstring>
+#include <algorithm>
 #include <atomic>
+#include <deque>
+#include <memory>
 
 namespace node {
 
 using v8::Array;
 using v8::ArrayBuffer;
+using v8::ArrayBufferView;
 using v8::Context;
+using v8::DontDelete;
+using v8::DontEnum;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
@@ -53,15 +62,145 @@ using v8::Global;
 using v8::HandleScope;
 using v8::Int32;
 using v8::Integer;
+using v8::Isolate;
 using v8::Local;
+using v8::MaybeLocal;
+using v8::Number;
 using v8::Object;
+using v8::PropertyAttribute;
+using v8::ReadOnly;
+using v8::SharedArrayBuffer;
+using v8::Signature;
 using v8::String;
 using v8::Uint32;
 using v8::Uint32Array;
 using v8::Value;
 
+namespace zlib {
+
+DictionaryObject::DictionaryObject(Environment* env,
+                                   Local<Object> object,
+                                   DictionaryData data)
+    : BaseObject(env, object), data_(std::move(data)) {
+  MakeWeak();
+}
+
+Local<FunctionTemplate> DictionaryObject::GetConstructorTemplate(
+    Environment* env) {
+  Local<FunctionTemplate> tmpl = env->zlib_dictionary_constructor_template();
+  if (tmpl.IsEmpty()) {
+    Isolate* isolate = env->isolate();
+    tmpl = env->NewFunctionTemplate(New);
+    tmpl->InstanceTemplate()->SetInternalFieldCount(1);
+    tmpl->SetClassName(FIXED_ONE_BYTE_STRING(isolate, "Dictionary"));
+
+    Local<Signature> signature = Signature::New(isolate, tmpl);
+    auto attributes =
+        static_cast<PropertyAttribute>(ReadOnly | DontDelete | DontEnum);
+    tmpl->PrototypeTemplate()->SetAccessorProperty(
+        FIXED_ONE_BYTE_STRING(isolate, "buffer"),
+        FunctionTemplate::New(isolate,
+                              GetBuffer,
+                              env->as_callback_data(),
+                              signature),
+        Local<FunctionTemplate>(),
+        attributes);
+    tmpl->PrototypeTemplate()->SetAccessorProperty(
+        FIXED_ONE_BYTE_STRING(isolate, "byteLength"),
+        FunctionTemplate::New(isolate,
+                              GetByteLength,
+                              env->as_callback_data(),
+                              signature),
+        Local<FunctionTemplate>(),
+        attributes);
+    env->set_zlib_dictionary_constructor_template(tmpl);
+  }
+  return tmpl;
+}
+
+bool DictionaryObject::HasInstance(Environment* env, Local<Value> value) {
+  return GetConstructorTemplate(env)->HasInstance(value);
+}
+
+MaybeLocal<Object> DictionaryObject::Create(Environment* env,
+                                            DictionaryData data) {
+  Local<Object> object;
+  if (!GetConstructorTemplate(env)->InstanceTemplate()
+          ->NewInstance(env->context()).ToLocal(&object)) {
+    return MaybeLocal<Object>();
+  }
+  new DictionaryObject(env, object, std::move(data));
+  return object;
+}
+
+void DictionaryObject::New(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  if (!args.IsConstructCall())
+    return THROW_ERR_CONSTRUCT_CALL_REQUIRED(env);
+
+  // The data is copied once, so that nothing can change it while streams
+  // use it.
+  const unsigned char* data;
+  size_t length;
+  if (args[0]->IsArrayBufferView()) {
+    Local<ArrayBufferView> view = args[0].As<ArrayBufferView>();
+    data = static_cast<const unsigned char*>(
+        view->Buffer()->GetContents().Data()) + view->ByteOffset();
+    length = view->ByteLength();
+  } else if (args[0]->IsArrayBuffer()) {
+    ArrayBuffer::Contents contents = args[0].As<ArrayBuffer>()->GetContents();
+    data = static_cast<const unsigned char*>(contents.Data());
+    length = contents.ByteLength();
+  } else if (args[0]->IsSharedArrayBuffer()) {
+    SharedArrayBuffer::Contents contents =
+        args[0].As<SharedArrayBuffer>()->GetContents();
+    data = static_cast<const unsigned char*>(contents.Data());
+    length = contents.ByteLength();
+  } else {
+    return THROW_ERR_INVALID_ARG_TYPE(
+        env,
+        "The \"data\" argument must be an instance of Buffer, TypedArray, "
+        "DataView, ArrayBuffer, or SharedArrayBuffer.");
+  }
+
+  new DictionaryObject(
+      env,
+      args.This(),
+      std::make_shared<const std::vector<unsigned char>>(data, data + length));
+}
+
+// Returns a copy, so that the data that streams use cannot be changed.
+void DictionaryObject::GetBuffer(const FunctionCallbackInfo<Value>& args) {
+  DictionaryObject* dictionary;
+  ASSIGN_OR_RETURN_UNWRAP(&dictionary, args.This());
+  Environment* env = dictionary->env();
+  const std::vector<unsigned char>& data = *dictionary->data_;
+  AllocatedBuffer buffer = env->AllocateManaged(data.size());
+  if (!data.empty())
+    memcpy(buffer.data(), data.data(), data.size());
+  args.GetReturnValue().Set(buffer.ToArrayBuffer());
+}
+
+void DictionaryObject::GetByteLength(const FunctionCallbackInfo<Value>& args) {
+  DictionaryObject* dictionary;
+  ASSIGN_OR_RETURN_UNWRAP(&dictionary, args.This());
+  args.GetReturnValue().Set(
+      static_cast<double>(dictionary->data_->size()));
+}
+
+// The data is shared with every stream and Worker that uses the dictionary,
+// so it is only attributed to the dictionary.
+void DictionaryObject::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("data", data_->size());
+}
+
+}  // namespace zlib
+
 namespace {
 
+using zlib::DictionaryData;
+using zlib::DictionaryObject;
+
 // Fewer than 64 bytes per chunk is not recommended.
 // Technically it could work with as few as 8, but even 64 bytes
 // is low.  Usually a MB or more is best.
@@ -121,6 +260,57 @@ struct CompressionError {
   inline bool IsError() const { return code != nullptr; }
 };
 
+// The preset dictionary of a stream. A zlib.Dictionary is shared, anything
+// else is copied.
+class ZlibDictionary : public MemoryRetainer {
+ public:
+  ZlibDictionary() = default;
+  ZlibDictionary(ZlibDictionary&&) = default;
+  ZlibDictionary& operator=(ZlibDictionary&&) = default;
+
+  ZlibDictionary(const ZlibDictionary&) = delete;
+  ZlibDictionary& operator=(const ZlibDictionary&) = delete;
+
+  // Leaves the dictionary empty if |value| is neither a Buffer nor a
+  // zlib.Dictionary.
+  void Set(Environment* env, Local<Value> value) {
+    clear();
+    if (Buffer::HasInstance(value)) {
+      const unsigned char* data =
+          reinterpret_cast<unsigned char*>(Buffer::Data(value));
+      data_ = std::make_shared<const std::vector<unsigned char>>(
+          data, data + Buffer::Length(value));
+      shared_ = false;
+    } else if (DictionaryObject::HasInstance(env, value)) {
+      data_ = Unwrap<DictionaryObject>(value.As<Object>())->data();
+      shared_ = true;
+    }
+  }
+
+  inline const unsigned char* data() const {
+    return data_ ? data_->data() : nullptr;
+  }
+  inline size_t size() const { return data_ ? data_->size() : 0; }
+  inline bool empty() const { return size() == 0; }
+
+  void clear() {
+    data_.reset();
+    shared_ = false;
+  }
+
+  // Shared data is attributed to the zlib.Dictionary.
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    if (data_ && !shared_)
+      tracker->TrackFieldWithSize("copy", data_->size());
+  }
+  SET_MEMORY_INFO_NAME(ZlibDictionary)
+  SET_SELF_SIZE(ZlibDictionary)
+
+ private:
+  DictionaryData data_;
+  bool shared_ = false;
+};
+
 class ZlibContext : public MemoryRetainer {
  public:
   ZlibContext() = default;
@@ -136,8 +326,11 @@ class ZlibContext : public MemoryRetainer {
   CompressionError ResetStream();
 
   // Zlib-specific:
+  // Deflate streams without a dictionary are taken from |pool| if it is not
+  // nullptr, and given back to it on Close().
   CompressionError Init(int level, int window_bits, int mem_level, int strategy,
-                        std::vector<unsigned char>&& dictionary);
+                        ZlibDictionary&& dictionary,
+                        ZlibContextPool* pool);
   void SetAllocationFunctions(alloc_func alloc, free_func free, void* opaque);
   CompressionError SetParams(int level, int strategy);
 
@@ -163,9 +356,14 @@ class ZlibContext : public MemoryRetainer {
   int strategy_ = 0;
   int window_bits_ = 0;
   unsigned int gzip_id_bytes_read_ = 0;
-  std::vector<unsigned char> dictionary_;
-
-  z_stream strm_;
+  ZlibDictionary dictionary_;
+  ZlibContextPool* pool_ = nullptr;
+  size_t pooled_size_ = 0;
+
+  // This is on the heap so that it can be kept in a ZlibContextPool;
+  // deflate's internal state points back to it. It is nullptr after the
+  // stream has been given back to the pool.
+  std::unique_ptr<z_stream> strm_ = std::make_unique<z_stream>();
 };
 
 // Brotli has different data types for compression and decompression streams,
@@ -595,14 +793,8 @@ class ZlibStream : public CompressionStream<ZlibContext> {
     CHECK(args[5]->IsFunction());
     Local<Function> write_js_callback = args[5].As<Function>();
 
-    std::vector<unsigned char> dictionary;
-    if (Buffer::HasInstance(args[6])) {
-      unsigned char* data =
-          reinterpret_cast<unsigned char*>(Buffer::Data(args[6]));
-      dictionary = std::vector<unsigned char>(
-          data,
-          data + Buffer::Length(args[6]));
-    }
+    ZlibDictionary dictionary;
+    dictionary.Set(wrap->env(), args[6]);
 
     wrap->InitStream(write_result, write_js_callback);
 
@@ -611,7 +803,8 @@ class ZlibStream : public CompressionStream<ZlibContext> {
         AllocForZlib, FreeForZlib, static_cast<CompressionStream*>(wrap));
     const CompressionError err =
         wrap->context()->Init(level, window_bits, mem_level, strategy,
-                              std::move(dictionary));
+                              std::move(dictionary),
+                              wrap->env()->zlib_context_pool());
     if (err.IsError())
       wrap->EmitError(err);
 
@@ -717,15 +910,628 @@ class BrotliCompressionStream : public CompressionStream<CompressionContext> {
 using BrotliEncoderStream = BrotliCompressionStream<BrotliEncoderContext>;
 using BrotliDecoderStream = BrotliCompressionStream<BrotliDecoderContext>;
 
+// Compresses a deflate, zlib or gzip stream on several threads of the
+// threadpool at once, the way pigz does it. The input is cut into blocks that
+// are compressed independently of each other, each one primed with the input
+// that came before it as its dictionary so that back-references may still
+// reach across block boundaries. Every block but the last ends with a sync
+// flush, which ends it on a byte boundary, so that the compressed blocks can
+// be concatenated as they are. Only the first block has a header; the
+// trailer is written separately, with the check value of the whole stream
+// combined from the check values of the blocks.
+//
+// This implements the same interface towards JS land as ZlibStream. A write
+// only finishes once all of its input has been taken over into blocks and,
+// for flushes, all of the blocks have been written to the output buffer.
+class ParallelDeflateStream : public AsyncWrap {
+ public:
+  ParallelDeflateStream(Environment* env,
+                        Local<Object> wrap,
+                        node_zlib_mode mode)
+      : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB),
+        mode_(mode) {
+    CHECK(mode == DEFLATE || mode == GZIP || mode == DEFLATERAW);
+    MakeWeak();
+  }
+
+  ~ParallelDeflateStream() override {
+    DropBlocks();
+  }
+
+  static void New(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    CHECK(args[0]->IsInt32());
+    node_zlib_mode mode =
+        static_cast<node_zlib_mode>(args[0].As<Int32>()->Value());
+    new ParallelDeflateStream(env, args.This(), mode);
+  }
+
+  static void Init(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args.Length() == 9 &&
+      "init(windowBits, level, memLevel, strategy, writeResult, writeCallback,"
+      " dictionary, blockSize, concurrency)");
+
+    ParallelDeflateStream* wrap;
+    ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+    Local<Context> context = args.GetIsolate()->GetCurrentContext();
+
+    uint32_t window_bits, mem_level, strategy, block_size, concurrency;
+    int32_t level;
+    if (!args[0]->Uint32Value(context).To(&window_bits) ||
+        !args[1]->Int32Value(context).To(&level) ||
+        !args[2]->Uint32Value(context).To(&mem_level) ||
+        !args[3]->Uint32Value(context).To(&strategy) ||
+        !args[7]->Uint32Value(context).To(&block_size) ||
+        !args[8]->Uint32Value(context).To(&concurrency)) {
+      return;
+    }
+
+    CHECK((window_bits >= Z_MIN_WINDOWBITS &&
+           window_bits <= Z_MAX_WINDOWBITS) && "invalid windowBits");
+    CHECK((level >= Z_MIN_LEVEL && level <= Z_MAX_LEVEL) &&
+          "invalid compression level");
+    CHECK((mem_level >= Z_MIN_MEMLEVEL && mem_level <= Z_MAX_MEMLEVEL) &&
+          "invalid memlevel");
+    CHECK((strategy == Z_FILTERED || strategy == Z_HUFFMAN_ONLY ||
+           strategy == Z_RLE || strategy == Z_FIXED ||
+           strategy == Z_DEFAULT_STRATEGY) && "invalid strategy");
+    CHECK_GT(block_size, 0);
+    CHECK_GT(concurrency, 0);
+
+    CHECK(args[4]->IsUint32Array());
+    Local<ArrayBuffer> ab = args[4].As<Uint32Array>()->Buffer();
+    wrap->write_result_ = static_cast<uint32_t*>(ab->GetContents().Data());
+
+    CHECK(args[5]->IsFunction());
+    wrap->write_js_callback_.Reset(args.GetIsolate(), args[5].As<Function>());
+
+    // Like ZlibContext, this ignores the dictionary for gzip streams. Each
+    // block needs its own copy of it anyway.
+    ZlibDictionary dictionary;
+    dictionary.Set(wrap->env(), args[6]);
+    if (wrap->mode_ != GZIP) {
+      wrap->dictionary_.assign(dictionary.data(),
+                               dictionary.data() + dictionary.size());
+    }
+
+    // zlib turns a window size of 256 bytes into 512 bytes for zlib streams
+    // and rejects it for raw streams, which are used for all but the first
+    // block here.
+    wrap->window_bits_ = std::max<int>(window_bits, 9);
+    wrap->level_ = level;
+    wrap->mem_level_ = mem_level;
+    wrap->strategy_ = strategy;
+    wrap->block_size_ = block_size;
+    wrap->concurrency_ = concurrency;
+    wrap->ResetStream();
+    wrap->init_done_ = true;
+
+    args.GetReturnValue().Set(true);
+  }
+
+  static void Params(const FunctionCallbackInfo<Value>& args) {
+    CHECK(args.Length() == 2 && "params(level, strategy)");
+    ParallelDeflateStream* wrap;
+    ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+    Local<Context> context = args.GetIsolate()->GetCurrentContext();
+    int level;
+    if (!args[0]->Int32Value(context).To(&level)) return;
+    int strategy;
+    if (!args[1]->Int32Value(context).To(&strategy)) return;
+
+    // The new parameters apply from the next block on; JS land flushes
+    // before calling this, which ends the current block.
+    wrap->level_ = level;
+    wrap->strategy_ = strategy;
+  }
+
+  static void Reset(const FunctionCallbackInfo<Value>& args) {
+    ParallelDeflateStream* wrap;
+    ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+    wrap->DropBlocks();
+    wrap->ResetStream();
+  }
+
+  static void Close(const FunctionCallbackInfo<Value>& args) {
+    ParallelDeflateStream* wrap;
+    ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+    wrap->Close();
+  }
+
+  // write(flush, in, in_off, in_len, out, out_off, out_len)
+  template <bool async>
+  static void Write(const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+    Local<Context> context = env->context();
+    CHECK_EQ(args.Length(), 7);
+
+    uint32_t in_off, in_len, out_off, out_len, flush;
+    const char* in = nullptr;
+    in_len = 0;
+
+    if (!args[0]->Uint32Value(context).To(&flush)) return;
+    CHECK((flush == Z_NO_FLUSH || flush == Z_PARTIAL_FLUSH ||
+           flush == Z_SYNC_FLUSH || flush == Z_FULL_FLUSH ||
+           flush == Z_FINISH || flush == Z_BLOCK) && "Invalid flush value");
+
+    if (!args[1]->IsNull()) {
+      CHECK(Buffer::HasInstance(args[1]));
+      Local<Object> in_buf = args[1].As<Object>();
+      if (!args[2]->Uint32Value(context).To(&in_off)) return;
+      if (!args[3]->Uint32Value(context).To(&in_len)) return;
+      CHECK(Buffer::IsWithinBounds(in_off, in_len, Buffer::Length(in_buf)));
+      in = Buffer::Data(in_buf) + in_off;
+    }
+
+    CHECK(Buffer::HasInstance(args[4]));
+    Local<Object> out_buf = args[4].As<Object>();
+    if (!args[5]->Uint32Value(context).To(&out_off)) return;
+    if (!args[6]->Uint32Value(context).To(&out_len)) return;
+    CHECK(Buffer::IsWithinBounds(out_off, out_len, Buffer::Length(out_buf)));
+    char* out = Buffer::Data(out_buf) + out_off;
+
+    ParallelDeflateStream* wrap;
+    ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+    wrap->Write<async>(flush, in, in_len, out, out_len);
+  }
+
+  template <bool async>
+  void Write(int flush,
+             const char* in, uint32_t in_len,
+             char* out, uint32_t out_len) {
+    CHECK(init_done_ && "write before init");
+    CHECK(!closed_ && "already finalized");
+    CHECK_EQ(false, write_in_progress_);
+
+    flush_ = flush;
+    next_in_ = in;
+    avail_in_ = in_len;
+    next_out_ = out;
+    avail_out_ = out_len;
+
+    if (!async) {
+      env()->PrintSyncTrace();
+      if (running_ > 0) {
+        // There is no way to wait for the threadpool here.
+        error_ = CompressionError(
+            "Synchronous write while blocks are being compressed",
+            "Z_STREAM_ERROR", Z_STREAM_ERROR);
+      } else {
+        sync_ = true;
+        CHECK(Advance());
+        sync_ = false;
+      }
+      if (error_.IsError()) {
+        EmitError(error_);
+        return;
+      }
+      UpdateWriteResult();
+      return;
+    }
+
+    write_in_progress_ = true;
+    Ref();
+    if (Advance()) {
+      // Like for ZlibStream, the callback for the write is always called
+      // asynchronously.
+      env()->SetImmediate([this](Environment*) {
+        if (write_in_progress_)
+          FinishWrite();
+      }, object());
+    }
+  }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackField("dictionary", dictionary_);
+    tracker->TrackField("input", input_);
+    tracker->TrackField("window", window_);
+    // The output of blocks on the threadpool may still be resized.
+    size_t block_memory = 0;
+    for (const auto& block : blocks_) {
+      block_memory += block->input_.capacity();
+      if (block->done_)
+        block_memory += block->output_.capacity();
+    }
+    tracker->TrackFieldWithSize("blocks", block_memory);
+  }
+
+  SET_MEMORY_INFO_NAME(ParallelDeflateStream)
+  SET_SELF_SIZE(ParallelDeflateStream)
+
+ private:
+  class Block : public ThreadPoolWork {
+   public:
+    Block(ParallelDeflateStream* stream, int flush)
+        : ThreadPoolWork(stream->env()),
+          stream_(stream),
+          mode_(stream->mode_),
+          first_(!stream->started_),
+          flush_(flush),
+          level_(stream->level_),
+          window_bits_(stream->window_bits_),
+          mem_level_(stream->mem_level_),
+          strategy_(stream->strategy_) {}
+
+    void DoThreadPoolWork() override;
+    void AfterThreadPoolWork(int status) override;
+
+    ParallelDeflateStream* stream_;
+    const node_zlib_mode mode_;
+    const bool first_;
+    const int flush_;
+    const int level_;
+    const int window_bits_;
+    const int mem_level_;
+    const int strategy_;
+    std::vector<char> input_;
+    std::vector<unsigned char> dictionary_;
+    std::vector<char> output_;
+    size_t output_offset_ = 0;
+    uLong check_ = 0;
+    int err_ = Z_OK;
+    const char* message_ = nullptr;
+    bool done_ = false;
+    bool combined_ = false;
+    // Set when the stream no longer needs the block while it is still being
+    // compressed. The block deletes itself once it is done.
+    bool orphaned_ = false;
+  };
+
+  void Close() {
+    if (closed_)
+      return;
+    closed_ = true;
+    if (write_in_progress_) {
+      write_in_progress_ = false;
+      Unref();
+    }
+    DropBlocks();
+    input_.clear();
+    window_.clear();
+    dictionary_.clear();
+  }
+
+  void ResetStream() {
+    started_ = false;
+    finishing_ = false;
+    input_.clear();
+    input_.reserve(block_size_);
+    // A preset dictionary is history for the first blocks, too.
+    window_.clear();
+    AppendToWindow(reinterpret_cast<const char*>(dictionary_.data()),
+                   dictionary_.size());
+    check_ = mode_ == GZIP ? crc32(0, Z_NULL, 0) : adler32(0, Z_NULL, 0);
+    total_in_ = 0;
+    error_ = CompressionError {};
+  }
+
+  void DropBlocks() {
+    for (auto& block : blocks_) {
+      if (!block->done_) {
+        block->orphaned_ = true;
+        block.release();
+        Unref();
+      }
+    }
+    blocks_.clear();
+    running_ = 0;
+  }
+
+  // Keeps the last 2^windowBits bytes of input, which is all history that
+  // deflate can refer back to.
+  void AppendToWindow(const char* data, size_t length) {
+    const size_t window_size = size_t{1} << window_bits_;
+    if (length >= window_size) {
+      window_.assign(data + length - window_size, data + length);
+      return;
+    }
+    window_.insert(window_.end(), data, data + length);
+    if (window_.size() > window_size)
+      window_.erase(window_.begin(), window_.end() - window_size);
+  }
+
+  // Moves the input collected so far into a new block and starts compressing
+  // it.
+  void StartBlock(int flush) {
+    std::unique_ptr<Block> block = std::make_unique<Block>(this, flush);
+    block->dictionary_ = started_ ? window_ : dictionary_;
+    AppendToWindow(input_.data(), input_.size());
+    // After a full flush, decompression has to be able to start without
+    // any of the data before it.
+    if (flush == Z_FULL_FLUSH)
+      window_.clear();
+    block->input_.swap(input_);
+    input_.reserve(block_size_);
+    started_ = true;
+    if (flush == Z_FINISH)
+      finishing_ = true;
+
+    Block* raw = block.get();
+    blocks_.emplace_back(std::move(block));
+    if (sync_) {
+      raw->DoThreadPoolWork();
+      raw->done_ = true;
+    } else {
+      running_++;
+      Ref();
+      raw->ScheduleWork();
+    }
+  }
+
+  // Updates the check value of the stream with a block, in stream order, and
+  // appends the trailer to the last block.
+  void CombineBlock(Block* block) {
+    const uLong length = block->input_.size();
+    if (mode_ == GZIP)
+      check_ = crc32_combine(check_, block->check_, length);
+    else if (mode_ == DEFLATE)
+      check_ = adler32_combine(check_, block->check_, length);
+    total_in_ += length;
+    std::vector<char>().swap(block->input_);
+    block->combined_ = true;
+
+    // When the first block is also the last one, zlib writes the trailer.
+    if (block->flush_ != Z_FINISH || block->first_)
+      return;
+    std::vector<char>& out = block->output_;
+    if (mode_ == GZIP) {
+      for (int i = 0; i < 32; i += 8)
+        out.push_back(static_cast<char>(check_ >> i));
+      for (int i = 0; i < 32; i += 8)
+        out.push_back(static_cast<char>(total_in_ >> i));
+    } else if (mode_ == DEFLATE) {
+      for (int i = 24; i >= 0; i -= 8)
+        out.push_back(static_cast<char>(check_ >> i));
+    }
+  }
+
+  // Copies the output of finished blocks to the output buffer of the
+  // current write, in stream order. Returns false on error.
+  bool CopyOutput() {
+    while (!blocks_.empty() && blocks_.front()->done_) {
+      Block* block = blocks_.front().get();
+      if (!block->combined_) {
+        if (block->err_ != Z_OK) {
+          error_ = CompressionError(
+              block->message_ != nullptr ? block->message_ : "Zlib error",
+              ZlibStrerror(block->err_), block->err_);
+          return false;
+        }
+        CombineBlock(block);
+      }
+      const size_t length = std::min(
+          avail_out_, block->output_.size() - block->output_offset_);
+      memcpy(next_out_, block->output_.data() + block->output_offset_, length);
+      next_out_ += length;
+      avail_out_ -= length;
+      block->output_offset_ += length;
+      if (block->output_offset_ < block->output_.size())
+        break;
+      blocks_.pop_front();
+    }
+    return true;
+  }
+
+  // Makes as much progress with the current write as is possible without
+  // waiting for a block. Returns true once the write is done.
+  bool Advance() {
+    for (;;) {
+      if (!CopyOutput())
+        return true;
+      if (avail_out_ == 0)
+        return true;
+
+      if (avail_in_ > 0 && !finishing_) {
+        // Do not take over more input than there are threads to compress it.
+        if (blocks_.size() >= concurrency_) {
+          CHECK(!sync_);
+          return false;
+        }
+        const size_t length =
+            std::min(avail_in_, block_size_ - input_.size());
+        input_.insert(input_.end(), next_in_, next_in_ + length);
+        next_in_ += length;
+        avail_in_ -= length;
+        if (input_.size() == block_size_)
+          StartBlock(Z_SYNC_FLUSH);
+        continue;
+      }
+
+      if (flush_ == Z_NO_FLUSH)
+        return true;
+      if (flush_ == Z_FINISH && !finishing_) {
+        StartBlock(Z_FINISH);
+        continue;
+      }
+      if (flush_ != Z_FINISH && !input_.empty()) {
+        StartBlock(flush_ == Z_FULL_FLUSH ? Z_FULL_FLUSH : Z_SYNC_FLUSH);
+        continue;
+      }
+      // Flushes are done once everything has been written out.
+      CHECK_IMPLIES(sync_, blocks_.empty());
+      return blocks_.empty();
+    }
+  }
+
+  void OnBlockDone(Block* block) {
+    OnScopeLeave on_scope_leave([&]() { Unref(); });
+    block->done_ = true;
+    CHECK_GT(running_, 0);
+    running_--;
+    if (write_in_progress_ && Advance())
+      FinishWrite();
+  }
+
+  void UpdateWriteResult() {
+    write_result_[0] = avail_out_;
+    write_result_[1] = avail_in_;
+  }
+
+  void FinishWrite() {
+    OnScopeLeave on_scope_leave([&]() { Unref(); });
+    write_in_progress_ = false;
+
+    HandleScope handle_scope(env()->isolate());
+    Context::Scope context_scope(env()->context());
+
+    if (error_.IsError()) {
+      EmitError(error_);
+      return;
+    }
+
+    UpdateWriteResult();
+    Local<Function> cb = PersistentToLocal::Default(env()->isolate(),
+                                                    write_js_callback_);
+    MakeCallback(cb, 0, nullptr);
+  }
+
+  void EmitError(const CompressionError& err) {
+    CHECK_EQ(env()->context(), env()->isolate()->GetCurrentContext());
+
+    HandleScope scope(env()->isolate());
+    Local<Value> args[3] = {
+      OneByteString(env()->isolate(), err.message),
+      Integer::New(env()->isolate(), err.err),
+      OneByteString(env()->isolate(), err.code)
+    };
+    MakeCallback(env()->onerror_string(), arraysize(args), args);
+  }
+
+  void Ref() {
+    if (++refs_ == 1) {
+      ClearWeak();
+    }
+  }
+
+  void Unref() {
+    CHECK_GT(refs_, 0);
+    if (--refs_ == 0) {
+      MakeWeak();
+    }
+  }
+
+  const node_zlib_mode mode_;
+  int level_ = 0;
+  int window_bits_ = 0;
+  int mem_level_ = 0;
+  int strategy_ = 0;
+  size_t block_size_ = 0;
+  size_t concurrency_ = 0;
+  std::vector<unsigned char> dictionary_;
+
+  bool init_done_ = false;
+  bool closed_ = false;
+  bool write_in_progress_ = false;
+  bool sync_ = false;
+  unsigned int refs_ = 0;
+  uint32_t* write_result_ = nullptr;
+  Global<Function> write_js_callback_;
+  CompressionError error_;
+
+  // The current write.
+  int flush_ = Z_NO_FLUSH;
+  const char* next_in_ = nullptr;
+  size_t avail_in_ = 0;
+  char* next_out_ = nullptr;
+  size_t avail_out_ = 0;
+
+  // Whether the first block, which carries the header, has been started.
+  bool started_ = false;
+  // Whether the last block has been started.
+  bool finishing_ = false;
+  // Input for the next block.
+  std::vector<char> input_;
+  // The input before the next block, which it is primed with.
+  std::vector<unsigned char> window_;
+  // Blocks that have not been written out yet, in stream order.
+  std::deque<std::unique_ptr<Block>> blocks_;
+  // Blocks that are being compressed on the threadpool.
+  size_t running_ = 0;
+  uLong check_ = 0;
+  uLong total_in_ = 0;
+};
+
+void ParallelDeflateStream::Block::DoThreadPoolWork() {
+  // Only the first block has a header. All others are raw deflate data.
+  int window_bits = -window_bits_;
+  if (first_ && mode_ == GZIP)
+    window_bits = window_bits_ + 16;
+  else if (first_ && mode_ == DEFLATE)
+    window_bits = window_bits_;
+
+  // These allocations are short-lived and made on the threadpool, so they
+  // are not reported to V8.
+  z_stream strm;
+  strm.zalloc = Z_NULL;
+  strm.zfree = Z_NULL;
+  strm.opaque = Z_NULL;
+  err_ = deflateInit2(&strm, level_, Z_DEFLATED, window_bits, mem_level_,
+                      strategy_);
+  if (err_ != Z_OK) {
+    message_ = strm.msg;
+    return;
+  }
+
+  if (!dictionary_.empty())
+    err_ = deflateSetDictionary(&strm, dictionary_.data(), dictionary_.size());
+
+  if (err_ == Z_OK) {
+    strm.next_in = reinterpret_cast<Bytef*>(input_.data());
+    strm.avail_in = input_.size();
+    // A sync flush adds an empty stored block to the bound for Z_FINISH.
+    output_.resize(deflateBound(&strm, input_.size()) + 5);
+    size_t length = 0;
+    do {
+      if (length == output_.size())
+        output_.resize(output_.size() * 2);
+      strm.next_out = reinterpret_cast<Bytef*>(output_.data() + length);
+      strm.avail_out = output_.size() - length;
+      err_ = deflate(&strm, flush_ == Z_FINISH ? Z_FINISH : Z_SYNC_FLUSH);
+      length = output_.size() - strm.avail_out;
+    } while (err_ == Z_OK && strm.avail_out == 0);
+    output_.resize(length);
+    // Z_BUF_ERROR only means that a sync flush had nothing left to write.
+    if (err_ == Z_STREAM_END || err_ == Z_BUF_ERROR)
+      err_ = Z_OK;
+  }
+  message_ = strm.msg;
+  dictionary_.clear();
+
+  if (mode_ == GZIP) {
+    check_ = crc32(0, reinterpret_cast<Bytef*>(input_.data()), input_.size());
+  } else if (mode_ == DEFLATE) {
+    check_ = adler32(1, reinterpret_cast<Bytef*>(input_.data()),
+                     input_.size());
+  }
+
+  // This reports an error for blocks that were not finished, which is fine.
+  deflateEnd(&strm);
+}
+
+void ParallelDeflateStream::Block::AfterThreadPoolWork(int status) {
+  CHECK_EQ(status, 0);
+  if (orphaned_) {
+    delete this;
+    return;
+  }
+  stream_->OnBlockDone(this);
+}
+
 void ZlibContext::Close() {
   CHECK_LE(mode_, UNZIP);
 
   int status = Z_OK;
-  if (mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW) {
-    status = deflateEnd(&strm_);
+  if (pool_ != nullptr && mode_ != NONE) {
+    pool_->Release({ level_, window_bits_, mem_level_, strategy_ },
+                   pooled_size_,
+                   std::move(strm_));
+    pool_ = nullptr;
+  } else if (mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW) {
+    status = deflateEnd(strm_.get());
   } else if (mode_ == INFLATE || mode_ == GUNZIP || mode_ == INFLATERAW ||
              mode_ == UNZIP) {
-    status = inflateEnd(&strm_);
+    status = inflateEnd(strm_.get());
   }
 
   CHECK(status == Z_OK || status == Z_DATA_ERROR);
@@ -745,11 +1551,11 @@ void ZlibContext::DoThreadPoolWork() {
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflate(&strm_, flush_);
+      err_ = deflate(strm_.get(), flush_);
       break;
     case UNZIP:
-      if (strm_.avail_in > 0) {
-        next_expected_header_byte = strm_.next_in;
+      if (strm_->avail_in > 0) {
+        next_expected_header_byte = strm_->next_in;
       }
 
       switch (gzip_id_bytes_read_) {
@@ -762,7 +1568,7 @@ void ZlibContext::DoThreadPoolWork() {
             gzip_id_bytes_read_ = 1;
             next_expected_header_byte++;
 
-            if (strm_.avail_in == 1) {
+            if (strm_->avail_in == 1) {
               // The only available byte was already read.
               break;
             }
@@ -795,7 +1601,7 @@ void ZlibContext::DoThreadPoolWork() {
     case INFLATE:
     case GUNZIP:
     case INFLATERAW:
-      err_ = inflate(&strm_, flush_);
+      err_ = inflate(strm_.get(), flush_);
 
       // If data was encoded with dictionary (INFLATERAW will have it set in
       // SetDictionary, don't repeat that here)
@@ -803,12 +1609,12 @@ void ZlibContext::DoThreadPoolWork() {
           err_ == Z_NEED_DICT &&
           !dictionary_.empty()) {
         // Load it
-        err_ = inflateSetDictionary(&strm_,
+        err_ = inflateSetDictionary(strm_.get(),
                                     dictionary_.data(),
                                     dictionary_.size());
         if (err_ == Z_OK) {
           // And try to decode again
-          err_ = inflate(&strm_, flush_);
+          err_ = inflate(strm_.get(), flush_);
         } else if (err_ == Z_DATA_ERROR) {
           // Both inflateSetDictionary() and inflate() return Z_DATA_ERROR.
           // Make it possible for After() to tell a bad dictionary from bad
@@ -817,17 +1623,17 @@ void ZlibContext::DoThreadPoolWork() {
         }
       }
 
-      while (strm_.avail_in > 0 &&
+      while (strm_->avail_in > 0 &&
              mode_ == GUNZIP &&
              err_ == Z_STREAM_END &&
-             strm_.next_in[0] != 0x00) {
+             strm_->next_in[0] != 0x00) {
         // Bytes remain in input buffer. Perhaps this is another compressed
         // member in the same archive, or just trailing garbage.
         // Trailing zero bytes are okay, though, since they are frequently
         // used for padding.
 
         ResetStream();
-        err_ = inflate(&strm_, flush_);
+        err_ = inflate(strm_.get(), flush_);
       }
       break;
     default:
@@ -838,10 +1644,10 @@ void ZlibContext::DoThreadPoolWork() {
 
 void ZlibContext::SetBuffers(char* in, uint32_t in_len,
                              char* out, uint32_t out_len) {
-  strm_.avail_in = in_len;
-  strm_.next_in = reinterpret_cast<Bytef*>(in);
-  strm_.avail_out = out_len;
-  strm_.next_out = reinterpret_cast<Bytef*>(out);
+  strm_->avail_in = in_len;
+  strm_->next_in = reinterpret_cast<Bytef*>(in);
+  strm_->avail_out = out_len;
+  strm_->next_out = reinterpret_cast<Bytef*>(out);
 }
 
 
@@ -852,14 +1658,14 @@ void ZlibContext::SetFlush(int flush) {
 
 void ZlibContext::GetAfterWriteOffsets(uint32_t* avail_in,
                                        uint32_t* avail_out) const {
-  *avail_in = strm_.avail_in;
-  *avail_out = strm_.avail_out;
+  *avail_in = strm_->avail_in;
+  *avail_out = strm_->avail_out;
 }
 
 
 CompressionError ZlibContext::ErrorForMessage(const char* message) const {
-  if (strm_.msg != nullptr)
-    message = strm_.msg;
+  if (strm_ && strm_->msg != nullptr)
+    message = strm_->msg;
 
   return CompressionError { message, ZlibStrerror(err_), err_ };
 }
@@ -870,7 +1676,7 @@ CompressionError ZlibContext::GetErrorInfo() const {
   switch (err_) {
   case Z_OK:
   case Z_BUF_ERROR:
-    if (strm_.avail_out != 0 && flush_ == Z_FINISH) {
+    if (strm_->avail_out != 0 && flush_ == Z_FINISH) {
       return ErrorForMessage("unexpected end of file");
     }
   case Z_STREAM_END:
@@ -897,12 +1703,12 @@ CompressionError ZlibContext::ResetStream() {
     case DEFLATE:
     case DEFLATERAW:
     case GZIP:
-      err_ = deflateReset(&strm_);
+      err_ = deflateReset(strm_.get());
       break;
     case INFLATE:
     case INFLATERAW:
     case GUNZIP:
-      err_ = inflateReset(&strm_);
+      err_ = inflateReset(strm_.get());
       break;
     default:
       break;
@@ -918,15 +1724,15 @@ CompressionError ZlibContext::ResetStream() {
 void ZlibContext::SetAllocationFunctions(alloc_func alloc,
                                          free_func free,
                                          void* opaque) {
-  strm_.zalloc = alloc;
-  strm_.zfree = free;
-  strm_.opaque = opaque;
+  strm_->zalloc = alloc;
+  strm_->zfree = free;
+  strm_->opaque = opaque;
 }
 
 
 CompressionError ZlibContext::Init(
     int level, int window_bits, int mem_level, int strategy,
-    std::vector<unsigned char>&& dictionary) {
+    ZlibDictionary&& dictionary, ZlibContextPool* pool) {
   if (!((window_bits == 0) &&
         (mode_ == INFLATE ||
          mode_ == GUNZIP ||
@@ -972,7 +1778,19 @@ CompressionError ZlibContext::Init(
     case DEFLATE:
     case GZIP:
     case DEFLATERAW:
-      err_ = deflateInit2(&strm_,
+      // A preset dictionary changes the state of the stream in ways that
+      // deflateReset() does not undo, so those streams are not pooled.
+      if (pool != nullptr && dictionary.empty()) {
+        std::unique_ptr<z_stream> strm = pool->Acquire(
+            { level_, window_bits_, mem_level_, strategy_ },
+            &pooled_size_, &err_);
+        if (strm) {
+          strm_ = std::move(strm);
+          pool_ = pool;
+        }
+        break;
+      }
+      err_ = deflateInit2(strm_.get(),
                           level_,
                           Z_DEFLATED,
                           window_bits_,
@@ -983,7 +1801,7 @@ CompressionError ZlibContext::Init(
     case GUNZIP:
     case INFLATERAW:
     case UNZIP:
-      err_ = inflateInit2(&strm_, window_bits_);
+      err_ = inflateInit2(strm_.get(), window_bits_);
       break;
     default:
       UNREACHABLE();
@@ -1010,14 +1828,14 @@ CompressionError ZlibContext::SetDictionary() {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
-      err_ = deflateSetDictionary(&strm_,
+      err_ = deflateSetDictionary(strm_.get(),
                                   dictionary_.data(),
                                   dictionary_.size());
       break;
     case INFLATERAW:
       // The other inflate cases will have the dictionary set when inflate()
       // returns Z_NEED_DICT in Process()
-      err_ = inflateSetDictionary(&strm_,
+      err_ = inflateSetDictionary(strm_.get(),
                                   dictionary_.data(),
                                   dictionary_.size());
       break;
@@ -1039,7 +1857,12 @@ CompressionError ZlibContext::SetParams(int level, int strategy) {
   switch (mode_) {
     case DEFLATE:
     case DEFLATERAW:
-      err_ = deflateParams(&strm_, level, strategy);
+      err_ = deflateParams(strm_.get(), level, strategy);
+      // A pooled stream is given back under its current parameters.
+      if (err_ == Z_OK) {
+        level_ = level;
+        strategy_ = strategy;
+      }
       break;
     default:
       break;
@@ -1208,6 +2031,30 @@ CompressionError BrotliDecoderContext::GetErrorInfo() const {
 }
 
 
+void GetContextPoolStatistics(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ZlibContextPool* pool = env->zlib_context_pool();
+  if (pool == nullptr)
+    return;
+
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  const uint64_t* stats = pool->stats();
+  Local<Object> obj = Object::New(isolate);
+#define V(name, value)                                                        \
+  obj->Set(context,                                                           \
+           FIXED_ONE_BYTE_STRING(isolate, name),                              \
+           Number::New(isolate, static_cast<double>(value))).Check();
+  V("hits", stats[ZlibContextPool::kHits])
+  V("misses", stats[ZlibContextPool::kMisses])
+  V("released", stats[ZlibContextPool::kReleased])
+  V("evicted", stats[ZlibContextPool::kEvicted])
+  V("idle", pool->idle_count())
+  V("idleBytes", pool->idle_size())
+#undef V
+  args.GetReturnValue().Set(obj);
+}
+
 template <typename Stream>
 struct MakeClass {
   static void Make(Environment* env, Local<Object> target, const char* name) {
@@ -1241,6 +2088,14 @@ void Initialize(Local<Object> target,
   MakeClass<ZlibStream>::Make(env, target, "Zlib");
   MakeClass<BrotliEncoderStream>::Make(env, target, "BrotliEncoder");
   MakeClass<BrotliDecoderStream>::Make(env, target, "BrotliDecoder");
+  MakeClass<ParallelDeflateStream>::Make(env, target, "ParallelDeflate");
+
+  env->SetMethod(target, "getContextPoolStatistics", GetContextPoolStatistics);
+
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(env->isolate(), "Dictionary"),
+              DictionaryObject::GetConstructorTemplate(env)
+                  ->GetFunction(env->context()).ToLocalChecked()).Check();
 
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "ZLIB_VERSION"),
@@ -1249,6 +2104,110 @@ void Initialize(Local<Object> target,
 
 }  // anonymous namespace
 
+ZlibContextPool::ZlibContextPool(Environment* env, size_t max_size)
+    : env_(env), max_size_(max_size) {}
+
+ZlibContextPool::~ZlibContextPool() {
+  while (!idle_.empty()) {
+    FreeStream(std::move(idle_.front().strm));
+    idle_.pop_front();
+  }
+  AdjustAmountOfExternalAllocatedMemory();
+}
+
+std::unique_ptr<z_stream> ZlibContextPool::Acquire(const Key& key,
+                                                   size_t* size,
+                                                   int* err) {
+  for (auto it = idle_.rbegin(); it != idle_.rend(); ++it) {
+    if (!(it->key == key))
+      continue;
+    std::unique_ptr<z_stream> strm = std::move(it->strm);
+    *size = it->size;
+    idle_size_ -= it->size;
+    idle_.erase(std::next(it).base());
+    stats_[kHits]++;
+    *err = Z_OK;
+    return strm;
+  }
+
+  stats_[kMisses]++;
+  std::unique_ptr<z_stream> strm = std::make_unique<z_stream>();
+  strm->zalloc = Alloc;
+  strm->zfree = Free;
+  strm->opaque = this;
+  const size_t allocated_before = allocated_;
+  *err = deflateInit2(strm.get(), key.level, Z_DEFLATED, key.window_bits,
+                      key.mem_level, key.strategy);
+  *size = allocated_ - allocated_before;
+  AdjustAmountOfExternalAllocatedMemory();
+  if (*err != Z_OK)
+    return nullptr;
+  return strm;
+}
+
+void ZlibContextPool::Release(const Key& key,
+                              size_t size,
+                              std::unique_ptr<z_stream> strm) {
+  if (size > max_size_ || deflateReset(strm.get()) != Z_OK) {
+    FreeStream(std::move(strm));
+    AdjustAmountOfExternalAllocatedMemory();
+    return;
+  }
+
+  while (idle_size_ + size > max_size_) {
+    idle_size_ -= idle_.front().size;
+    FreeStream(std::move(idle_.front().strm));
+    idle_.pop_front();
+    stats_[kEvicted]++;
+  }
+  AdjustAmountOfExternalAllocatedMemory();
+
+  idle_.push_back(Entry { key, size, std::move(strm) });
+  idle_size_ += size;
+  stats_[kReleased]++;
+}
+
+void ZlibContextPool::MemoryInfo(MemoryTracker* tracker) const {
+  tracker->TrackFieldWithSize("idle_streams", idle_size_);
+}
+
+// Like CompressionStream's allocation functions, this stores the size of
+// each allocation in front of it.
+void* ZlibContextPool::Alloc(void* data, uInt items, uInt size) {
+  ZlibContextPool* pool = static_cast<ZlibContextPool*>(data);
+  size_t real_size =
+      MultiplyWithOverflowCheck(static_cast<size_t>(items),
+                                static_cast<size_t>(size)) + sizeof(size_t);
+  char* memory = UncheckedMalloc(real_size);
+  if (UNLIKELY(memory == nullptr)) return nullptr;
+  *reinterpret_cast<size_t*>(memory) = real_size;
+  pool->allocated_ += real_size;
+  return memory + sizeof(size_t);
+}
+
+void ZlibContextPool::Free(void* data, void* pointer) {
+  if (UNLIKELY(pointer == nullptr)) return;
+  ZlibContextPool* pool = static_cast<ZlibContextPool*>(data);
+  char* real_pointer = static_cast<char*>(pointer) - sizeof(size_t);
+  size_t real_size = *reinterpret_cast<size_t*>(real_pointer);
+  CHECK_GE(pool->allocated_, real_size);
+  pool->allocated_ -= real_size;
+  free(real_pointer);
+}
+
+void ZlibContextPool::FreeStream(std::unique_ptr<z_stream> strm) {
+  const int status = deflateEnd(strm.get());
+  CHECK(status == Z_OK || status == Z_DATA_ERROR);
+}
+
+void ZlibContextPool::AdjustAmountOfExternalAllocatedMemory() {
+  const int64_t change = static_cast<int64_t>(allocated_) -
+                         static_cast<int64_t>(reported_);
+  if (change == 0) return;
+  reported_ = allocated_;
+  env_->isolate()->AdjustAmountOfExternalAllocatedMemory(change);
+}
+
 void DefineZlibConstants(Local<Object> target) {
   NODE_DEFINE_CONSTANT(target, Z_NO_FLUSH);
   NODE_DEFINE_CONSTANT(target, Z_PARTIAL_FLUSH);
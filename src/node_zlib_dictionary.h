@@ -0,0 +1,56 @@
+#ifndef SRC_NODE_ZLIB_DICTIONARY_H_
+#define SRC_NODE_ZLIB_DICTIONARY_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "base_object.h"
+#include "v8.h"
+
+#include <memory>
+#include <vector>
+
+namespace node {
+
+class Environment;
+
+namespace zlib {
+
+// The contents of a zlib.Dictionary. They are never modified after they have
+// been copied in, so any number of streams can read them on the threadpool,
+// and in other threads, without synchronization.
+using DictionaryData = std::shared_ptr<const std::vector<unsigned char>>;
+
+// The JS zlib.Dictionary object. Posting it to a Worker creates an object
+// there that refers to the same data.
+class DictionaryObject : public BaseObject {
+ public:
+  static v8::Local<v8::FunctionTemplate> GetConstructorTemplate(
+      Environment* env);
+  static bool HasInstance(Environment* env, v8::Local<v8::Value> value);
+  static v8::MaybeLocal<v8::Object> Create(Environment* env,
+                                            DictionaryData data);
+
+  inline const DictionaryData& data() const { return data_; }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(DictionaryObject)
+  SET_SELF_SIZE(DictionaryObject)
+
+ private:
+  DictionaryObject(Environment* env,
+                   v8::Local<v8::Object> object,
+                   DictionaryData data);
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetByteLength(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  DictionaryData data_;
+};
+
+}  // namespace zlib
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_ZLIB_DICTIONARY_H_
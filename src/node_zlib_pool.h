@@ -0,0 +1,103 @@
+#ifndef SRC_NODE_ZLIB_POOL_H_
+#define SRC_NODE_ZLIB_POOL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "memory_tracker.h"
+#include "zlib.h"
+
+#include <deque>
+#include <memory>
+
+namespace node {
+
+class Environment;
+
+// Keeps the deflate streams of closed zlib compression streams around for
+// reuse by new streams with the same parameters. deflateInit2() allocates
+// about 256 KiB of window and hash tables with the default parameters, which
+// can cost more than compressing a small HTTP response; deflateReset() only
+// clears the hash table.
+// The memory of all streams created by the pool, in use or idle, is reported
+// to V8 as external memory. Only idle streams count towards the size limit.
+// The pool is only created when `--zlib-context-pool-size` is non-zero.
+class ZlibContextPool : public MemoryRetainer {
+ public:
+  enum StatsFields {
+    kHits,       // Streams that were taken from the pool.
+    kMisses,     // Streams that had to be created.
+    kReleased,   // Streams that were given back for reuse.
+    kEvicted,    // Idle streams that were freed to stay within the limit.
+    kStatsFieldCount
+  };
+
+  // deflateInit2() parameters. window_bits includes the offset for gzip and
+  // the sign for raw streams.
+  struct Key {
+    int level;
+    int window_bits;
+    int mem_level;
+    int strategy;
+
+    bool operator==(const Key& other) const {
+      return level == other.level &&
+             window_bits == other.window_bits &&
+             mem_level == other.mem_level &&
+             strategy == other.strategy;
+    }
+  };
+
+  ZlibContextPool(Environment* env, size_t max_size);
+  ~ZlibContextPool() override;
+
+  ZlibContextPool(const ZlibContextPool&) = delete;
+  ZlibContextPool& operator=(const ZlibContextPool&) = delete;
+
+  // Returns a stream that deflateInit2() has been called on, preferably an
+  // idle one. |*size| is set to the memory that the stream uses, which has to
+  // be passed back to Release(). Returns nullptr and sets |*err| if creating
+  // a new stream failed.
+  std::unique_ptr<z_stream> Acquire(const Key& key, size_t* size, int* err);
+  // Resets a stream that is no longer used and keeps it for reuse. Frees it
+  // instead if it cannot be reset or if the pool would grow too large.
+  void Release(const Key& key, size_t size, std::unique_ptr<z_stream> strm);
+
+  inline size_t idle_count() const { return idle_.size(); }
+  inline size_t idle_size() const { return idle_size_; }
+  inline const uint64_t* stats() const { return stats_; }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(ZlibContextPool)
+  SET_SELF_SIZE(ZlibContextPool)
+
+ private:
+  struct Entry {
+    Key key;
+    size_t size;
+    std::unique_ptr<z_stream> strm;
+  };
+
+  // All allocations happen in deflateInit2() and deflateEnd(), which are
+  // only called on the main thread.
+  static void* Alloc(void* data, uInt items, uInt size);
+  static void Free(void* data, void* pointer);
+  void FreeStream(std::unique_ptr<z_stream> strm);
+  void AdjustAmountOfExternalAllocatedMemory();
+
+  Environment* const env_;
+  const size_t max_size_;
+  // Memory allocated for the streams of this pool, and the part of it that
+  // has been reported to V8.
+  size_t allocated_ = 0;
+  size_t reported_ = 0;
+  // Idle streams, least recently used first.
+  std::deque<Entry> idle_;
+  size_t idle_size_ = 0;
+  uint64_t stats_[kStatsFieldCount] = {};
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_NODE_ZLIB_POOL_H_
@@ -7,10 +7,12 @@
 #include "node_errors.h"
 #include "env-inl.h"
 #include "js_stream.h"
+#include "memory_tracker-inl.h"
 #include "string_bytes.h"
 #include "util-inl.h"
 #include "v8.h"
 
+#include <algorithm>
 #include <climits>  // INT_MAX
 
 namespace node {
@@ -25,12 +27,14 @@ using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::HandleScope;
 using v8::Integer;
+using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
 using v8::Object;
 using v8::ReadOnly;
 using v8::String;
 using v8::Value;
+using v8::WeakCallbackInfo;
 
 template int StreamBase::WriteString<ASCII>(
     const FunctionCallbackInfo<Value>& args);
@@ -463,6 +467,13 @@ void StreamResource::ClearError() {
 uv_buf_t EmitToJSStreamListener::OnStreamAlloc(size_t suggested_size) {
   CHECK_NOT_NULL(stream_);
   Environment* env = static_cast<StreamBase*>(stream_)->stream_env();
+  StreamReadPool* pool = env->stream_read_pool();
+  if (pool != nullptr) {
+    uv_buf_t buf = pool->Reserve(suggested_size);
+    if (buf.base != nullptr)
+      return buf;
+    pool->CountUnpooledRead();
+  }
   return env->AllocateManaged(suggested_size).release();
 }
 
@@ -472,6 +483,22 @@ void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf_) {
   Environment* env = stream->stream_env();
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
+
+  StreamReadPool* pool = env->stream_read_pool();
+  if (pool != nullptr && pool->Owns(buf_)) {
+    if (nread <= 0) {
+      pool->Release();
+      if (nread < 0)
+        stream->CallJSOnreadMethod(nread, Local<ArrayBuffer>());
+      return;
+    }
+
+    size_t offset;
+    Local<ArrayBuffer> ab = pool->Commit(nread, &offset);
+    stream->CallJSOnreadMethod(nread, ab, offset);
+    return;
+  }
+
   AllocatedBuffer buf(env, buf_);
 
   if (nread <= 0)  {
@@ -487,6 +514,184 @@ void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf_) {
 }
 
 
+StreamReadPool::StreamReadPool(Environment* env, size_t slab_size)
+    : env_(env), slab_size_(slab_size) {
+  CHECK_GT(slab_size_, 0);
+}
+
+
+StreamReadPool::~StreamReadPool() {
+  // The Environment is going away, so no more JS code can access the views
+  // that may still point into the slabs.
+  if (current_ != nullptr)
+    FreeSlab(current_);
+  for (Slab* slab : retired_)
+    FreeSlab(slab);
+  for (Slab* slab : spare_)
+    FreeSlab(slab);
+}
+
+
+StreamReadPool::Slab* StreamReadPool::NewSlab() {
+  // Slabs are handed to JS as a whole through `buf.buffer`, and are shared
+  // by all streams. They have to start out zero-filled so that one stream
+  // cannot see what was read from another one, or uninitialized memory.
+  if (!spare_.empty()) {
+    Slab* slab = spare_.back();
+    spare_.pop_back();
+    memset(slab->data, 0, slab_size_);
+    stats_[kSlabsReused]++;
+    return slab;
+  }
+
+  char* data = static_cast<char*>(
+      env_->isolate_data()->allocator()->Allocate(slab_size_));
+  if (data == nullptr)
+    return nullptr;
+  env_->isolate()->AdjustAmountOfExternalAllocatedMemory(slab_size_);
+  stats_[kSlabsAllocated]++;
+  return new Slab { this, data, {} };
+}
+
+
+void StreamReadPool::FreeSlab(Slab* slab) {
+  slab->buffer.Reset();
+  env_->Free(slab->data, slab_size_);
+  env_->isolate()->AdjustAmountOfExternalAllocatedMemory(
+      -static_cast<int64_t>(slab_size_));
+  delete slab;
+}
+
+
+void StreamReadPool::RetireCurrentSlab() {
+  if (current_ == nullptr)
+    return;
+  if (current_->buffer.IsEmpty()) {
+    // No views were ever handed out for this slab, so it can be reused as-is.
+    spare_.push_back(current_);
+  } else {
+    retired_.insert(current_);
+  }
+  current_ = nullptr;
+  offset_ = 0;
+}
+
+
+uv_buf_t StreamReadPool::Reserve(size_t suggested_size) {
+  // libuv always calls the read callback right after the allocation callback,
+  // but nothing in the StreamListener contract guarantees that. Do not hand
+  // out overlapping regions if a reservation is still outstanding.
+  if (reserved_)
+    return uv_buf_init(nullptr, 0);
+
+  if (current_ != nullptr && slab_size_ - offset_ < kMinReservation &&
+      slab_size_ - offset_ < suggested_size) {
+    RetireCurrentSlab();
+  }
+
+  if (current_ == nullptr) {
+    current_ = NewSlab();
+    offset_ = 0;
+    if (current_ == nullptr)
+      return uv_buf_init(nullptr, 0);
+  }
+
+  reserved_ = true;
+  reserved_offset_ = offset_;
+  reserved_length_ = std::min(suggested_size, slab_size_ - offset_);
+  return uv_buf_init(current_->data + reserved_offset_, reserved_length_);
+}
+
+
+bool StreamReadPool::Owns(const uv_buf_t& buf) const {
+  return reserved_ &&
+         current_ != nullptr &&
+         buf.base == current_->data + reserved_offset_;
+}
+
+
+void StreamReadPool::Release() {
+  CHECK(reserved_);
+  reserved_ = false;
+}
+
+
+Local<ArrayBuffer> StreamReadPool::Commit(size_t nread, size_t* offset) {
+  CHECK(reserved_);
+  CHECK_NOT_NULL(current_);
+  CHECK_LE(nread, reserved_length_);
+  reserved_ = false;
+
+  Isolate* isolate = env_->isolate();
+  Local<ArrayBuffer> ab;
+  if (current_->buffer.IsEmpty()) {
+    ab = ArrayBuffer::New(isolate,
+                          current_->data,
+                          slab_size_,
+                          v8::ArrayBufferCreationMode::kExternalized);
+    current_->buffer.Reset(isolate, ab);
+    current_->buffer.SetWeak(current_,
+                             WeakCallback,
+                             v8::WeakCallbackType::kParameter);
+  } else {
+    ab = PersistentToLocal::Default(isolate, current_->buffer);
+  }
+
+  *offset = reserved_offset_;
+  // Keep subsequent views 8-byte aligned, so that they can be used to back
+  // typed arrays with larger element sizes, like `Buffer.allocUnsafe()` does.
+  offset_ = std::min(RoundUp<size_t>(reserved_offset_ + nread, 8), slab_size_);
+  stats_[kPooledReads]++;
+  stats_[kPooledBytes] += nread;
+  return ab;
+}
+
+
+void StreamReadPool::WeakCallback(const WeakCallbackInfo<Slab>& data) {
+  Slab* slab = data.GetParameter();
+  slab->buffer.Reset();
+  slab->pool->OnSlabCollected(slab);
+}
+
+
+void StreamReadPool::OnSlabCollected(Slab* slab) {
+  stats_[kSlabsCollected]++;
+
+  if (slab == current_) {
+    // All views into the current slab are gone. The data they covered is
+    // cleared before the slab is handed to JS again, and unless a read into
+    // it is in progress, it is filled from the beginning again.
+    memset(slab->data, 0, reserved_ ? reserved_offset_ : offset_);
+    if (!reserved_)
+      offset_ = 0;
+    return;
+  }
+
+  // This runs during garbage collection, where calling into V8 is not
+  // allowed, and freeing the slab adjusts the external memory. The slab stays
+  // in retired_ until then, so that it is freed with the pool if the
+  // Environment goes away first.
+  env_->SetUnrefImmediate([this, slab](Environment* env) {
+    RecycleSlab(slab);
+  });
+}
+
+
+void StreamReadPool::RecycleSlab(Slab* slab) {
+  CHECK_EQ(retired_.erase(slab), 1);
+  if (spare_.size() < kMaxSpareSlabs)
+    spare_.push_back(slab);
+  else
+    FreeSlab(slab);
+}
+
+
+void StreamReadPool::MemoryInfo(MemoryTracker* tracker) const {
+  size_t slabs = retired_.size() + spare_.size() + (current_ != nullptr);
+  tracker->TrackFieldWithSize("slabs", slabs * slab_size_);
+}
+
+
 uv_buf_t CustomBufferJSListener::OnStreamAlloc(size_t suggested_size) {
   return buffer_;
 }
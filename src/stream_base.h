@@ -180,6 +180,84 @@ class EmitToJSStreamListener : public ReportWritesToJSStreamListener {
 };
 
 
+// A per-Environment pool of read buffers used by `EmitToJSStreamListener`.
+// Instead of allocating (and then shrinking) a fresh 64 KiB buffer for every
+// read, small reads are carved out of a shared slab and passed to JS as
+// views into one ArrayBuffer. A slab is recycled once the ArrayBuffer that
+// covers it has been garbage collected, i.e. once all views into it are gone.
+// The pool is only created when `--stream-read-pool-size` is non-zero.
+class StreamReadPool : public MemoryRetainer {
+ public:
+  enum StatsFields {
+    kPooledReads,
+    kUnpooledReads,
+    kPooledBytes,
+    kSlabsAllocated,
+    kSlabsReused,
+    kSlabsCollected,
+    kStatsFieldCount
+  };
+
+  StreamReadPool(Environment* env, size_t slab_size);
+  ~StreamReadPool() override;
+
+  StreamReadPool(const StreamReadPool&) = delete;
+  StreamReadPool& operator=(const StreamReadPool&) = delete;
+
+  // Returns a buffer that points into the current slab, or a buffer with
+  // `base == nullptr` if the read cannot be served from the pool (e.g.
+  // because another reservation is still outstanding).
+  uv_buf_t Reserve(size_t suggested_size);
+  // Returns true if `buf` is the outstanding reservation of this pool.
+  bool Owns(const uv_buf_t& buf) const;
+  // Mark `nread` bytes of the outstanding reservation as used, and return
+  // the ArrayBuffer covering the slab together with the offset of the data.
+  v8::Local<v8::ArrayBuffer> Commit(size_t nread, size_t* offset);
+  // Give back the outstanding reservation without using any of it.
+  void Release();
+
+  // Record a read that was not served from the pool.
+  inline void CountUnpooledRead() { stats_[kUnpooledReads]++; }
+  inline const uint64_t* stats() const { return stats_; }
+
+  void MemoryInfo(MemoryTracker* tracker) const override;
+  SET_MEMORY_INFO_NAME(StreamReadPool)
+  SET_SELF_SIZE(StreamReadPool)
+
+ private:
+  struct Slab {
+    StreamReadPool* pool;
+    char* data;
+    v8::Global<v8::ArrayBuffer> buffer;
+  };
+
+  static void WeakCallback(const v8::WeakCallbackInfo<Slab>& data);
+  void OnSlabCollected(Slab* slab);
+  void RecycleSlab(Slab* slab);
+  void RetireCurrentSlab();
+  Slab* NewSlab();
+  void FreeSlab(Slab* slab);
+
+  // Reads smaller than this are not worth starting a new slab for.
+  static constexpr size_t kMinReservation = 1024;
+  // Upper bound for the number of unused slabs kept around for reuse.
+  static constexpr size_t kMaxSpareSlabs = 2;
+
+  Environment* const env_;
+  const size_t slab_size_;
+  Slab* current_ = nullptr;
+  size_t offset_ = 0;
+  bool reserved_ = false;
+  size_t reserved_offset_ = 0;
+  size_t reserved_length_ = 0;
+  // Slabs that still have live views in JS land.
+  std::unordered_set<Slab*> retired_;
+  // Slabs whose views have all been collected and that can be reused.
+  std::vector<Slab*> spare_;
+  uint64_t stats_[kStatsFieldCount] = {};
+};
+
+
 // An alternative listener that uses a custom, user-provided buffer
 // for reading data.
 class CustomBufferJSListener : public ReportWritesToJSStreamListener {
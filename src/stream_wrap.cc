@@ -43,14 +43,45 @@ using v8::EscapableHandleScope;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
+using v8::Number;
 using v8::Object;
 using v8::ReadOnly;
 using v8::Signature;
 using v8::Value;
 
 
+// Returns the counters of the Environment's StreamReadPool as an object,
+// or undefined if the pool is disabled.
+static void GetReadPoolStatistics(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  StreamReadPool* pool = env->stream_read_pool();
+  if (pool == nullptr)
+    return;
+
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  const uint64_t* stats = pool->stats();
+  Local<Object> obj = Object::New(isolate);
+#define V(name, index)                                                        \
+  obj->Set(context,                                                           \
+           FIXED_ONE_BYTE_STRING(isolate, name),                              \
+           Number::New(isolate,                                               \
+                       static_cast<double>(                                   \
+                           stats[StreamReadPool::index]))).Check();
+  V("pooledReads", kPooledReads)
+  V("unpooledReads", kUnpooledReads)
+  V("pooledBytes", kPooledBytes)
+  V("slabsAllocated", kSlabsAllocated)
+  V("slabsReused", kSlabsReused)
+  V("slabsCollected", kSlabsCollected)
+#undef V
+  args.GetReturnValue().Set(obj);
+}
+
+
 void LibuvStreamWrap::Initialize(Local<Object> target,
                                  Local<Value> unused,
                                  Local<Context> context,
@@ -110,6 +141,8 @@ void LibuvStreamWrap::Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(target, kLastWriteWasAsync);
   target->Set(context, FIXED_ONE_BYTE_STRING(env->isolate(), "streamBaseState"),
               env->stream_base_state().GetJSArray()).Check();
+
+  env->SetMethod(target, "getReadPoolStatistics", GetReadPoolStatistics);
 }
 
 
@@ -25,6 +25,7 @@
 #include "env-inl.h"
 #include "node_buffer.h"
 #include "node_errors.h"
+#include "string_simd.h"
 #include "util.h"
 
 #include <climits>
@@ -244,13 +245,32 @@ static inline unsigned unhex(uint8_t x) {
   return unhex_table[x];
 }
 
+// Like base64_decode_simd(), vector instructions are only used for one-byte
+// input.
+template <typename TypeName>
+static size_t hex_decode_simd(char* buf,
+                              size_t len,
+                              const TypeName* src,
+                              const size_t srcLen) {
+  return 0;
+}
+
+static size_t hex_decode_simd(char* buf,
+                              size_t len,
+                              const char* src,
+                              const size_t srcLen) {
+  return simd::HexDecode(src, srcLen, buf, len) / 2;
+}
+
 template <typename TypeName>
 static size_t hex_decode(char* buf,
                          size_t len,
                          const TypeName* src,
                          const size_t srcLen) {
   size_t i;
-  for (i = 0; i < len && i * 2 + 1 < srcLen; ++i) {
+  for (i = hex_decode_simd(buf, len, src, srcLen);
+       i < len && i * 2 + 1 < srcLen;
+       ++i) {
     unsigned a = unhex(src[i * 2 + 0]);
     unsigned b = unhex(src[i * 2 + 1]);
     if (!~a || !~b)
@@ -365,6 +385,15 @@ size_t StringBytes::Write(Isolate* isolate,
       if (str->IsExternalOneByte()) {
         auto ext = str->GetExternalOneByteStringResource();
         nbytes = base64_decode(buf, buflen, ext->data(), ext->length());
+      } else if (str->IsOneByte()) {
+        // Decoding one-byte input can use vector instructions.
+        MaybeStackBuffer<char> value(str->Length());
+        str->WriteOneByte(isolate,
+                          reinterpret_cast<uint8_t*>(*value),
+                          0,
+                          value.length(),
+                          flags);
+        nbytes = base64_decode(buf, buflen, *value, value.length());
       } else {
         String::Value value(isolate, str);
         nbytes = base64_decode(buf, buflen, *value, value.length());
@@ -376,6 +405,15 @@ size_t StringBytes::Write(Isolate* isolate,
       if (str->IsExternalOneByte()) {
         auto ext = str->GetExternalOneByteStringResource();
         nbytes = hex_decode(buf, buflen, ext->data(), ext->length());
+      } else if (str->IsOneByte()) {
+        // Decoding one-byte input can use vector instructions.
+        MaybeStackBuffer<char> value(str->Length());
+        str->WriteOneByte(isolate,
+                          reinterpret_cast<uint8_t*>(*value),
+                          0,
+                          value.length(),
+                          flags);
+        nbytes = hex_decode(buf, buflen, *value, value.length());
       } else {
         String::Value value(isolate, str);
         nbytes = hex_decode(buf, buflen, *value, value.length());
@@ -587,13 +625,45 @@ static void force_ascii(const char* src, char* dst, size_t len) {
 }
 
 
+// Transcodes UTF-8 text that has no code points beyond U+00FF to Latin-1.
+// Returns false if the text has other code points or is not valid UTF-8,
+// which are left to V8.
+static bool utf8_to_latin1(const char* src,
+                           size_t slen,
+                           char* dst,
+                           size_t* written) {
+  size_t i = 0;
+  size_t k = 0;
+  for (;;) {
+    const size_t ascii = simd::AsciiPrefixLength(src + i, slen - i);
+    memcpy(dst + k, src + i, ascii);
+    i += ascii;
+    k += ascii;
+    if (i == slen)
+      break;
+    // U+0080 to U+00FF are encoded as 0xc2 or 0xc3 and a continuation byte.
+    const uint8_t lead = static_cast<uint8_t>(src[i]);
+    if ((lead & 0xfe) != 0xc2 || i + 1 == slen)
+      return false;
+    const uint8_t next = static_cast<uint8_t>(src[i + 1]);
+    if ((next & 0xc0) != 0x80)
+      return false;
+    dst[k++] = static_cast<char>((lead << 6) | (next & 0x3f));
+    i += 2;
+  }
+  *written = k;
+  return true;
+}
+
+
 static size_t hex_encode(const char* src, size_t slen, char* dst, size_t dlen) {
   // We know how much we'll write, just make sure that there's space.
   CHECK(dlen >= slen * 2 &&
       "not enough space provided for hex encode");
 
   dlen = slen * 2;
-  for (uint32_t i = 0, k = 0; k < dlen; i += 1, k += 2) {
+  const size_t done = simd::HexEncode(src, slen, dst);
+  for (size_t i = done, k = done * 2; k < dlen; i += 1, k += 2) {
     static const char hex[] = "0123456789abcdef";
     uint8_t val = static_cast<uint8_t>(src[i]);
     dst[k + 0] = hex[val >> 4];
@@ -654,7 +724,24 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
         return ExternOneByteString::NewFromCopy(isolate, buf, buflen, error);
       }
 
-    case UTF8:
+    case UTF8: {
+      // ASCII and Latin-1 text becomes a one-byte string without going
+      // through V8's UTF-8 decoder.
+      const size_t ascii = simd::AsciiPrefixLength(buf, buflen);
+      if (ascii == buflen)
+        return ExternOneByteString::NewFromCopy(isolate, buf, buflen, error);
+      if ((static_cast<uint8_t>(buf[ascii]) & 0xfe) == 0xc2) {
+        char* latin1 = node::UncheckedMalloc(buflen);
+        if (latin1 == nullptr) {
+          *error = node::ERR_MEMORY_ALLOCATION_FAILED(isolate);
+          return MaybeLocal<Value>();
+        }
+        size_t length;
+        if (utf8_to_latin1(buf, buflen, latin1, &length))
+          return ExternOneByteString::New(isolate, latin1, length, error);
+        free(latin1);
+      }
+
       val = String::NewFromUtf8(isolate,
                                 buf,
                                 v8::NewStringType::kNormal,
@@ -664,6 +751,7 @@ MaybeLocal<Value> StringBytes::Encode(Isolate* isolate,
         return MaybeLocal<Value>();
       }
       return val.ToLocalChecked();
+    }
 
     case LATIN1:
       return ExternOneByteString::NewFromCopy(isolate, buf, buflen, error);
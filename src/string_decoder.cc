@@ -27,21 +27,14 @@ MaybeLocal<String> MakeString(Isolate* isolate,
                               size_t length,
                               enum encoding encoding) {
   Local<Value> error;
-  MaybeLocal<Value> ret;
-  if (encoding == UTF8) {
-    return String::NewFromUtf8(
-        isolate,
-        data,
-        v8::NewStringType::kNormal,
-        length);
-  } else {
-    ret = StringBytes::Encode(
-        isolate,
-        data,
-        length,
-        encoding,
-        &error);
-  }
+  // This includes UTF-8, for which StringBytes::Encode() has a fast path for
+  // ASCII and Latin-1 text.
+  MaybeLocal<Value> ret = StringBytes::Encode(
+      isolate,
+      data,
+      length,
+      encoding,
+      &error);
 
   if (ret.IsEmpty()) {
     CHECK(!error.IsEmpty());
@@ -0,0 +1,1071 @@
+#include "string_simd.h"
+#include "base64.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || \
+    defined(__i386__) || defined(_M_IX86)
+#define NODE_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define NODE_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// GCC and Clang only allow intrinsics for instruction sets that are enabled
+// for the function that uses them. The build targets the baseline ISA, so
+// the functions that are selected at runtime enable them individually.
+#if defined(__GNUC__) || defined(__clang__)
+#define NODE_SIMD_TARGET(name) __attribute__((target(name)))
+#else
+#define NODE_SIMD_TARGET(name)
+#endif
+
+namespace node {
+namespace simd {
+
+namespace {
+
+#if NODE_SIMD_X86 || NODE_SIMD_NEON
+
+// UTF-8 validation follows John Keiser's and Daniel Lemire's "Validating
+// UTF-8 In Less Than One Instruction Per Byte". Three table lookups, on the
+// high and low nibble of the previous byte and on the high nibble of the
+// current one, yield a bit for every kind of error that the two bytes can
+// form; the AND of the three has a bit set only if both bytes agree on it.
+// Missing or extra continuation bytes of 3- and 4-byte sequences are
+// checked separately. kTwoContinuations is not an error if it is expected.
+enum Utf8ErrorBits : uint8_t {
+  kTooShort = 1 << 0,          // 11______ 0_______ or 11______ 11______
+  kTooLong = 1 << 1,           // 0_______ 10______
+  kOverlong3 = 1 << 2,         // 11100000 100_____
+  kTooLarge = 1 << 3,          // 11110100 1001____ and above
+  kSurrogate = 1 << 4,         // 11101101 101_____
+  kOverlong2 = 1 << 5,         // 1100000_ 10______
+  kTooLarge1000 = 1 << 6,      // 11110101 1000____ and above
+  kOverlong4 = 1 << 6,         // 11110000 1000____
+  kTwoContinuations = 1 << 7,  // 10______ 10______
+  kCarry = kTooShort | kTooLong | kTwoContinuations
+};
+
+const uint8_t kUtf8Byte1High[16] = {
+  // 0_______ ________: ASCII
+  kTooLong, kTooLong, kTooLong, kTooLong,
+  kTooLong, kTooLong, kTooLong, kTooLong,
+  // 10______ ________: continuation
+  kTwoContinuations, kTwoContinuations, kTwoContinuations, kTwoContinuations,
+  // 1100____ ________: 2-byte lead
+  kTooShort | kOverlong2,
+  // 1101____ ________: 2-byte lead
+  kTooShort,
+  // 1110____ ________: 3-byte lead
+  kTooShort | kOverlong3 | kSurrogate,
+  // 1111____ ________: 4-byte lead
+  kTooShort | kTooLarge | kTooLarge1000 | kOverlong4
+};
+
+const uint8_t kUtf8Byte1Low[16] = {
+  // ____0000 ________
+  kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+  // ____0001 ________
+  kCarry | kOverlong2,
+  // ____001_ ________
+  kCarry,
+  kCarry,
+  // ____0100 ________
+  kCarry | kTooLarge,
+  // ____0101 ________ and up
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000,
+  // ____1101 ________
+  kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+  kCarry | kTooLarge | kTooLarge1000,
+  kCarry | kTooLarge | kTooLarge1000
+};
+
+const uint8_t kUtf8Byte2High[16] = {
+  // ________ 0_______: ASCII
+  kTooShort, kTooShort, kTooShort, kTooShort,
+  kTooShort, kTooShort, kTooShort, kTooShort,
+  // ________ 1000____
+  kTooLong | kOverlong2 | kTwoContinuations | kOverlong3 | kTooLarge1000 |
+      kOverlong4,
+  // ________ 1001____
+  kTooLong | kOverlong2 | kTwoContinuations | kOverlong3 | kTooLarge,
+  // ________ 101_____
+  kTooLong | kOverlong2 | kTwoContinuations | kSurrogate | kTooLarge,
+  kTooLong | kOverlong2 | kTwoContinuations | kSurrogate | kTooLarge,
+  // ________ 11______: lead
+  kTooShort, kTooShort, kTooShort, kTooShort
+};
+
+#endif  // NODE_SIMD_X86 || NODE_SIMD_NEON
+
+#if NODE_SIMD_X86
+
+enum class Level {
+  kNone,
+  kSSSE3,
+  kAVX2
+};
+
+Level DetectLevel() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  const int max_leaf = info[0];
+  if (max_leaf < 1)
+    return Level::kNone;
+  __cpuid(info, 1);
+  const bool ssse3 = (info[2] & (1 << 9)) != 0;
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx = (info[2] & (1 << 28)) != 0;
+  bool avx2 = false;
+  // The OS has to save the upper halves of the YMM registers, too.
+  if (max_leaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6) {
+    __cpuidex(info, 7, 0);
+    avx2 = (info[1] & (1 << 5)) != 0;
+  }
+#else
+  __builtin_cpu_init();
+  const bool ssse3 = __builtin_cpu_supports("ssse3");
+  const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+  if (avx2 && ssse3)
+    return Level::kAVX2;
+  if (ssse3)
+    return Level::kSSSE3;
+  return Level::kNone;
+}
+
+Level GetLevel() {
+  static const Level level = DetectLevel();
+  return level;
+}
+
+// Base64 encoding and the packing of decoded values follow Wojciech Muła's
+// and Daniel Lemire's "Faster Base64 Encoding and Decoding Using AVX2
+// Instructions". Decoding translates characters with comparisons instead of
+// table lookups so that both alphabets are accepted, like the scalar code.
+
+// Turns 12 input bytes at offsets 0 to 11 into 16 base64 characters.
+NODE_SIMD_TARGET("ssse3")
+inline __m128i Base64EncodeBlock(__m128i in) {
+  in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7,
+                                         4, 5, 3, 4, 1, 2, 0, 1));
+  const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  const __m128i indices = _mm_or_si128(t1, t3);
+
+  // 0..25 map to 13, 26..51 to 0, 52..61 to 1..10, 62 to 11 and 63 to 12,
+  // which selects the offset from the index to its character.
+  __m128i ranges = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  ranges = _mm_or_si128(ranges, _mm_and_si128(upper, _mm_set1_epi8(13)));
+  const __m128i offsets = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A', 0, 0);
+  return _mm_add_epi8(_mm_shuffle_epi8(offsets, ranges), indices);
+}
+
+NODE_SIMD_TARGET("avx2")
+inline __m256i Base64EncodeBlock(__m256i in) {
+  in = _mm256_shuffle_epi8(in, _mm256_broadcastsi128_si256(
+      _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1)));
+  const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+  const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+  const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+  const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+  const __m256i indices = _mm256_or_si256(t1, t3);
+
+  __m256i ranges = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+  const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+  ranges =
+      _mm256_or_si256(ranges, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+  const __m256i offsets = _mm256_broadcastsi128_si256(_mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+      '/' - 63, 'A', 0, 0));
+  return _mm256_add_epi8(_mm256_shuffle_epi8(offsets, ranges), indices);
+}
+
+// Translates 16 base64 characters to their 6-bit values and packs those into
+// 12 bytes at offsets 0 to 11. Returns false if a character is not part of
+// either alphabet.
+NODE_SIMD_TARGET("ssse3")
+inline bool Base64DecodeBlock(__m128i in, __m128i* out) {
+  const __m128i upper =
+      _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('A' - 1)),
+                    _mm_cmplt_epi8(in, _mm_set1_epi8('Z' + 1)));
+  const __m128i lower =
+      _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('a' - 1)),
+                    _mm_cmplt_epi8(in, _mm_set1_epi8('z' + 1)));
+  const __m128i digit =
+      _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('0' - 1)),
+                    _mm_cmplt_epi8(in, _mm_set1_epi8('9' + 1)));
+  const __m128i plus = _mm_or_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8('+')),
+                                    _mm_cmpeq_epi8(in, _mm_set1_epi8('-')));
+  const __m128i slash = _mm_or_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8('/')),
+                                     _mm_cmpeq_epi8(in, _mm_set1_epi8('_')));
+  const __m128i valid = _mm_or_si128(_mm_or_si128(upper, lower),
+                                     _mm_or_si128(digit,
+                                                  _mm_or_si128(plus, slash)));
+  if (_mm_movemask_epi8(valid) != 0xffff)
+    return false;
+
+  __m128i values =
+      _mm_and_si128(upper, _mm_sub_epi8(in, _mm_set1_epi8('A')));
+  values = _mm_or_si128(values, _mm_and_si128(
+      lower, _mm_sub_epi8(in, _mm_set1_epi8('a' - 26))));
+  values = _mm_or_si128(values, _mm_and_si128(
+      digit, _mm_add_epi8(in, _mm_set1_epi8(52 - '0'))));
+  values = _mm_or_si128(values, _mm_and_si128(plus, _mm_set1_epi8(62)));
+  values = _mm_or_si128(values, _mm_and_si128(slash, _mm_set1_epi8(63)));
+
+  // Every 32-bit lane holds 4 values a, b, c and d, which become the 24-bit
+  // number a << 18 | b << 12 | c << 6 | d, stored big-endian.
+  const __m128i ab_cd =
+      _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  const __m128i abcd = _mm_madd_epi16(ab_cd, _mm_set1_epi32(0x00011000));
+  *out = _mm_shuffle_epi8(abcd, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8,
+                                              14, 13, 12, -1, -1, -1, -1));
+  return true;
+}
+
+// Like the above for 32 characters, packed into 24 bytes at offsets 0 to 23.
+NODE_SIMD_TARGET("avx2")
+inline bool Base64DecodeBlock(__m256i in, __m256i* out) {
+  const __m256i upper =
+      _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('A' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), in));
+  const __m256i lower =
+      _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('a' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), in));
+  const __m256i digit =
+      _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('0' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), in));
+  const __m256i plus =
+      _mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('+')),
+                      _mm256_cmpeq_epi8(in, _mm256_set1_epi8('-')));
+  const __m256i slash =
+      _mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('/')),
+                      _mm256_cmpeq_epi8(in, _mm256_set1_epi8('_')));
+  const __m256i valid =
+      _mm256_or_si256(_mm256_or_si256(upper, lower),
+                      _mm256_or_si256(digit, _mm256_or_si256(plus, slash)));
+  if (_mm256_movemask_epi8(valid) != -1)
+    return false;
+
+  __m256i values =
+      _mm256_and_si256(upper, _mm256_sub_epi8(in, _mm256_set1_epi8('A')));
+  values = _mm256_or_si256(values, _mm256_and_si256(
+      lower, _mm256_sub_epi8(in, _mm256_set1_epi8('a' - 26))));
+  values = _mm256_or_si256(values, _mm256_and_si256(
+      digit, _mm256_add_epi8(in, _mm256_set1_epi8(52 - '0'))));
+  values =
+      _mm256_or_si256(values, _mm256_and_si256(plus, _mm256_set1_epi8(62)));
+  values =
+      _mm256_or_si256(values, _mm256_and_si256(slash, _mm256_set1_epi8(63)));
+
+  const __m256i ab_cd =
+      _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+  const __m256i abcd =
+      _mm256_madd_epi16(ab_cd, _mm256_set1_epi32(0x00011000));
+  const __m256i packed = _mm256_shuffle_epi8(abcd, _mm256_broadcastsi128_si256(
+      _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)));
+  *out = _mm256_permutevar8x32_epi32(packed,
+                                     _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+  return true;
+}
+
+// Translates 16 hex digits to their values. Returns false if a character is
+// not a hex digit.
+NODE_SIMD_TARGET("ssse3")
+inline bool HexDecodeBlock(__m128i in, __m128i* out) {
+  const __m128i digit =
+      _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8('0' - 1)),
+                    _mm_cmplt_epi8(in, _mm_set1_epi8('9' + 1)));
+  const __m128i lowered = _mm_or_si128(in, _mm_set1_epi8(0x20));
+  const __m128i letter =
+      _mm_and_si128(_mm_cmpgt_epi8(lowered, _mm_set1_epi8('a' - 1)),
+                    _mm_cmplt_epi8(lowered, _mm_set1_epi8('f' + 1)));
+  if (_mm_movemask_epi8(_mm_or_si128(digit, letter)) != 0xffff)
+    return false;
+  *out = _mm_or_si128(
+      _mm_and_si128(digit, _mm_sub_epi8(in, _mm_set1_epi8('0'))),
+      _mm_and_si128(letter, _mm_sub_epi8(lowered, _mm_set1_epi8('a' - 10))));
+  return true;
+}
+
+NODE_SIMD_TARGET("avx2")
+inline bool HexDecodeBlock(__m256i in, __m256i* out) {
+  const __m256i digit =
+      _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8('0' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), in));
+  const __m256i lowered = _mm256_or_si256(in, _mm256_set1_epi8(0x20));
+  const __m256i letter =
+      _mm256_and_si256(_mm256_cmpgt_epi8(lowered, _mm256_set1_epi8('a' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lowered));
+  if (_mm256_movemask_epi8(_mm256_or_si256(digit, letter)) != -1)
+    return false;
+  *out = _mm256_or_si256(
+      _mm256_and_si256(digit, _mm256_sub_epi8(in, _mm256_set1_epi8('0'))),
+      _mm256_and_si256(letter,
+                       _mm256_sub_epi8(lowered, _mm256_set1_epi8('a' - 10))));
+  return true;
+}
+
+NODE_SIMD_TARGET("ssse3")
+size_t Base64EncodeSSSE3(const char* src, size_t slen, char* dst) {
+  size_t i = 0;
+  size_t k = 0;
+  // Every block reads 16 bytes but only consumes 12 of them.
+  for (; i + 16 <= slen; i += 12, k += 16) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k),
+                     Base64EncodeBlock(in));
+  }
+  return i;
+}
+
+NODE_SIMD_TARGET("avx2")
+size_t Base64EncodeAVX2(const char* src, size_t slen, char* dst) {
+  size_t i = 0;
+  size_t k = 0;
+  for (; i + 28 <= slen; i += 24, k += 32) {
+    const __m128i lo =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12));
+    const __m256i in =
+        _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k),
+                        Base64EncodeBlock(in));
+  }
+  return i + Base64EncodeSSSE3(src + i, slen - i, dst + k);
+}
+
+NODE_SIMD_TARGET("ssse3")
+size_t Base64DecodeSSSE3(const char* src, size_t slen,
+                         char* dst, size_t dlen) {
+  size_t i = 0;
+  size_t k = 0;
+  // Every block writes 16 bytes but only produces 12 of them.
+  for (; i + 16 <= slen && k + 16 <= dlen; i += 16, k += 12) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i out;
+    if (!Base64DecodeBlock(in, &out))
+      break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k), out);
+  }
+  return i;
+}
+
+NODE_SIMD_TARGET("avx2")
+size_t Base64DecodeAVX2(const char* src, size_t slen, char* dst, size_t dlen) {
+  size_t i = 0;
+  size_t k = 0;
+  for (; i + 32 <= slen && k + 32 <= dlen; i += 32, k += 24) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i out;
+    if (!Base64DecodeBlock(in, &out))
+      return i;
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k), out);
+  }
+  return i + Base64DecodeSSSE3(src + i, slen - i, dst + k, dlen - k);
+}
+
+NODE_SIMD_TARGET("ssse3")
+size_t HexEncodeSSSE3(const char* src, size_t slen, char* dst) {
+  const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                       '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 16 <= slen; i += 16) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    const __m128i hi =
+        _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(in, 4), mask));
+    const __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(in, mask));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i),
+                     _mm_unpacklo_epi8(hi, lo));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i + 16),
+                     _mm_unpackhi_epi8(hi, lo));
+  }
+  return i;
+}
+
+NODE_SIMD_TARGET("avx2")
+size_t HexEncodeAVX2(const char* src, size_t slen, char* dst) {
+  const __m256i digits = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                    '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'));
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+  size_t i = 0;
+  for (; i + 32 <= slen; i += 32) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const __m256i hi = _mm256_shuffle_epi8(
+        digits, _mm256_and_si256(_mm256_srli_epi16(in, 4), mask));
+    const __m256i lo =
+        _mm256_shuffle_epi8(digits, _mm256_and_si256(in, mask));
+    // Unpacking works within 128-bit lanes, so the halves are out of order.
+    const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+    const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i),
+                        _mm256_permute2x128_si256(a, b, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i + 32),
+                        _mm256_permute2x128_si256(a, b, 0x31));
+  }
+  return i + HexEncodeSSSE3(src + i, slen - i, dst + 2 * i);
+}
+
+NODE_SIMD_TARGET("ssse3")
+size_t HexDecodeSSSE3(const char* src, size_t slen, char* dst, size_t dlen) {
+  // Multiplies the first digit of every pair by 16 and adds the second one.
+  const __m128i weights = _mm_set1_epi16(0x0110);
+  size_t i = 0;
+  size_t k = 0;
+  for (; i + 32 <= slen && k + 16 <= dlen; i += 32, k += 16) {
+    __m128i a;
+    __m128i b;
+    if (!HexDecodeBlock(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)), &a) ||
+        !HexDecodeBlock(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 16)),
+            &b)) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + k),
+                     _mm_packus_epi16(_mm_maddubs_epi16(a, weights),
+                                      _mm_maddubs_epi16(b, weights)));
+  }
+  return i;
+}
+
+NODE_SIMD_TARGET("avx2")
+size_t HexDecodeAVX2(const char* src, size_t slen, char* dst, size_t dlen) {
+  const __m256i weights = _mm256_set1_epi16(0x0110);
+  size_t i = 0;
+  size_t k = 0;
+  for (; i + 64 <= slen && k + 32 <= dlen; i += 64, k += 32) {
+    __m256i a;
+    __m256i b;
+    if (!HexDecodeBlock(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)),
+            &a) ||
+        !HexDecodeBlock(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 32)),
+            &b)) {
+      return i;
+    }
+    // Packing works within 128-bit lanes, so the quarters are out of order.
+    const __m256i packed =
+        _mm256_packus_epi16(_mm256_maddubs_epi16(a, weights),
+                            _mm256_maddubs_epi16(b, weights));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + k),
+                        _mm256_permute4x64_epi64(packed, 0xd8));
+  }
+  return i + HexDecodeSSSE3(src + i, slen - i, dst + k, dlen - k);
+}
+
+NODE_SIMD_TARGET("sse2")
+size_t AsciiPrefixLengthSSE2(const char* src, size_t len) {
+  size_t i = 0;
+  for (; i + 64 <= len; i += 64) {
+    const __m128i* p = reinterpret_cast<const __m128i*>(src + i);
+    const __m128i any = _mm_or_si128(
+        _mm_or_si128(_mm_loadu_si128(p), _mm_loadu_si128(p + 1)),
+        _mm_or_si128(_mm_loadu_si128(p + 2), _mm_loadu_si128(p + 3)));
+    if (_mm_movemask_epi8(any) != 0)
+      break;
+  }
+  for (; i + 16 <= len; i += 16) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (_mm_movemask_epi8(in) != 0)
+      break;
+  }
+  while (i < len && static_cast<int8_t>(src[i]) >= 0)
+    i++;
+  return i;
+}
+
+NODE_SIMD_TARGET("sse2")
+size_t CountNonAsciiSSE2(const char* src, size_t len) {
+  const __m128i zero = _mm_setzero_si128();
+  size_t count = 0;
+  size_t i = 0;
+  while (i + 16 <= len) {
+    // Count in bytes for up to 255 blocks at a time, then add those up.
+    const size_t blocks = std::min<size_t>((len - i) / 16, 255);
+    __m128i counts = zero;
+    for (size_t end = i + blocks * 16; i < end; i += 16) {
+      const __m128i in =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+      counts = _mm_sub_epi8(counts, _mm_cmplt_epi8(in, zero));
+    }
+    const __m128i sums = _mm_sad_epu8(counts, zero);
+    count += _mm_cvtsi128_si32(sums) + _mm_extract_epi16(sums, 4);
+  }
+  for (; i < len; i++)
+    count += static_cast<uint8_t>(src[i]) >> 7;
+  return count;
+}
+
+// Returns the errors between the bytes of |input| and their predecessors,
+// the last of which are at the end of |prev_input|.
+NODE_SIMD_TARGET("ssse3")
+inline __m128i Utf8Errors(__m128i input, __m128i prev_input) {
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+  const __m128i byte_1_high = _mm_shuffle_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(kUtf8Byte1High)),
+      _mm_and_si128(_mm_srli_epi16(prev1, 4), mask));
+  const __m128i byte_1_low = _mm_shuffle_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(kUtf8Byte1Low)),
+      _mm_and_si128(prev1, mask));
+  const __m128i byte_2_high = _mm_shuffle_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(kUtf8Byte2High)),
+      _mm_and_si128(_mm_srli_epi16(input, 4), mask));
+  const __m128i special =
+      _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+  // The top bit is set where the byte 2 or 3 positions back is the lead of a
+  // 3- or 4-byte sequence, i.e. where a continuation byte has to follow.
+  const __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+  const __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+  const __m128i must_continue = _mm_or_si128(
+      _mm_subs_epu8(prev2, _mm_set1_epi8(0xe0 - 0x80)),
+      _mm_subs_epu8(prev3, _mm_set1_epi8(0xf0 - 0x80)));
+  return _mm_xor_si128(
+      _mm_and_si128(must_continue, _mm_set1_epi8(static_cast<char>(0x80))),
+      special);
+}
+
+// Non-zero where the end of |input| is a sequence that is not complete yet.
+NODE_SIMD_TARGET("ssse3")
+inline __m128i Utf8Incomplete(__m128i input) {
+  const __m128i max = _mm_setr_epi8(
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+      static_cast<char>(0xf0 - 1), static_cast<char>(0xe0 - 1),
+      static_cast<char>(0xc0 - 1));
+  return _mm_subs_epu8(input, max);
+}
+
+NODE_SIMD_TARGET("ssse3")
+inline void Utf8CheckBlock(__m128i input,
+                           __m128i* prev_input,
+                           __m128i* prev_incomplete,
+                           __m128i* error) {
+  if (_mm_movemask_epi8(input) == 0) {
+    // ASCII is valid unless the previous block ended in the middle of a
+    // sequence.
+    *error = _mm_or_si128(*error, *prev_incomplete);
+  } else {
+    *error = _mm_or_si128(*error, Utf8Errors(input, *prev_input));
+    *prev_incomplete = Utf8Incomplete(input);
+  }
+  *prev_input = input;
+}
+
+NODE_SIMD_TARGET("ssse3")
+bool ValidateUtf8SSSE3(const char* src, size_t len) {
+  __m128i prev_input = _mm_setzero_si128();
+  __m128i prev_incomplete = _mm_setzero_si128();
+  __m128i error = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    const __m128i in =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    Utf8CheckBlock(in, &prev_input, &prev_incomplete, &error);
+  }
+  if (i < len) {
+    // A zero-padded tail fails as too short if it ends in a lead byte.
+    char tail[16] = {};
+    memcpy(tail, src + i, len - i);
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tail));
+    Utf8CheckBlock(in, &prev_input, &prev_incomplete, &error);
+  }
+  error = _mm_or_si128(error, prev_incomplete);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) ==
+         0xffff;
+}
+
+NODE_SIMD_TARGET("avx2")
+inline __m256i Utf8Errors(__m256i input, __m256i prev_input) {
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+  // The 32 bytes that end right before the last 16 bytes of |input|, so that
+  // shifting across the two 128-bit lanes works.
+  const __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+  const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+  const __m256i byte_1_high = _mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(kUtf8Byte1High))),
+      _mm256_and_si256(_mm256_srli_epi16(prev1, 4), mask));
+  const __m256i byte_1_low = _mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(kUtf8Byte1Low))),
+      _mm256_and_si256(prev1, mask));
+  const __m256i byte_2_high = _mm256_shuffle_epi8(
+      _mm256_broadcastsi128_si256(
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(kUtf8Byte2High))),
+      _mm256_and_si256(_mm256_srli_epi16(input, 4), mask));
+  const __m256i special = _mm256_and_si256(
+      _mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+  const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+  const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+  const __m256i must_continue = _mm256_or_si256(
+      _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xe0 - 0x80)),
+      _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xf0 - 0x80)));
+  return _mm256_xor_si256(
+      _mm256_and_si256(must_continue,
+                       _mm256_set1_epi8(static_cast<char>(0x80))),
+      special);
+}
+
+NODE_SIMD_TARGET("avx2")
+inline __m256i Utf8Incomplete(__m256i input) {
+  const __m256i max = _mm256_setr_epi8(
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+      static_cast<char>(0xf0 - 1), static_cast<char>(0xe0 - 1),
+      static_cast<char>(0xc0 - 1));
+  return _mm256_subs_epu8(input, max);
+}
+
+NODE_SIMD_TARGET("avx2")
+inline void Utf8CheckBlock(__m256i input,
+                           __m256i* prev_input,
+                           __m256i* prev_incomplete,
+                           __m256i* error) {
+  if (_mm256_movemask_epi8(input) == 0) {
+    *error = _mm256_or_si256(*error, *prev_incomplete);
+  } else {
+    *error = _mm256_or_si256(*error, Utf8Errors(input, *prev_input));
+    *prev_incomplete = Utf8Incomplete(input);
+  }
+  *prev_input = input;
+}
+
+NODE_SIMD_TARGET("avx2")
+bool ValidateUtf8AVX2(const char* src, size_t len) {
+  __m256i prev_input = _mm256_setzero_si256();
+  __m256i prev_incomplete = _mm256_setzero_si256();
+  __m256i error = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 32 <= len; i += 32) {
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    Utf8CheckBlock(in, &prev_input, &prev_incomplete, &error);
+  }
+  if (i < len) {
+    char tail[32] = {};
+    memcpy(tail, src + i, len - i);
+    const __m256i in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tail));
+    Utf8CheckBlock(in, &prev_input, &prev_incomplete, &error);
+  }
+  error = _mm256_or_si256(error, prev_incomplete);
+  return _mm256_testz_si256(error, error) != 0;
+}
+
+#elif NODE_SIMD_NEON
+
+size_t Base64EncodeNEON(const char* src, size_t slen, char* dst) {
+  static const char kTable[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                               "abcdefghijklmnopqrstuvwxyz"
+                               "0123456789+/";
+  const uint8_t* table = reinterpret_cast<const uint8_t*>(kTable);
+  uint8x16x4_t lut;
+  lut.val[0] = vld1q_u8(table);
+  lut.val[1] = vld1q_u8(table + 16);
+  lut.val[2] = vld1q_u8(table + 32);
+  lut.val[3] = vld1q_u8(table + 48);
+  size_t i = 0;
+  size_t k = 0;
+  for (; i + 48 <= slen; i += 48, k += 64) {
+    const uint8x16x3_t in =
+        vld3q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16x4_t out;
+    out.val[0] = vshrq_n_u8(in.val[0], 2);
+    out.val[1] = vorrq_u8(vandq_u8(vshlq_n_u8(in.val[0], 4), vdupq_n_u8(0x30)),
+                          vshrq_n_u8(in.val[1], 4));
+    out.val[2] = vorrq_u8(vandq_u8(vshlq_n_u8(in.val[1], 2), vdupq_n_u8(0x3c)),
+                          vshrq_n_u8(in.val[2], 6));
+    out.val[3] = vandq_u8(in.val[2], vdupq_n_u8(0x3f));
+    for (int j = 0; j < 4; j++)
+      out.val[j] = vqtbl4q_u8(lut, out.val[j]);
+    vst4q_u8(reinterpret_cast<uint8_t*>(dst + k), out);
+  }
+  return i;
+}
+
+size_t Base64DecodeNEON(const char* src, size_t slen, char* dst, size_t dlen) {
+  // The ASCII half of unbase64_table, where every entry that is not a 6-bit
+  // value has its top bit set.
+  const uint8_t* table = reinterpret_cast<const uint8_t*>(unbase64_table);
+  uint8x16x4_t lo;
+  uint8x16x4_t hi;
+  for (int j = 0; j < 4; j++) {
+    lo.val[j] = vld1q_u8(table + 16 * j);
+    hi.val[j] = vld1q_u8(table + 64 + 16 * j);
+  }
+  size_t i = 0;
+  size_t k = 0;
+  for (; i + 64 <= slen && k + 48 <= dlen; i += 64, k += 48) {
+    uint8x16x4_t in = vld4q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16_t error = vdupq_n_u8(0);
+    for (int j = 0; j < 4; j++) {
+      // Out-of-range indices yield 0 in the first lookup and keep the
+      // previous result in the second one, so non-ASCII characters have to
+      // be checked for separately.
+      uint8x16_t values = vqtbl4q_u8(lo, in.val[j]);
+      values = vqtbx4q_u8(values, hi, vsubq_u8(in.val[j], vdupq_n_u8(64)));
+      error = vorrq_u8(error, vorrq_u8(values, in.val[j]));
+      in.val[j] = values;
+    }
+    if (vmaxvq_u8(error) & 0x80)
+      break;
+    uint8x16x3_t out;
+    out.val[0] = vorrq_u8(vshlq_n_u8(in.val[0], 2), vshrq_n_u8(in.val[1], 4));
+    out.val[1] = vorrq_u8(vshlq_n_u8(in.val[1], 4), vshrq_n_u8(in.val[2], 2));
+    out.val[2] = vorrq_u8(vshlq_n_u8(in.val[2], 6), in.val[3]);
+    vst3q_u8(reinterpret_cast<uint8_t*>(dst + k), out);
+  }
+  return i;
+}
+
+size_t HexEncodeNEON(const char* src, size_t slen, char* dst) {
+  const uint8x16_t digits =
+      vld1q_u8(reinterpret_cast<const uint8_t*>("0123456789abcdef"));
+  size_t i = 0;
+  for (; i + 16 <= slen; i += 16) {
+    const uint8x16_t in = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16x2_t out;
+    out.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(in, 4));
+    out.val[1] = vqtbl1q_u8(digits, vandq_u8(in, vdupq_n_u8(0x0f)));
+    vst2q_u8(reinterpret_cast<uint8_t*>(dst + 2 * i), out);
+  }
+  return i;
+}
+
+inline bool HexDecodeBlock(uint8x16_t in, uint8x16_t* out) {
+  const uint8x16_t digit = vsubq_u8(in, vdupq_n_u8('0'));
+  const uint8x16_t is_digit = vcltq_u8(digit, vdupq_n_u8(10));
+  const uint8x16_t letter =
+      vsubq_u8(vorrq_u8(in, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+  const uint8x16_t is_letter = vcltq_u8(letter, vdupq_n_u8(6));
+  if (vminvq_u8(vorrq_u8(is_digit, is_letter)) != 0xff)
+    return false;
+  *out = vbslq_u8(is_digit, digit, vaddq_u8(letter, vdupq_n_u8(10)));
+  return true;
+}
+
+size_t HexDecodeNEON(const char* src, size_t slen, char* dst, size_t dlen) {
+  size_t i = 0;
+  size_t k = 0;
+  for (; i + 32 <= slen && k + 16 <= dlen; i += 32, k += 16) {
+    const uint8x16x2_t in =
+        vld2q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    uint8x16_t hi;
+    uint8x16_t lo;
+    if (!HexDecodeBlock(in.val[0], &hi) || !HexDecodeBlock(in.val[1], &lo))
+      break;
+    vst1q_u8(reinterpret_cast<uint8_t*>(dst + k),
+             vorrq_u8(vshlq_n_u8(hi, 4), lo));
+  }
+  return i;
+}
+
+size_t AsciiPrefixLengthNEON(const char* src, size_t len) {
+  size_t i = 0;
+  for (; i + 64 <= len; i += 64) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(src + i);
+    const uint8x16_t any =
+        vorrq_u8(vorrq_u8(vld1q_u8(p), vld1q_u8(p + 16)),
+                 vorrq_u8(vld1q_u8(p + 32), vld1q_u8(p + 48)));
+    if (vmaxvq_u8(any) >= 0x80)
+      break;
+  }
+  for (; i + 16 <= len; i += 16) {
+    if (vmaxvq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(src + i))) >= 0x80)
+      break;
+  }
+  while (i < len && static_cast<int8_t>(src[i]) >= 0)
+    i++;
+  return i;
+}
+
+size_t CountNonAsciiNEON(const char* src, size_t len) {
+  size_t count = 0;
+  size_t i = 0;
+  while (i + 16 <= len) {
+    // Count in bytes for up to 255 blocks at a time, then add those up.
+    const size_t blocks = std::min<size_t>((len - i) / 16, 255);
+    uint8x16_t counts = vdupq_n_u8(0);
+    for (size_t end = i + blocks * 16; i < end; i += 16) {
+      const uint8x16_t in = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+      counts = vaddq_u8(counts, vshrq_n_u8(in, 7));
+    }
+    count += vaddlvq_u8(counts);
+  }
+  for (; i < len; i++)
+    count += static_cast<uint8_t>(src[i]) >> 7;
+  return count;
+}
+
+// See the x86 version of these for what they do.
+inline uint8x16_t Utf8Errors(uint8x16_t input, uint8x16_t prev_input) {
+  const uint8x16_t prev1 = vextq_u8(prev_input, input, 15);
+  const uint8x16_t byte_1_high =
+      vqtbl1q_u8(vld1q_u8(kUtf8Byte1High), vshrq_n_u8(prev1, 4));
+  const uint8x16_t byte_1_low =
+      vqtbl1q_u8(vld1q_u8(kUtf8Byte1Low), vandq_u8(prev1, vdupq_n_u8(0x0f)));
+  const uint8x16_t byte_2_high =
+      vqtbl1q_u8(vld1q_u8(kUtf8Byte2High), vshrq_n_u8(input, 4));
+  const uint8x16_t special =
+      vandq_u8(vandq_u8(byte_1_high, byte_1_low), byte_2_high);
+
+  const uint8x16_t prev2 = vextq_u8(prev_input, input, 14);
+  const uint8x16_t prev3 = vextq_u8(prev_input, input, 13);
+  const uint8x16_t must_continue =
+      vorrq_u8(vqsubq_u8(prev2, vdupq_n_u8(0xe0 - 0x80)),
+               vqsubq_u8(prev3, vdupq_n_u8(0xf0 - 0x80)));
+  return veorq_u8(vandq_u8(must_continue, vdupq_n_u8(0x80)), special);
+}
+
+inline uint8x16_t Utf8Incomplete(uint8x16_t input) {
+  static const uint8_t kMax[16] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xf0 - 1, 0xe0 - 1, 0xc0 - 1
+  };
+  return vqsubq_u8(input, vld1q_u8(kMax));
+}
+
+inline void Utf8CheckBlock(uint8x16_t input,
+                           uint8x16_t* prev_input,
+                           uint8x16_t* prev_incomplete,
+                           uint8x16_t* error) {
+  if (vmaxvq_u8(input) < 0x80) {
+    *error = vorrq_u8(*error, *prev_incomplete);
+  } else {
+    *error = vorrq_u8(*error, Utf8Errors(input, *prev_input));
+    *prev_incomplete = Utf8Incomplete(input);
+  }
+  *prev_input = input;
+}
+
+bool ValidateUtf8NEON(const char* src, size_t len) {
+  uint8x16_t prev_input = vdupq_n_u8(0);
+  uint8x16_t prev_incomplete = vdupq_n_u8(0);
+  uint8x16_t error = vdupq_n_u8(0);
+  size_t i = 0;
+  for (; i + 16 <= len; i += 16) {
+    const uint8x16_t in = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+    Utf8CheckBlock(in, &prev_input, &prev_incomplete, &error);
+  }
+  if (i < len) {
+    uint8_t tail[16] = {};
+    memcpy(tail, src + i, len - i);
+    Utf8CheckBlock(vld1q_u8(tail), &prev_input, &prev_incomplete, &error);
+  }
+  error = vorrq_u8(error, prev_incomplete);
+  return vmaxvq_u8(error) == 0;
+}
+
+#endif  // NODE_SIMD_X86
+
+#if !NODE_SIMD_X86 && !NODE_SIMD_NEON
+
+size_t AsciiPrefixLengthScalar(const char* src, size_t len) {
+  size_t i = 0;
+  while (i < len && static_cast<int8_t>(src[i]) >= 0)
+    i++;
+  return i;
+}
+
+size_t CountNonAsciiScalar(const char* src, size_t len) {
+  size_t count = 0;
+  for (size_t i = 0; i < len; i++)
+    count += static_cast<uint8_t>(src[i]) >> 7;
+  return count;
+}
+
+#endif  // !NODE_SIMD_X86 && !NODE_SIMD_NEON
+
+#if !NODE_SIMD_NEON
+
+bool ValidateUtf8Scalar(const char* src, size_t len) {
+  const uint8_t* s = reinterpret_cast<const uint8_t*>(src);
+  size_t i = 0;
+  while (i < len) {
+    const uint8_t c = s[i];
+    if (c < 0x80) {
+      i++;
+      continue;
+    }
+    // The allowed range of the second byte depends on the lead byte, see
+    // Table 3-7 of the Unicode standard. Later bytes are 0x80 to 0xbf.
+    size_t n;
+    uint8_t lo = 0x80;
+    uint8_t hi = 0xbf;
+    if (c >= 0xc2 && c <= 0xdf) {
+      n = 2;
+    } else if (c >= 0xe0 && c <= 0xef) {
+      n = 3;
+      if (c == 0xe0) lo = 0xa0;
+      if (c == 0xed) hi = 0x9f;
+    } else if (c >= 0xf0 && c <= 0xf4) {
+      n = 4;
+      if (c == 0xf0) lo = 0x90;
+      if (c == 0xf4) hi = 0x8f;
+    } else {
+      return false;
+    }
+    if (len - i < n || s[i + 1] < lo || s[i + 1] > hi)
+      return false;
+    for (size_t j = 2; j < n; j++) {
+      if ((s[i + j] & 0xc0) != 0x80)
+        return false;
+    }
+    i += n;
+  }
+  return true;
+}
+
+#endif  // !NODE_SIMD_NEON
+
+}  // anonymous namespace
+
+size_t Base64Encode(const char* src, size_t slen, char* dst) {
+#if NODE_SIMD_X86
+  switch (GetLevel()) {
+    case Level::kAVX2:
+      return Base64EncodeAVX2(src, slen, dst);
+    case Level::kSSSE3:
+      return Base64EncodeSSSE3(src, slen, dst);
+    default:
+      return 0;
+  }
+#elif NODE_SIMD_NEON
+  return Base64EncodeNEON(src, slen, dst);
+#else
+  return 0;
+#endif
+}
+
+size_t Base64Decode(const char* src, size_t slen, char* dst, size_t dlen) {
+#if NODE_SIMD_X86
+  switch (GetLevel()) {
+    case Level::kAVX2:
+      return Base64DecodeAVX2(src, slen, dst, dlen);
+    case Level::kSSSE3:
+      return Base64DecodeSSSE3(src, slen, dst, dlen);
+    default:
+      return 0;
+  }
+#elif NODE_SIMD_NEON
+  return Base64DecodeNEON(src, slen, dst, dlen);
+#else
+  return 0;
+#endif
+}
+
+size_t HexEncode(const char* src, size_t slen, char* dst) {
+#if NODE_SIMD_X86
+  switch (GetLevel()) {
+    case Level::kAVX2:
+      return HexEncodeAVX2(src, slen, dst);
+    case Level::kSSSE3:
+      return HexEncodeSSSE3(src, slen, dst);
+    default:
+      return 0;
+  }
+#elif NODE_SIMD_NEON
+  return HexEncodeNEON(src, slen, dst);
+#else
+  return 0;
+#endif
+}
+
+size_t HexDecode(const char* src, size_t slen, char* dst, size_t dlen) {
+#if NODE_SIMD_X86
+  switch (GetLevel()) {
+    case Level::kAVX2:
+      return HexDecodeAVX2(src, slen, dst, dlen);
+    case Level::kSSSE3:
+      return HexDecodeSSSE3(src, slen, dst, dlen);
+    default:
+      return 0;
+  }
+#elif NODE_SIMD_NEON
+  return HexDecodeNEON(src, slen, dst, dlen);
+#else
+  return 0;
+#endif
+}
+
+size_t AsciiPrefixLength(const char* src, size_t len) {
+#if NODE_SIMD_X86
+  return AsciiPrefixLengthSSE2(src, len);
+#elif NODE_SIMD_NEON
+  return AsciiPrefixLengthNEON(src, len);
+#else
+  return AsciiPrefixLengthScalar(src, len);
+#endif
+}
+
+size_t CountNonAscii(const char* src, size_t len) {
+#if NODE_SIMD_X86
+  return CountNonAsciiSSE2(src, len);
+#elif NODE_SIMD_NEON
+  return CountNonAsciiNEON(src, len);
+#else
+  return CountNonAsciiScalar(src, len);
+#endif
+}
+
+bool ValidateUtf8(const char* src, size_t len) {
+  // Most text starts with, or is entirely, ASCII.
+  const size_t ascii = AsciiPrefixLength(src, len);
+  src += ascii;
+  len -= ascii;
+  if (len == 0)
+    return true;
+#if NODE_SIMD_X86
+  switch (GetLevel()) {
+    case Level::kAVX2:
+      return ValidateUtf8AVX2(src, len);
+    case Level::kSSSE3:
+      return ValidateUtf8SSSE3(src, len);
+    default:
+      return ValidateUtf8Scalar(src, len);
+  }
+#elif NODE_SIMD_NEON
+  return ValidateUtf8NEON(src, len);
+#else
+  return ValidateUtf8Scalar(src, len);
+#endif
+}
+
+}  // namespace simd
+}  // namespace node
@@ -0,0 +1,51 @@
+#ifndef SRC_STRING_SIMD_H_
+#define SRC_STRING_SIMD_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <cstddef>
+
+namespace node {
+namespace simd {
+
+// Vectorized inner loops of the string encoders and decoders. The widest
+// implementation that the CPU supports (SSSE3 or AVX2 on x86, NEON on arm64)
+// is picked at runtime. The codecs handle a prefix of the input and return
+// how many input bytes they consumed, possibly 0; the caller finishes the
+// rest with scalar code.
+
+// Encodes whole groups of 3 bytes as base64, writing 4 characters for each
+// group to |dst|.
+size_t Base64Encode(const char* src, size_t slen, char* dst);
+
+// Decodes whole groups of 4 characters from the standard or the URL-safe
+// base64 alphabet, writing 3 bytes for each group to |dst|. Stops before a
+// block that contains anything else, like whitespace or padding. Writes at
+// most |dlen| bytes.
+size_t Base64Decode(const char* src, size_t slen, char* dst, size_t dlen);
+
+// Encodes bytes as lowercase hex digits, writing 2 characters for each byte
+// to |dst|.
+size_t HexEncode(const char* src, size_t slen, char* dst);
+
+// Decodes pairs of hex digits, writing 1 byte for each pair to |dst|. Stops
+// before a block that contains anything else. Writes at most |dlen| bytes.
+size_t HexDecode(const char* src, size_t slen, char* dst, size_t dlen);
+
+// Returns the length of the longest prefix of |src| that is ASCII.
+size_t AsciiPrefixLength(const char* src, size_t len);
+
+// Returns the number of bytes in |src| that are not ASCII.
+size_t CountNonAscii(const char* src, size_t len);
+
+// Returns true if |src| is well-formed UTF-8, i.e. has no truncated or
+// invalid sequences, overlong forms, surrogates or code points beyond
+// U+10FFFF.
+bool ValidateUtf8(const char* src, size_t len);
+
+}  // namespace simd
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_STRING_SIMD_H_
@@ -31,10 +31,18 @@
 #include "stream_base-inl.h"
 #include "util-inl.h"
 
+#include <openssl/kdf.h>
+
+#ifdef __linux__
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif  // __linux__
+
 namespace node {
 
 using crypto::SecureContext;
 using crypto::SSLWrap;
+using v8::Boolean;
 using v8::Context;
 using v8::DontDelete;
 using v8::EscapableHandleScope;
@@ -44,6 +52,7 @@ using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::Isolate;
 using v8::Local;
+using v8::Number;
 using v8::Object;
 using v8::ReadOnly;
 using v8::Signature;
@@ -258,6 +267,7 @@ void TLSWrap::SSLInfoCallback(const SSL* ssl_, int where, int ret) {
     Local<Value> callback;
 
     c->established_ = true;
+    c->handshake_written_ = BIO_number_written(c->enc_out_);
 
     if (object->Get(env->context(), env->onhandshakedone_string())
           .ToLocal(&callback) && callback->IsFunction()) {
@@ -299,60 +309,87 @@ void TLSWrap::EncOut() {
     return;
   }
 
+  // Write out whatever encrypted output is ready. Writes that finish
+  // synchronously are committed right away, so this keeps going until either
+  // everything is written or the underlying stream has to wait.
+  if (BIO_pending(enc_out_) != 0) {
+    int err = FlushEncOut();
+    if (err != 0) {
+      InvokeQueued(err);
+      return;
+    }
+    if (write_size_ != 0)
+      return;
+
+    // Everything was written synchronously. Simulate asynchronous finishing,
+    // TLS cannot handle this at the moment: callers such as DoWrite() and
+    // Cycle() do not expect the write callback to run from within them.
+    env()->SetImmediate([this](Environment* env) {
+      ClearIn();
+      EncOut();
+    }, object());
+    return;
+  }
+
   // No encrypted output ready to write to the underlying stream.
-  if (BIO_pending(enc_out_) == 0) {
-    Debug(this, "No pending encrypted output");
-    if (pending_cleartext_input_.size() == 0) {
-      if (!in_dowrite_) {
-        Debug(this, "No pending cleartext input, not inside DoWrite()");
+  Debug(this, "No pending encrypted output");
+  if (pending_cleartext_input_.size() == 0) {
+    if (!in_dowrite_) {
+      Debug(this, "No pending cleartext input, not inside DoWrite()");
+      InvokeQueued(0);
+    } else {
+      Debug(this, "No pending cleartext input, inside DoWrite()");
+      // TODO(@sam-github, @addaleax) If in_dowrite_ is true, appdata was
+      // passed to SSL_write().  If we are here, the data was not encrypted to
+      // enc_out_ yet.  Calling Done() "works", but since the write is not
+      // flushed, its too soon.  Just returning and letting the next EncOut()
+      // call Done() passes the test suite, but without more careful analysis,
+      // its not clear if it is always correct. Not calling Done() could block
+      // data flow, so for now continue to call Done(), just do it in the next
+      // tick.
+      env()->SetImmediate([this](Environment* env) {
         InvokeQueued(0);
-      } else {
-        Debug(this, "No pending cleartext input, inside DoWrite()");
-        // TODO(@sam-github, @addaleax) If in_dowrite_ is true, appdata was
-        // passed to SSL_write().  If we are here, the data was not encrypted to
-        // enc_out_ yet.  Calling Done() "works", but since the write is not
-        // flushed, its too soon.  Just returning and letting the next EncOut()
-        // call Done() passes the test suite, but without more careful analysis,
-        // its not clear if it is always correct. Not calling Done() could block
-        // data flow, so for now continue to call Done(), just do it in the next
-        // tick.
-        env()->SetImmediate([this](Environment* env) {
-          InvokeQueued(0);
-        }, object());
-      }
+      }, object());
     }
-    return;
   }
+}
 
-  char* data[kSimultaneousBufferCount];
-  size_t size[arraysize(data)];
-  size_t count = arraysize(data);
-  write_size_ = crypto::NodeBIO::FromBIO(enc_out_)->PeekMultiple(data,
-                                                                 size,
-                                                                 &count);
-  CHECK(write_size_ != 0 && count != 0);
 
-  uv_buf_t buf[arraysize(data)];
-  uv_buf_t* bufs = buf;
-  for (size_t i = 0; i < count; i++)
-    buf[i] = uv_buf_init(data[i], size[i]);
+int TLSWrap::FlushEncOut() {
+  crypto::NodeBIO* bio = crypto::NodeBIO::FromBIO(enc_out_);
+  while (write_size_ == 0 && BIO_pending(enc_out_) != 0) {
+    char* data[kSimultaneousBufferCount];
+    size_t size[arraysize(data)];
+    size_t count = arraysize(data);
+    write_size_ = bio->PeekMultiple(data, size, &count);
+    CHECK(write_size_ != 0 && count != 0);
 
-  Debug(this, "Writing %zu buffers to the underlying stream", count);
-  StreamWriteResult res = underlying_stream()->Write(bufs, count);
-  if (res.err != 0) {
-    InvokeQueued(res.err);
-    return;
-  }
+    uv_buf_t buf[arraysize(data)];
+    for (size_t i = 0; i < count; i++)
+      buf[i] = uv_buf_init(data[i], size[i]);
 
-  if (!res.async) {
-    Debug(this, "Write finished synchronously");
-    HandleScope handle_scope(env()->isolate());
+    Debug(this, "Writing %zu buffers to the underlying stream", count);
+    StreamWriteResult res = underlying_stream()->Write(buf, count);
+    if (res.err != 0)
+      return res.err;
 
-    // Simulate asynchronous finishing, TLS cannot handle this at the moment.
-    env()->SetImmediate([this](Environment* env) {
-      OnStreamAfterWrite(nullptr, 0);
-    }, object());
+    write_stats_[kFlushes]++;
+    write_stats_[kEncryptedBytes] += write_size_;
+    if (res.async)
+      break;
+
+    Debug(this, "Write finished synchronously");
+    write_stats_[kSyncFlushes]++;
+    bio->Read(nullptr, write_size_);
+    write_size_ = 0;
+    MaybeEnableKernelTLS();
+    // Cleartext that was held back waiting for the handshake can go out in
+    // the same pass. Inside DoWrite() it was only just stored, so don't
+    // bother trying again.
+    if (!in_dowrite_)
+      ClearIn();
   }
+  return 0;
 }
 
 
@@ -385,12 +422,13 @@ void TLSWrap::OnStreamAfterWrite(WriteWrap* req_wrap, int status) {
 
   // Commit
   crypto::NodeBIO::FromBIO(enc_out_)->Read(nullptr, write_size_);
+  write_size_ = 0;
+  MaybeEnableKernelTLS();
 
   // Ensure that the progress will be made and `InvokeQueued` will be called.
   ClearIn();
 
   // Try writing more data
-  write_size_ = 0;
   EncOut();
 }
 
@@ -529,6 +567,19 @@ void TLSWrap::ClearOut() {
     }
   }
 
+  // With kernel TLS, OpenSSL only writes records in response to what it
+  // reads, which are alerts that cannot be sent (see EnableKernelTLSTx()).
+  // The connection cannot continue properly without them.
+  bool alert_dropped = false;
+  if (ktls_state_ == KernelTLSState::kActive) {
+    BIO* wbio = SSL_get_wbio(ssl_.get());
+    alert_dropped = BIO_pending(wbio) != 0;
+    if (alert_dropped) {
+      Debug(this, "Dropping a record that OpenSSL wrote after kernel TLS");
+      (void) BIO_reset(wbio);
+    }
+  }
+
   int flags = SSL_get_shutdown(ssl_.get());
   if (!eof_ && flags & SSL_RECEIVED_SHUTDOWN) {
     eof_ = true;
@@ -542,6 +593,11 @@ void TLSWrap::ClearOut() {
     HandleScope handle_scope(env()->isolate());
     int err;
     Local<Value> arg = GetSSLError(read, &err, nullptr);
+    if (arg.IsEmpty() && alert_dropped) {
+      err = SSL_ERROR_SSL;
+      arg = Exception::Error(FIXED_ONE_BYTE_STRING(env()->isolate(),
+          "A TLS alert could not be sent with kernel TLS"));
+    }
 
     // Ignore ZERO_RETURN after EOF, it is basically not a error
     if (err == SSL_ERROR_ZERO_RETURN && eof_)
@@ -579,14 +635,17 @@ void TLSWrap::ClearIn() {
   }
 
   AllocatedBuffer data = std::move(pending_cleartext_input_);
+
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
-  int written = SSL_write(ssl_.get(), data.data(), data.size());
-  Debug(this, "Writing %zu bytes, written = %d", data.size(), written);
-  CHECK(written == -1 || written == static_cast<int>(data.size()));
+  uv_buf_t buf = uv_buf_init(data.data(), data.size());
+  int ssl_ret = 0;
+  size_t written = EncryptCleartext(&buf, 1, &ssl_ret);
+  Debug(this, "Writing %zu bytes, written = %zu", data.size(), written);
+  CHECK(written == 0 || written == data.size());
 
   // All written
-  if (written != -1) {
+  if (written != 0) {
     Debug(this, "Successfully wrote all data to SSL");
     return;
   }
@@ -597,7 +656,7 @@ void TLSWrap::ClearIn() {
 
   int err;
   std::string error_str;
-  Local<Value> arg = GetSSLError(written, &err, &error_str);
+  Local<Value> arg = GetSSLError(ssl_ret, &err, &error_str);
   if (!arg.IsEmpty()) {
     Debug(this, "Got SSL error (%d)", err);
     write_callback_scheduled_ = true;
@@ -678,8 +737,155 @@ void TLSWrap::ClearError() {
 }
 
 
+size_t TLSWrap::EncryptCleartext(const uv_buf_t* bufs,
+                                 size_t count,
+                                 int* ssl_ret) {
+  if (ktls_state_ == KernelTLSState::kActive) {
+    // The kernel encrypts whatever is written to the socket, so the cleartext
+    // goes to the underlying stream as it is.
+    crypto::NodeBIO* bio = crypto::NodeBIO::FromBIO(enc_out_);
+    size_t length = 0;
+    for (size_t i = 0; i < count; i++) {
+      bio->Write(bufs[i].base, bufs[i].len);
+      length += bufs[i].len;
+    }
+    write_stats_[kCleartextBytes] += length;
+    write_stats_[kRecords] +=
+        (length + SSL3_RT_MAX_PLAIN_LENGTH - 1) / SSL3_RT_MAX_PLAIN_LENGTH;
+    return length;
+  }
+
+  char scratch[kCoalesceBufferSize];
+  size_t scratch_used = 0;
+  size_t encrypted = 0;
+
+  auto write = [&](const char* data, size_t len) {
+    int written = SSL_write(ssl_.get(), data, len);
+    if (written <= 0) {
+      *ssl_ret = written;
+      return false;
+    }
+    CHECK_EQ(static_cast<size_t>(written), len);
+    encrypted += len;
+    write_stats_[kCleartextBytes] += len;
+    write_stats_[kRecords] +=
+        (len + SSL3_RT_MAX_PLAIN_LENGTH - 1) / SSL3_RT_MAX_PLAIN_LENGTH;
+    return true;
+  };
+
+  auto flush_scratch = [&]() {
+    if (scratch_used == 0)
+      return true;
+    size_t len = scratch_used;
+    scratch_used = 0;
+    return write(scratch, len);
+  };
+
+  for (size_t i = 0; i < count; i++) {
+    const uv_buf_t& buf = bufs[i];
+    if (buf.len == 0)
+      continue;
+
+    if (buf.len <= kMaxCoalescedBufferSize) {
+      if (scratch_used + buf.len > sizeof(scratch) && !flush_scratch())
+        return encrypted;
+      memcpy(scratch + scratch_used, buf.base, buf.len);
+      scratch_used += buf.len;
+      continue;
+    }
+
+    if (!flush_scratch() || !write(buf.base, buf.len))
+      return encrypted;
+  }
+
+  flush_scratch();
+  return encrypted;
+}
+
+
+int TLSWrap::DoTryWrite(uv_buf_t** bufs, size_t* count) {
+  // Only take the synchronous path if nothing else is queued up; everything
+  // else needs the ordering guarantees of DoWrite() and EncOut().
+  if (ssl_ == nullptr ||
+      !established_ ||
+      shutdown_ ||
+      !hello_parser_.IsEnded() ||
+      is_awaiting_new_session() ||
+      current_write_ != nullptr ||
+      current_empty_write_ != nullptr ||
+      write_size_ != 0 ||
+      encrypted_ahead_ != 0 ||
+      pending_cleartext_input_.size() != 0 ||
+      BIO_pending(enc_out_) != 0) {
+    return 0;
+  }
+
+  uv_buf_t* vbufs = *bufs;
+  size_t vcount = *count;
+  size_t length = 0;
+  for (size_t i = 0; i < vcount; i++)
+    length += vbufs[i].len;
+  if (length == 0)
+    return 0;
+
+  MaybeEnableKernelTLS();
+  if (ktls_state_ == KernelTLSState::kActive) {
+    // Nothing to encrypt, so the buffers can be written without a copy.
+    int err = underlying_stream()->DoTryWrite(bufs, count);
+    if (err != 0)
+      return err;
+    size_t remaining = 0;
+    for (size_t i = 0; i < *count; i++)
+      remaining += (*bufs)[i].len;
+    write_stats_[kCleartextBytes] += length - remaining;
+    write_stats_[kEncryptedBytes] += length - remaining;
+    if (remaining == 0)
+      write_stats_[kSyncWrites]++;
+    return 0;
+  }
+
+  crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
+  int ssl_ret = 0;
+  size_t written = EncryptCleartext(vbufs, vcount, &ssl_ret);
+  Debug(this, "DoTryWrite() encrypted %zu of %zu bytes", written, length);
+  // Leave the error, or the wait for the peer, to DoWrite().
+  if (written == 0)
+    return 0;
+
+  int err = FlushEncOut();
+  if (err != 0)
+    return err;
+
+  if (written < length) {
+    // Slice off what was encrypted; DoWrite() takes care of the rest.
+    for (; vcount > 0; vbufs++, vcount--) {
+      if (vbufs[0].len > written) {
+        vbufs[0].base += written;
+        vbufs[0].len -= written;
+        break;
+      }
+      written -= vbufs[0].len;
+    }
+    *bufs = vbufs;
+    *count = vcount;
+    return 0;
+  }
+
+  if (write_size_ != 0) {
+    // The underlying stream could not take everything. Keep the buffers as
+    // they are so that DoWrite() is called and can complete once the rest of
+    // enc_out_ has been written.
+    encrypted_ahead_ = length;
+    return 0;
+  }
+
+  write_stats_[kSyncWrites]++;
+  *count = 0;
+  return 0;
+}
+
+
 // Called by StreamBase::Write() to request async write of clear text into SSL.
-// TODO(@sam-github) Should there be a TLSWrap::DoTryWrite()?
 int TLSWrap::DoWrite(WriteWrap* w,
                      uv_buf_t* bufs,
                      size_t count,
@@ -736,33 +942,45 @@ int TLSWrap::DoWrite(WriteWrap* w,
     return 0;
   }
 
-  AllocatedBuffer data;
-  crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
-
-  int written = 0;
-  if (count != 1) {
-    data = env()->AllocateManaged(length);
-    size_t offset = 0;
-    for (i = 0; i < count; i++) {
-      memcpy(data.data() + offset, bufs[i].base, bufs[i].len);
-      offset += bufs[i].len;
+  // DoTryWrite() has already encrypted this data but could not write all of
+  // it to the underlying stream synchronously. EncOut() finishes the job.
+  if (encrypted_ahead_ != 0) {
+    bool encrypted = encrypted_ahead_ == length;
+    encrypted_ahead_ = 0;
+    if (encrypted) {
+      Debug(this, "Data was already encrypted by DoTryWrite()");
+      in_dowrite_ = true;
+      EncOut();
+      in_dowrite_ = false;
+      return 0;
     }
-    written = SSL_write(ssl_.get(), data.data(), length);
-  } else {
-    // Only one buffer: try to write directly, only store if it fails
-    written = SSL_write(ssl_.get(), bufs[0].base, bufs[0].len);
-    if (written == -1) {
-      data = env()->AllocateManaged(length);
-      memcpy(data.data(), bufs[0].base, bufs[0].len);
+  }
+
+  // If the handshake has only just finished, write out its last records now
+  // so that this data can already be encrypted by the kernel.
+  if (ktls_state_ == KernelTLSState::kPending &&
+      established_ &&
+      write_size_ == 0 &&
+      BIO_pending(enc_out_) != 0) {
+    in_dowrite_ = true;
+    int err = FlushEncOut();
+    in_dowrite_ = false;
+    if (err != 0) {
+      current_write_ = nullptr;
+      return err;
     }
   }
+  MaybeEnableKernelTLS();
+
+  crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
-  CHECK(written == -1 || written == static_cast<int>(length));
-  Debug(this, "Writing %zu bytes, written = %d", length, written);
+  int ssl_ret = 0;
+  size_t written = EncryptCleartext(bufs, count, &ssl_ret);
+  Debug(this, "Writing %zu bytes, written = %zu", length, written);
 
-  if (written == -1) {
+  if (written < length) {
     int err;
-    Local<Value> arg = GetSSLError(written, &err, &error_);
+    Local<Value> arg = GetSSLError(ssl_ret, &err, &error_);
 
     // If we stopped writing because of an error, it's fatal, discard the data.
     if (!arg.IsEmpty()) {
@@ -774,6 +992,19 @@ int TLSWrap::DoWrite(WriteWrap* w,
     Debug(this, "Saving data for later write");
     // Otherwise, save unwritten data so it can be written later by ClearIn().
     CHECK_EQ(pending_cleartext_input_.size(), 0);
+    AllocatedBuffer data = env()->AllocateManaged(length - written);
+    size_t offset = 0;
+    size_t skip = written;
+    for (i = 0; i < count; i++) {
+      if (skip >= bufs[i].len) {
+        skip -= bufs[i].len;
+        continue;
+      }
+      memcpy(data.data() + offset, bufs[i].base + skip, bufs[i].len - skip);
+      offset += bufs[i].len - skip;
+      skip = 0;
+    }
+    CHECK_EQ(offset, data.size());
     pending_cleartext_input_ = std::move(data);
   }
 
@@ -858,6 +1089,281 @@ int TLSWrap::DoShutdown(ShutdownWrap* req_wrap) {
 }
 
 
+void TLSWrap::GetWriteStatistics(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  Environment* env = wrap->env();
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+
+  const uint64_t* stats = wrap->write_stats_;
+  Local<Object> obj = Object::New(isolate);
+#define V(name, index)                                                        \
+  obj->Set(context,                                                           \
+           FIXED_ONE_BYTE_STRING(isolate, name),                              \
+           Number::New(isolate, static_cast<double>(stats[index]))).Check();
+  V("cleartextBytes", kCleartextBytes)
+  V("records", kRecords)
+  V("encryptedBytes", kEncryptedBytes)
+  V("flushes", kFlushes)
+  V("syncFlushes", kSyncFlushes)
+  V("syncWrites", kSyncWrites)
+#undef V
+  args.GetReturnValue().Set(obj);
+}
+
+
+void TLSWrap::MaybeEnableKernelTLS() {
+  if (ktls_state_ != KernelTLSState::kPending ||
+      ssl_ == nullptr ||
+      !established_ ||
+      write_size_ != 0 ||
+      BIO_pending(enc_out_) != 0) {
+    return;
+  }
+
+  if (EnableKernelTLSTx()) {
+    Debug(this, "Kernel TLS transmit offload enabled");
+    ktls_state_ = KernelTLSState::kActive;
+  } else {
+    Debug(this, "Kernel TLS transmit offload unavailable: %s",
+          ktls_reason_.c_str());
+    ktls_state_ = KernelTLSState::kUnavailable;
+  }
+}
+
+
+#ifdef __linux__
+namespace {
+
+// The parts of the kernel TLS ABI that are used here, as defined in
+// <linux/tcp.h> and <linux/tls.h>. They are spelled out so that building does
+// not depend on the version of the installed kernel headers.
+constexpr int kTcpUlp = 31;
+constexpr int kSolTls = 282;
+constexpr int kTlsTx = 1;
+constexpr uint16_t kTls12Version = 0x0303;
+constexpr uint16_t kTlsCipherAesGcm128 = 51;
+constexpr uint16_t kTlsCipherAesGcm256 = 52;
+constexpr size_t kTlsAesGcmSaltSize = 4;
+
+struct TlsCryptoInfo {
+  uint16_t version;
+  uint16_t cipher_type;
+};
+
+template <size_t kKeySize>
+struct Tls12CryptoInfoAesGcm {
+  TlsCryptoInfo info;
+  unsigned char iv[8];
+  unsigned char key[kKeySize];
+  unsigned char salt[kTlsAesGcmSaltSize];
+  unsigned char rec_seq[8];
+};
+
+template <size_t kKeySize>
+int SetKernelTLSTxKeys(int fd,
+                       uint16_t cipher_type,
+                       const unsigned char* key,
+                       const unsigned char* salt,
+                       const unsigned char* seq) {
+  Tls12CryptoInfoAesGcm<kKeySize> info;
+  memset(&info, 0, sizeof(info));
+  info.info.version = kTls12Version;
+  info.info.cipher_type = cipher_type;
+  memcpy(info.key, key, sizeof(info.key));
+  memcpy(info.salt, salt, sizeof(info.salt));
+  // The explicit nonce only has to be unique, so use the sequence number
+  // like OpenSSL does.
+  memcpy(info.iv, seq, sizeof(info.iv));
+  memcpy(info.rec_seq, seq, sizeof(info.rec_seq));
+  int err = 0;
+  if (setsockopt(fd, kSolTls, kTlsTx, &info, sizeof(info)) != 0)
+    err = -errno;
+  OPENSSL_cleanse(&info, sizeof(info));
+  return err;
+}
+
+}  // anonymous namespace
+#endif  // __linux__
+
+
+bool TLSWrap::EnableKernelTLSTx() {
+#ifndef __linux__
+  ktls_reason_ = "not supported on this platform";
+  return false;
+#else
+  AsyncWrap* wrap = underlying_stream()->GetAsyncWrap();
+  int fd = underlying_stream()->GetFD();
+  if (wrap == nullptr || wrap->provider_type() != PROVIDER_TCPWRAP || fd < 0) {
+    ktls_reason_ = "not a TCP socket";
+    return false;
+  }
+
+  // OpenSSL 1.1.1 has no interface for exporting TLSv1.3 traffic secrets and
+  // record sequence numbers, so only TLSv1.2 can be offloaded.
+  SSL* ssl = ssl_.get();
+  if (SSL_version(ssl) != TLS1_2_VERSION) {
+    ktls_reason_ = "protocol is not TLSv1.2";
+    return false;
+  }
+
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  int cipher_nid = SSL_CIPHER_get_cipher_nid(cipher);
+  size_t key_len;
+  if (cipher_nid == NID_aes_128_gcm) {
+    key_len = 16;
+  } else if (cipher_nid == NID_aes_256_gcm) {
+    key_len = 32;
+  } else {
+    ktls_reason_ = std::string("cipher ") + SSL_CIPHER_get_name(cipher) +
+                   " is not supported";
+    return false;
+  }
+
+  // The kernel always produces records of up to 16KB.
+  SSL_SESSION* session = SSL_get_session(ssl);
+  if (SSL_SESSION_get_max_fragment_length(session) !=
+      TLSEXT_max_fragment_length_DISABLED) {
+    ktls_reason_ = "a maximum fragment length was negotiated";
+    return false;
+  }
+
+  // The kernel has to continue with the sequence number that OpenSSL would
+  // use next, which is only known while Finished is the last record that
+  // OpenSSL wrote. Anything else, be it application data, data that was held
+  // back during the handshake and flushed by ClearIn(), or an alert, counts
+  // towards it.
+  if (BIO_number_written(enc_out_) != handshake_written_) {
+    ktls_reason_ = "records were written after the handshake finished";
+    return false;
+  }
+
+  // Recompute the key block (RFC 5246, section 6.3). For AEAD ciphers it
+  // consists of the client and server write keys followed by the client and
+  // server implicit nonces.
+  constexpr size_t kSaltLen = kTlsAesGcmSaltSize;
+  unsigned char master_key[SSL_MAX_MASTER_KEY_LENGTH];
+  size_t master_key_len =
+      SSL_SESSION_get_master_key(session, master_key, sizeof(master_key));
+  unsigned char randoms[2 * SSL3_RANDOM_SIZE];
+  SSL_get_server_random(ssl, randoms, SSL3_RANDOM_SIZE);
+  SSL_get_client_random(ssl, randoms + SSL3_RANDOM_SIZE, SSL3_RANDOM_SIZE);
+  unsigned char key_block[2 * 32 + 2 * kSaltLen];
+  size_t key_block_len = 2 * key_len + 2 * kSaltLen;
+  OnScopeLeave cleanse([&]() {
+    OPENSSL_cleanse(master_key, sizeof(master_key));
+    OPENSSL_cleanse(key_block, sizeof(key_block));
+  });
+
+  static const unsigned char kKeyExpansion[] = "key expansion";
+  crypto::EVPKeyCtxPointer pctx(
+      EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, nullptr));
+  if (!pctx ||
+      EVP_PKEY_derive_init(pctx.get()) <= 0 ||
+      EVP_PKEY_CTX_set_tls1_prf_md(
+          pctx.get(), SSL_CIPHER_get_handshake_digest(cipher)) <= 0 ||
+      EVP_PKEY_CTX_set1_tls1_prf_secret(
+          pctx.get(), master_key, master_key_len) <= 0 ||
+      EVP_PKEY_CTX_add1_tls1_prf_seed(
+          pctx.get(), kKeyExpansion, sizeof(kKeyExpansion) - 1) <= 0 ||
+      EVP_PKEY_CTX_add1_tls1_prf_seed(
+          pctx.get(), randoms, sizeof(randoms)) <= 0 ||
+      EVP_PKEY_derive(pctx.get(), key_block, &key_block_len) <= 0) {
+    ERR_clear_error();
+    ktls_reason_ = "failed to derive the write keys";
+    return false;
+  }
+
+  const unsigned char* key = key_block + (is_server() ? key_len : 0);
+  const unsigned char* salt =
+      key_block + 2 * key_len + (is_server() ? kSaltLen : 0);
+  // Finished is the only record that has been protected by these keys.
+  static const unsigned char seq[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+  // Records that OpenSSL writes from now on would be wrapped as application
+  // data by the kernel and reuse its sequence numbers, so they go here
+  // instead and are never sent. See ClearOut().
+  crypto::BIOPointer discard(BIO_new(BIO_s_mem()));
+  if (!discard) {
+    ktls_reason_ = "out of memory";
+    return false;
+  }
+
+  int err = 0;
+  if (setsockopt(fd, IPPROTO_TCP, kTcpUlp, "tls", sizeof("tls")) != 0) {
+    err = -errno;
+  } else if (key_len == 16) {
+    err = SetKernelTLSTxKeys<16>(fd, kTlsCipherAesGcm128, key, salt, seq);
+  } else {
+    err = SetKernelTLSTxKeys<32>(fd, kTlsCipherAesGcm256, key, salt, seq);
+  }
+  if (err != 0) {
+    ktls_reason_ = std::string("kernel: ") + uv_strerror(err);
+    return false;
+  }
+
+  // enc_out_ now only holds cleartext for the kernel. OpenSSL gives up its
+  // reference to it when the new BIO is set.
+  BIO_up_ref(enc_out_);
+  owned_enc_out_.reset(enc_out_);
+  SSL_set0_wbio(ssl, discard.release());
+  // Without a way to pass the record type to the kernel, the connection ends
+  // without close_notify, and renegotiation is refused.
+  SSL_set_quiet_shutdown(ssl, 1);
+  SSL_set_options(ssl, SSL_OP_NO_RENEGOTIATION);
+  return true;
+#endif  // __linux__
+}
+
+
+void TLSWrap::EnableKernelTLS(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK(!wrap->established_);
+  if (wrap->ktls_state_ == KernelTLSState::kDisabled)
+    wrap->ktls_state_ = KernelTLSState::kPending;
+}
+
+
+void TLSWrap::GetKernelTLSStatus(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  Environment* env = wrap->env();
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+
+  const char* reason = nullptr;
+  switch (wrap->ktls_state_) {
+    case KernelTLSState::kDisabled:
+      reason = "not requested";
+      break;
+    case KernelTLSState::kPending:
+      reason = "handshake in progress";
+      break;
+    case KernelTLSState::kActive:
+      break;
+    case KernelTLSState::kUnavailable:
+      reason = wrap->ktls_reason_.c_str();
+      break;
+  }
+
+  // Only transmit offload is implemented: received records may contain
+  // alerts or handshake messages, which a plain read() cannot tell apart.
+  bool tx = wrap->ktls_state_ == KernelTLSState::kActive;
+  Local<Object> obj = Object::New(isolate);
+  obj->Set(context, FIXED_ONE_BYTE_STRING(isolate, "tx"),
+           Boolean::New(isolate, tx)).Check();
+  obj->Set(context, FIXED_ONE_BYTE_STRING(isolate, "rx"),
+           Boolean::New(isolate, false)).Check();
+  if (reason != nullptr) {
+    obj->Set(context, env->reason_string(),
+             OneByteString(isolate, reason)).Check();
+  }
+  args.GetReturnValue().Set(obj);
+}
+
+
 void TLSWrap::SetVerifyMode(const FunctionCallbackInfo<Value>& args) {
   TLSWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -966,6 +1472,7 @@ void TLSWrap::DestroySSL(const FunctionCallbackInfo<Value>& args) {
   wrap->SSLWrap<TLSWrap>::DestroySSL();
   wrap->enc_in_ = nullptr;
   wrap->enc_out_ = nullptr;
+  wrap->owned_enc_out_.reset();
 
   if (wrap->stream_ != nullptr)
     wrap->stream_->RemoveStreamListener(wrap);
@@ -1134,6 +1641,9 @@ void TLSWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "enableTrace", EnableTrace);
   env->SetProtoMethod(t, "destroySSL", DestroySSL);
   env->SetProtoMethod(t, "enableCertCb", EnableCertCb);
+  env->SetProtoMethod(t, "getWriteStatistics", GetWriteStatistics);
+  env->SetProtoMethod(t, "enableKernelTLS", EnableKernelTLS);
+  env->SetProtoMethod(t, "getKernelTLSStatus", GetKernelTLSStatus);
 
   StreamBase::AddMethods(env, t);
   SSLWrap<TLSWrap>::AddMethods(env, t);
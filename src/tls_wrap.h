@@ -70,6 +70,7 @@ class TLSWrap : public AsyncWrap,
   int ReadStart() override;  // Exposed to JS
   int ReadStop() override;   // Exposed to JS
   int DoShutdown(ShutdownWrap* req_wrap) override;
+  int DoTryWrite(uv_buf_t** bufs, size_t* count) override;
   int DoWrite(WriteWrap* w,
               uv_buf_t* bufs,
               size_t count,
@@ -108,6 +109,31 @@ class TLSWrap : public AsyncWrap,
   // Maximum number of buffers passed to uv_write()
   static const int kSimultaneousBufferCount = 10;
 
+  // Cleartext buffers up to this size are copied together before being passed
+  // to SSL_write(), so that many small writes end up in few TLS records.
+  // Larger buffers are passed to SSL_write() as they are.
+  static const size_t kMaxCoalescedBufferSize = 4096;
+  static const size_t kCoalesceBufferSize = 16384;
+
+  enum WriteStatsFields {
+    kCleartextBytes,   // Bytes passed to SSL_write().
+    kRecords,          // TLS application data records produced.
+    kEncryptedBytes,   // Bytes written to the underlying stream.
+    kFlushes,          // Writes to the underlying stream.
+    kSyncFlushes,      // ... of which finished synchronously.
+    kSyncWrites,       // Writes that completed without a WriteWrap.
+    kWriteStatsFieldCount
+  };
+
+  // Kernel TLS transmit offload. It is requested before the handshake and set
+  // up once the handshake is done and all of its records have been written.
+  enum class KernelTLSState {
+    kDisabled,
+    kPending,
+    kActive,
+    kUnavailable
+  };
+
   TLSWrap(Environment* env,
           v8::Local<v8::Object> obj,
           Kind kind,
@@ -126,6 +152,20 @@ class TLSWrap : public AsyncWrap,
   void ClearIn();  // SSL_write() clear data "in" to SSL.
   void ClearOut();  // SSL_read() clear text "out" from SSL.
 
+  // Pass cleartext to SSL_write(), coalescing small buffers. Returns the number
+  // of bytes that were accepted; if that is less than the total, |*ssl_ret|
+  // is set to the result of the failed SSL_write() call.
+  size_t EncryptCleartext(const uv_buf_t* bufs, size_t count, int* ssl_ret);
+  // Write enc_out_ to the underlying stream until it is empty or a write has
+  // to complete asynchronously, in which case write_size_ is non-zero.
+  // Returns a libuv error code if a write failed.
+  int FlushEncOut();
+  // Hand the write keys to the kernel if offload was requested and the
+  // connection has reached a point where that is possible.
+  void MaybeEnableKernelTLS();
+  // Returns false, with ktls_reason_ set, if offload is not possible.
+  bool EnableKernelTLSTx();
+
   // Call Done() on outstanding WriteWrap request.
   bool InvokeQueued(int status, const char* error_str = nullptr);
 
@@ -165,6 +205,11 @@ class TLSWrap : public AsyncWrap,
   static void EnableTrace(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void EnableCertCb(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void DestroySSL(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetWriteStatistics(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableKernelTLS(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetKernelTLSStatus(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetServername(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetServername(const v8::FunctionCallbackInfo<v8::Value>& args);
   static int SelectSNIContextCallback(SSL* s, int* ad, void* arg);
@@ -178,6 +223,17 @@ class TLSWrap : public AsyncWrap,
   size_t write_size_ = 0;
   WriteWrap* current_write_ = nullptr;
   bool in_dowrite_ = false;
+  // Number of cleartext bytes of the next DoWrite() call that DoTryWrite()
+  // already encrypted into enc_out_.
+  size_t encrypted_ahead_ = 0;
+  uint64_t write_stats_[kWriteStatsFieldCount] = {};
+  KernelTLSState ktls_state_ = KernelTLSState::kDisabled;
+  std::string ktls_reason_;
+  // BIO_number_written(enc_out_) when the handshake finished.
+  uint64_t handshake_written_ = 0;
+  // Once kernel TLS is active, OpenSSL writes to a different BIO, and this
+  // holds the reference to enc_out_.
+  crypto::BIOPointer owned_enc_out_;
   WriteWrap* current_empty_write_ = nullptr;
   bool write_callback_scheduled_ = false;
   bool started_ = false;
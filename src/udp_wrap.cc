@@ -26,15 +26,23 @@
 #include "req_wrap-inl.h"
 #include "util-inl.h"
 
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#endif
+
 namespace node {
 
 using v8::Array;
+using v8::ArrayBuffer;
 using v8::Context;
 using v8::DontDelete;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Integer;
+using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
 using v8::Object;
@@ -43,6 +51,7 @@ using v8::ReadOnly;
 using v8::Signature;
 using v8::String;
 using v8::Uint32;
+using v8::Uint32Array;
 using v8::Undefined;
 using v8::Value;
 
@@ -52,6 +61,14 @@ class SendWrap : public ReqWrap<uv_udp_send_t> {
   inline bool have_callback() const;
   size_t msg_size;
 
+  // A batched send may be split across several libuv requests. Only the
+  // first one is dispatched through ReqWrap, the others live in
+  // `batch_reqs` and point back to this object through their `data` field.
+  // The JS callback runs once all of them have finished.
+  std::unique_ptr<uv_udp_send_t[]> batch_reqs;
+  size_t pending = 1;
+  int status = 0;
+
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(SendWrap)
   SET_SELF_SIZE(SendWrap)
@@ -119,9 +136,12 @@ void UDPWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "bind6", Bind6);
   env->SetProtoMethod(t, "connect6", Connect6);
   env->SetProtoMethod(t, "send6", Send6);
+  env->SetProtoMethod(t, "sendBatch", SendBatch);
+  env->SetProtoMethod(t, "sendBatch6", SendBatch6);
   env->SetProtoMethod(t, "disconnect", Disconnect);
   env->SetProtoMethod(t, "recvStart", RecvStart);
   env->SetProtoMethod(t, "recvStop", RecvStop);
+  env->SetProtoMethod(t, "setRecvBatchSize", SetRecvBatchSize);
   env->SetProtoMethod(t, "getpeername",
                       GetSockOrPeerName<UDPWrap, uv_udp_getpeername>);
   env->SetProtoMethod(t, "getsockname",
@@ -552,6 +572,201 @@ void UDPWrap::Send6(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+int UDPWrap::TrySendBatch(const uv_buf_t* bufs,
+                          const sockaddr_storage* addrs,
+                          size_t count,
+                          size_t* sent) {
+  *sent = 0;
+  // Datagrams that are already queued in libuv have to go out first.
+  if (uv_udp_get_send_queue_count(&handle_) > 0)
+    return 0;
+
+#ifdef __linux__
+  // The kernel processes at most UIO_MAXIOV messages per sendmmsg() call.
+  static constexpr size_t kMaxSendmmsgBatch = 1024;
+  uv_os_fd_t fd;
+  int err = uv_fileno(reinterpret_cast<uv_handle_t*>(&handle_), &fd);
+  if (err != 0)
+    return err;
+
+  MaybeStackBuffer<struct mmsghdr, 64> msgs(count);
+  for (size_t i = 0; i < count; i++) {
+    struct msghdr* hdr = &msgs[i].msg_hdr;
+    memset(hdr, 0, sizeof(*hdr));
+    if (addrs != nullptr) {
+      hdr->msg_name = const_cast<sockaddr_storage*>(&addrs[i]);
+      hdr->msg_namelen = addrs[i].ss_family == AF_INET6 ?
+          sizeof(sockaddr_in6) : sizeof(sockaddr_in);
+    }
+    // uv_buf_t is layout-compatible with struct iovec on Unices.
+    hdr->msg_iov = reinterpret_cast<struct iovec*>(const_cast<uv_buf_t*>(
+        &bufs[i]));
+    hdr->msg_iovlen = 1;
+  }
+
+  size_t done = 0;
+  while (done < count) {
+    unsigned int vlen = std::min<size_t>(count - done, kMaxSendmmsgBatch);
+    int r;
+    do {
+      r = sendmmsg(fd, &msgs[done], vlen, 0);
+    } while (r == -1 && errno == EINTR);
+
+    if (r == -1) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+        break;
+      // Report errors for the very first datagram only, like
+      // uv_udp_try_send() does. Otherwise, let uv_udp_send() retry the rest
+      // and report the error asynchronously.
+      if (done == 0)
+        return uv_translate_sys_error(errno);
+      break;
+    }
+    done += r;
+  }
+  *sent = done;
+  return 0;
+#else
+  while (*sent < count) {
+    const sockaddr* addr = addrs == nullptr ? nullptr :
+        reinterpret_cast<const sockaddr*>(&addrs[*sent]);
+    int err = uv_udp_try_send(&handle_, &bufs[*sent], 1, addr);
+    if (err == UV_ENOSYS || err == UV_EAGAIN)
+      return 0;
+    if (err < 0)
+      return *sent == 0 ? err : 0;
+    (*sent)++;
+  }
+  return 0;
+#endif  // __linux__
+}
+
+
+void UDPWrap::DoSendBatch(const FunctionCallbackInfo<Value>& args,
+                          int family) {
+  Environment* env = Environment::GetCurrent(args);
+
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+
+  // sendBatch(req, list, ports, addresses, hasCallback)
+  // ports and addresses are undefined for connected sockets.
+  CHECK_EQ(args.Length(), 5);
+  CHECK(args[0]->IsObject());
+  CHECK(args[1]->IsArray());
+  const bool sendto = args[2]->IsArray();
+  if (sendto)
+    CHECK(args[3]->IsArray());
+  CHECK(args[4]->IsBoolean());
+
+  Local<Object> req_wrap_obj = args[0].As<Object>();
+  Local<Array> chunks = args[1].As<Array>();
+  const size_t count = chunks->Length();
+  const bool have_callback = args[4]->IsTrue();
+  CHECK_GT(count, 0);
+
+  MaybeStackBuffer<uv_buf_t, 64> bufs(count);
+  MaybeStackBuffer<sockaddr_storage, 16> addrs(sendto ? count : 0);
+  size_t msg_size = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    Local<Value> chunk = chunks->Get(env->context(), i).ToLocalChecked();
+    size_t length = Buffer::Length(chunk);
+    bufs[i] = uv_buf_init(Buffer::Data(chunk), length);
+    msg_size += length;
+
+    if (sendto) {
+      Local<Value> port =
+          args[2].As<Array>()->Get(env->context(), i).ToLocalChecked();
+      Local<Value> address =
+          args[3].As<Array>()->Get(env->context(), i).ToLocalChecked();
+      CHECK(port->IsUint32());
+      CHECK(address->IsString());
+      node::Utf8Value address_str(env->isolate(), address);
+      int err = sockaddr_for_family(family,
+                                    address_str.out(),
+                                    port.As<Uint32>()->Value(),
+                                    &addrs[i]);
+      if (err != 0)
+        return args.GetReturnValue().Set(err);
+    }
+  }
+
+  const sockaddr_storage* addrs_ptr = sendto ? *addrs : nullptr;
+  auto addr_at = [&](size_t i) {
+    return addrs_ptr == nullptr ? nullptr :
+        reinterpret_cast<const sockaddr*>(&addrs_ptr[i]);
+  };
+
+  size_t sent = 0;
+  if (!UNLIKELY(env->options()->test_udp_no_try_send)) {
+    int err = wrap->TrySendBatch(*bufs, addrs_ptr, count, &sent);
+    if (err != 0)
+      return args.GetReturnValue().Set(err);
+    if (sent == count) {
+      // + 1 so that the JS side can distinguish 0-length async sends from
+      // 0-length sync sends.
+      args.GetReturnValue().Set(static_cast<uint32_t>(msg_size) + 1);
+      return;
+    }
+  }
+
+  AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(wrap);
+  SendWrap* req_wrap = new SendWrap(env, req_wrap_obj, have_callback);
+  req_wrap->msg_size = msg_size;
+
+  int err = req_wrap->Dispatch(uv_udp_send,
+                               &wrap->handle_,
+                               &bufs[sent],
+                               1,
+                               addr_at(sent),
+                               OnSend);
+  if (err) {
+    delete req_wrap;
+    return args.GetReturnValue().Set(err);
+  }
+
+  // libuv copies the buffer descriptors and addresses, so the remaining
+  // datagrams can be queued from the stack-allocated arrays.
+  const size_t remaining = count - sent - 1;
+  if (remaining > 0) {
+    req_wrap->batch_reqs.reset(new uv_udp_send_t[remaining]);
+    for (size_t i = 0; i < remaining; i++) {
+      uv_udp_send_t* req = &req_wrap->batch_reqs[i];
+      req->data = static_cast<ReqWrap<uv_udp_send_t>*>(req_wrap);
+      const size_t index = sent + 1 + i;
+      err = uv_udp_send(req,
+                        &wrap->handle_,
+                        &bufs[index],
+                        1,
+                        addr_at(index),
+                        OnSend);
+      if (err) {
+        // The requests queued so far will still complete and report this
+        // error through the callback.
+        req_wrap->status = err;
+        break;
+      }
+      req_wrap->pending++;
+    }
+  }
+
+  args.GetReturnValue().Set(0);
+}
+
+
+void UDPWrap::SendBatch(const FunctionCallbackInfo<Value>& args) {
+  DoSendBatch(args, AF_INET);
+}
+
+
+void UDPWrap::SendBatch6(const FunctionCallbackInfo<Value>& args) {
+  DoSendBatch(args, AF_INET6);
+}
+
+
 void UDPWrap::RecvStart(const FunctionCallbackInfo<Value>& args) {
   UDPWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap,
@@ -576,13 +791,20 @@ void UDPWrap::RecvStop(const FunctionCallbackInfo<Value>& args) {
 
 
 void UDPWrap::OnSend(uv_udp_send_t* req, int status) {
-  std::unique_ptr<SendWrap> req_wrap{static_cast<SendWrap*>(req->data)};
+  SendWrap* wrap = static_cast<SendWrap*>(req->data);
+  if (status < 0 && wrap->status == 0)
+    wrap->status = status;
+  CHECK_GT(wrap->pending, 0);
+  if (--wrap->pending > 0)
+    return;
+
+  std::unique_ptr<SendWrap> req_wrap{wrap};
   if (req_wrap->have_callback()) {
     Environment* env = req_wrap->env();
     HandleScope handle_scope(env->isolate());
     Context::Scope context_scope(env->context());
     Local<Value> arg[] = {
-      Integer::New(env->isolate(), status),
+      Integer::New(env->isolate(), req_wrap->status),
       Integer::New(env->isolate(), req_wrap->msg_size),
     };
     req_wrap->MakeCallback(env->oncomplete_string(), 2, arg);
@@ -590,11 +812,38 @@ void UDPWrap::OnSend(uv_udp_send_t* req, int status) {
 }
 
 
+void UDPWrap::SetRecvBatchSize(const FunctionCallbackInfo<Value>& args) {
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  CHECK(args[0]->IsUint32());
+  wrap->recv_batch_size_ = args[0].As<Uint32>()->Value();
+  wrap->recv_batch_offsets_.reserve(wrap->recv_batch_size_ + 1);
+  wrap->recv_batch_addrs_.reserve(wrap->recv_batch_size_);
+}
+
+
 void UDPWrap::OnAlloc(uv_handle_t* handle,
                       size_t suggested_size,
                       uv_buf_t* buf) {
   UDPWrap* wrap = static_cast<UDPWrap*>(handle->data);
-  *buf = wrap->env()->AllocateManaged(suggested_size).release();
+  if (!wrap->recv_batching()) {
+    *buf = wrap->env()->AllocateManaged(suggested_size).release();
+    return;
+  }
+
+  if (wrap->recv_batch_buffer_.data() == nullptr) {
+    wrap->recv_batch_buffer_ = wrap->env()->AllocateManaged(
+        std::max(kRecvBatchBufferSize, suggested_size));
+    wrap->recv_batch_used_ = 0;
+  }
+  // AppendToRecvBatch() flushes the batch before the remaining space gets
+  // too small for a full datagram, so this never truncates.
+  CHECK_GE(wrap->recv_batch_buffer_.size() - wrap->recv_batch_used_,
+           std::min(suggested_size, kMaxDatagramSize));
+  *buf = uv_buf_init(wrap->recv_batch_buffer_.data() + wrap->recv_batch_used_,
+                     wrap->recv_batch_buffer_.size() - wrap->recv_batch_used_);
 }
 
 void UDPWrap::OnRecv(uv_udp_t* handle,
@@ -605,7 +854,24 @@ void UDPWrap::OnRecv(uv_udp_t* handle,
   UDPWrap* wrap = static_cast<UDPWrap*>(handle->data);
   Environment* env = wrap->env();
 
-  AllocatedBuffer buf(env, *buf_);
+  if (wrap->recv_batching()) {
+    // The buffer is owned by recv_batch_buffer_.
+    if (nread == 0 && addr == nullptr) {
+      // The socket has been drained, deliver what we have.
+      wrap->FlushRecvBatch();
+      return;
+    }
+    if (nread >= 0) {
+      wrap->AppendToRecvBatch(nread, addr);
+      return;
+    }
+    // Keep datagrams and errors in order.
+    wrap->FlushRecvBatch();
+  }
+
+  AllocatedBuffer buf(env);
+  if (!wrap->recv_batching())
+    buf = AllocatedBuffer(env, *buf_);
   if (nread == 0 && addr == nullptr) {
     return;
   }
@@ -632,6 +898,102 @@ void UDPWrap::OnRecv(uv_udp_t* handle,
   wrap->MakeCallback(env->onmessage_string(), arraysize(argv), argv);
 }
 
+
+void UDPWrap::AppendToRecvBatch(size_t nread, const struct sockaddr* addr) {
+  CHECK_NOT_NULL(addr);
+  recv_batch_offsets_.push_back(static_cast<uint32_t>(recv_batch_used_));
+  recv_batch_addrs_.emplace_back();
+  memcpy(&recv_batch_addrs_.back(),
+         addr,
+         addr->sa_family == AF_INET6 ? sizeof(sockaddr_in6) :
+                                       sizeof(sockaddr_in));
+  recv_batch_used_ += nread;
+
+  if (recv_batch_addrs_.size() >= recv_batch_size_ ||
+      recv_batch_buffer_.size() - recv_batch_used_ < kMaxDatagramSize) {
+    FlushRecvBatch();
+  } else {
+    ScheduleRecvBatchFlush();
+  }
+}
+
+
+void UDPWrap::ScheduleRecvBatchFlush() {
+  if (recv_batch_flush_scheduled_)
+    return;
+  recv_batch_flush_scheduled_ = true;
+  env()->SetImmediate([this](Environment* env) {
+    recv_batch_flush_scheduled_ = false;
+    if (IsHandleClosing())
+      return;
+    FlushRecvBatch();
+  }, object());
+}
+
+
+static bool SameAddress(const sockaddr_storage& a, const sockaddr_storage& b) {
+  if (a.ss_family != b.ss_family)
+    return false;
+  if (a.ss_family == AF_INET6) {
+    const sockaddr_in6& a6 = reinterpret_cast<const sockaddr_in6&>(a);
+    const sockaddr_in6& b6 = reinterpret_cast<const sockaddr_in6&>(b);
+    return a6.sin6_port == b6.sin6_port &&
+           a6.sin6_scope_id == b6.sin6_scope_id &&
+           memcmp(&a6.sin6_addr, &b6.sin6_addr, sizeof(a6.sin6_addr)) == 0;
+  }
+  const sockaddr_in& a4 = reinterpret_cast<const sockaddr_in&>(a);
+  const sockaddr_in& b4 = reinterpret_cast<const sockaddr_in&>(b);
+  return a4.sin_port == b4.sin_port &&
+         a4.sin_addr.s_addr == b4.sin_addr.s_addr;
+}
+
+
+void UDPWrap::FlushRecvBatch() {
+  const size_t count = recv_batch_addrs_.size();
+  if (count == 0)
+    return;
+
+  Environment* env = this->env();
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Context::Scope context_scope(env->context());
+
+  recv_batch_offsets_.push_back(static_cast<uint32_t>(recv_batch_used_));
+  AllocatedBuffer buf = std::move(recv_batch_buffer_);
+  buf.Resize(recv_batch_used_);
+  recv_batch_used_ = 0;
+
+  Local<ArrayBuffer> offsets_ab =
+      ArrayBuffer::New(isolate, (count + 1) * sizeof(uint32_t));
+  memcpy(offsets_ab->GetContents().Data(),
+         recv_batch_offsets_.data(),
+         (count + 1) * sizeof(uint32_t));
+
+  // Datagrams from the same peer usually arrive in runs, so consecutive
+  // entries share one address object.
+  MaybeStackBuffer<Local<Value>, 64> rinfos(count);
+  for (size_t i = 0; i < count; i++) {
+    if (i > 0 && SameAddress(recv_batch_addrs_[i], recv_batch_addrs_[i - 1])) {
+      rinfos[i] = rinfos[i - 1];
+    } else {
+      rinfos[i] = AddressToJS(
+          env, reinterpret_cast<const sockaddr*>(&recv_batch_addrs_[i]));
+    }
+  }
+
+  recv_batch_offsets_.clear();
+  recv_batch_addrs_.clear();
+
+  Local<Value> argv[] = {
+    Integer::New(isolate, count),
+    object(),
+    buf.ToArrayBuffer(),
+    Uint32Array::New(offsets_ab, 0, count + 1),
+    Array::New(isolate, rinfos.out(), count)
+  };
+  MakeCallback(env->onmessages_string(), arraysize(argv), argv);
+}
+
 MaybeLocal<Object> UDPWrap::Instantiate(Environment* env,
                                         AsyncWrap* parent,
                                         UDPWrap::SocketType type) {
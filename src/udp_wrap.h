@@ -30,6 +30,8 @@
 #include "uv.h"
 #include "v8.h"
 
+#include <vector>
+
 namespace node {
 
 class UDPWrap: public HandleWrap {
@@ -50,9 +52,13 @@ class UDPWrap: public HandleWrap {
   static void Bind6(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Connect6(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Send6(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SendBatch(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SendBatch6(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Disconnect(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RecvStart(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RecvStop(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetRecvBatchSize(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void AddMembership(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void DropMembership(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void AddSourceSpecificMembership(
@@ -90,6 +96,15 @@ class UDPWrap: public HandleWrap {
                      int family);
   static void DoSend(const v8::FunctionCallbackInfo<v8::Value>& args,
                      int family);
+  static void DoSendBatch(const v8::FunctionCallbackInfo<v8::Value>& args,
+                          int family);
+  // Send as many of the datagrams as possible synchronously, using a single
+  // sendmmsg() call where available. `*sent` is set to the number of
+  // datagrams that went out. Returns 0 or a libuv error code.
+  int TrySendBatch(const uv_buf_t* bufs,
+                   const sockaddr_storage* addrs,
+                   size_t count,
+                   size_t* sent);
   static void SetMembership(const v8::FunctionCallbackInfo<v8::Value>& args,
                             uv_membership membership);
   static void SetSourceMembership(
@@ -106,7 +121,30 @@ class UDPWrap: public HandleWrap {
                      const struct sockaddr* addr,
                      unsigned int flags);
 
+  // Batched receive: datagrams are read back-to-back into one buffer and
+  // delivered to JS through a single `onmessages` call, either when
+  // `recv_batch_size_` datagrams have been collected, when the buffer cannot
+  // hold another maximum-sized datagram, when the socket has been drained or,
+  // at the latest, in the check phase of the current event loop iteration.
+  static constexpr size_t kRecvBatchBufferSize = 256 * 1024;
+  // Largest UDP payload we may have to make room for.
+  static constexpr size_t kMaxDatagramSize = 64 * 1024;
+
+  inline bool recv_batching() const { return recv_batch_size_ > 0; }
+  void AppendToRecvBatch(size_t nread, const struct sockaddr* addr);
+  void ScheduleRecvBatchFlush();
+  void FlushRecvBatch();
+
   uv_udp_t handle_;
+
+  size_t recv_batch_size_ = 0;
+  AllocatedBuffer recv_batch_buffer_;
+  size_t recv_batch_used_ = 0;
+  // Start offsets of the datagrams in the batch buffer, followed by the
+  // end offset of the last one once the batch is flushed.
+  std::vector<uint32_t> recv_batch_offsets_;
+  std::vector<sockaddr_storage> recv_batch_addrs_;
+  bool recv_batch_flush_scheduled_ = false;
 };
 
 }  // namespace node
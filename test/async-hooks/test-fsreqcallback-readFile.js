@@ -25,17 +25,13 @@ function onread() {
     assert.strictEqual(a.triggerAsyncId, lastParent);
     lastParent = a.uid;
   }
-  checkInvocations(as[0], { init: 1, before: 1, after: 1, destroy: 1 },
+  // Small files are opened, read and closed by a single request.
+  assert.strictEqual(as.length, 1);
+
+  // This callback is called from within the fs req callback therefore
+  // the req is still going and after/destroy haven't been called yet
+  checkInvocations(as[0], { init: 1, before: 1 },
                    'reqwrap[0]: while in onread callback');
-  checkInvocations(as[1], { init: 1, before: 1, after: 1, destroy: 1 },
-                   'reqwrap[1]: while in onread callback');
-  checkInvocations(as[2], { init: 1, before: 1, after: 1, destroy: 1 },
-                   'reqwrap[2]: while in onread callback');
-
-  // This callback is called from within the last fs req callback therefore
-  // the last req is still going and after/destroy haven't been called yet
-  checkInvocations(as[3], { init: 1, before: 1 },
-                   'reqwrap[3]: while in onread callback');
   tick(2);
 }
 
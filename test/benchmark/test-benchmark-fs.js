@@ -10,7 +10,9 @@ runBenchmark('fs', [
   'concurrent=1',
   'dir=.github',
   'dur=0.1',
+  'encoding=buffer',
   'encodingType=buf',
+  'files=1',
   'filesize=1024',
   'len=1024',
   'mode=callback',
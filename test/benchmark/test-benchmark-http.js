@@ -15,16 +15,19 @@ runBenchmark('http',
              [
                'benchmarker=test-double-http',
                'arg=string',
+               'batch=true',
                'c=1',
                'chunkedEnc=true',
                'chunks=0',
                'dur=0.1',
                'e=0',
+               'headers=1',
                'input=keep-alive',
                'key=""',
                'len=1',
                'method=write',
                'n=1',
+               'read=true',
                'res=normal',
                'type=asc',
                'url=long',
@@ -13,6 +13,7 @@ const runBenchmark = require('../common/benchmark');
 
 runBenchmark('worker',
              [
+               'functions=16',
                'n=1',
                'sendsPerBroadcast=1',
                'workers=1',
@@ -1,7 +1,10 @@
 #include "base64.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -125,3 +128,44 @@ TEST(Base64Test, Decode) {
        "dCBjdXBpZGF0YXQgbm9uIHByb2lkZW50LCBzdW50IGluIGN1bHBhIHF1aSBvZmZpY2lh\n"
        "IGRlc2VydW50IG1vbGxpdCBhbmltIGlkIGVzdCBsYWJvcnVtLg", text);
 }
+
+// Long inputs go through the vectorized code, which has to agree with the
+// scalar code for two-byte input, including where it falls back to it.
+TEST(Base64Test, DecodeLong) {
+  std::string text;
+  for (int i = 0; i < 3000; i++)
+    text += static_cast<char>(i * 7 + i / 256);
+  std::string encoded(node::base64_encoded_size(text.size()), '\0');
+  base64_encode(text.data(), text.size(), &encoded[0], encoded.size());
+
+  auto test = [&](const std::string& input, size_t dstlen) {
+    std::vector<char> narrow(dstlen);
+    std::vector<char> wide(dstlen);
+    const std::vector<uint16_t> wide_input(input.begin(), input.end());
+    const size_t narrow_len =
+        base64_decode(narrow.data(), dstlen, input.data(), input.size());
+    const size_t wide_len = base64_decode(wide.data(), dstlen,
+                                          wide_input.data(), wide_input.size());
+    EXPECT_EQ(narrow_len, wide_len);
+    EXPECT_EQ(narrow, wide);
+    return std::string(narrow.data(), narrow_len);
+  };
+
+  EXPECT_EQ(test(encoded, text.size()), text);
+  EXPECT_EQ(test(encoded, text.size() / 2), text.substr(0, text.size() / 2));
+
+  std::string url_safe = encoded;
+  for (char& c : url_safe) {
+    if (c == '+') c = '-';
+    if (c == '/') c = '_';
+  }
+  EXPECT_EQ(test(url_safe, text.size()), text);
+
+  for (size_t i = 0; i < 200; i += 7) {
+    std::string input = encoded;
+    input.insert(i, "\n");
+    EXPECT_EQ(test(input, text.size()), text);
+    input[i] = '\x80';
+    test(input, text.size());
+  }
+}
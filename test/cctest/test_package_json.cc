@@ -0,0 +1,93 @@
+#include "node_package_json.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+using node::loader::PackageJson;
+using node::loader::ParsePackageJson;
+
+namespace {
+
+std::shared_ptr<const PackageJson> Parse(const std::string& source) {
+  return ParsePackageJson(std::string(source));
+}
+
+}  // anonymous namespace
+
+TEST(PackageJsonTest, Fields) {
+  auto pkg = Parse("{ \"name\": \"pkg\", \"main\" : \"./lib/index.js\",\n"
+                   "  \"version\": \"1.0.0\", \"type\": \"module\",\n"
+                   "  \"exports\": { \".\": [\"./a.js\", null] },\n"
+                   "  \"imports\": { \"#dep\": \"./dep.js\" } }");
+  ASSERT_FALSE(pkg->needs_js_parse);
+  EXPECT_TRUE(pkg->mentions_fields);
+
+  const PackageJson::FieldValue& name = (*pkg)[PackageJson::kName];
+  EXPECT_TRUE(name.present);
+  EXPECT_TRUE(name.is_string);
+  EXPECT_EQ(name.value, "pkg");
+  EXPECT_EQ(name.json, "\"pkg\"");
+  EXPECT_EQ((*pkg)[PackageJson::kMain].value, "./lib/index.js");
+  EXPECT_EQ((*pkg)[PackageJson::kType].value, "module");
+
+  const PackageJson::FieldValue& exports = (*pkg)[PackageJson::kExports];
+  EXPECT_TRUE(exports.present);
+  EXPECT_FALSE(exports.is_string);
+  EXPECT_EQ(exports.json, "{ \".\": [\"./a.js\", null] }");
+  EXPECT_EQ((*pkg)[PackageJson::kImports].json,
+            "{ \"#dep\": \"./dep.js\" }");
+}
+
+TEST(PackageJsonTest, MissingFields) {
+  auto pkg = Parse("{\"name\":\"pkg\",\"dependencies\":{\"main\":\"1\"}}");
+  ASSERT_FALSE(pkg->needs_js_parse);
+  // The CommonJS loader looks for these strings anywhere in the file.
+  EXPECT_TRUE(pkg->mentions_fields);
+  EXPECT_FALSE((*pkg)[PackageJson::kMain].present);
+  EXPECT_FALSE((*pkg)[PackageJson::kExports].present);
+
+  pkg = Parse("{\"name\":\"pkg\"}");
+  EXPECT_FALSE(pkg->needs_js_parse);
+  EXPECT_FALSE(pkg->mentions_fields);
+}
+
+TEST(PackageJsonTest, Strings) {
+  auto pkg = Parse("\xEF\xBB\xBF{\"ma\\u0069n\": \"a\\/b\\u00e9\\ud83d\\ude00"
+                   "\\n\\\"\"}");
+  ASSERT_FALSE(pkg->needs_js_parse);
+  const PackageJson::FieldValue& main = (*pkg)[PackageJson::kMain];
+  EXPECT_TRUE(main.is_string);
+  EXPECT_EQ(main.value, "a/b\xC3\xA9\xF0\x9F\x98\x80\n\"");
+}
+
+TEST(PackageJsonTest, DuplicateKeys) {
+  auto pkg = Parse("{\"main\": 1, \"main\": \"b\", \"type\": \"module\","
+                   " \"type\": false}");
+  ASSERT_FALSE(pkg->needs_js_parse);
+  EXPECT_EQ((*pkg)[PackageJson::kMain].value, "b");
+  EXPECT_FALSE((*pkg)[PackageJson::kType].is_string);
+  EXPECT_EQ((*pkg)[PackageJson::kType].json, "false");
+}
+
+TEST(PackageJsonTest, NeedsJSParse) {
+  for (const char* source : { "", "[]", "null", "\"main\"", "{\"main\":}",
+                              "{\"main\":\"a\",}", "{\"a\":01}", "{} x",
+                              "{\"a\":\"\\ud800\"}", "{\"a\":'b'}",
+                              "{\"a\":\"\t\"}", "{\"a\":-}", "{\"a\":1.}",
+                              "{\"main\":\"a\"" }) {
+    auto pkg = Parse(source);
+    EXPECT_TRUE(pkg->needs_js_parse) << source;
+    EXPECT_EQ(pkg->source, source);
+    EXPECT_FALSE((*pkg)[PackageJson::kMain].present) << source;
+  }
+
+  std::string deep(100, '[');
+  deep = "{\"main\":\"a\",\"x\":" + deep + std::string(100, ']') + "}";
+  EXPECT_TRUE(Parse(deep)->needs_js_parse);
+}
+
+TEST(PackageJsonTest, Numbers) {
+  auto pkg = Parse("{\"a\": [0, -0, 1.5, -12e3, 4E+2, 5e-1, true, false]}");
+  EXPECT_FALSE(pkg->needs_js_parse);
+}
@@ -0,0 +1,84 @@
+#include "string_simd.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+using node::simd::AsciiPrefixLength;
+using node::simd::CountNonAscii;
+using node::simd::ValidateUtf8;
+
+namespace {
+
+bool Validate(const std::string& str) {
+  return ValidateUtf8(str.data(), str.size());
+}
+
+}  // anonymous namespace
+
+TEST(StringSimdTest, AsciiPrefixLength) {
+  for (size_t length : {0, 1, 15, 16, 17, 63, 64, 65, 200}) {
+    std::string str(length, 'a');
+    EXPECT_EQ(AsciiPrefixLength(str.data(), str.size()), length);
+    EXPECT_EQ(CountNonAscii(str.data(), str.size()), 0u);
+    for (size_t i = 0; i < length; i++) {
+      str[i] = '\xe9';
+      EXPECT_EQ(AsciiPrefixLength(str.data(), str.size()), i);
+      EXPECT_EQ(CountNonAscii(str.data(), str.size()), 1u);
+      str[i] = 'a';
+    }
+    str.assign(length, '\xff');
+    EXPECT_EQ(CountNonAscii(str.data(), str.size()), length);
+  }
+}
+
+TEST(StringSimdTest, ValidateUtf8) {
+  const std::string valid[] = {
+    "",
+    "abc",
+    "\x7f",
+    "\xc2\x80",
+    "\xdf\xbf",
+    "\xe0\xa0\x80",
+    "\xed\x9f\xbf",
+    "\xee\x80\x80",
+    "\xef\xbf\xbf",
+    "\xf0\x90\x80\x80",
+    "\xf4\x8f\xbf\xbf",
+  };
+  const std::string invalid[] = {
+    "\x80",              // Continuation without lead.
+    "\xc2",              // Truncated.
+    "\xe0\xa0",
+    "\xf0\x90\x80",
+    "\xc2\x41",          // Lead followed by ASCII.
+    "\xc2\xc2\x80",      // Lead followed by lead.
+    "\xc0\x80",          // Overlong.
+    "\xc1\xbf",
+    "\xe0\x9f\xbf",
+    "\xf0\x8f\xbf\xbf",
+    "\xed\xa0\x80",      // Surrogate.
+    "\xed\xbf\xbf",
+    "\xf4\x90\x80\x80",  // Beyond U+10FFFF.
+    "\xf5\x80\x80\x80",
+    "\xff",
+    "\xc2\x80\x80",      // Extra continuation.
+    "\xe0\xa0\x80\x80",
+  };
+
+  // Place every sequence at every offset of a block and at the end of the
+  // input, which is where the vectorized code has its edge cases.
+  for (size_t prefix = 0; prefix < 70; prefix++) {
+    const std::string ascii(prefix, 'x');
+    for (const std::string& str : valid) {
+      EXPECT_TRUE(Validate(ascii + str));
+      EXPECT_TRUE(Validate(ascii + str + ascii));
+      EXPECT_TRUE(Validate(ascii + str + "\xc3\xa9" + ascii));
+    }
+    for (const std::string& str : invalid) {
+      EXPECT_FALSE(Validate(ascii + str));
+      EXPECT_FALSE(Validate(ascii + str + ascii));
+      EXPECT_FALSE(Validate(ascii + "\xc3\xa9" + str + ascii));
+    }
+  }
+}
@@ -0,0 +1,69 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { StringDecoder } = require('string_decoder');
+const { TextDecoder } = require('util');
+
+// ASCII and Latin-1 text is decoded from UTF-8 without V8's or ICU's decoder.
+// The results have to be the same as for any other text, including for
+// strings that are large enough to be external.
+
+const small = 'Hello, world! ';
+const latin1 = 'Grüße, café, naïve, £5 ÿ ';
+const other = 'Привет, мир! 👋 ';
+const large = 2 * 1024 * 1024;
+
+for (const text of [small, latin1, other]) {
+  for (const str of [text, text.repeat(Math.ceil(large / text.length))]) {
+    const buf = Buffer.from(str);
+    assert.strictEqual(buf.toString(), str);
+    assert.strictEqual(buf.toString('utf8', 3), buf.slice(3).toString());
+    assert.strictEqual(Buffer.byteLength(buf.toString()), buf.length);
+    assert.strictEqual(Buffer.byteLength(buf.toString('latin1')), buf.length +
+                       buf.filter((byte) => byte >= 0x80).length);
+
+    const decoder = new StringDecoder('utf8');
+    assert.strictEqual(decoder.write(buf.slice(0, 7)) +
+                       decoder.write(buf.slice(7)) +
+                       decoder.end(), str);
+  }
+}
+
+// Invalid UTF-8 that starts like Latin-1 is left to V8.
+for (const [bytes, str] of [
+  [[0x61, 0xc3], 'a\ufffd'],
+  [[0xc3, 0x41], '\ufffdA'],
+  [[0xc3, 0xa9, 0xc2], '\u00e9\ufffd'],
+  [[0xc2], '\ufffd'],
+]) {
+  assert.strictEqual(Buffer.from(bytes).toString(), str);
+}
+
+if (common.hasIntl) {
+  for (const str of [small, latin1, other]) {
+    const decoder = new TextDecoder();
+    const buf = Buffer.from(str);
+    assert.strictEqual(decoder.decode(buf), str);
+    assert.strictEqual(decoder.decode(Buffer.concat([
+      Buffer.from([0xef, 0xbb, 0xbf]), buf])), str);
+    assert.strictEqual(
+      new TextDecoder('utf-8', { ignoreBOM: true })
+        .decode(Buffer.concat([Buffer.from([0xef, 0xbb, 0xbf]), buf])),
+      `\ufeff${str}`);
+
+    // A character split across calls goes through ICU, and so does whatever
+    // follows it in the same call.
+    const split = Buffer.from(`x${other}`);
+    assert.strictEqual(decoder.decode(split.slice(0, 3), { stream: true }) +
+                       decoder.decode(split.slice(3), { stream: true }) +
+                       decoder.decode(buf),
+                       `x${other}${str}`);
+  }
+
+  assert.strictEqual(new TextDecoder().decode(Buffer.from([0x61, 0xff])),
+                     'a\ufffd');
+  assert.throws(
+    () => new TextDecoder('utf-8', { fatal: true })
+      .decode(Buffer.from([0x61, 0xc3])),
+    { code: 'ERR_ENCODING_INVALID_ENCODED_DATA' });
+}
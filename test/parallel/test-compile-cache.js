@@ -0,0 +1,85 @@
+'use strict';
+
+// Tests --experimental-compile-cache and NODE_COMPILE_CACHE: the code cache of
+// user modules is written on the first run, consumed on later runs and
+// refreshed when a module changes.
+
+require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const cacheDir = path.join(tmpdir.path, 'cache');
+const main = path.join(tmpdir.path, 'main.js');
+const dep = path.join(tmpdir.path, 'dep.js');
+
+fs.writeFileSync(main, `
+const { internalBinding } = require('internal/test/binding');
+const {
+  flushCompileCache,
+  getCompileCacheStatistics,
+} = internalBinding('contextify');
+require('./dep.js');
+import('./esm.mjs').then(() => {
+  const stats = getCompileCacheStatistics();
+  flushCompileCache();
+  stats.written = getCompileCacheStatistics().written;
+  console.log(JSON.stringify(stats));
+});
+`);
+fs.writeFileSync(dep, 'module.exports = 42;\n');
+fs.writeFileSync(path.join(tmpdir.path, 'esm.mjs'), 'export default 42;\n');
+
+function run(args, env) {
+  const child = spawnSync(process.execPath, [
+    '--expose-internals',
+    '--experimental-modules',
+    '--no-warnings',
+    ...args,
+    main,
+  ], { env: { ...process.env, ...env } });
+  assert.strictEqual(child.status, 0, child.stderr.toString());
+  return JSON.parse(child.stdout);
+}
+
+{
+  const stats = run([`--experimental-compile-cache=${cacheDir}`]);
+  assert.strictEqual(stats.hits, 0);
+  assert.strictEqual(stats.misses, 3);
+  assert.strictEqual(stats.rejected, 0);
+  assert.strictEqual(stats.written, 3);
+  assert.ok(stats.directory.startsWith(cacheDir));
+  assert.strictEqual(fs.readdirSync(stats.directory).length, 3);
+}
+
+{
+  const stats = run([`--experimental-compile-cache=${cacheDir}`]);
+  assert.strictEqual(stats.hits, 3);
+  assert.strictEqual(stats.misses, 0);
+  assert.strictEqual(stats.rejected, 0);
+  assert.strictEqual(stats.written, 0);
+}
+
+{
+  const stats = run([], { NODE_COMPILE_CACHE: cacheDir });
+  assert.strictEqual(stats.hits, 3);
+  assert.strictEqual(stats.written, 0);
+}
+
+// A modified module is compiled from scratch and its cache is replaced.
+fs.writeFileSync(dep, 'module.exports = 43;\n');
+{
+  const stats = run([`--experimental-compile-cache=${cacheDir}`]);
+  assert.strictEqual(stats.hits, 2);
+  assert.strictEqual(stats.misses, 1);
+  assert.strictEqual(stats.written, 1);
+}
+{
+  const stats = run([`--experimental-compile-cache=${cacheDir}`]);
+  assert.strictEqual(stats.hits, 3);
+  assert.strictEqual(stats.written, 0);
+}
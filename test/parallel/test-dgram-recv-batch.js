@@ -0,0 +1,58 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+// With recvBatchSize, datagrams are delivered through 'messages' events
+// that carry a shared buffer, an offsets table and the sender addresses.
+
+const count = 50;
+const batchSize = 16;
+
+[null, 'string', 0, 4097, 1.5].forEach((recvBatchSize) => {
+  assert.throws(() => {
+    dgram.createSocket({ type: 'udp4', recvBatchSize });
+  }, { code: /^ERR_(INVALID_ARG_TYPE|OUT_OF_RANGE)$/ });
+});
+
+const receiver = dgram.createSocket({ type: 'udp4', recvBatchSize: batchSize });
+const sender = dgram.createSocket('udp4');
+
+receiver.on('message', common.mustNotCall());
+
+const received = [];
+receiver.on('messages', common.mustCallAtLeast((buffer, offsets, rinfos) => {
+  assert.ok(Buffer.isBuffer(buffer));
+  assert.ok(offsets instanceof Uint32Array);
+  assert.ok(rinfos.length > 0);
+  assert.ok(rinfos.length <= batchSize);
+  assert.strictEqual(offsets.length, rinfos.length + 1);
+  assert.strictEqual(offsets[0], 0);
+  assert.strictEqual(offsets[rinfos.length], buffer.length);
+
+  for (let i = 0; i < rinfos.length; i++) {
+    assert.strictEqual(rinfos[i].address, common.localhostIPv4);
+    assert.strictEqual(rinfos[i].family, 'IPv4');
+    assert.strictEqual(rinfos[i].port, sender.address().port);
+    received.push(buffer.toString('latin1', offsets[i], offsets[i + 1]));
+  }
+
+  if (received.length === count) {
+    const expected = [];
+    for (let i = 0; i < count; i++)
+      expected.push(`message ${i}`.padEnd(i, '.'));
+    assert.deepStrictEqual(received, expected);
+    receiver.close();
+    sender.close();
+  }
+}));
+
+receiver.bind(0, common.mustCall(() => {
+  sender.bind(0, common.mustCall(() => {
+    const port = receiver.address().port;
+    for (let i = 0; i < count; i++) {
+      sender.send(`message ${i}`.padEnd(i, '.'), port, common.localhostIPv4);
+    }
+  }));
+}));
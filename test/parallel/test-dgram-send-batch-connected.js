@@ -0,0 +1,40 @@
+// Flags: --test-udp-no-try-send
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+// sendBatch() on a connected socket, with all datagrams going through the
+// asynchronous path.
+
+const server = dgram.createSocket('udp4');
+const client = dgram.createSocket('udp4');
+const count = 10;
+
+const received = [];
+server.on('message', common.mustCall((msg) => {
+  received.push(msg.toString());
+  if (received.length === count) {
+    assert.deepStrictEqual(received.sort(),
+                           Array.from({ length: count }, (_, i) => `${i}`));
+    server.close();
+    client.close();
+  }
+}, count));
+
+server.bind(0, common.mustCall(() => {
+  client.connect(server.address().port, common.mustCall(() => {
+    assert.throws(() => {
+      client.sendBatch([{ msg: 'x', port: server.address().port }]);
+    }, { code: 'ERR_SOCKET_DGRAM_IS_CONNECTED' });
+
+    const messages = [];
+    for (let i = 0; i < count; i++)
+      messages.push({ msg: `${i}` });
+    client.sendBatch(messages, common.mustCall((err, sent) => {
+      assert.ifError(err);
+      assert.strictEqual(sent, 10);
+    }));
+  }));
+}));
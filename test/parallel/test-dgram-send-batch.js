@@ -0,0 +1,76 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+// socket.sendBatch() sends every entry as its own datagram, to possibly
+// different destinations, and completes once.
+
+const receivers = [dgram.createSocket('udp4'), dgram.createSocket('udp4')];
+const sender = dgram.createSocket('udp4');
+const perReceiver = 20;
+
+assert.throws(() => sender.sendBatch('foo'), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => sender.sendBatch([], 'foo'), {
+  code: 'ERR_INVALID_CALLBACK'
+});
+assert.throws(() => sender.sendBatch([null]), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => sender.sendBatch([{ msg: 42, port: 1234 }]), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => sender.sendBatch([{ msg: 'foo', port: 0 }]), {
+  code: 'ERR_SOCKET_BAD_PORT'
+});
+
+let bound = 0;
+let done = 0;
+for (const receiver of receivers) {
+  const seen = [];
+  receiver.on('message', common.mustCall((msg) => {
+    seen.push(msg.toString());
+    if (seen.length === perReceiver) {
+      const expected = [];
+      for (let i = 0; i < perReceiver; i++)
+        expected.push(`${receiver.address().port}:${i}`);
+      assert.deepStrictEqual(seen.sort(), expected.sort());
+      receiver.close();
+      if (++done === receivers.length)
+        sender.close();
+    }
+  }, perReceiver));
+  receiver.bind(0, common.localhostIPv4, common.mustCall(() => {
+    if (++bound === receivers.length)
+      send();
+  }));
+}
+
+function send() {
+  const messages = [];
+  let bytes = 0;
+  for (let i = 0; i < perReceiver; i++) {
+    for (const receiver of receivers) {
+      const { port } = receiver.address();
+      const msg = `${port}:${i}`;
+      bytes += msg.length;
+      messages.push({
+        msg: i % 2 ? Buffer.from(msg) : msg,
+        port,
+        address: common.localhostIPv4
+      });
+    }
+  }
+
+  sender.sendBatch(messages, common.mustCall((err, sent) => {
+    assert.ifError(err);
+    assert.strictEqual(sent, bytes);
+  }));
+  sender.sendBatch([], common.mustCall((err, sent) => {
+    assert.ifError(err);
+    assert.strictEqual(sent, 0);
+  }));
+}
@@ -0,0 +1,124 @@
+// Flags: --expose-internals --experimental-fs-io-uring
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { internalBinding } = require('internal/test/binding');
+const { getIoUringStatistics } = internalBinding('fs');
+
+// With --experimental-fs-io-uring, fs requests are completed by io_uring
+// where it is available, and by the threadpool otherwise. Either way they
+// have to behave exactly as before.
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const filename = path.join(tmpdir.path, 'io-uring.txt');
+const missing = path.join(tmpdir.path, 'missing.txt');
+const data = Buffer.from('hello io_uring\n'.repeat(1000));
+
+function checkStatistics() {
+  const stats = getIoUringStatistics();
+  if (stats === undefined) {
+    // io_uring is not supported, or it is blocked by a seccomp filter. The
+    // requests above went to the threadpool.
+    common.printSkipMessage('io_uring is not available');
+    return;
+  }
+  assert.ok(stats.submitted > 0);
+  assert.ok(stats.submitCalls > 0);
+  assert.ok(stats.submitCalls <= stats.submitted);
+  assert.strictEqual(stats.completed, stats.submitted);
+  assert.strictEqual(stats.inFlight, 0);
+  assert.ok(stats.maxInFlight >= 10);
+}
+
+fs.open(filename, 'w+', common.mustCall((err, fd) => {
+  assert.ifError(err);
+  fs.write(fd, data, 0, data.length, 0, common.mustCall((err, written) => {
+    assert.ifError(err);
+    assert.strictEqual(written, data.length);
+    fs.fsync(fd, common.mustCall((err) => {
+      assert.ifError(err);
+      fs.fstat(fd, common.mustCall((err, stats) => {
+        assert.ifError(err);
+        assert.deepStrictEqual(stats, fs.fstatSync(fd));
+        assert.strictEqual(stats.size, data.length);
+        testReads(fd);
+      }));
+    }));
+  }));
+}));
+
+function testReads(fd) {
+  // Many concurrent reads at explicit positions.
+  const chunk = 1000;
+  let pending = Math.ceil(data.length / chunk);
+  for (let pos = 0; pos < data.length; pos += chunk) {
+    const buffer = Buffer.alloc(chunk);
+    fs.read(fd, buffer, 0, chunk, pos, common.mustCall((err, bytesRead) => {
+      assert.ifError(err);
+      assert.strictEqual(bytesRead, Math.min(chunk, data.length - pos));
+      assert.deepStrictEqual(buffer.slice(0, bytesRead),
+                             data.slice(pos, pos + bytesRead));
+      if (--pending === 0)
+        testAppend(fd);
+    }));
+  }
+}
+
+function testAppend(fd) {
+  // Writes without a position use the current file position.
+  fs.writev(fd, [Buffer.from('a'), Buffer.from('bc')], common.mustCall(
+    (err, written) => {
+      assert.ifError(err);
+      assert.strictEqual(written, 3);
+      fs.fdatasync(fd, common.mustCall((err) => {
+        assert.ifError(err);
+        fs.close(fd, common.mustCall((err) => {
+          assert.ifError(err);
+          assert.deepStrictEqual(fs.readFileSync(filename),
+                                 Buffer.concat([data, Buffer.from('abc')]));
+          testStat();
+        }));
+      }));
+    }));
+}
+
+function testStat() {
+  fs.stat(filename, { bigint: true }, common.mustCall((err, stats) => {
+    assert.ifError(err);
+    assert.deepStrictEqual(stats, fs.statSync(filename, { bigint: true }));
+    fs.lstat(tmpdir.path, common.mustCall((err, stats) => {
+      assert.ifError(err);
+      assert.ok(stats.isDirectory());
+      testErrors();
+    }));
+  }));
+}
+
+function testErrors() {
+  fs.stat(missing, common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ENOENT');
+    assert.strictEqual(err.syscall, 'stat');
+    assert.strictEqual(err.path, missing);
+    fs.open(missing, 'r', common.mustCall((err) => {
+      assert.strictEqual(err.code, 'ENOENT');
+      assert.strictEqual(err.syscall, 'open');
+      assert.strictEqual(err.path, missing);
+      testPromises().then(common.mustCall(checkStatistics));
+    }));
+  }));
+}
+
+async function testPromises() {
+  const handle = await fs.promises.open(filename, 'r');
+  const { size } = await handle.stat();
+  assert.strictEqual(size, data.length + 3);
+  const { bytesRead, buffer } = await handle.read(Buffer.alloc(5), 0, 5, 0);
+  assert.strictEqual(bytesRead, 5);
+  assert.strictEqual(buffer.toString(), 'hello');
+  await handle.close();
+  await assert.rejects(fs.promises.stat(missing), { code: 'ENOENT' });
+}
@@ -0,0 +1,74 @@
+'use strict';
+const common = require('../common');
+
+// Files of up to 512 KiB are opened, read and closed by fs.readFile() in a
+// single threadpool job. Larger files and files that are not regular files
+// are read in chunks after that. Check that both return the same data as
+// fs.readFileSync(), with and without an encoding.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const sizes = [0, 1, 4096, 512 * 1024, 512 * 1024 + 1, 3 * 1024 * 1024];
+
+for (const size of sizes) {
+  const filename = path.join(tmpdir.path, `readfile-${size}.bin`);
+  const data = Buffer.alloc(size);
+  for (let i = 0; i < size; i++)
+    data[i] = (i * 7) % 256;
+  fs.writeFileSync(filename, data);
+
+  fs.readFile(filename, common.mustCall((err, buf) => {
+    assert.ifError(err);
+    assert(Buffer.isBuffer(buf));
+    assert.deepStrictEqual(buf, data);
+  }));
+
+  for (const encoding of ['utf8', 'latin1', 'hex', 'base64', 'ucs2']) {
+    fs.readFile(filename, { encoding }, common.mustCall((err, str) => {
+      assert.ifError(err);
+      assert.strictEqual(str, data.toString(encoding));
+    }));
+  }
+}
+
+// Flags are passed on to open().
+{
+  const filename = path.join(tmpdir.path, 'readfile-created.txt');
+  fs.readFile(filename, { flag: 'a+' }, common.mustCall((err, buf) => {
+    assert.ifError(err);
+    assert.strictEqual(buf.length, 0);
+    assert(fs.existsSync(filename));
+  }));
+}
+
+// Errors from open() have the same shape as before.
+{
+  const filename = path.join(tmpdir.path, 'does-not-exist');
+  fs.readFile(filename, common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ENOENT');
+    assert.strictEqual(err.syscall, 'open');
+    assert.strictEqual(err.path, filename);
+  }));
+}
+
+// Directories are not regular files, so they are read from JS, which fails
+// with the error from read().
+if (!common.isWindows && !common.isAIX && !common.isFreeBSD) {
+  fs.readFile(tmpdir.path, common.mustCall((err) => {
+    assert.strictEqual(err.code, 'EISDIR');
+    assert.strictEqual(err.syscall, 'read');
+  }));
+}
+
+// Regular files that claim to be empty are read until EOF.
+if (common.isLinux) {
+  fs.readFile('/proc/self/status', 'utf8', common.mustCall((err, str) => {
+    assert.ifError(err);
+    assert(str.includes('Pid:'));
+  }));
+}
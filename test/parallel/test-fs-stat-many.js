@@ -0,0 +1,83 @@
+'use strict';
+const common = require('../common');
+
+// fs.statMany() looks up a list of paths at once, and reports errors for
+// each path instead of failing as a whole.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { pathToFileURL } = require('url');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'stat-many.txt');
+const missing = path.join(tmpdir.path, 'missing.txt');
+fs.writeFileSync(file, 'hello');
+
+const paths = [
+  file, tmpdir.path, missing, Buffer.from(file), pathToFileURL(file)
+];
+
+function checkResults(results, bigint) {
+  assert.ok(Array.isArray(results));
+  assert.strictEqual(results.length, paths.length);
+
+  const fileStats = fs.statSync(file, { bigint });
+  assert.deepStrictEqual(results[0], fileStats);
+  assert.deepStrictEqual(results[1], fs.statSync(tmpdir.path, { bigint }));
+  assert.deepStrictEqual(results[3], fileStats);
+  assert.deepStrictEqual(results[4], fileStats);
+  assert.ok(results[1].isDirectory());
+  assert.strictEqual(typeof results[0].size, bigint ? 'bigint' : 'number');
+
+  const err = results[2];
+  assert.ok(err instanceof Error);
+  assert.strictEqual(err.code, 'ENOENT');
+  assert.strictEqual(err.syscall, 'stat');
+  assert.strictEqual(err.path, missing);
+}
+
+checkResults(fs.statManySync(paths), false);
+checkResults(fs.statManySync(paths, { bigint: true }), true);
+assert.deepStrictEqual(fs.statManySync([]), []);
+
+fs.statMany(paths, common.mustCall((err, results) => {
+  assert.ifError(err);
+  checkResults(results, false);
+}));
+
+fs.statMany(paths, { bigint: true }, common.mustCall((err, results) => {
+  assert.ifError(err);
+  checkResults(results, true);
+}));
+
+fs.statMany([], common.mustCall((err, results) => {
+  assert.ifError(err);
+  assert.deepStrictEqual(results, []);
+}));
+
+(async () => {
+  checkResults(await fs.promises.statMany(paths), false);
+  checkResults(await fs.promises.statMany(paths, { bigint: true }), true);
+})().then(common.mustCall());
+
+for (const invalid of [file, 1, null, undefined, {}]) {
+  assert.throws(() => fs.statManySync(invalid), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    message: /The "paths" argument must be of type Array/
+  });
+  assert.throws(() => fs.statMany(invalid, common.mustNotCall()), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+}
+
+assert.throws(() => fs.statManySync([file, 1]), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  message: /The "paths\[1\]" argument must be/
+});
+
+assert.throws(() => fs.statMany(paths), {
+  code: 'ERR_INVALID_CALLBACK'
+});
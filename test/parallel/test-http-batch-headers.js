@@ -0,0 +1,133 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+// With batchHeaders, headers are passed from the parser in one go and only
+// turned into strings on access. The result has to be the same as without it,
+// also for more headers than the parser used to pass at once.
+
+assert.throws(() => http.createServer({ batchHeaders: 'yes' }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+const lines = [
+  'Host: example.com',
+  'Content-Type: text/plain',
+  'Set-Cookie: a=1',
+  'Set-Cookie: b=2',
+  'Accept: text/html',
+  'Accept: text/plain',
+  'X-Empty:',
+  'Transfer-Encoding: chunked',
+];
+for (let i = 0; i < 100; i++)
+  lines.push(`X-Header-${i}: value ${i}`);
+
+const request = 'POST / HTTP/1.1\r\n' +
+                `${lines.join('\r\n')}\r\n\r\n` +
+                '5\r\nhello\r\n0\r\n' +
+                'X-Trailer: done\r\n\r\n';
+
+function getRequest(options, callback) {
+  const server = http.createServer(options, common.mustCall((req, res) => {
+    let body = '';
+    req.setEncoding('utf8');
+    req.on('data', (chunk) => body += chunk);
+    req.on('end', common.mustCall(() => {
+      assert.strictEqual(body, 'hello');
+      res.end();
+      server.close();
+      callback(req);
+    }));
+  }));
+  server.listen(0, common.mustCall(() => {
+    const socket = net.connect(server.address().port, () => {
+      // Split the request in the middle of a header.
+      const split = request.indexOf('X-Header-50') + 4;
+      socket.write(request.slice(0, split));
+      setTimeout(() => socket.end(request.slice(split)), 10);
+    });
+    socket.resume();
+  }));
+}
+
+// By default, headers and rawHeaders are plain data properties.
+for (const name of ['headers', 'rawHeaders']) {
+  assert.strictEqual(
+    Object.getOwnPropertyDescriptor(http.IncomingMessage.prototype, name),
+    undefined);
+}
+
+function assertDataProperties(req) {
+  for (const name of ['headers', 'rawHeaders']) {
+    const descriptor = Object.getOwnPropertyDescriptor(req, name);
+    assert.strictEqual(descriptor.writable, true);
+    assert.strictEqual(descriptor.enumerable, true);
+  }
+}
+
+getRequest({}, common.mustCall((expected) => {
+  assertDataProperties(expected);
+  assert.strictEqual(expected.headers['x-header-99'], 'value 99');
+  assert.deepStrictEqual(expected.headers['set-cookie'], ['a=1', 'b=2']);
+  assert.strictEqual(expected.headers.accept, 'text/html, text/plain');
+  assert.strictEqual(expected.headers['x-empty'], '');
+
+  getRequest({ batchHeaders: true }, common.mustCall((req) => {
+    // Headers are first accessed after the message is complete.
+    assert.deepStrictEqual(req.rawHeaders, expected.rawHeaders);
+    assert.deepStrictEqual(req.headers, expected.headers);
+    assert.deepStrictEqual(req.rawTrailers, ['X-Trailer', 'done']);
+    assert.deepStrictEqual(req.trailers, { 'x-trailer': 'done' });
+    assertDataProperties(req);
+
+    req.headers = { replaced: 'yes' };
+    assert.deepStrictEqual(req.headers, { replaced: 'yes' });
+    assert.deepStrictEqual(req.rawHeaders, expected.rawHeaders);
+  }));
+
+  // The headers limit applies as before.
+  const server = http.createServer({
+    batchHeaders: true
+  }, common.mustCall((req, res) => {
+    assert.deepStrictEqual(Object.keys(req.headers), ['host', 'content-type']);
+    assert.strictEqual(req.rawHeaders.length, lines.length * 2);
+    res.end();
+    server.close();
+  }));
+  server.maxHeadersCount = 2;
+  server.listen(0, common.mustCall(() => {
+    net.connect(server.address().port, function() {
+      this.end(request);
+      this.resume();
+    });
+  }));
+}));
+
+// The server only turns the header block into `headers` itself if the
+// request has an Expect header.
+{
+  const server = http.createServer({ batchHeaders: true });
+  server.on('request', common.mustCall((req, res) => {
+    assert.strictEqual(
+      typeof Object.getOwnPropertyDescriptor(req, 'headers').get, 'function');
+    res.end();
+  }));
+  server.on('checkContinue', common.mustCall((req, res) => {
+    assert.strictEqual(req.headers.expect, '100-continue');
+    res.writeContinue();
+    res.end();
+    server.close();
+  }));
+  server.listen(0, common.mustCall(() => {
+    const socket = net.connect(server.address().port, () => {
+      socket.end('GET / HTTP/1.1\r\nHost: example.com\r\n' +
+                 'X-Expected: no\r\n\r\n' +
+                 'POST / HTTP/1.1\r\nHost: example.com\r\n' +
+                 'EXPECT: 100-continue\r\nContent-Length: 0\r\n\r\n');
+    });
+    socket.resume();
+  }));
+}
@@ -0,0 +1,60 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+// Well-known header names are shared strings in the parser when they are
+// spelled in the usual way or in lowercase. Any spelling has to be kept as is
+// in rawHeaders and lowercased in headers, including names that are flushed
+// to JS before the headers are complete. The same goes for headers that are
+// passed in batch mode.
+
+const names = [
+  'Content-Type', 'content-type', 'CONTENT-TYPE', 'Content-type',
+  'User-Agent', 'user-agent', 'X-Forwarded-For', 'x-forwarded-for',
+  'TE', 'te', 'Te', 'X-Unknown-Header', 'Sec-Fetch-Mode',
+];
+const lines = [];
+for (let i = 0; i < 3; i++) {
+  for (const name of names)
+    lines.push([name, `${name} ${i}`]);
+}
+
+function valuesOf(lowercase) {
+  return lines.filter(([name]) => name.toLowerCase() === lowercase)
+              .map(([, value]) => value);
+}
+
+function test(options) {
+  const server = http.createServer(options, common.mustCall((req, res) => {
+    const raw = ['Host', 'example.com'];
+    for (const [name, value] of lines)
+      raw.push(name, value);
+    raw.push('Connection', 'close');
+    assert.deepStrictEqual(req.rawHeaders, raw);
+
+    // Duplicates of these are dropped.
+    assert.strictEqual(req.headers['content-type'], 'Content-Type 0');
+    assert.strictEqual(req.headers['user-agent'], 'User-Agent 0');
+    // Duplicates of these are joined.
+    for (const name of ['x-forwarded-for', 'te', 'x-unknown-header'])
+      assert.strictEqual(req.headers[name], valuesOf(name).join(', '));
+    res.end();
+    server.close();
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const socket = net.connect(server.address().port, () => {
+      socket.end('GET / HTTP/1.1\r\nHost: example.com\r\n' +
+                 lines.map(([name, value]) => `${name}: ${value}\r\n`)
+                      .join('') +
+                 'Connection: close\r\n\r\n');
+    });
+    socket.resume();
+  }));
+}
+
+// Header blocks passed in batch mode use the same strings for these names.
+test({});
+test({ batchHeaders: true });
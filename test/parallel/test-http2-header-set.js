@@ -0,0 +1,96 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const http2 = require('http2');
+
+// A header set is converted once and sent after the headers passed to
+// respond() and request(). The peer has to see the same headers as if they
+// had been passed along with the others.
+
+const responseSet = http2.createHeaderSet({
+  'Content-Type': 'text/plain',
+  'x-frame-options': 'DENY',
+  'set-cookie': ['a=1', 'b=2'],
+  'x-empty': [],
+  'x-undefined': undefined
+});
+assert.deepStrictEqual(responseSet.headers, {
+  '__proto__': null,
+  'content-type': 'text/plain',
+  'x-frame-options': 'DENY',
+  'set-cookie': ['a=1', 'b=2']
+});
+assert(Object.isFrozen(responseSet));
+assert(Object.isFrozen(responseSet.headers));
+assert(Object.isFrozen(responseSet.headers['set-cookie']));
+
+const requestSet = http2.createHeaderSet({ 'user-agent': 'test', 'x-n': 1 });
+assert.strictEqual(requestSet.headers['x-n'], '1');
+
+assert.throws(() => http2.createHeaderSet({ ':status': 200 }), {
+  code: 'ERR_HTTP2_INVALID_PSEUDOHEADER'
+});
+assert.throws(() => http2.createHeaderSet({ connection: 'close' }), {
+  code: 'ERR_HTTP2_INVALID_CONNECTION_HEADERS'
+});
+assert.throws(() => http2.createHeaderSet({ 'content-type': ['a', 'b'] }), {
+  code: 'ERR_HTTP2_HEADER_SINGLE_VALUE'
+});
+assert.throws(() => http2.createHeaderSet('foo'), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+const server = http2.createServer();
+
+server.on('stream', common.mustCall((stream, headers) => {
+  assert.strictEqual(headers['user-agent'], 'test');
+  assert.strictEqual(headers['x-n'], '1');
+  assert.strictEqual(headers['x-request'], 'yes');
+
+  for (const headerSet of [{}, responseSet.headers]) {
+    assert.throws(() => stream.respond({}, { headerSet }), {
+      code: 'ERR_INVALID_OPT_VALUE'
+    });
+  }
+  // Single value headers may not be in both.
+  assert.throws(() => {
+    stream.respond({ 'content-type': 'text/html' }, { headerSet: responseSet });
+  }, { code: 'ERR_HTTP2_HEADER_SINGLE_VALUE' });
+
+  stream.respond({ 'x-response': 'yes', 'set-cookie': 'c=3' },
+                 { headerSet: responseSet });
+  assert.strictEqual(stream.sentHeaders[':status'], 200);
+  assert.strictEqual(stream.sentHeaders['x-response'], 'yes');
+  assert.strictEqual(stream.sentHeaders['content-type'], 'text/plain');
+  stream.end('ok');
+}, 2));
+
+server.listen(0, common.mustCall(() => {
+  const client = http2.connect(`http://localhost:${server.address().port}`);
+
+  function request(callback) {
+    const req = client.request({ 'x-request': 'yes' },
+                               { headerSet: requestSet });
+    assert.strictEqual(req.sentHeaders[':path'], '/');
+    assert.strictEqual(req.sentHeaders['user-agent'], 'test');
+    req.on('response', common.mustCall((headers) => {
+      assert.strictEqual(headers[':status'], 200);
+      assert.strictEqual(headers['x-response'], 'yes');
+      assert.strictEqual(headers['content-type'], 'text/plain');
+      assert.strictEqual(headers['x-frame-options'], 'DENY');
+      assert.deepStrictEqual(headers['set-cookie'], ['c=3', 'a=1', 'b=2']);
+      assert.strictEqual(headers['x-empty'], undefined);
+    }));
+    req.resume();
+    req.on('end', common.mustCall(callback));
+  }
+
+  // The same sets are used for more than one stream.
+  request(() => request(() => {
+    client.close();
+    server.close();
+  }));
+}));
@@ -0,0 +1,76 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const http2 = require('http2');
+const makeDuplexPair = require('../common/duplexpair');
+const { PerformanceObserver } = require('perf_hooks');
+
+// Many concurrent uploads that are echoed back make the server session stop
+// processing input while its writes are in progress. Input that arrives in
+// the meantime is queued and has to be processed in order.
+//
+// The server's transport finishes writes late and keeps delivering data
+// after it has been asked to stop reading, so that input is queued for sure.
+
+const kStreams = 20;
+const kLength = 256 * 1024;
+
+const entries = {};
+const obs = new PerformanceObserver((items) => {
+  for (const entry of items.getEntries()) {
+    if (entry.name === 'Http2Session')
+      entries[entry.type] = entry;
+  }
+});
+obs.observe({ entryTypes: ['http2'] });
+
+function body(index) {
+  const data = Buffer.alloc(kLength);
+  for (let i = 0; i < kLength; i += 4)
+    data.writeUInt32LE((i * 2654435761 + index) >>> 0, i);
+  return data;
+}
+
+const server = http2.createServer();
+server.on('stream', common.mustCall((stream) => {
+  stream.respond();
+  stream.pipe(stream);
+}, kStreams));
+
+const { clientSide, serverSide } = makeDuplexPair();
+serverSide.pause = function() {
+  return this;
+};
+const write = serverSide._write;
+serverSide._write = function(chunk, encoding, callback) {
+  write.call(this, chunk, encoding, () => setTimeout(callback, 1));
+};
+server.emit('connection', serverSide);
+
+const client = http2.connect('http://localhost:80', {
+  createConnection: common.mustCall(() => clientSide)
+});
+let remaining = kStreams;
+for (let i = 0; i < kStreams; i++) {
+  const expected = body(i);
+  const req = client.request({ ':method': 'POST' });
+  const chunks = [];
+  req.on('data', (chunk) => chunks.push(chunk));
+  req.on('end', common.mustCall(() => {
+    assert(Buffer.concat(chunks).equals(expected));
+    if (--remaining === 0)
+      client.close();
+  }));
+  req.end(expected);
+}
+
+process.on('exit', () => {
+  const serverEntry = entries.server;
+  const clientEntry = entries.client;
+  assert(serverEntry.bytesQueued > 0, `${serverEntry.bytesQueued}`);
+  assert(serverEntry.bytesQueued <= serverEntry.bytesRead);
+  assert(clientEntry.bytesQueued <= clientEntry.bytesRead);
+});
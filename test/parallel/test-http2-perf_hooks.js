@@ -23,6 +23,7 @@ const obs = new PerformanceObserver(common.mustCall((items) => {
       assert.strictEqual(typeof entry.bytesWritten, 'number');
       assert.strictEqual(typeof entry.bytesRead, 'number');
       assert.strictEqual(typeof entry.maxConcurrentStreams, 'number');
+      assert(entry.bytesQueued >= 0 && entry.bytesQueued <= entry.bytesRead);
       switch (entry.type) {
         case 'server':
           assert.strictEqual(entry.streamCount, 1);
@@ -0,0 +1,101 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const fs = require('fs');
+const http2 = require('http2');
+const path = require('path');
+
+// Files are read ahead of the DATA frames that are being sent. The client has
+// to receive the same data as before, including for ranges that go past the
+// end of the file, and the stream has to be reset if the file becomes shorter
+// than the range that was announced.
+
+const {
+  HTTP2_HEADER_CONTENT_LENGTH,
+  NGHTTP2_INTERNAL_ERROR
+} = http2.constants;
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'data.bin');
+const truncated = path.join(tmpdir.path, 'truncated.bin');
+const data = Buffer.alloc(1024 * 1024);
+for (let i = 0; i < data.length; i++)
+  data[i] = i % 251;
+fs.writeFileSync(file, data);
+fs.writeFileSync(truncated, data);
+
+const ranges = [
+  [undefined, undefined, data],
+  [1000, 5000, data.slice(1000, 6000)],
+  [data.length - 10, 100, data.slice(-10)],
+];
+
+const server = http2.createServer();
+server.on('stream', (stream, headers) => {
+  if (headers['x-truncate'] === '1') {
+    stream.respondWithFile(truncated, {}, {
+      statCheck: common.mustCall(() => {
+        fs.truncateSync(truncated, 100 * 1024);
+      })
+    });
+    return;
+  }
+
+  const [offset, length] = ranges[headers['x-range'] | 0];
+  switch (headers['x-mode']) {
+    case 'fd':
+    case 'fd-stat': {
+      const fd = fs.openSync(file, 'r');
+      stream.on('close', () => fs.closeSync(fd));
+      const statCheck = headers['x-mode'] === 'fd-stat' ?
+        common.mustCall() : undefined;
+      stream.respondWithFD(fd, {}, { offset, length, statCheck });
+      break;
+    }
+    default:
+      stream.respondWithFile(file, {}, { offset, length });
+  }
+});
+
+server.listen(0, common.mustCall(() => {
+  const client = http2.connect(`http://localhost:${server.address().port}`);
+  let pending = ranges.length * 3 + 1;
+  function done() {
+    if (--pending === 0) {
+      client.close();
+      server.close();
+    }
+  }
+
+  for (let i = 0; i < ranges.length; i++) {
+    for (const mode of ['file', 'fd', 'fd-stat']) {
+      const req = client.request({ 'x-range': `${i}`, 'x-mode': mode });
+      const chunks = [];
+      req.on('data', (chunk) => chunks.push(chunk));
+      req.on('end', common.mustCall(() => {
+        assert.deepStrictEqual(Buffer.concat(chunks), ranges[i][2]);
+        done();
+      }));
+    }
+  }
+
+  const req = client.request({ 'x-truncate': '1' });
+  req.on('response', common.mustCall((headers) => {
+    assert.strictEqual(+headers[HTTP2_HEADER_CONTENT_LENGTH], data.length);
+  }));
+  req.on('error', common.expectsError({
+    code: 'ERR_HTTP2_STREAM_ERROR',
+    type: Error,
+    message: 'Stream closed with error code NGHTTP2_INTERNAL_ERROR'
+  }));
+  req.resume();
+  req.on('close', common.mustCall(() => {
+    assert.strictEqual(req.rstCode, NGHTTP2_INTERNAL_ERROR);
+    done();
+  }));
+}));
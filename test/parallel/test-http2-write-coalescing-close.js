@@ -0,0 +1,41 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const http2 = require('http2');
+
+// Writes that are still held back for coalescing when the socket closes are
+// canceled. Their callbacks must not be lost, and must not be called from
+// within the teardown of the session.
+
+const server = http2.createServer({
+  writeCoalesceSize: 1 << 30,
+  writeCoalesceDelay: 10 * 1000 * 1000
+});
+let socket;
+server.on('connection', common.mustCall((connection) => {
+  socket = connection;
+}));
+server.on('stream', common.mustCall((stream) => {
+  const { session } = stream;
+  let closed = false;
+  session.on('close', common.mustCall(() => {
+    closed = true;
+  }));
+  stream.respond();
+  stream.write('x', common.mustCall(() => {
+    assert(closed);
+    server.close();
+  }));
+  setTimeout(() => socket.destroy(), common.platformTimeout(100));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = http2.connect(`http://localhost:${server.address().port}`);
+  client.on('error', () => {});
+  const req = client.request();
+  req.on('error', () => {});
+  req.on('close', common.mustCall(() => client.destroy()));
+}));
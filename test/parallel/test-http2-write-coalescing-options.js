@@ -0,0 +1,26 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const http2 = require('http2');
+
+// The write coalescing options must fit into a uint32.
+
+for (const name of ['writeCoalesceSize', 'writeCoalesceDelay']) {
+  for (const value of [-1, 1.5, 2 ** 32, NaN]) {
+    const options = { [name]: value };
+    const error = { code: 'ERR_OUT_OF_RANGE' };
+    assert.throws(() => http2.createServer(options), error);
+    assert.throws(() => http2.createSecureServer(options), error);
+    assert.throws(() => http2.connect('http://localhost:1', options), error);
+  }
+  for (const value of ['1', null, {}]) {
+    const options = { [name]: value };
+    const error = { code: 'ERR_INVALID_ARG_TYPE' };
+    assert.throws(() => http2.createServer(options), error);
+    assert.throws(() => http2.connect('http://localhost:1', options), error);
+  }
+  http2.createServer({ [name]: 0 });
+  http2.createServer({ [name]: 2 ** 32 - 1 });
+}
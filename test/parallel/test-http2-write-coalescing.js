@@ -0,0 +1,73 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const http2 = require('http2');
+const { PerformanceObserver } = require('perf_hooks');
+
+// With writeCoalesceSize, frames are held back until enough data is pending
+// or the event loop iteration ends. All streams still have to complete with
+// the right data, including with a zero delay and writes larger than the
+// amount of data that is copied.
+
+const small = Buffer.from('x'.repeat(100));
+const large = Buffer.alloc(64 * 1024, 'y');
+const kStreams = 50;
+
+const framesPerWrite = [];
+const obs = new PerformanceObserver((items) => {
+  for (const entry of items.getEntries()) {
+    if (entry.name === 'Http2Session')
+      framesPerWrite.push(entry.framesPerWrite);
+  }
+});
+obs.observe({ entryTypes: ['http2'] });
+
+const tests = [
+  { writeCoalesceSize: 16384 },
+  { writeCoalesceSize: 16384, writeCoalesceDelay: 0 },
+  { writeCoalesceSize: 1 << 30 },
+];
+
+function runTest(options) {
+  const server = http2.createServer(options);
+  server.on('stream', common.mustCall((stream, headers) => {
+    stream.respond();
+    const body = headers[':path'] === '/large' ? large : small;
+    stream.write(body.slice(0, 10));
+    stream.end(body.slice(10));
+  }, kStreams));
+
+  server.listen(0, common.mustCall(() => {
+    const client = http2.connect(`http://localhost:${server.address().port}`,
+                                 options);
+    let remaining = kStreams;
+    for (let i = 0; i < kStreams; i++) {
+      const path = i % 10 === 0 ? '/large' : '/small';
+      const req = client.request({ ':path': path });
+      const chunks = [];
+      req.on('data', (chunk) => chunks.push(chunk));
+      req.on('end', common.mustCall(() => {
+        assert.deepStrictEqual(Buffer.concat(chunks),
+                               path === '/large' ? large : small);
+        if (--remaining > 0)
+          return;
+        client.close();
+        server.close(common.mustCall(() => {
+          if (tests.length > 0)
+            runTest(tests.shift());
+        }));
+      }));
+    }
+  }));
+}
+
+runTest(tests.shift());
+
+process.on('exit', () => {
+  assert.strictEqual(framesPerWrite.length, 6);
+  for (const value of framesPerWrite)
+    assert(value >= 1, `${value}`);
+});
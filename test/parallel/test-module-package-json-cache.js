@@ -0,0 +1,68 @@
+'use strict';
+const common = require('../common');
+
+// package.json files are parsed natively, once per process, and the results
+// are shared with Worker threads. Check that the fields are read like
+// JSON.parse() would, and that a changed file is read again.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { Worker } = require('worker_threads');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+function writePackage(name, json, files) {
+  const dir = path.join(tmpdir.path, 'node_modules', name);
+  fs.mkdirSync(dir, { recursive: true });
+  fs.writeFileSync(path.join(dir, 'package.json'), json);
+  for (const [file, source] of Object.entries(files))
+    fs.writeFileSync(path.join(dir, file), source);
+  return dir;
+}
+
+const entry = path.join(tmpdir.path, 'entry.js');
+fs.writeFileSync(entry, 'module.exports = (id) => require(id);');
+const load = require(entry);
+
+// Escape sequences, a byte order mark and duplicate keys.
+const escapes = writePackage(
+  'escapes', '\ufeff{ "main": 1, "ma\\u0069n": "lib\\/m\\u00e4in.js" }', {});
+fs.mkdirSync(path.join(escapes, 'lib'));
+fs.writeFileSync(path.join(escapes, 'lib', 'm\u00e4in.js'),
+                 'module.exports = "escapes";');
+assert.strictEqual(load('escapes'), 'escapes');
+
+// Fields other than strings, and unrelated content of any shape.
+writePackage('nested', JSON.stringify({
+  description: 'x'.repeat(100000),
+  main: './main.js',
+  config: { deep: [[[{ a: [1, -2.5e3, true, null] }]]] }
+}, null, 2), { 'main.js': 'module.exports = "nested";' });
+assert.strictEqual(load('nested'), 'nested');
+
+// Invalid JSON is reported like before.
+const invalid = writePackage('invalid', '{ "main": "index.js", }', {});
+assert.throws(() => load('invalid'), {
+  name: 'SyntaxError',
+  path: path.join(invalid, 'package.json'),
+  message: /^Error parsing .*package\.json: Unexpected token }/
+});
+
+// Changes to a package.json are seen by threads that read it later.
+const changing = writePackage('changing', '{ "main": "a.js" }', {
+  'a.js': 'module.exports = "a";',
+  'bb.js': 'module.exports = "bb";'
+});
+assert.strictEqual(load('changing'), 'a');
+fs.writeFileSync(path.join(changing, 'package.json'), '{ "main": "bb.js" }');
+
+const worker = new Worker(`
+  const { parentPort, workerData } = require('worker_threads');
+  const load = require(workerData.entry);
+  parentPort.postMessage([load('escapes'), load('nested'), load('changing')]);
+`, { eval: true, workerData: { entry } });
+worker.on('message', common.mustCall((results) => {
+  assert.deepStrictEqual(results, ['escapes', 'nested', 'bb']);
+}));
@@ -0,0 +1,214 @@
+'use strict';
+
+// Tests --experimental-resolution-cache: results of module resolution are
+// written on the first run, used on later runs, and ignored once a directory
+// or package.json file they depend on has changed. Results that depend on
+// paths modified within the last few seconds are not written, so the test
+// moves the modification times of the paths it changes into the past.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const { pathToFileURL } = require('url');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const cacheFile = path.join(tmpdir.path, 'resolution-cache.json');
+const app = path.join(tmpdir.path, 'app');
+const outerPkg = path.join(tmpdir.path, 'node_modules', 'pkg');
+const innerPkg = path.join(app, 'node_modules', 'pkg');
+const main = path.join(app, 'main.js');
+
+fs.mkdirSync(path.join(app, 'lib'), { recursive: true });
+fs.mkdirSync(outerPkg, { recursive: true });
+// The cache is saved even if all 'exit' listeners are removed.
+fs.writeFileSync(main, `
+process.removeAllListeners('exit');
+const results = [require.resolve('pkg'), require.resolve('./lib/util')];
+import('./esm.mjs').then(({ default: url }) => {
+  results.push(url);
+  console.log(JSON.stringify(results));
+});
+`);
+fs.writeFileSync(path.join(app, 'lib', 'util.js'), '');
+fs.writeFileSync(path.join(app, 'esm.mjs'), `
+import 'pkg';
+export default import.meta.url;
+`);
+fs.writeFileSync(path.join(outerPkg, 'index.js'), '');
+
+let age = 600;
+function backdate(...paths) {
+  // Every call uses a later time than the previous one.
+  const time = Date.now() / 1000 - age--;
+  for (const p of paths)
+    fs.utimesSync(p, time, time);
+}
+
+backdate(tmpdir.path, app, path.join(app, 'lib'), main,
+         path.join(app, 'lib', 'util.js'), path.join(app, 'esm.mjs'),
+         path.join(tmpdir.path, 'node_modules'), outerPkg,
+         path.join(outerPkg, 'index.js'));
+
+function run(args = [], entry = main, file = cacheFile) {
+  const child = spawnSync(process.execPath, [
+    '--experimental-modules',
+    '--no-warnings',
+    `--experimental-resolution-cache=${file}`,
+    '--trace-resolution-cache',
+    ...args,
+    entry,
+  ]);
+  const stderr = child.stderr.toString();
+  assert.strictEqual(child.status, 0, stderr);
+  const match = new RegExp('^Resolution cache (.+): (\\d+) hits, (\\d+) ' +
+                           'misses, (\\d+) stale \\([\\d.]+% hit rate\\)$',
+                           'm').exec(stderr);
+  assert.ok(match, stderr);
+  assert.strictEqual(match[1], file);
+  return {
+    resolved: JSON.parse(child.stdout),
+    hits: +match[2],
+    misses: +match[3],
+    stale: +match[4],
+  };
+}
+
+const expected = [
+  path.join(outerPkg, 'index.js'),
+  path.join(app, 'lib', 'util.js'),
+  pathToFileURL(path.join(app, 'esm.mjs')).href,
+];
+
+// Nothing is cached on the first run.
+let result = run();
+assert.strictEqual(result.hits, 0);
+assert.ok(result.misses > 0);
+assert.strictEqual(result.stale, 0);
+assert.deepStrictEqual(result.resolved, expected);
+assert.ok(fs.existsSync(cacheFile));
+const data = JSON.parse(fs.readFileSync(cacheFile, 'utf8'));
+assert.strictEqual(data.version, 1);
+const firstMtime = fs.statSync(cacheFile).mtimeMs;
+
+// Everything comes from the cache on the second run, and the file is not
+// written again.
+result = run();
+assert.ok(result.hits > 0);
+assert.strictEqual(result.misses, 0);
+assert.strictEqual(result.stale, 0);
+assert.deepStrictEqual(result.resolved, expected);
+assert.strictEqual(fs.statSync(cacheFile).mtimeMs, firstMtime);
+
+// A package that is installed closer to the application takes precedence
+// over the cached result.
+fs.mkdirSync(innerPkg, { recursive: true });
+fs.writeFileSync(path.join(innerPkg, 'index.js'), '');
+fs.writeFileSync(path.join(innerPkg, 'other.js'), '');
+fs.writeFileSync(path.join(innerPkg, 'package.json'), '{}');
+backdate(app, path.join(app, 'node_modules'), innerPkg,
+         path.join(innerPkg, 'index.js'), path.join(innerPkg, 'other.js'),
+         path.join(innerPkg, 'package.json'));
+result = run();
+assert.ok(result.stale > 0);
+assert.strictEqual(result.resolved[0], path.join(innerPkg, 'index.js'));
+result = run();
+assert.strictEqual(result.misses, 0);
+assert.strictEqual(result.stale, 0);
+assert.strictEqual(result.resolved[0], path.join(innerPkg, 'index.js'));
+
+// So does a change to the "main" field of the package. Overwriting the file
+// does not modify any of the directories that were searched.
+fs.writeFileSync(path.join(innerPkg, 'package.json'),
+                 JSON.stringify({ main: 'other.js' }));
+backdate(path.join(innerPkg, 'package.json'));
+result = run();
+assert.ok(result.stale > 0);
+assert.strictEqual(result.resolved[0], path.join(innerPkg, 'other.js'));
+
+// A cache file that cannot be parsed is treated as empty and replaced.
+fs.writeFileSync(cacheFile, '{');
+result = run();
+assert.strictEqual(result.hits, 0);
+assert.ok(result.misses > 0);
+assert.strictEqual(result.resolved[0], path.join(innerPkg, 'other.js'));
+result = run();
+assert.strictEqual(result.misses, 0);
+
+// Results written with options that affect resolution are not used with
+// other options.
+result = run(['--preserve-symlinks']);
+assert.strictEqual(result.hits, 0);
+assert.ok(result.misses > 0);
+
+// Replacing a symbolic link that a relative import goes through changes the
+// directory that it is in.
+if (common.canCreateSymLink()) {
+  const esmMain = path.join(app, 'main.mjs');
+  const link = path.join(app, 'dep.mjs');
+  fs.writeFileSync(esmMain, `
+import url from './dep.mjs';
+console.log(JSON.stringify([url]));
+`);
+  fs.mkdirSync(path.join(tmpdir.path, 'targets'));
+  const first = path.join(tmpdir.path, 'targets', 'first.mjs');
+  const second = path.join(tmpdir.path, 'targets', 'second.mjs');
+  fs.writeFileSync(first, 'export default import.meta.url;\n');
+  fs.writeFileSync(second, 'export default import.meta.url;\n');
+  fs.symlinkSync(first, link);
+  backdate(app, esmMain, path.join(tmpdir.path, 'targets'), first, second);
+
+  result = run([], esmMain);
+  assert.deepStrictEqual(result.resolved, [pathToFileURL(first).href]);
+  result = run([], esmMain);
+  assert.strictEqual(result.misses, 0);
+  assert.deepStrictEqual(result.resolved, [pathToFileURL(first).href]);
+  fs.unlinkSync(link);
+  fs.symlinkSync(second, link);
+  backdate(app);
+  result = run([], esmMain);
+  assert.ok(result.stale > 0);
+  assert.deepStrictEqual(result.resolved, [pathToFileURL(second).href]);
+}
+
+// Results that depend on a directory that was modified just now are not
+// written, as the directory could be modified again without its modification
+// time changing. A time in the future is always that close.
+const lib = path.join(app, 'lib');
+fs.writeFileSync(path.join(lib, 'extra.js'), '');
+const future = Date.now() / 1000 + 600;
+fs.utimesSync(lib, future, future);
+result = run();
+assert.ok(result.stale > 0);
+result = run();
+assert.ok(result.misses > 0);
+backdate(lib);
+result = run();
+result = run();
+assert.strictEqual(result.misses, 0);
+assert.strictEqual(result.stale, 0);
+
+// A cache file in a directory that lookups search does not make the results
+// that depend on that directory stale when it is written.
+{
+  const appCache = path.join(app, '.resolution-cache.json');
+  result = run([], main, appCache);
+  assert.ok(result.misses > 0);
+  const mtime = fs.statSync(appCache).mtimeMs;
+  result = run([], main, appCache);
+  assert.ok(result.hits > 0);
+  assert.strictEqual(result.misses, 0);
+  assert.strictEqual(result.stale, 0);
+  assert.strictEqual(fs.statSync(appCache).mtimeMs, mtime);
+
+  // Other changes to the directory still do.
+  fs.writeFileSync(path.join(app, 'new.js'), '');
+  result = run([], main, appCache);
+  assert.ok(result.stale > 0);
+  result = run([], main, appCache);
+  assert.strictEqual(result.misses, 0);
+  assert.strictEqual(result.stale, 0);
+}
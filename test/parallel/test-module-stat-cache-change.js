@@ -0,0 +1,48 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+
+if (!common.isLinux)
+  common.skip('the order and kinds of fs.watch() events differ elsewhere');
+
+// Writing to a file that the module stat cache knows about does not drop any
+// cached entries. Creating a file does.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { ModuleStatCache } = require('internal/modules/cjs/stat_cache');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'file.js');
+const created = path.join(tmpdir.path, 'created.js');
+fs.writeFileSync(file, '');
+
+const cache = new ModuleStatCache(new Map());
+assert.strictEqual(cache.stat(file), 0);
+assert.ok(cache.stat(created) < 0);
+
+const done = common.mustCall(() => {
+  cache.dirs.forEach((watcher) => watcher.close && watcher.close());
+});
+const invalidate = cache.invalidate;
+cache.invalidate = function(changed, renamed) {
+  invalidate.call(this, changed, renamed);
+  // Other tests change the directories above tmpdir.
+  if (path.dirname(changed) !== tmpdir.path)
+    return;
+  // Events are reported in order, so the write came before this.
+  assert.strictEqual(changed, created);
+  assert.strictEqual(renamed, true);
+  assert.strictEqual(cache.stats.get(file), 0);
+  assert.strictEqual(cache.stats.has(created), false);
+  done();
+};
+
+// Give the watcher time to start before changing anything.
+setTimeout(() => {
+  fs.appendFileSync(file, 'module.exports = 1;');
+  fs.writeFileSync(created, '');
+}, common.platformTimeout(100));
@@ -0,0 +1,52 @@
+// Flags: --experimental-module-stat-cache
+'use strict';
+const common = require('../common');
+
+// With --experimental-module-stat-cache, the file system lookups of require()
+// are kept after it returns, and dropped when fs.watch() reports a change.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+
+const tmpdir = require('../common/tmpdir');
+tmpdir.refresh();
+
+const app = path.join(tmpdir.path, 'app');
+const pkg = path.join(tmpdir.path, 'node_modules', 'pkg');
+fs.mkdirSync(path.join(app, 'lib'), { recursive: true });
+fs.mkdirSync(pkg, { recursive: true });
+fs.writeFileSync(path.join(pkg, 'index.js'), 'module.exports = "pkg";');
+fs.writeFileSync(path.join(app, 'lib', 'a.js'),
+                 'module.exports = require("pkg") + require("./b.json").b;');
+fs.writeFileSync(path.join(app, 'lib', 'b.json'), '{ "b": 1 }');
+
+// Modules are found through the node_modules directories as usual.
+assert.strictEqual(require(path.join(app, 'lib', 'a')), 'pkg1');
+
+// A module that does not exist yet is found once the watcher has seen it.
+const later = path.join(app, 'lib', 'later');
+assert.throws(() => require(later), { code: 'MODULE_NOT_FOUND' });
+fs.writeFileSync(`${later}.js`, 'module.exports = "later";');
+
+function waitForModule(request, expected, callback) {
+  let result;
+  try {
+    result = require(request);
+  } catch (err) {
+    assert.strictEqual(err.code, 'MODULE_NOT_FOUND');
+    setTimeout(waitForModule, 10, request, expected, callback);
+    return;
+  }
+  assert.strictEqual(result, expected);
+  callback();
+}
+
+waitForModule(later, 'later', common.mustCall(() => {
+  // The same holds for whole directories that are created later.
+  const other = path.join(tmpdir.path, 'other', 'node_modules', 'other');
+  assert.throws(() => require(other), { code: 'MODULE_NOT_FOUND' });
+  fs.mkdirSync(other, { recursive: true });
+  fs.writeFileSync(path.join(other, 'index.js'), 'module.exports = "other";');
+  waitForModule(other, 'other', common.mustCall());
+}));
@@ -0,0 +1,55 @@
+// Flags: --expose-internals --stream-read-pool-size=8192
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { internalBinding } = require('internal/test/binding');
+const { getReadPoolStatistics } = internalBinding('stream_wrap');
+
+// Reads on TCP sockets are served from the shared read pool and the data
+// arrives intact, even when a chunk does not fit into the rest of a slab.
+
+const messages = [];
+for (let i = 0; i < 50; i++)
+  messages.push(Buffer.alloc(100 + i * 97, String.fromCharCode(97 + i % 26)));
+const expected = Buffer.concat(messages);
+
+const server = net.createServer(common.mustCall((socket) => {
+  const chunks = [];
+  socket.on('data', (chunk) => {
+    // Pooled chunks are views into a larger slab.
+    assert.ok(chunk.byteOffset + chunk.length <= chunk.buffer.byteLength);
+    assert.strictEqual(chunk.buffer.byteLength, 8192);
+    assert.strictEqual(chunk.byteOffset % 8, 0);
+    // The rest of the slab has not been read into yet and is zero-filled.
+    const rest = new Uint8Array(chunk.buffer, chunk.byteOffset + chunk.length);
+    assert.ok(rest.every((byte) => byte === 0));
+    chunks.push(chunk);
+  });
+  socket.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(chunks), expected);
+
+    const stats = getReadPoolStatistics();
+    assert.ok(stats.pooledReads > 0);
+    assert.ok(stats.pooledBytes >= expected.length);
+    assert.ok(stats.slabsAllocated > 1);
+    assert.strictEqual(typeof stats.unpooledReads, 'number');
+    assert.strictEqual(typeof stats.slabsReused, 'number');
+    assert.strictEqual(typeof stats.slabsCollected, 'number');
+
+    socket.end();
+    server.close();
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port, common.mustCall(() => {
+    let i = 0;
+    (function writeNext() {
+      if (i === messages.length)
+        return client.end();
+      client.write(messages[i++], writeNext);
+    })();
+  }));
+  client.resume();
+}));
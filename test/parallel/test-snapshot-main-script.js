@@ -0,0 +1,51 @@
+'use strict';
+
+// Tests the --main option of node_mksnapshot, which is what configure's
+// --node-snapshot-main uses. The output file is only replaced if the script
+// runs successfully.
+
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+const tmpdir = require('../common/tmpdir');
+
+const exe = common.isWindows ? 'node_mksnapshot.exe' : 'node_mksnapshot';
+const mksnapshot = path.join(path.dirname(process.execPath), exe);
+if (!fs.existsSync(mksnapshot))
+  common.skip('node_mksnapshot is not available');
+
+tmpdir.refresh();
+const output = path.join(tmpdir.path, 'node_snapshot.cc');
+
+function run(source) {
+  const script = path.join(tmpdir.path, 'main.js');
+  fs.writeFileSync(script, source);
+  return spawnSync(mksnapshot, ['--main', script, output],
+                   { encoding: 'utf8' });
+}
+
+// A script that runs successfully produces a snapshot.
+let child = run('globalThis.snapshotMainValue = [1, 2, 3];');
+assert.strictEqual(child.status, 0, child.stderr);
+const snapshot = fs.readFileSync(output, 'utf8');
+assert.ok(snapshot.includes('GetEmbeddedSnapshotBlob'));
+assert.deepStrictEqual(fs.readdirSync(tmpdir.path).sort(),
+                       ['main.js', 'node_snapshot.cc']);
+
+// A script that throws fails the run and leaves the previous output alone.
+child = run('throw new Error("snapshot main failed");');
+assert.strictEqual(child.status, 1);
+assert.ok(child.stderr.includes('snapshot main failed'), child.stderr);
+assert.strictEqual(fs.readFileSync(output, 'utf8'), snapshot);
+assert.deepStrictEqual(fs.readdirSync(tmpdir.path).sort(),
+                       ['main.js', 'node_snapshot.cc']);
+
+// So does a script that does not exist.
+child = spawnSync(mksnapshot, [
+  '--main', path.join(tmpdir.path, 'missing.js'), output
+], { encoding: 'utf8' });
+assert.strictEqual(child.status, 1);
+assert.ok(child.stderr.includes('Cannot open'), child.stderr);
+assert.strictEqual(fs.readFileSync(output, 'utf8'), snapshot);
@@ -0,0 +1,119 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const fixtures = require('../common/fixtures');
+const tls = require('tls');
+
+// The kernelTLS option offloads encryption when possible and otherwise falls
+// back to user space. Data has to arrive intact either way.
+
+const key = fixtures.readKey('agent2-key.pem');
+const cert = fixtures.readKey('agent2-cert.pem');
+const payload = Buffer.alloc(128 * 1024, 'x');
+
+assert.throws(() => tls.connect({ kernelTLS: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+
+function unavailable(reason) {
+  return (status) => {
+    assert.deepStrictEqual(status, { tx: false, rx: false, reason });
+  };
+}
+
+// Whether the kernel accepted the keys, which depends on the `tls` module
+// being available. The first supported connection finds out.
+let kernelAvailable;
+
+function supported(status) {
+  if (kernelAvailable === undefined) {
+    kernelAvailable = status.tx;
+    if (!kernelAvailable) {
+      common.printSkipMessage('kernel TLS is not available ' +
+                              `(${status.reason})`);
+    }
+  }
+  if (kernelAvailable) {
+    assert.deepStrictEqual(status, { tx: true, rx: false });
+  } else {
+    assert.strictEqual(status.tx, false);
+    assert.strictEqual(status.rx, false);
+    assert.ok(status.reason.startsWith('kernel: '), status.reason);
+  }
+}
+
+const tests = [
+  [{ kernelTLS: false }, unavailable('not requested')],
+];
+if (common.isLinux) {
+  tests.push(
+    [{ minVersion: 'TLSv1.3' }, unavailable('protocol is not TLSv1.2')],
+    [{ maxVersion: 'TLSv1.2', ciphers: 'AES128-SHA256' },
+     unavailable('cipher AES128-SHA256 is not supported')],
+    [{ maxVersion: 'TLSv1.2', ciphers: 'ECDHE-RSA-AES128-GCM-SHA256' },
+     supported],
+    [{ maxVersion: 'TLSv1.2', ciphers: 'ECDHE-RSA-AES256-GCM-SHA384' },
+     supported]
+  );
+} else {
+  tests.push([{}, unavailable('not supported on this platform')]);
+}
+
+function collect(socket, callback) {
+  const chunks = [];
+  let length = 0;
+  socket.on('data', (chunk) => {
+    chunks.push(chunk);
+    length += chunk.length;
+    if (length === payload.length) {
+      assert.deepStrictEqual(Buffer.concat(chunks), payload);
+      callback();
+    }
+  });
+}
+
+// Both sides write right after the handshake.
+function runTest([options, checkStatus]) {
+  const server = tls.createServer({
+    key,
+    cert,
+    kernelTLS: true,
+    ...options
+  }, common.mustCall((socket) => {
+    socket.write(payload);
+    collect(socket, common.mustCall(() => {
+      checkStatus(socket.getKernelTLSStatus());
+    }));
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false,
+      kernelTLS: true,
+      ...options
+    }, common.mustCall(() => {
+      client.write(payload);
+    }));
+    if (options.kernelTLS !== false) {
+      assert.deepStrictEqual(client.getKernelTLSStatus(), {
+        tx: false,
+        rx: false,
+        reason: 'handshake in progress'
+      });
+    }
+    collect(client, common.mustCall(() => {
+      checkStatus(client.getKernelTLSStatus());
+      client.end();
+    }));
+    client.on('close', common.mustCall(() => {
+      server.close();
+      if (tests.length > 0)
+        runTest(tests.shift());
+    }));
+  }));
+}
+
+runTest(tests.shift());
@@ -0,0 +1,60 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+const assert = require('assert');
+const fixtures = require('../common/fixtures');
+const tls = require('tls');
+
+// Data written to a TLSSocket arrives intact whether it is written in many
+// small chunks, which are coalesced into shared records, or in large ones,
+// and the write counters account for all of it.
+
+const small = [];
+for (let i = 0; i < 200; i++)
+  small.push(Buffer.alloc(50 + i, String.fromCharCode(97 + i % 26)));
+const large = Buffer.alloc(256 * 1024, 'x');
+const expected = Buffer.concat([...small, large]);
+
+const server = tls.createServer({
+  key: fixtures.readKey('agent2-key.pem'),
+  cert: fixtures.readKey('agent2-cert.pem')
+}, common.mustCall((socket) => {
+  const chunks = [];
+  socket.on('data', (chunk) => chunks.push(chunk));
+  socket.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(chunks), expected);
+    socket.end();
+    server.close();
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = tls.connect({
+    port: server.address().port,
+    rejectUnauthorized: false
+  }, common.mustCall(() => {
+    const before = client.getWriteStatistics();
+    assert.strictEqual(before.cleartextBytes, 0);
+    assert.strictEqual(before.records, 0);
+
+    // Corked writes reach the TLS layer as a single writev().
+    client.cork();
+    for (const chunk of small)
+      client.write(chunk);
+    client.uncork();
+
+    client.write(large, common.mustCall(() => {
+      const stats = client.getWriteStatistics();
+      assert.strictEqual(stats.cleartextBytes, expected.length);
+      assert.ok(stats.records < small.length, `${stats.records} records`);
+      assert.ok(stats.records >= Math.ceil(expected.length / 16384));
+      assert.ok(stats.encryptedBytes > stats.cleartextBytes);
+      assert.ok(stats.flushes > 0);
+      assert.ok(stats.syncFlushes <= stats.flushes);
+      assert.strictEqual(typeof stats.syncWrites, 'number');
+      client.end();
+    }));
+  }));
+  client.resume();
+}));
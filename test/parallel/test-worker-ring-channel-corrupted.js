@@ -0,0 +1,46 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+const { RingChannel } = require('worker_threads');
+
+// Writes and reads fail with ERR_WORKER_RING_CHANNEL_CORRUPTED instead of
+// hanging or reading garbage when the header of the buffer is overwritten.
+
+// The indices in the header, as offsets into a Uint32Array.
+const kReserve = 0;
+const kCommit = 16;
+const kRead = 32;
+
+const corrupted = { code: 'ERR_WORKER_RING_CHANNEL_CORRUPTED' };
+
+function withIndices(indices, fn) {
+  const channel = new RingChannel(64);
+  const header = new Uint32Array(channel.buffer, 0, kRead + 1);
+  for (const [offset, value] of indices)
+    header[offset] = value;
+  fn(channel);
+  channel.close();
+}
+
+// The commit index is ahead of the reserve index.
+withIndices([[kCommit, 100]], (channel) => {
+  assert.throws(() => channel.write(Buffer.alloc(4)), corrupted);
+  assert.throws(() => channel.read(), corrupted);
+});
+
+// The commit index is not aligned.
+withIndices([[kReserve, 8], [kCommit, 2]], (channel) => {
+  assert.throws(() => channel.write(Buffer.alloc(4)), corrupted);
+});
+
+// Space was reserved but is never committed, as if a producer had stopped
+// half way. The write gives up after a while.
+withIndices([[kReserve, 8]], (channel) => {
+  assert.throws(() => channel.write(Buffer.alloc(4)), corrupted);
+  assert.strictEqual(channel.read(), undefined);
+});
+
+// The read index is ahead of the commit index.
+withIndices([[kRead, 8]], (channel) => {
+  assert.throws(() => channel.read(), corrupted);
+});
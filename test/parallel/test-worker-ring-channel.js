@@ -0,0 +1,117 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { RingChannel, Worker } = require('worker_threads');
+
+// Messages written to a RingChannel arrive in order and unchanged, also when
+// they wrap around the end of the ring or come from several threads.
+
+for (const [size, code] of [
+  [32, 'ERR_OUT_OF_RANGE'],
+  [2 ** 32, 'ERR_OUT_OF_RANGE'],
+  [1.5, 'ERR_OUT_OF_RANGE'],
+  [100, 'ERR_INVALID_ARG_VALUE'],
+  ['64', 'ERR_INVALID_ARG_TYPE'],
+]) {
+  assert.throws(() => new RingChannel(size), { code });
+}
+assert.throws(() => new RingChannel(new SharedArrayBuffer(1000)), {
+  code: 'ERR_INVALID_ARG_VALUE'
+});
+
+{
+  const channel = new RingChannel(64);
+  assert.strictEqual(channel.maxMessageSize, 28);
+  assert.throws(() => channel.write(Buffer.alloc(29)), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+  assert.throws(() => channel.write('foo'), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.strictEqual(channel.read(), undefined);
+
+  // Messages of different sizes wrap around the end of the ring many times.
+  for (let i = 0; i < 100; i++) {
+    const message = Buffer.alloc(i % 29, i);
+    assert.strictEqual(channel.write(message), true);
+    assert.deepStrictEqual(channel.read(), message);
+  }
+  assert.strictEqual(channel.read(), undefined);
+
+  // A Uint32Array is written as its bytes.
+  channel.write(new Uint32Array([1]));
+  assert.deepStrictEqual(channel.read(),
+                         Buffer.from(new Uint32Array([1]).buffer));
+
+  // Only one RingChannel for a buffer can receive messages.
+  const other = new RingChannel(channel.buffer);
+  assert.throws(() => other.read(), {
+    code: 'ERR_WORKER_RING_CHANNEL_RECEIVING'
+  });
+  assert.throws(() => other.on('message', common.mustNotCall()), {
+    code: 'ERR_WORKER_RING_CHANNEL_RECEIVING'
+  });
+  channel.close();
+  assert.strictEqual(channel.write(Buffer.alloc(1)), false);
+  assert.strictEqual(channel.read(), undefined);
+
+  // Once the receiver is closed, another one can take over.
+  assert.strictEqual(other.write(Buffer.from('abc')), true);
+  assert.deepStrictEqual(other.read(), Buffer.from('abc'));
+  other.close();
+}
+
+{
+  // A full ring emits 'drain' once the receiver has made room.
+  const channel = new RingChannel(64);
+  let written = 0;
+  while (channel.write(Buffer.alloc(12, written)))
+    written++;
+  assert.strictEqual(written, 4);
+  channel.on('drain', common.mustCall(() => {
+    assert.strictEqual(channel.write(Buffer.alloc(12, written)), true);
+    channel.close();
+  }));
+  for (let i = 0; i < written; i++)
+    assert.deepStrictEqual(channel.read(), Buffer.alloc(12, i));
+}
+
+{
+  // Several workers write to the same ring, the main thread receives.
+  const workers = 3;
+  const messages = 5000;
+  const channel = new RingChannel(4096);
+  const next = new Array(workers).fill(0);
+  let pending = workers * messages;
+  channel.on('message', common.mustCall((message) => {
+    const id = message.readUInt32LE(0);
+    assert.strictEqual(message.readUInt32LE(4), next[id]++);
+    assert.strictEqual(message.length, 8 + next[id] % 50);
+    if (--pending === 0)
+      channel.close();
+  }, workers * messages));
+
+  for (let id = 0; id < workers; id++) {
+    new Worker(`
+      const { RingChannel, workerData } = require('worker_threads');
+      const { buffer, id, messages } = workerData;
+      const channel = new RingChannel(buffer);
+      let i = 0;
+      function write() {
+        for (; i < messages; i++) {
+          const message = Buffer.alloc(8 + (i + 1) % 50);
+          message.writeUInt32LE(id, 0);
+          message.writeUInt32LE(i, 4);
+          if (!channel.write(message))
+            return;
+        }
+        channel.close();
+      }
+      channel.on('drain', write);
+      write();
+    `, {
+      eval: true,
+      workerData: { buffer: channel.buffer, id, messages }
+    }).on('exit', common.mustCall((code) => assert.strictEqual(code, 0)));
+  }
+}
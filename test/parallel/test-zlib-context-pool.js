@@ -0,0 +1,60 @@
+// Flags: --zlib-context-pool-size=1048576
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const { execFileSync } = require('child_process');
+const zlib = require('zlib');
+const { getContextPoolStatistics } = zlib;
+
+// Closed deflate streams are reused by new streams with the same parameters,
+// which must produce the same output as fresh ones.
+
+// Without the pool, all statistics are 0.
+assert.deepStrictEqual(JSON.parse(execFileSync(process.execPath, [
+  '-p', 'JSON.stringify(require("zlib").getContextPoolStatistics())'
+])), { hits: 0, misses: 0, released: 0, evicted: 0, idle: 0, idleBytes: 0 });
+
+const input = Buffer.from('hello world '.repeat(1000));
+const expected = {
+  gzip: zlib.gzipSync(input),
+  deflate: zlib.deflateSync(input),
+  deflateRaw: zlib.deflateRawSync(input, { level: 1 }),
+};
+
+let stats = getContextPoolStatistics();
+assert.strictEqual(stats.misses, 3);
+assert.strictEqual(stats.released, 3);
+assert.strictEqual(stats.idle, 3);
+
+for (let i = 0; i < 10; i++) {
+  assert.deepStrictEqual(zlib.gzipSync(input), expected.gzip);
+  assert.deepStrictEqual(zlib.deflateSync(input), expected.deflate);
+  assert.deepStrictEqual(zlib.deflateRawSync(input, { level: 1 }),
+                         expected.deflateRaw);
+}
+stats = getContextPoolStatistics();
+assert.strictEqual(stats.hits, 30);
+assert.strictEqual(stats.misses, 3);
+
+// Streams with a dictionary and decompression streams are not pooled.
+zlib.deflateSync(input, { dictionary: Buffer.from('hello') });
+zlib.inflateSync(expected.deflate);
+assert.deepStrictEqual(getContextPoolStatistics(), stats);
+
+// A stream that is closed halfway through leaves no state behind.
+const partial = zlib.createGzip();
+partial.write(input, common.mustCall(() => {
+  partial.close(common.mustCall(() => {
+    zlib.gzip(input, common.mustCall((err, result) => {
+      assert.ifError(err);
+      assert.deepStrictEqual(result, expected.gzip);
+
+      // The idle streams stay within the limit.
+      for (let level = 0; level <= 9; level++)
+        zlib.gzipSync(input, { level });
+      stats = getContextPoolStatistics();
+      assert.ok(stats.evicted > 0);
+      assert.ok(stats.idleBytes <= 1048576);
+    }));
+  }));
+}));
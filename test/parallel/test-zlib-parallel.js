@@ -0,0 +1,107 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+// With the parallel option, the input is compressed in blocks on several
+// threads. The result has to be a single valid stream of the same format.
+
+const blockSize = 32 * 1024;
+const chunks = [];
+for (let i = 0; i < 200; i++)
+  chunks.push(Buffer.from(`${i} `.repeat(i * 10) + 'x'.repeat(i % 7)));
+// Some data that does not compress.
+const noise = Buffer.alloc(100 * 1024);
+for (let i = 0, x = 1; i < noise.length; i++) {
+  x = (Math.imul(x, 1103515245) + 12345) >>> 0;
+  noise[i] = x >>> 24;
+}
+chunks.push(noise);
+const input = Buffer.concat(chunks);
+const dictionary = Buffer.from('0 1 2 3 4 5 6 7 8 9 x');
+
+assert.throws(() => zlib.createGzip({ parallel: 'yes' }), {
+  code: 'ERR_INVALID_ARG_TYPE'
+});
+assert.throws(() => zlib.createGzip({ parallel: 0 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+assert.throws(() => zlib.createGzip({ parallel: true, blockSize: 1024 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+
+const formats = [
+  ['Gzip', 'gunzipSync', {}],
+  ['Deflate', 'inflateSync', {}],
+  ['DeflateRaw', 'inflateRawSync', {}],
+  ['Deflate', 'inflateSync', { dictionary }],
+  ['DeflateRaw', 'inflateRawSync', { dictionary }],
+];
+
+for (const [type, decompress, extraOptions] of formats) {
+  const options = { parallel: 3, blockSize, ...extraOptions };
+  const inflate = (buffer) => zlib[decompress](buffer, extraOptions);
+
+  // Synchronous compression uses the same block format.
+  const method = `${type[0].toLowerCase()}${type.slice(1)}Sync`;
+  assert.deepStrictEqual(inflate(zlib[method](input, options)), input);
+  assert.deepStrictEqual(inflate(zlib[method]('', options)), Buffer.alloc(0));
+
+  // A small input is a single block.
+  assert.deepStrictEqual(zlib[method]('hello', options),
+                         zlib[method]('hello', extraOptions));
+
+  // Streams, with small output chunks and flushes in between.
+  const stream = new zlib[type]({ ...options, chunkSize: 1024 });
+  const output = [];
+  stream.on('data', (chunk) => output.push(chunk));
+  stream.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(inflate(Buffer.concat(output)), input);
+  }));
+  let flushed = 0;
+  chunks.forEach((chunk, i) => {
+    stream.write(chunk);
+    if (i % 50 === 49) {
+      stream.flush(common.mustCall(() => {
+        // Everything written so far can be decompressed.
+        const data = Buffer.concat(output);
+        const partial = zlib[decompress](data, {
+          ...extraOptions,
+          finishFlush: zlib.constants.Z_SYNC_FLUSH
+        });
+        assert.ok(partial.length > flushed);
+        flushed = partial.length;
+      }));
+    }
+  });
+  stream.end();
+}
+
+// The parameters can change in between.
+{
+  const stream = zlib.createGzip({ parallel: true, level: 1 });
+  const output = [];
+  stream.on('data', (chunk) => output.push(chunk));
+  stream.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(zlib.gunzipSync(Buffer.concat(output)),
+                           Buffer.concat([input, input]));
+  }));
+  stream.write(input);
+  stream.params(9, zlib.constants.Z_DEFAULT_STRATEGY, common.mustCall(() => {
+    stream.end(input);
+  }));
+}
+
+// Closing while blocks are being compressed.
+{
+  const stream = zlib.createDeflate({ parallel: 2, blockSize });
+  stream.write(input);
+  stream.close(common.mustCall());
+}
+
+// Decompression ignores the option.
+zlib.gunzip(zlib.gzipSync(input), { parallel: true },
+            common.mustCall((err, result) => {
+              assert.ifError(err);
+              assert.deepStrictEqual(result, input);
+            }));
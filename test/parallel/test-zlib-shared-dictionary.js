@@ -0,0 +1,89 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+const { Worker } = require('worker_threads');
+
+// A zlib.Dictionary can be used by many streams, also in Workers, and works
+// like the same data passed as a Buffer.
+
+const data = Buffer.from('{"id":,"name":"","email":"@example.com"}');
+const input = Buffer.from('{"id":1,"name":"someone","email":"a@example.com"}');
+
+[1, 'dictionary', {}, null].forEach((value) => {
+  assert.throws(() => zlib.createDictionary(value), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+  assert.throws(() => new zlib.Dictionary(value), {
+    code: 'ERR_INVALID_ARG_TYPE'
+  });
+});
+
+const dictionary = zlib.createDictionary(data);
+assert.ok(dictionary instanceof zlib.Dictionary);
+assert.ok(dictionary.buffer instanceof ArrayBuffer);
+assert.deepStrictEqual(Buffer.from(new zlib.Dictionary(data).buffer), data);
+assert.strictEqual(dictionary.byteLength, data.length);
+assert.throws(() => zlib.Dictionary(data), {
+  code: 'ERR_CONSTRUCT_CALL_REQUIRED'
+});
+
+// The data is copied once, also from a SharedArrayBuffer.
+const copy = Buffer.from(data);
+const fromCopy = zlib.createDictionary(copy);
+copy.fill(0);
+assert.deepStrictEqual(Buffer.from(fromCopy.buffer), data);
+const shared = new SharedArrayBuffer(data.length);
+data.copy(Buffer.from(shared));
+const fromShared = zlib.createDictionary(shared);
+Buffer.from(shared).fill(0);
+assert.deepStrictEqual(Buffer.from(fromShared.buffer), data);
+
+// The contents of a dictionary cannot be changed through its buffer.
+assert.notStrictEqual(dictionary.buffer, dictionary.buffer);
+new Uint8Array(dictionary.buffer).fill(0);
+assert.deepStrictEqual(Buffer.from(dictionary.buffer), data);
+
+for (const [compress, decompress] of [
+  ['deflateSync', 'inflateSync'],
+  ['deflateRawSync', 'inflateRawSync'],
+]) {
+  const expected = zlib[compress](input, { dictionary: data });
+  for (let i = 0; i < 3; i++) {
+    const compressed = zlib[compress](input, { dictionary });
+    assert.deepStrictEqual(compressed, expected);
+    assert.deepStrictEqual(zlib[decompress](compressed, { dictionary }), input);
+  }
+  assert.deepStrictEqual(
+    zlib[compress](input, { dictionary, parallel: 2 }), expected);
+}
+
+// Decompressing without the dictionary fails.
+assert.throws(() => zlib.inflateSync(zlib.deflateSync(input, { dictionary })),
+              /Missing dictionary/);
+
+// Streams in a Worker share the memory of the dictionary.
+const worker = new Worker(`
+  const assert = require('assert');
+  const { parentPort, workerData } = require('worker_threads');
+  const zlib = require('zlib');
+  const { dictionary } = workerData;
+  assert.ok(dictionary instanceof zlib.Dictionary);
+  zlib.deflate(workerData.input, { dictionary }, (err, result) => {
+    if (err) throw err;
+    parentPort.postMessage(result);
+  });
+`, { eval: true, workerData: { dictionary, input } });
+worker.on('message', common.mustCall((compressed) => {
+  assert.deepStrictEqual(
+    zlib.inflateSync(Buffer.from(compressed), { dictionary }), input);
+}));
+worker.on('exit', common.mustCall((code) => {
+  assert.strictEqual(code, 0);
+  // The dictionary stays usable after the Worker is gone.
+  zlib.inflate(zlib.deflateSync(input, { dictionary }), { dictionary },
+               common.mustCall((err, result) => {
+                 assert.ifError(err);
+                 assert.deepStrictEqual(result, input);
+               }));
+}));
@@ -104,6 +104,15 @@ function testInitialized(req, ctor_name) {
 }
 
 
+{
+  const { RingChannel, kRingChannelHeaderSize } = internalBinding('messaging');
+  const handle =
+    new RingChannel(new SharedArrayBuffer(kRingChannelHeaderSize + 64));
+  testInitialized(handle, 'RingChannel');
+  handle.close();
+}
+
+
 {
   // We don't want to expose getAsyncId for promises but we need to construct
   // one so that the corresponding provider type is removed from the
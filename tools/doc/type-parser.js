@@ -94,6 +94,7 @@ const customTypesMap = {
     'http2.html#http2_class_http2_http2serverresponse',
   'Http2SecureServer': 'http2.html#http2_class_http2secureserver',
   'Http2Server': 'http2.html#http2_class_http2server',
+  'Http2HeaderSet': 'http2.html#http2_class_http2headerset',
   'Http2Session': 'http2.html#http2_class_http2session',
   'Http2Stream': 'http2.html#http2_class_http2stream',
   'ServerHttp2Stream': 'http2.html#http2_class_serverhttp2stream',
@@ -145,7 +146,9 @@ const customTypesMap = {
   'vm.SourceTextModule': 'vm.html#vm_class_vm_sourcetextmodule',
 
   'MessagePort': 'worker_threads.html#worker_threads_class_messageport',
+  'RingChannel': 'worker_threads.html#worker_threads_class_ringchannel',
 
+  'zlib.Dictionary': 'zlib.html#zlib_class_zlib_dictionary',
   'zlib options': 'zlib.html#zlib_class_options',
 };
 
@@ -1,4 +1,5 @@
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -13,23 +14,40 @@
 
 #ifdef _WIN32
 #include <windows.h>
-
-int wmain(int argc, wchar_t* argv[]) {
-#else   // UNIX
-int main(int argc, char* argv[]) {
 #endif  // _WIN32
 
+static int Main(int argc, char* argv[]) {
   v8::V8::SetFlagsFromString("--random_seed=42");
 
-  if (argc < 2) {
-    std::cerr << "Usage: " << argv[0] << " <path/to/output.cc>\n";
+  if (argc != 2 && !(argc == 4 && strcmp(argv[1], "--main") == 0)) {
+    std::cerr << "Usage: " << argv[0]
+              << " [--main <path/to/script.js>] <path/to/output.cc>\n";
     return 1;
   }
 
+  std::string main_script;
+  std::string main_script_name;
+  if (argc == 4) {
+    main_script_name = argv[2];
+    std::ifstream in(main_script_name, std::ios::in | std::ios::binary);
+    if (!in.is_open()) {
+      std::cerr << "Cannot open " << main_script_name << "\n";
+      return 1;
+    }
+    std::stringstream contents;
+    contents << in.rdbuf();
+    main_script = contents.str();
+  }
+
+  // The output only replaces an existing file once it is complete, so that a
+  // failed run does not leave behind a file that the build considers to be
+  // up to date.
+  std::string output = argv[argc - 1];
+  std::string temp_output = output + ".tmp";
   std::ofstream out;
-  out.open(argv[1], std::ios::out | std::ios::binary);
+  out.open(temp_output, std::ios::out | std::ios::binary);
   if (!out.is_open()) {
-    std::cerr << "Cannot open " << argv[1] << "\n";
+    std::cerr << "Cannot open " << temp_output << "\n";
     return 1;
   }
 
@@ -42,13 +60,57 @@ int main(int argc, char* argv[]) {
   CHECK(!result.early_return);
   CHECK_EQ(result.exit_code, 0);
 
+  int exit_code = 0;
   {
-    std::string snapshot =
-        node::SnapshotBuilder::Generate(result.args, result.exec_args);
-    out << snapshot;
+    std::string snapshot = node::SnapshotBuilder::Generate(
+        result.args, result.exec_args, main_script, main_script_name);
+    if (snapshot.empty()) {
+      std::cerr << "Failed to run " << main_script_name << "\n";
+      exit_code = 1;
+    } else {
+      out << snapshot;
+    }
     out.close();
   }
 
+  if (exit_code == 0) {
+#ifdef _WIN32
+    // rename() does not replace existing files on Windows.
+    std::remove(output.c_str());
+#endif  // _WIN32
+    if (out.fail() || std::rename(temp_output.c_str(), output.c_str()) != 0) {
+      std::cerr << "Cannot write " << output << "\n";
+      exit_code = 1;
+    }
+  }
+  if (exit_code != 0)
+    std::remove(temp_output.c_str());
+
   node::TearDownOncePerProcess();
-  return 0;
+  return exit_code;
 }
+
+#ifdef _WIN32
+int wmain(int argc, wchar_t* wargv[]) {
+  // Convert argv to UTF8
+  std::vector<std::string> args(argc);
+  std::vector<char*> argv(argc + 1);
+  for (int i = 0; i < argc; i++) {
+    int size = WideCharToMultiByte(
+        CP_UTF8, 0, wargv[i], -1, nullptr, 0, nullptr, nullptr);
+    if (size == 0) {
+      std::cerr << "Could not convert arguments to utf8.\n";
+      return 1;
+    }
+    args[i].resize(size);
+    WideCharToMultiByte(
+        CP_UTF8, 0, wargv[i], -1, &args[i][0], size, nullptr, nullptr);
+    argv[i] = &args[i][0];
+  }
+  return Main(argc, argv.data());
+}
+#else   // UNIX
+int main(int argc, char* argv[]) {
+  return Main(argc, argv);
+}
+#endif  // _WIN32
@@ -10,8 +10,14 @@ namespace node {
 using v8::Context;
 using v8::HandleScope;
 using v8::Isolate;
+using v8::Local;
+using v8::NewStringType;
+using v8::Script;
+using v8::ScriptOrigin;
 using v8::SnapshotCreator;
 using v8::StartupData;
+using v8::String;
+using v8::TryCatch;
 
 template <typename T>
 void WriteVector(std::stringstream* ss, const T* vec, size_t size) {
@@ -60,9 +66,36 @@ const std::vector<size_t>* NodeMainInstance::GetIsolateDataIndexes() {
   return ss.str();
 }
 
+static bool RunMainScript(Isolate* isolate,
+                          Local<Context> context,
+                          const std::string& source,
+                          const std::string& filename) {
+  Context::Scope context_scope(context);
+  TryCatch try_catch(isolate);
+  Local<String> source_str;
+  Local<String> filename_str;
+  Local<Script> script;
+  if (!String::NewFromUtf8(isolate, source.data(), NewStringType::kNormal,
+                           source.size()).ToLocal(&source_str) ||
+      !String::NewFromUtf8(isolate, filename.data(), NewStringType::kNormal,
+                           filename.size()).ToLocal(&filename_str)) {
+    std::cerr << "Cannot load " << filename << "\n";
+    return false;
+  }
+  ScriptOrigin origin(filename_str);
+  if (!Script::Compile(context, source_str, &origin).ToLocal(&script) ||
+      script->Run(context).IsEmpty()) {
+    PrintCaughtException(isolate, context, try_catch);
+    return false;
+  }
+  return true;
+}
+
 std::string SnapshotBuilder::Generate(
     const std::vector<std::string> args,
-    const std::vector<std::string> exec_args) {
+    const std::vector<std::string> exec_args,
+    const std::string& main_script,
+    const std::string& main_script_name) {
   // TODO(joyeecheung): collect external references and set it in
   // params.external_references.
   std::vector<intptr_t> external_references = {
@@ -72,6 +105,7 @@ std::string SnapshotBuilder::Generate(
                                                        uv_default_loop());
   std::unique_ptr<NodeMainInstance> main_instance;
   std::string result;
+  bool failed = false;
 
   {
     std::vector<size_t> isolate_data_indexes;
@@ -87,18 +121,28 @@ std::string SnapshotBuilder::Generate(
       creator.SetDefaultContext(Context::New(isolate));
       isolate_data_indexes = main_instance->isolate_data()->Serialize(&creator);
 
-      size_t index = creator.AddContext(NewContext(isolate));
+      Local<Context> context = NewContext(isolate);
+      if (!main_script.empty() &&
+          !RunMainScript(isolate, context, main_script, main_script_name)) {
+        failed = true;
+      }
+      size_t index = creator.AddContext(context);
       CHECK_EQ(index, NodeMainInstance::kNodeContextIndex);
     }
 
+    // Keep the code compiled by the main script so that it does not have to
+    // be compiled again at startup.
+    SnapshotCreator::FunctionCodeHandling function_code_handling =
+        main_script.empty() ? SnapshotCreator::FunctionCodeHandling::kClear :
+                              SnapshotCreator::FunctionCodeHandling::kKeep;
     // Must be out of HandleScope
-    StartupData blob =
-        creator.CreateBlob(SnapshotCreator::FunctionCodeHandling::kClear);
+    StartupData blob = creator.CreateBlob(function_code_handling);
     CHECK(blob.CanBeRehashed());
     // Must be done while the snapshot creator isolate is entered i.e. the
     // creator is still alive.
     main_instance->Dispose();
-    result = FormatBlob(&blob, isolate_data_indexes);
+    if (!failed)
+      result = FormatBlob(&blob, isolate_data_indexes);
     delete[] blob.data;
   }
 
@@ -7,8 +7,16 @@
 namespace node {
 class SnapshotBuilder {
  public:
+  // If |main_script| is not empty, it is run in the main context before the
+  // context is serialized, and whatever it leaves on the global object is
+  // available to every process started from the snapshot. The script runs
+  // before Node.js is bootstrapped, so it can only use plain JavaScript.
+  // Worker threads do not start from the snapshot and do not see its effects.
+  // Returns an empty string if the script throws.
   static std::string Generate(const std::vector<std::string> args,
-                              const std::vector<std::string> exec_args);
+                              const std::vector<std::string> exec_args,
+                              const std::string& main_script = "",
+                              const std::string& main_script_name = "");
 };
 }  // namespace node
 